@@ -0,0 +1,214 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <libp2p/basic/coroutine.hpp>
+#include <libp2p/basic/readwriter.hpp>
+
+/**
+ * @file coroutine_benchmark.cpp
+ * Echo session written as a chain of callbacks (each capturing
+ * shared_from_this() and a copy of the message, as protocol sessions used to)
+ * vs the same session written as basic::Coroutine. Stream completes
+ * operations via io_context, so the numbers show the overhead of the
+ * session itself.
+ *
+ * Argument: message size.
+ *
+ * Reported counters:
+ *  - allocs_per_op: heap allocations per echoed message.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  std::atomic<size_t> allocations{0};
+}  // namespace
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+  using Result = outcome::result<size_t>;
+
+  /// Stream which has always data to read and accepts all the writes,
+  /// callbacks are posted to io_context
+  class LoopStream : public basic::ReadWriter {
+   public:
+    explicit LoopStream(boost::asio::io_context &io) : io_(io) {}
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      readSome(out, bytes, std::move(cb));
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      deferReadCallback(std::min<size_t>(bytes, out.size()), std::move(cb));
+    }
+
+    void deferReadCallback(Result res, ReadCallbackFunc cb) override {
+      boost::asio::post(io_, [res, cb{std::move(cb)}] { cb(res); });
+    }
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override {
+      deferReadCallback(bytes, std::move(cb));
+    }
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override {
+      write(in, bytes, std::move(cb));
+    }
+
+    void deferWriteCallback(std::error_code ec,
+                            WriteCallbackFunc cb) override {
+      deferReadCallback(ec, std::move(cb));
+    }
+
+   private:
+    boost::asio::io_context &io_;
+  };
+
+  /// Echo session as a chain of callbacks
+  class CallbackEcho : public std::enable_shared_from_this<CallbackEcho> {
+   public:
+    CallbackEcho(std::shared_ptr<LoopStream> stream, size_t msg_size,
+                 size_t rounds)
+        : stream_(std::move(stream)), buf_(msg_size), rounds_(rounds) {}
+
+    void start() {
+      doRead();
+    }
+
+   private:
+    void doRead() {
+      if (rounds_ == 0) {
+        return;
+      }
+      stream_->readSome(
+          buf_, buf_.size(),
+          [self{shared_from_this()}](Result res) { self->onRead(res); });
+    }
+
+    void onRead(Result res) {
+      if (!res) {
+        return;
+      }
+      auto write_buf =
+          std::vector<uint8_t>(buf_.begin(), buf_.begin() + res.value());
+      gsl::span<const uint8_t> span = write_buf;
+      stream_->write(span, span.size(),
+                     [self{shared_from_this()},
+                      write_buf{std::move(write_buf)}](Result res) {
+                       self->onWrite(res);
+                     });
+    }
+
+    void onWrite(Result res) {
+      if (!res) {
+        return;
+      }
+      --rounds_;
+      doRead();
+    }
+
+    std::shared_ptr<LoopStream> stream_;
+    std::vector<uint8_t> buf_;
+    size_t rounds_;
+  };
+
+  /// The same session as a coroutine
+  class CoroutineEcho : public basic::Coroutine<CoroutineEcho> {
+   public:
+    CoroutineEcho(std::shared_ptr<LoopStream> stream, size_t msg_size,
+                  size_t rounds)
+        : stream_(std::move(stream)), buf_(msg_size), rounds_(rounds) {}
+
+    static void start(std::shared_ptr<CoroutineEcho> self) {
+      self->spawn(self);
+    }
+
+    void resume(Result res) {
+      BOOST_ASIO_CORO_REENTER(this) {
+        for (; rounds_ > 0; --rounds_) {
+          BOOST_ASIO_CORO_YIELD awaitReadSome(*stream_, buf_, buf_.size());
+          if (!res) {
+            break;
+          }
+          BOOST_ASIO_CORO_YIELD awaitWrite(*stream_, buf_, res.value());
+          if (!res) {
+            break;
+          }
+        }
+      }
+    }
+
+   private:
+    std::shared_ptr<LoopStream> stream_;
+    std::vector<uint8_t> buf_;
+    size_t rounds_;
+  };
+
+  /// Messages echoed by one session in each iteration
+  constexpr size_t kRounds = 1000;
+
+  template <typename Start>
+  void runEcho(benchmark::State &state, Start &&start) {
+    const auto msg_size = static_cast<size_t>(state.range(0));
+    boost::asio::io_context io;
+    auto stream = std::make_shared<LoopStream>(io);
+
+    size_t allocs = 0;
+    for (auto _ : state) {
+      auto started = allocations.load(std::memory_order_relaxed);
+      start(stream, msg_size);
+      io.restart();
+      io.run();
+      allocs += allocations.load(std::memory_order_relaxed) - started;
+    }
+
+    auto ops = static_cast<double>(state.iterations() * kRounds);
+    state.SetItemsProcessed(static_cast<int64_t>(ops));
+    state.counters["allocs_per_op"] = static_cast<double>(allocs) / ops;
+  }
+
+  void BM_CallbackEcho(benchmark::State &state) {
+    runEcho(state, [](auto stream, size_t msg_size) {
+      std::make_shared<CallbackEcho>(std::move(stream), msg_size, kRounds)
+          ->start();
+    });
+  }
+
+  void BM_CoroutineEcho(benchmark::State &state) {
+    runEcho(state, [](auto stream, size_t msg_size) {
+      CoroutineEcho::start(std::make_shared<CoroutineEcho>(
+          std::move(stream), msg_size, kRounds));
+    });
+  }
+
+}  // namespace
+
+BENCHMARK(BM_CallbackEcho)->ArgName("msg_size")->Arg(64)->Arg(16 * 1024);
+BENCHMARK(BM_CoroutineEcho)->ArgName("msg_size")->Arg(64)->Arg(16 * 1024);
@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdlib>
+
+#include <benchmark/benchmark.h>
+#include "testutil/prepare_loggers.hpp"
+
+/**
+ * Common entry point of all benchmarks: libp2p loggers are muted down to
+ * errors (unless TRACE_DEBUG is set), so that logging does not affect the
+ * measurements
+ */
+int main(int argc, char **argv) {
+  testutil::prepareLoggers(std::getenv("TRACE_DEBUG") != nullptr
+                               ? soralog::Level::TRACE
+                               : soralog::Level::ERROR);
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return EXIT_FAILURE;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BENCHUTIL_DELAYED_LINK_HPP
+#define LIBP2P_BENCHUTIL_DELAYED_LINK_HPP
+
+#include <deque>
+#include <random>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <libp2p/connection/secure_connection.hpp>
+#include <libp2p/transport/memory/memory_connection.hpp>
+
+namespace benchutil {
+
+  /// Link parameters, zero bandwidth means unlimited
+  struct LinkConfig {
+    std::chrono::milliseconds delay{};
+    size_t bytes_per_second = 0;
+  };
+
+  inline libp2p::peer::PeerId randomPeerId(std::mt19937 &gen) {
+    std::uniform_int_distribution<int> dist{0, 255};
+    std::vector<uint8_t> bytes(32);
+    for (auto &b : bytes) {
+      b = static_cast<uint8_t>(dist(gen));
+    }
+    auto hash =
+        libp2p::multi::Multihash::create(libp2p::multi::sha256, bytes);
+    return libp2p::peer::PeerId::fromHash(hash.value()).value();
+  }
+
+  /**
+   * Secure connection over a memory connection, which passes written data to
+   * the other side after delay. Writes complete immediately if bandwidth is
+   * unlimited, otherwise after the data is transmitted at link rate
+   */
+  class DelayedConnection
+      : public libp2p::connection::SecureConnection,
+        public std::enable_shared_from_this<DelayedConnection> {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    DelayedConnection(
+        boost::asio::io_context &io,
+        std::shared_ptr<libp2p::transport::MemoryConnection> raw,
+        LinkConfig link, libp2p::peer::PeerId local,
+        libp2p::peer::PeerId remote)
+        : io_(io),
+          raw_(std::move(raw)),
+          link_(link),
+          delivery_timer_(io),
+          write_timer_(io),
+          local_(std::move(local)),
+          remote_(std::move(remote)) {}
+
+    libp2p::outcome::result<libp2p::peer::PeerId> localPeer()
+        const override {
+      return local_;
+    }
+
+    libp2p::outcome::result<libp2p::peer::PeerId> remotePeer()
+        const override {
+      return remote_;
+    }
+
+    libp2p::outcome::result<libp2p::crypto::PublicKey> remotePublicKey()
+        const override {
+      return std::make_error_code(std::errc::not_supported);
+    }
+
+    bool isInitiator() const noexcept override {
+      return raw_->isInitiator();
+    }
+
+    libp2p::outcome::result<libp2p::multi::Multiaddress> localMultiaddr()
+        override {
+      return raw_->localMultiaddr();
+    }
+
+    libp2p::outcome::result<libp2p::multi::Multiaddress> remoteMultiaddr()
+        override {
+      return raw_->remoteMultiaddr();
+    }
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      raw_->read(out, bytes, std::move(cb));
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      raw_->readSome(out, bytes, std::move(cb));
+    }
+
+    void deferReadCallback(libp2p::outcome::result<size_t> res,
+                           ReadCallbackFunc cb) override {
+      raw_->deferReadCallback(res, std::move(cb));
+    }
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override {
+      writeSome(in, bytes, std::move(cb));
+    }
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override {
+      auto transmitted = Clock::now();
+      if (link_.bytes_per_second > 0) {
+        transmitted = std::max(transmitted, link_free_at_)
+            + std::chrono::nanoseconds(bytes * 1000000000ull
+                                       / link_.bytes_per_second);
+        link_free_at_ = transmitted;
+      }
+
+      line_.push_back({transmitted + link_.delay,
+                       libp2p::common::ByteArray(in.begin(),
+                                                 in.begin() + bytes)});
+      if (line_.size() == 1) {
+        deliverNext();
+      }
+
+      if (link_.bytes_per_second == 0) {
+        boost::asio::post(io_, [cb{std::move(cb)}, bytes] { cb(bytes); });
+        return;
+      }
+      write_timer_.expires_at(transmitted);
+      write_timer_.async_wait(
+          [cb{std::move(cb)}, bytes](const boost::system::error_code &ec) {
+            if (ec) {
+              cb(std::make_error_code(std::errc::operation_canceled));
+            } else {
+              cb(bytes);
+            }
+          });
+    }
+
+    void deferWriteCallback(std::error_code ec,
+                            WriteCallbackFunc cb) override {
+      raw_->deferWriteCallback(ec, std::move(cb));
+    }
+
+    bool isClosed() const override {
+      return raw_->isClosed();
+    }
+
+    libp2p::outcome::result<void> close() override {
+      delivery_timer_.cancel();
+      write_timer_.cancel();
+      return raw_->close();
+    }
+
+   private:
+    struct Delayed {
+      Clock::time_point deliver_at;
+      libp2p::common::ByteArray data;
+    };
+
+    void deliverNext() {
+      delivery_timer_.expires_at(line_.front().deliver_at);
+      delivery_timer_.async_wait(
+          [wptr{weak_from_this()}](const boost::system::error_code &ec) {
+            auto self = wptr.lock();
+            if (!self || ec) {
+              return;
+            }
+            // memory connection copies data into the other side's buffer
+            auto &data = self->line_.front().data;
+            self->raw_->write(data, data.size(),
+                              [](libp2p::outcome::result<size_t>) {});
+            self->line_.pop_front();
+            if (!self->line_.empty()) {
+              self->deliverNext();
+            }
+          });
+    }
+
+    boost::asio::io_context &io_;
+    std::shared_ptr<libp2p::transport::MemoryConnection> raw_;
+    LinkConfig link_;
+    boost::asio::steady_timer delivery_timer_;
+    boost::asio::steady_timer write_timer_;
+    Clock::time_point link_free_at_;
+    std::deque<Delayed> line_;
+    libp2p::peer::PeerId local_;
+    libp2p::peer::PeerId remote_;
+  };
+
+  /// Creates two sides of a delayed link, {initiator's, acceptor's}
+  inline std::pair<std::shared_ptr<DelayedConnection>,
+                   std::shared_ptr<DelayedConnection>>
+  makeDelayedLink(boost::asio::io_context &io, LinkConfig link) {
+    std::mt19937 gen{42};  // NOLINT
+    auto initiator_id = randomPeerId(gen);
+    auto acceptor_id = randomPeerId(gen);
+    auto [a, b] = libp2p::transport::MemoryConnection::makePair(
+        io, libp2p::multi::Multiaddress::create("/memory/1").value(),
+        libp2p::multi::Multiaddress::create("/memory/2").value());
+    return {std::make_shared<DelayedConnection>(io, a, link, initiator_id,
+                                                acceptor_id),
+            std::make_shared<DelayedConnection>(io, b, link, acceptor_id,
+                                                initiator_id)};
+  }
+
+}  // namespace benchutil
+
+#endif  // LIBP2P_BENCHUTIL_DELAYED_LINK_HPP
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BENCHUTIL_LATENCY_RECORDER_HPP
+#define LIBP2P_BENCHUTIL_LATENCY_RECORDER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace benchutil {
+
+  /**
+   * Collects latency samples and reports their percentiles as benchmark
+   * counters (in microseconds)
+   */
+  class LatencyRecorder {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit LatencyRecorder(size_t expected_samples = 0) {
+      samples_.reserve(expected_samples);
+    }
+
+    /// Starts measuring of a single sample
+    void start() {
+      started_ = Clock::now();
+    }
+
+    /// Finishes measuring of a single sample started by start()
+    void stop() {
+      add(Clock::now() - started_);
+    }
+
+    void add(Clock::duration sample) {
+      samples_.push_back(sample);
+    }
+
+    size_t size() const {
+      return samples_.size();
+    }
+
+    /// Returns q-th percentile (q in [0, 1]) in microseconds
+    double percentile(double q) {
+      if (samples_.empty()) {
+        return 0.0;
+      }
+      auto n = static_cast<size_t>(q * static_cast<double>(samples_.size()));
+      n = std::min(n, samples_.size() - 1);
+      std::nth_element(samples_.begin(), samples_.begin() + n, samples_.end());
+      return std::chrono::duration<double, std::micro>(samples_[n]).count();
+    }
+
+    /// Puts p50 and p99 latencies into state counters
+    void report(::benchmark::State &state) {
+      state.counters["p50_us"] = percentile(0.5);
+      state.counters["p99_us"] = percentile(0.99);
+    }
+
+   private:
+    Clock::time_point started_;
+    std::vector<Clock::duration> samples_;
+  };
+
+}  // namespace benchutil
+
+#endif  // LIBP2P_BENCHUTIL_LATENCY_RECORDER_HPP
@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BENCHUTIL_LOOPBACK_HOSTS_HPP
+#define LIBP2P_BENCHUTIL_LOOPBACK_HOSTS_HPP
+
+#include <atomic>
+#include <chrono>
+
+#include <boost/di/extension/scopes/shared.hpp>
+#include <libp2p/injector/host_injector.hpp>
+
+namespace benchutil {
+
+  /// Returns unique /ip4/127.0.0.1/tcp/<port> address for each call
+  inline libp2p::multi::Multiaddress nextLoopbackAddress() {
+    static std::atomic<uint16_t> port{42000};
+    return libp2p::multi::Multiaddress::create(
+               "/ip4/127.0.0.1/tcp/" + std::to_string(port++))
+        .value();
+  }
+
+  /// Returns unique /memory/<id> address for each call
+  inline libp2p::multi::Multiaddress nextMemoryAddress() {
+    static std::atomic<uint64_t> id{42000};
+    return libp2p::multi::Multiaddress::create("/memory/"
+                                               + std::to_string(id++))
+        .value();
+  }
+
+  /**
+   * Makes host injector with the given security and muxer adaptors, all
+   * the objects created by the injector share the given io_context
+   */
+  template <typename SecurityAdaptor, typename MuxerAdaptor,
+            typename... InjectorArgs>
+  auto makeInjector(std::shared_ptr<boost::asio::io_context> io,
+                    InjectorArgs &&...args) {
+    return libp2p::injector::makeHostInjector<
+        boost::di::extension::shared_config>(
+        boost::di::bind<boost::asio::io_context>.to(
+            std::move(io))[boost::di::override],
+        libp2p::injector::useSecurityAdaptors<SecurityAdaptor>(),
+        libp2p::injector::useMuxerAdaptors<MuxerAdaptor>(),
+        std::forward<InjectorArgs>(args)...);
+  }
+
+  /**
+   * Two real hosts (server and client) built by the host injector with the
+   * given security and muxer adaptors over TCP loopback. Both hosts share
+   * the same io_context, which is driven by the benchmark thread
+   */
+  template <typename SecurityAdaptor, typename MuxerAdaptor>
+  class LoopbackHosts {
+   public:
+    using Timeout = std::chrono::milliseconds;
+
+    static constexpr Timeout kDefaultTimeout{10000};
+
+    template <typename... InjectorArgs>
+    explicit LoopbackHosts(InjectorArgs &&...args)
+        : io_(std::make_shared<boost::asio::io_context>()),
+          server_(makeHost(args...)),
+          client_(makeHost(args...)) {}
+
+    ~LoopbackHosts() {
+      client_->stop();
+      server_->stop();
+      io_->restart();
+      io_->poll();
+    }
+
+    /// Makes the server listen and starts both hosts
+    bool start() {
+      if (!server_->listen(nextLoopbackAddress())) {
+        return false;
+      }
+      server_->start();
+      client_->start();
+      return true;
+    }
+
+    libp2p::Host &server() {
+      return *server_;
+    }
+
+    libp2p::Host &client() {
+      return *client_;
+    }
+
+    libp2p::peer::PeerInfo serverInfo() const {
+      return server_->getPeerInfo();
+    }
+
+    boost::asio::io_context &io() {
+      return *io_;
+    }
+
+    /**
+     * Runs io_context handlers until predicate is satisfied
+     * @return false on timeout
+     */
+    template <typename Predicate>
+    bool runUntil(Predicate &&done, Timeout timeout = kDefaultTimeout) {
+      auto deadline = std::chrono::steady_clock::now() + timeout;
+      io_->restart();
+      while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          return false;
+        }
+        io_->run_one_for(timeout);
+      }
+      return true;
+    }
+
+   private:
+    template <typename... InjectorArgs>
+    std::shared_ptr<libp2p::Host> makeHost(InjectorArgs &...args) {
+      auto injector =
+          makeInjector<SecurityAdaptor, MuxerAdaptor>(io_, args...);
+      return injector.template create<std::shared_ptr<libp2p::Host>>();
+    }
+
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::shared_ptr<libp2p::Host> server_;
+    std::shared_ptr<libp2p::Host> client_;
+  };
+
+}  // namespace benchutil
+
+#endif  // LIBP2P_BENCHUTIL_LOOPBACK_HOSTS_HPP
@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <libp2p/crypto/protobuf/protobuf_key.hpp>
+#include <libp2p/log/lazy.hpp>
+#include <libp2p/log/sublogger.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+/**
+ * @file lazy_logging_benchmark.cpp
+ * Cost of debug log calls with peer id and address arguments while debug
+ * level is disabled (benchmarks run with errors only), as in Kademlia
+ * executors:
+ *  - Eager: arguments are converted to strings before the level check,
+ *  - Lazy: arguments are wrapped with log::lazy() and log::address(),
+ *  - Gated: SUBLOG_DEBUG() checks the level before evaluating arguments.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+
+  peer::PeerId makePeerId() {
+    std::vector<uint8_t> key(36, 0x42);
+    return peer::PeerId::fromPublicKey(crypto::ProtobufKey{key}).value();
+  }
+
+  struct Fixture {
+    log::SubLogger log{"Benchmark", log::defaultGroupName};
+    peer::PeerId peer_id = makePeerId();
+    multi::Multiaddress address =
+        multi::Multiaddress::create("/ip4/192.168.0.1/tcp/30333").value();
+  };
+
+  void BM_EagerDebug(benchmark::State &state) {
+    Fixture f;
+    for (auto _ : state) {
+      f.log.debug("connected to {} at {}", f.peer_id.toBase58(),
+                  f.address.getStringAddress());
+    }
+  }
+
+  void BM_LazyDebug(benchmark::State &state) {
+    Fixture f;
+    for (auto _ : state) {
+      f.log.debug("connected to {} at {}",
+                  log::lazy([&] { return f.peer_id.toBase58(); }),
+                  log::address(f.address));
+    }
+  }
+
+  void BM_GatedDebug(benchmark::State &state) {
+    Fixture f;
+    for (auto _ : state) {
+      SUBLOG_DEBUG(f.log, "connected to {} at {}", f.peer_id.toBase58(),
+                   f.address.getStringAddress());
+    }
+  }
+
+}  // namespace
+
+BENCHMARK(BM_EagerDebug);
+BENCHMARK(BM_LazyDebug);
+BENCHMARK(BM_GatedDebug);
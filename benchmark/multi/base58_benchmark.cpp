@@ -0,0 +1,168 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <random>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+#include <libp2p/multi/multibase_codec/codecs/base58.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+/**
+ * @file base58_benchmark.cpp
+ * Base58 codec vs the previous byte-at-a-time implementation (kept below as
+ * the reference), and PeerId::toBase58() with cached string vs encoding on
+ * every call.
+ *
+ * Argument: number of bytes; 34 and 38 are sizes of sha256 multihash and of
+ * identity multihash of ed25519 key, i.e. of typical peer ids.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace reference {
+
+  constexpr std::string_view kAlphabet =
+      "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+  std::string encode(const std::vector<uint8_t> &bytes) {
+    auto begin = bytes.begin();
+    size_t zeroes = 0;
+    while (begin != bytes.end() && *begin == 0) {
+      ++begin;
+      ++zeroes;
+    }
+    size_t size = (bytes.end() - begin) * 138 / 100 + 1;
+    std::vector<uint8_t> b58(size);
+    size_t length = 0;
+    for (; begin != bytes.end(); ++begin) {
+      int carry = *begin;
+      size_t i = 0;
+      for (auto it = b58.rbegin();
+           (carry != 0 || i < length) && it != b58.rend(); ++it, ++i) {
+        carry += 256 * (*it);
+        *it = carry % 58;
+        carry /= 58;
+      }
+      length = i;
+    }
+    auto it = b58.begin() + (size - length);
+    while (it != b58.end() && *it == 0) {
+      ++it;
+    }
+    std::string str(zeroes, '1');
+    for (; it != b58.end(); ++it) {
+      str += kAlphabet[*it];
+    }
+    return str;
+  }
+
+  std::vector<uint8_t> decode(std::string_view str) {
+    size_t zeroes = 0;
+    while (zeroes < str.size() && str[zeroes] == '1') {
+      ++zeroes;
+    }
+    str.remove_prefix(zeroes);
+    size_t size = str.size() * 733 / 1000 + 1;
+    std::vector<uint8_t> b256(size);
+    size_t length = 0;
+    for (auto c : str) {
+      int carry = static_cast<int>(kAlphabet.find(c));
+      size_t i = 0;
+      for (auto it = b256.rbegin();
+           (carry != 0 || i < length) && it != b256.rend(); ++it, ++i) {
+        carry += 58 * (*it);
+        *it = carry % 256;
+        carry /= 256;
+      }
+      length = i;
+    }
+    auto it = b256.begin() + (size - length);
+    while (it != b256.end() && *it == 0) {
+      ++it;
+    }
+    std::vector<uint8_t> bytes(zeroes, 0);
+    bytes.insert(bytes.end(), it, b256.end());
+    return bytes;
+  }
+
+}  // namespace reference
+
+namespace {
+
+  std::vector<uint8_t> randomBytes(size_t size) {
+    std::mt19937 gen{42};  // NOLINT
+    std::uniform_int_distribution<int> dist{0, 255};
+    std::vector<uint8_t> bytes(size);
+    for (auto &b : bytes) {
+      b = static_cast<uint8_t>(dist(gen));
+    }
+    return bytes;
+  }
+
+  void BM_ReferenceEncode(benchmark::State &state) {
+    auto bytes = randomBytes(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(reference::encode(bytes));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_Encode(benchmark::State &state) {
+    auto bytes = randomBytes(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(multi::detail::encodeBase58(bytes));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_ReferenceDecode(benchmark::State &state) {
+    auto str = multi::detail::encodeBase58(randomBytes(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(reference::decode(str));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_Decode(benchmark::State &state) {
+    auto str = multi::detail::encodeBase58(randomBytes(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(multi::detail::decodeBase58(str));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+  }
+
+  peer::PeerId makePeerId() {
+    auto hash = multi::Multihash::create(multi::sha256, randomBytes(32));
+    return peer::PeerId::fromHash(hash.value()).value();
+  }
+
+  void BM_PeerIdEncode(benchmark::State &state) {
+    auto peer_id = makePeerId();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          multi::detail::encodeBase58(peer_id.toVector()));
+    }
+  }
+
+  void BM_PeerIdToBase58(benchmark::State &state) {
+    auto peer_id = makePeerId();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(peer_id.toBase58());
+    }
+  }
+
+  void sizes(benchmark::internal::Benchmark *b) {
+    b->ArgName("bytes")->Arg(34)->Arg(38)->Arg(256)->Arg(1024);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_ReferenceEncode)->Apply(sizes);
+BENCHMARK(BM_Encode)->Apply(sizes);
+BENCHMARK(BM_ReferenceDecode)->Apply(sizes);
+BENCHMARK(BM_Decode)->Apply(sizes);
+BENCHMARK(BM_PeerIdEncode);
+BENCHMARK(BM_PeerIdToBase58);
@@ -0,0 +1,161 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <random>
+#include <unordered_set>
+
+#include <benchmark/benchmark.h>
+#include <libp2p/multi/multiaddress.hpp>
+#include <libp2p/multi/uvarint.hpp>
+#include <libp2p/protocol/kademlia/message.hpp>
+
+/**
+ * @file multiaddress_benchmark.cpp
+ * Parsing of a FIND_NODE response with 20 closer peers, 3 addresses each,
+ * as it comes from the network. Multiaddresses are validated on the binary
+ * form, their strings are rendered only when requested, so the "Render"
+ * variants show what eager rendering used to cost on top of parsing.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using protocol::kademlia::Message;
+
+  constexpr size_t kPeers = 20;
+
+  std::vector<uint8_t> randomBytes(std::mt19937 &gen, size_t size) {
+    std::uniform_int_distribution<int> dist{0, 255};
+    std::vector<uint8_t> bytes(size);
+    for (auto &b : bytes) {
+      b = static_cast<uint8_t>(dist(gen));
+    }
+    return bytes;
+  }
+
+  /// Closer peers as typically returned by DHT nodes
+  Message::Peers makePeers() {
+    std::mt19937 gen{42};  // NOLINT
+    Message::Peers peers;
+    for (size_t i = 0; i < kPeers; ++i) {
+      auto hash = multi::Multihash::create(multi::sha256, randomBytes(gen, 32));
+      auto peer_id = peer::PeerId::fromHash(hash.value()).value();
+      auto n = std::to_string(i + 1);
+      peers.push_back(Message::Peer{
+          peer::PeerInfo{
+              peer_id,
+              {
+                  multi::Multiaddress::create("/ip4/10.0.0." + n
+                                              + "/tcp/30333")
+                      .value(),
+                  multi::Multiaddress::create("/ip6/2001:db8::" + n
+                                              + "/tcp/30333")
+                      .value(),
+                  multi::Multiaddress::create("/dns4/node-" + n
+                                              + ".example.org/tcp/30333/p2p/"
+                                              + peer_id.toBase58())
+                      .value(),
+              }},
+          Message::Connectedness::CAN_CONNECT});
+    }
+    return peers;
+  }
+
+  /// Binary addresses of all peers, as they are in protobuf message
+  std::vector<std::vector<uint8_t>> makeAddressBytes() {
+    std::vector<std::vector<uint8_t>> addresses;
+    for (auto &peer : makePeers()) {
+      for (auto &address : peer.info.addresses) {
+        addresses.push_back(address.getBytesAddress());
+      }
+    }
+    return addresses;
+  }
+
+  /// Serialized FIND_NODE response without varint length prefix
+  std::vector<uint8_t> makeResponse() {
+    Message msg;
+    msg.type = Message::Type::kFindNode;
+    msg.closer_peers = makePeers();
+    std::vector<uint8_t> buffer;
+    msg.serialize(buffer);
+    auto prefix = multi::UVarint::calculateSize(buffer);
+    buffer.erase(buffer.begin(), buffer.begin() + prefix);
+    return buffer;
+  }
+
+  void BM_CreateFromBytes(benchmark::State &state) {
+    auto addresses = makeAddressBytes();
+    for (auto _ : state) {
+      for (auto &bytes : addresses) {
+        benchmark::DoNotOptimize(multi::Multiaddress::create(bytes));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * addresses.size());
+  }
+
+  void BM_CreateFromBytesRender(benchmark::State &state) {
+    auto addresses = makeAddressBytes();
+    for (auto _ : state) {
+      for (auto &bytes : addresses) {
+        auto address = multi::Multiaddress::create(bytes).value();
+        benchmark::DoNotOptimize(address.getStringAddress());
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * addresses.size());
+  }
+
+  void BM_FindNodeResponse(benchmark::State &state) {
+    auto response = makeResponse();
+    Message msg;
+    for (auto _ : state) {
+      if (!msg.deserialize(response.data(), response.size())) {
+        state.SkipWithError(msg.errorMessage().c_str());
+        break;
+      }
+      benchmark::DoNotOptimize(msg.closer_peers);
+    }
+    state.SetBytesProcessed(state.iterations() * response.size());
+  }
+
+  void BM_FindNodeResponseRender(benchmark::State &state) {
+    auto response = makeResponse();
+    Message msg;
+    for (auto _ : state) {
+      if (!msg.deserialize(response.data(), response.size())) {
+        state.SkipWithError(msg.errorMessage().c_str());
+        break;
+      }
+      for (auto &peer : msg.closer_peers.value()) {
+        for (auto &address : peer.info.addresses) {
+          benchmark::DoNotOptimize(address.getStringAddress());
+        }
+      }
+    }
+    state.SetBytesProcessed(state.iterations() * response.size());
+  }
+
+  void BM_HashSetInsert(benchmark::State &state) {
+    std::vector<multi::Multiaddress> addresses;
+    for (auto &bytes : makeAddressBytes()) {
+      addresses.push_back(multi::Multiaddress::create(bytes).value());
+    }
+    for (auto _ : state) {
+      std::unordered_set<multi::Multiaddress> set;
+      for (auto &address : addresses) {
+        set.insert(address);
+      }
+      benchmark::DoNotOptimize(set);
+    }
+    state.SetItemsProcessed(state.iterations() * addresses.size());
+  }
+
+}  // namespace
+
+BENCHMARK(BM_CreateFromBytes);
+BENCHMARK(BM_CreateFromBytesRender);
+BENCHMARK(BM_FindNodeResponse);
+BENCHMARK(BM_FindNodeResponseRender);
+BENCHMARK(BM_HashSetInsert);
@@ -0,0 +1,209 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <libp2p/basic/scheduler/asio_scheduler_backend.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/muxer/yamux/yamuxed_connection.hpp>
+
+#include "benchutil/delayed_link.hpp"
+#include "benchutil/latency_recorder.hpp"
+
+/**
+ * @file yamux_scheduling_benchmark.cpp
+ * Round trip latency of small RPCs over a yamux connection, which also
+ * carries bulk transfers in other streams. The link has limited bandwidth,
+ * so that outbound frames queue up on the sending side.
+ *
+ * Arguments: number of bulk streams and priority of RPC stream.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using connection::YamuxedConnection;
+  using StreamSPtr = std::shared_ptr<connection::Stream>;
+  using Clock = std::chrono::steady_clock;
+
+  constexpr size_t kChunkSize = 64 * 1024;
+  constexpr size_t kRpcSize = 64;
+  constexpr benchutil::LinkConfig kLink{std::chrono::milliseconds(1),
+                                        100 * 1024 * 1024 / 8};
+  constexpr auto kTimeout = std::chrono::seconds(10);
+
+  /// Writes stream until error or stopped
+  class BulkWriter : public std::enable_shared_from_this<BulkWriter> {
+   public:
+    explicit BulkWriter(StreamSPtr stream)
+        : stream_(std::move(stream)), chunk_(kChunkSize, 0x42) {}  // NOLINT
+
+    void write() {
+      stream_->write(chunk_, chunk_.size(),
+                     [self{shared_from_this()}](outcome::result<size_t> r) {
+                       if (r && !self->stopped_) {
+                         self->write();
+                       }
+                     });
+    }
+
+    void stop() {
+      stopped_ = true;
+      stream_->reset();
+    }
+
+   private:
+    StreamSPtr stream_;
+    std::vector<uint8_t> chunk_;
+    bool stopped_ = false;
+  };
+
+  /// Server side: reads bulk streams to nowhere, echoes RPC stream
+  class Responder : public std::enable_shared_from_this<Responder> {
+   public:
+    Responder(StreamSPtr stream, bool echo)
+        : stream_(std::move(stream)), echo_(echo), buf_(kChunkSize) {}
+
+    void read() {
+      auto bytes = echo_ ? kRpcSize : buf_.size();
+      auto cb = [self{shared_from_this()}](outcome::result<size_t> r) {
+        if (!r) {
+          return;
+        }
+        if (!self->echo_) {
+          return self->read();
+        }
+        self->stream_->write(self->buf_, kRpcSize,
+                             [self](outcome::result<size_t> written) {
+                               if (written) {
+                                 self->read();
+                               }
+                             });
+      };
+      if (echo_) {
+        stream_->read(buf_, bytes, std::move(cb));
+      } else {
+        stream_->readSome(buf_, bytes, std::move(cb));
+      }
+    }
+
+   private:
+    StreamSPtr stream_;
+    bool echo_;
+    std::vector<uint8_t> buf_;
+  };
+
+  /// Yamuxed connections over a bandwidth limited link with bulk streams
+  /// and an RPC stream opened from client
+  class SharedConnection {
+   public:
+    SharedConnection(size_t bulk_streams, connection::Stream::Priority priority)
+        : io_(std::make_shared<boost::asio::io_context>()),
+          scheduler_(std::make_shared<basic::SchedulerImpl>(
+              std::make_shared<basic::AsioSchedulerBackend>(io_),
+              basic::Scheduler::Config{})),
+          response_(kRpcSize) {
+      auto [a, b] = benchutil::makeDelayedLink(*io_, kLink);
+      auto closed = [](const peer::PeerId &,
+                       const std::shared_ptr<connection::CapableConnection> &) {
+      };
+      client_ = std::make_shared<YamuxedConnection>(a, scheduler_, closed);
+      server_ = std::make_shared<YamuxedConnection>(b, scheduler_, closed);
+
+      // streams come in order of opening, the last one is RPC
+      server_->onStream([this, bulk_streams](StreamSPtr stream) {
+        auto echo = (inbound_streams_++ == bulk_streams);
+        std::make_shared<Responder>(std::move(stream), echo)->read();
+      });
+      client_->start();
+      server_->start();
+
+      for (size_t i = 0; i < bulk_streams; ++i) {
+        auto writer =
+            std::make_shared<BulkWriter>(client_->newStream().value());
+        writer->write();
+        writers_.push_back(std::move(writer));
+      }
+      rpc_ = client_->newStream().value();
+      rpc_->setPriority(priority);
+
+      // let bulk transfers fill the link
+      io_->run_for(std::chrono::milliseconds(200));
+    }
+
+    ~SharedConnection() {
+      for (auto &writer : writers_) {
+        writer->stop();
+      }
+      std::ignore = client_->close();
+      std::ignore = server_->close();
+      io_->restart();
+      io_->poll();
+    }
+
+    /// Sends request and waits for response, returns false on error or
+    /// timeout
+    bool call() {
+      std::vector<uint8_t> request(kRpcSize, 0x01);  // NOLINT
+      bool done = false;
+      bool failed = false;
+      rpc_->write(request, request.size(), [&](outcome::result<size_t> r) {
+        if (!r) {
+          failed = true;
+          return;
+        }
+        rpc_->read(response_, kRpcSize, [&](outcome::result<size_t> res) {
+          failed = !res;
+          done = true;
+        });
+      });
+
+      auto deadline = Clock::now() + kTimeout;
+      io_->restart();
+      while (!done && !failed && Clock::now() < deadline) {
+        io_->run_one_for(kTimeout);
+      }
+      return done && !failed;
+    }
+
+   private:
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::shared_ptr<basic::Scheduler> scheduler_;
+    std::shared_ptr<YamuxedConnection> client_;
+    std::shared_ptr<YamuxedConnection> server_;
+    std::vector<std::shared_ptr<BulkWriter>> writers_;
+    StreamSPtr rpc_;
+    std::vector<uint8_t> response_;
+    size_t inbound_streams_ = 0;
+  };
+
+  void BM_YamuxRpcUnderBulk(benchmark::State &state) {
+    SharedConnection conn(
+        state.range(0),
+        static_cast<connection::Stream::Priority>(state.range(1)));
+    benchutil::LatencyRecorder latency;
+    for (auto _ : state) {
+      latency.start();
+      if (!conn.call()) {
+        state.SkipWithError("RPC failed");
+        break;
+      }
+      latency.stop();
+    }
+    latency.report(state);
+  }
+
+  void bulkAndPriorities(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"bulk_streams", "rpc_priority"});
+    for (auto bulk : {0, 1, 4}) {
+      for (int priority : {int{connection::Stream::kDefaultPriority}, 255}) {
+        b->Args({bulk, priority});
+      }
+    }
+    b->Iterations(100)->UseRealTime()->Unit(benchmark::kMicrosecond);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_YamuxRpcUnderBulk)->Apply(bulkAndPriorities);
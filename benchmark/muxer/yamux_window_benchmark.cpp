@@ -0,0 +1,160 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <libp2p/basic/scheduler/asio_scheduler_backend.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/muxer/yamux/yamuxed_connection.hpp>
+
+#include "benchutil/delayed_link.hpp"
+
+/**
+ * @file yamux_window_benchmark.cpp
+ * Bulk transfer over a single yamux stream on a link with delay and
+ * unlimited bandwidth, so that throughput is limited by receive window per
+ * round trip only. The link is in-process: memory connections with a delay
+ * line on the sending side.
+ *
+ * Arguments: one way delay in milliseconds and maximum window size, the
+ * initial window size means a fixed window as it was before auto tuning.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using connection::YamuxedConnection;
+  using StreamSPtr = std::shared_ptr<connection::Stream>;
+  using Clock = std::chrono::steady_clock;
+
+  constexpr size_t kChunkSize = 64 * 1024;
+  constexpr size_t kTransferSize = 16 * 1024 * 1024;
+  constexpr auto kTimeout = std::chrono::seconds(60);
+
+  /// Reads stream until error and counts bytes received
+  class Sink : public std::enable_shared_from_this<Sink> {
+   public:
+    Sink(StreamSPtr stream, size_t &received)
+        : stream_(std::move(stream)), received_(received), buf_(kChunkSize) {}
+
+    void read() {
+      stream_->readSome(buf_, buf_.size(),
+                        [self{shared_from_this()}](outcome::result<size_t> r) {
+                          if (r) {
+                            self->received_ += r.value();
+                            self->read();
+                          }
+                        });
+    }
+
+   private:
+    StreamSPtr stream_;
+    size_t &received_;
+    std::vector<uint8_t> buf_;
+  };
+
+  /// Two yamuxed connections over a delayed link
+  class DelayedYamux {
+   public:
+    DelayedYamux(std::chrono::milliseconds delay,
+                 muxer::MuxedConnectionConfig config)
+        : io_(std::make_shared<boost::asio::io_context>()),
+          scheduler_(std::make_shared<basic::SchedulerImpl>(
+              std::make_shared<basic::AsioSchedulerBackend>(io_),
+              basic::Scheduler::Config{})) {
+      auto [a, b] = benchutil::makeDelayedLink(*io_, {delay});
+      auto closed = [](const peer::PeerId &,
+                       const std::shared_ptr<connection::CapableConnection> &) {
+      };
+      client_ = std::make_shared<YamuxedConnection>(a, scheduler_, closed,
+                                                    config);
+      server_ = std::make_shared<YamuxedConnection>(b, scheduler_, closed,
+                                                    config);
+      server_->onStream([this](StreamSPtr stream) {
+        std::make_shared<Sink>(std::move(stream), received_)->read();
+      });
+      client_->start();
+      server_->start();
+
+      // let the first ping measure RTT
+      io_->run_for(delay * 4);
+    }
+
+    ~DelayedYamux() {
+      std::ignore = client_->close();
+      std::ignore = server_->close();
+      io_->restart();
+      io_->poll();
+    }
+
+    /// Sends bytes over a new stream, returns false on error or timeout
+    bool transfer(size_t bytes) {
+      received_ = 0;
+      auto stream = client_->newStream();
+      if (!stream) {
+        return false;
+      }
+      std::vector<uint8_t> chunk(kChunkSize, 0x42);  // NOLINT
+      size_t sent = 0;
+      bool failed = false;
+      std::function<void()> write_next = [&] {
+        stream.value()->write(chunk, chunk.size(),
+                              [&](outcome::result<size_t> r) {
+                                if (!r) {
+                                  failed = true;
+                                  return;
+                                }
+                                sent += r.value();
+                                if (sent < bytes) {
+                                  write_next();
+                                }
+                              });
+      };
+      write_next();
+
+      auto deadline = Clock::now() + kTimeout;
+      io_->restart();
+      while (received_ < bytes && !failed && Clock::now() < deadline) {
+        io_->run_one_for(kTimeout);
+      }
+      stream.value()->reset();
+      return received_ >= bytes;
+    }
+
+   private:
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::shared_ptr<basic::Scheduler> scheduler_;
+    std::shared_ptr<YamuxedConnection> client_;
+    std::shared_ptr<YamuxedConnection> server_;
+    size_t received_ = 0;
+  };
+
+  void BM_YamuxDelayedBulk(benchmark::State &state) {
+    muxer::MuxedConnectionConfig config;
+    config.maximum_window_size = state.range(1);
+    DelayedYamux yamux(std::chrono::milliseconds(state.range(0)), config);
+    for (auto _ : state) {
+      if (!yamux.transfer(kTransferSize)) {
+        state.SkipWithError("transfer failed");
+        break;
+      }
+    }
+    state.SetBytesProcessed(state.iterations() * kTransferSize);
+  }
+
+  void delaysAndWindows(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"delay_ms", "max_window"});
+    for (auto delay : {5, 25}) {
+      for (size_t window :
+           {size_t{connection::YamuxFrame::kInitialWindowSize},
+            muxer::MuxedConnectionConfig::kDefaultMaxWindowSize}) {
+        b->Args({delay, static_cast<int64_t>(window)});
+      }
+    }
+    b->Iterations(3)->UseRealTime()->Unit(benchmark::kMillisecond);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_YamuxDelayedBulk)->Apply(delaysAndWindows);
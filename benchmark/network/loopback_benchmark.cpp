@@ -0,0 +1,403 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <boost/optional.hpp>
+
+#include "benchutil/latency_recorder.hpp"
+#include "benchutil/loopback_hosts.hpp"
+
+/**
+ * @file loopback_benchmark.cpp
+ * End-to-end benchmarks of real hosts connected over TCP loopback for every
+ * security x muxer combination:
+ *  - bulk throughput of a single stream (bytes/s),
+ *  - small messages request-response rate and latency percentiles,
+ *  - streams open/close rate over established connection,
+ *  - connection handshakes rate (TCP + security + muxer upgrade),
+ *  - TLS reconnect rate with and without session resumption.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using StreamSPtr = std::shared_ptr<connection::Stream>;
+
+  const peer::Protocol kSinkProtocol = "/benchmark/sink/1.0.0";
+  const peer::Protocol kEchoProtocol = "/benchmark/echo/1.0.0";
+
+  constexpr size_t kReadBufferSize = 64 * 1024;
+  constexpr size_t kBulkChunkSize = 64 * 1024;
+
+  /// Server side session: reads stream until it is closed or reset
+  /// and either discards the data (sink) or sends it back (echo)
+  class ServerSession : public std::enable_shared_from_this<ServerSession> {
+   public:
+    ServerSession(StreamSPtr stream, bool echo,
+                  std::shared_ptr<size_t> bytes_received)
+        : stream_(std::move(stream)),
+          echo_(echo),
+          bytes_received_(std::move(bytes_received)),
+          buf_(kReadBufferSize) {}
+
+    void read() {
+      stream_->readSome(buf_, buf_.size(),
+                        [self{shared_from_this()}](outcome::result<size_t> r) {
+                          self->onRead(r);
+                        });
+    }
+
+   private:
+    void onRead(outcome::result<size_t> r) {
+      if (!r || r.value() == 0) {
+        stream_->reset();
+        return;
+      }
+      *bytes_received_ += r.value();
+      if (!echo_) {
+        return read();
+      }
+      stream_->write(buf_, r.value(),
+                     [self{shared_from_this()}](outcome::result<size_t> w) {
+                       if (!w) {
+                         return self->stream_->reset();
+                       }
+                       self->read();
+                     });
+    }
+
+    StreamSPtr stream_;
+    bool echo_;
+    std::shared_ptr<size_t> bytes_received_;
+    std::vector<uint8_t> buf_;
+  };
+
+  /// Sets sink and echo protocol handlers on server host
+  template <typename Hosts>
+  std::shared_ptr<size_t> setServerHandlers(Hosts &hosts) {
+    auto bytes_received = std::make_shared<size_t>(0);
+    for (bool echo : {false, true}) {
+      hosts.server().setProtocolHandler(
+          echo ? kEchoProtocol : kSinkProtocol,
+          [echo, bytes_received](StreamSPtr stream) {
+            std::make_shared<ServerSession>(std::move(stream), echo,
+                                            bytes_received)
+                ->read();
+          });
+    }
+    return bytes_received;
+  }
+
+  /// Opens client stream to server, returns nullptr on failure
+  template <typename Hosts>
+  StreamSPtr openStream(Hosts &hosts, const peer::Protocol &protocol) {
+    auto result = std::make_shared<boost::optional<Host::StreamResult>>();
+    hosts.client().newStream(
+        hosts.serverInfo(), protocol,
+        [result](Host::StreamResult r) { *result = std::move(r); });
+    if (!hosts.runUntil([&] { return result->has_value(); })
+        || !result->value()) {
+      return nullptr;
+    }
+    return result->value().value();
+  }
+
+  /// Writes the whole buffer and waits until the write completes
+  template <typename Hosts>
+  bool writeAll(Hosts &hosts, connection::Stream &stream,
+                gsl::span<const uint8_t> data) {
+    auto result = std::make_shared<boost::optional<bool>>();
+    stream.write(data, data.size(), [result](outcome::result<size_t> r) {
+      *result = r.has_value();
+    });
+    return hosts.runUntil([&] { return result->has_value(); })
+        && result->value();
+  }
+
+  /// Reads exactly out.size() bytes
+  template <typename Hosts>
+  bool readAll(Hosts &hosts, connection::Stream &stream,
+               gsl::span<uint8_t> out) {
+    auto result = std::make_shared<boost::optional<bool>>();
+    stream.read(out, out.size(), [result](outcome::result<size_t> r) {
+      *result = r.has_value();
+    });
+    return hosts.runUntil([&] { return result->has_value(); })
+        && result->value();
+  }
+
+  /**
+   * Drops client's connections to server and waits until both sides have
+   * forgotten them, so that the next connect() makes a new handshake
+   */
+  template <typename Hosts>
+  bool disconnect(Hosts &hosts) {
+    const auto server_id = hosts.server().getId();
+    const auto client_id = hosts.client().getId();
+    hosts.client().disconnect(server_id);
+    return hosts.runUntil([&] {
+      return hosts.client()
+                 .getNetwork()
+                 .getConnectionManager()
+                 .getConnectionsToPeer(server_id)
+                 .empty()
+          && hosts.server()
+                 .getNetwork()
+                 .getConnectionManager()
+                 .getConnectionsToPeer(client_id)
+                 .empty();
+    });
+  }
+
+  /// Creates hosts and starts the server, reports an error to state on failure
+  template <typename Hosts>
+  std::shared_ptr<size_t> prepare(Hosts &hosts, benchmark::State &state) {
+    auto bytes_received = setServerHandlers(hosts);
+    if (!hosts.start()) {
+      state.SkipWithError("cannot listen on loopback");
+      return nullptr;
+    }
+    return bytes_received;
+  }
+
+  /**
+   * Single stream bulk transfer: every iteration writes state.range(0) bytes
+   * in 64 KiB chunks without waiting and completes when all of them are
+   * delivered to the server
+   */
+  template <typename Security, typename Muxer>
+  void BM_BulkThroughput(benchmark::State &state) {
+    const auto bytes_per_iteration = static_cast<size_t>(state.range(0));
+
+    benchutil::LoopbackHosts<Security, Muxer> hosts;
+    auto bytes_received = prepare(hosts, state);
+    if (!bytes_received) {
+      return;
+    }
+    auto stream = openStream(hosts, kSinkProtocol);
+    if (!stream) {
+      state.SkipWithError("cannot open stream");
+      return;
+    }
+
+    const std::vector<uint8_t> chunk(kBulkChunkSize, 0x42);
+    size_t bytes_sent = 0;
+    auto failed = std::make_shared<bool>(false);
+
+    for (auto _ : state) {
+      for (size_t n = 0; n < bytes_per_iteration; n += chunk.size()) {
+        auto size = std::min(chunk.size(), bytes_per_iteration - n);
+        stream->write(chunk, size, [failed](outcome::result<size_t> r) {
+          *failed = *failed || !r;
+        });
+        bytes_sent += size;
+      }
+      if (!hosts.runUntil(
+              [&] { return *failed || *bytes_received >= bytes_sent; })
+          || *failed) {
+        state.SkipWithError("bulk write failed");
+        break;
+      }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(*bytes_received));
+    stream->reset();
+  }
+
+  /**
+   * Request-response over a single stream: every iteration sends
+   * state.range(0) bytes and waits for them to be echoed back
+   */
+  template <typename Security, typename Muxer>
+  void BM_SmallMessageRoundtrip(benchmark::State &state) {
+    const auto msg_size = static_cast<size_t>(state.range(0));
+
+    benchutil::LoopbackHosts<Security, Muxer> hosts;
+    if (!prepare(hosts, state)) {
+      return;
+    }
+    auto stream = openStream(hosts, kEchoProtocol);
+    if (!stream) {
+      state.SkipWithError("cannot open stream");
+      return;
+    }
+
+    const std::vector<uint8_t> request(msg_size, 0x42);
+    std::vector<uint8_t> response(msg_size);
+    benchutil::LatencyRecorder latency(state.max_iterations);
+
+    for (auto _ : state) {
+      latency.start();
+      if (!writeAll(hosts, *stream, request)
+          || !readAll(hosts, *stream, response)) {
+        state.SkipWithError("roundtrip failed");
+        break;
+      }
+      latency.stop();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+    stream->reset();
+  }
+
+  /**
+   * Every iteration opens a new stream over the existing connection
+   * (including protocol negotiation), makes one roundtrip and closes it
+   */
+  template <typename Security, typename Muxer>
+  void BM_StreamOpenClose(benchmark::State &state) {
+    benchutil::LoopbackHosts<Security, Muxer> hosts;
+    if (!prepare(hosts, state)) {
+      return;
+    }
+    // establish the connection before measurements
+    if (auto stream = openStream(hosts, kEchoProtocol); stream) {
+      stream->reset();
+    } else {
+      state.SkipWithError("cannot connect");
+      return;
+    }
+
+    std::vector<uint8_t> buf(1, 0x42);
+    benchutil::LatencyRecorder latency(state.max_iterations);
+
+    for (auto _ : state) {
+      latency.start();
+      auto stream = openStream(hosts, kEchoProtocol);
+      if (!stream || !writeAll(hosts, *stream, buf)
+          || !readAll(hosts, *stream, buf)) {
+        state.SkipWithError("stream roundtrip failed");
+        break;
+      }
+      latency.stop();
+      stream->close([stream](outcome::result<void>) {});
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+  }
+
+  /**
+   * Every iteration establishes a new connection (TCP connect, security
+   * handshake and muxer negotiation) and then drops it
+   */
+  template <typename Security, typename Muxer>
+  void BM_Handshake(benchmark::State &state) {
+    benchutil::LoopbackHosts<Security, Muxer> hosts;
+    if (!prepare(hosts, state)) {
+      return;
+    }
+    const auto server_info = hosts.serverInfo();
+    benchutil::LatencyRecorder latency(state.max_iterations);
+
+    for (auto _ : state) {
+      auto result = std::make_shared<boost::optional<bool>>();
+      latency.start();
+      hosts.client().connect(server_info, [result](Host::ConnectionResult r) {
+        *result = r.has_value();
+      });
+      if (!hosts.runUntil([&] { return result->has_value(); })
+          || !result->value()) {
+        state.SkipWithError("cannot connect");
+        break;
+      }
+      latency.stop();
+
+      state.PauseTiming();
+      auto disconnected = disconnect(hosts);
+      state.ResumeTiming();
+      if (!disconnected) {
+        state.SkipWithError("cannot disconnect");
+        break;
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+  }
+
+  /**
+   * Reconnects to the same peer over TLS, with session resumption disabled
+   * (state.range(0) == 0) or enabled
+   */
+  template <typename Muxer>
+  void BM_TlsReconnect(benchmark::State &state) {
+    security::TlsConfig config;
+    config.session_resumption = state.range(0) != 0;
+
+    benchutil::LoopbackHosts<security::TlsAdaptor, Muxer> hosts(
+        boost::di::bind<security::TlsConfig>.to(config)[boost::di::override]);
+    if (!prepare(hosts, state)) {
+      return;
+    }
+    const auto server_info = hosts.serverInfo();
+    benchutil::LatencyRecorder latency(state.max_iterations);
+
+    auto connect = [&] {
+      auto result = std::make_shared<boost::optional<bool>>();
+      hosts.client().connect(server_info, [result](Host::ConnectionResult r) {
+        *result = r.has_value();
+      });
+      return hosts.runUntil([&] { return result->has_value(); })
+          && result->value();
+    };
+
+    // the first connection always makes full handshake
+    if (!connect()) {
+      state.SkipWithError("cannot connect");
+      return;
+    }
+
+    // session ticket precedes server's data, so it is received during
+    // protocol negotiation on connect
+    for (auto _ : state) {
+      state.PauseTiming();
+      auto disconnected = disconnect(hosts);
+      state.ResumeTiming();
+      if (!disconnected) {
+        state.SkipWithError("cannot disconnect");
+        break;
+      }
+      latency.start();
+      if (!connect()) {
+        state.SkipWithError("cannot reconnect");
+        break;
+      }
+      latency.stop();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    latency.report(state);
+  }
+
+}  // namespace
+
+// clang-format off
+#define LOOPBACK_BENCHMARKS(Security, Muxer)                               \
+  BENCHMARK_TEMPLATE(BM_BulkThroughput, Security, Muxer)                   \
+      ->Arg(1 << 20)->Arg(16 << 20)                                        \
+      ->Unit(benchmark::kMillisecond)->UseRealTime();                      \
+  BENCHMARK_TEMPLATE(BM_SmallMessageRoundtrip, Security, Muxer)            \
+      ->Arg(64)->Arg(1024)->Arg(16 * 1024)                                 \
+      ->Unit(benchmark::kMicrosecond)->UseRealTime();                      \
+  BENCHMARK_TEMPLATE(BM_StreamOpenClose, Security, Muxer)                  \
+      ->Unit(benchmark::kMicrosecond)->UseRealTime();                      \
+  BENCHMARK_TEMPLATE(BM_Handshake, Security, Muxer)                        \
+      ->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+LOOPBACK_BENCHMARKS(security::Plaintext, muxer::Yamux)
+LOOPBACK_BENCHMARKS(security::Plaintext, muxer::Mplex)
+LOOPBACK_BENCHMARKS(security::Secio, muxer::Yamux)
+LOOPBACK_BENCHMARKS(security::Secio, muxer::Mplex)
+LOOPBACK_BENCHMARKS(security::Noise, muxer::Yamux)
+LOOPBACK_BENCHMARKS(security::Noise, muxer::Mplex)
+LOOPBACK_BENCHMARKS(security::TlsAdaptor, muxer::Yamux)
+LOOPBACK_BENCHMARKS(security::TlsAdaptor, muxer::Mplex)
+
+BENCHMARK_TEMPLATE(BM_TlsReconnect, muxer::Yamux)
+    ->ArgName("resumption")->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMicrosecond)->UseRealTime();
+// clang-format on
@@ -0,0 +1,332 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <libp2p/basic/scheduler/asio_scheduler_backend.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/peer/address_repository/inmem_address_repository.hpp>
+#include <libp2p/peer/address_repository/persistent_address_repository.hpp>
+#include <libp2p/peer/key_repository/inmem_key_repository.hpp>
+#include <libp2p/peer/key_repository/persistent_key_repository.hpp>
+#include <libp2p/peer/protocol_repository/inmem_protocol_repository.hpp>
+#include <libp2p/peer/protocol_repository/persistent_protocol_repository.hpp>
+
+#include "benchutil/latency_recorder.hpp"
+#include "benchutil/loopback_hosts.hpp"
+
+/**
+ * @file peerstore_restart_benchmark.cpp
+ * Time for a restarted host to get connected to N peers of the network.
+ * Without persistent peerstore the host knows bootstrap node only, and
+ * learns other peers from it. With persistent peerstore peers are read
+ * from db written by the previous run.
+ *
+ * Arguments: number of peers and persistence (0 or 1).
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using StreamSPtr = std::shared_ptr<connection::Stream>;
+  using Clock = std::chrono::steady_clock;
+
+  const peer::Protocol kDirectoryProtocol = "/benchmark/directory/1.0.0";
+  const std::string kDbFile = "peerstore_benchmark.sqlite";
+  constexpr auto kTimeout = std::chrono::seconds(30);
+
+  void removeDbFiles() {
+    for (const auto *suffix : {"", "-wal", "-shm"}) {
+      boost::filesystem::remove(kDbFile + suffix);
+    }
+  }
+
+  /// Cache repositories don't resolve bootstrap addresses in benchmark
+  class NoDnsaddrResolver : public network::DnsaddrResolver {
+   public:
+    void load(multi::Multiaddress, AddressesCallback callback) override {
+      callback(std::make_error_code(std::errc::not_supported));
+    }
+  };
+
+  /// Reads directory listing until the stream is closed
+  class DirectoryReader : public std::enable_shared_from_this<DirectoryReader> {
+   public:
+    using Callback = std::function<void(std::string)>;
+
+    DirectoryReader(StreamSPtr stream, Callback cb)
+        : stream_(std::move(stream)), cb_(std::move(cb)), buf_(4096) {}
+
+    void read() {
+      stream_->readSome(buf_, buf_.size(),
+                        [self{shared_from_this()}](outcome::result<size_t> r) {
+                          if (!r || r.value() == 0) {
+                            return self->cb_(std::move(self->text_));
+                          }
+                          self->text_.append(self->buf_.begin(),
+                                             self->buf_.begin() + r.value());
+                          self->read();
+                        });
+    }
+
+   private:
+    StreamSPtr stream_;
+    Callback cb_;
+    std::vector<uint8_t> buf_;
+    std::string text_;
+  };
+
+  /// Host restarted by benchmark
+  class Client {
+   public:
+    Client(std::shared_ptr<boost::asio::io_context> io, bool persistent) {
+      std::shared_ptr<peer::AddressRepository> addresses =
+          std::make_shared<peer::InmemAddressRepository>(
+              std::make_shared<NoDnsaddrResolver>());
+      std::shared_ptr<peer::KeyRepository> keys =
+          std::make_shared<peer::InmemKeyRepository>();
+      std::shared_ptr<peer::ProtocolRepository> protocols =
+          std::make_shared<peer::InmemProtocolRepository>();
+      if (persistent) {
+        scheduler_ = std::make_shared<basic::SchedulerImpl>(
+            std::make_shared<basic::AsioSchedulerBackend>(io),
+            basic::Scheduler::Config{});
+        peerstore_ = std::make_shared<peer::PeerstoreDb>(
+            std::make_shared<storage::SQLite>(kDbFile), scheduler_,
+            peer::PeerstoreDb::Config{});
+        addresses = std::make_shared<peer::PersistentAddressRepository>(
+            std::move(addresses), peerstore_);
+        keys = std::make_shared<peer::PersistentKeyRepository>(std::move(keys),
+                                                               peerstore_);
+        protocols = std::make_shared<peer::PersistentProtocolRepository>(
+            std::move(protocols), peerstore_);
+      }
+
+      auto injector =
+          benchutil::makeInjector<security::Plaintext, muxer::Yamux>(
+              std::move(io),
+              boost::di::bind<peer::AddressRepository>.to(
+                  addresses)[boost::di::override],
+              boost::di::bind<peer::KeyRepository>.to(
+                  keys)[boost::di::override],
+              boost::di::bind<peer::ProtocolRepository>.to(
+                  protocols)[boost::di::override]);
+      host_ = injector.create<std::shared_ptr<Host>>();
+      host_->start();
+    }
+
+    ~Client() {
+      host_->stop();
+      if (peerstore_) {
+        peerstore_->flush();
+      }
+    }
+
+    Host &host() {
+      return *host_;
+    }
+
+   private:
+    std::shared_ptr<basic::Scheduler> scheduler_;
+    std::shared_ptr<peer::PeerstoreDb> peerstore_;
+    std::shared_ptr<Host> host_;
+  };
+
+  /// Listening hosts, the first one is bootstrap node, which lists all of
+  /// them
+  class Network {
+   public:
+    explicit Network(size_t peers)
+        : io_(std::make_shared<boost::asio::io_context>()) {
+      for (size_t i = 0; i < peers; ++i) {
+        auto injector =
+            benchutil::makeInjector<security::Plaintext, muxer::Yamux>(io_);
+        hosts_.push_back(injector.create<std::shared_ptr<Host>>());
+      }
+    }
+
+    ~Network() {
+      for (auto &host : hosts_) {
+        host->stop();
+      }
+      io_->restart();
+      io_->poll();
+    }
+
+    bool start() {
+      std::ostringstream listing;
+      for (auto &host : hosts_) {
+        if (!host->listen(benchutil::nextLoopbackAddress())) {
+          return false;
+        }
+        host->start();
+        auto info = host->getPeerInfo();
+        for (const auto &address : info.addresses) {
+          listing << info.id.toBase58() << ' ' << address.getStringAddress()
+                  << '\n';
+        }
+      }
+
+      auto text = std::make_shared<std::string>(listing.str());
+      hosts_.front()->setProtocolHandler(
+          kDirectoryProtocol, [text](StreamSPtr stream) {
+            gsl::span<const uint8_t> data(
+                reinterpret_cast<const uint8_t *>(text->data()),  // NOLINT
+                text->size());
+            stream->write(data, data.size(),
+                          [stream, text](outcome::result<size_t>) {
+                            stream->close([stream](outcome::result<void>) {});
+                          });
+          });
+      return true;
+    }
+
+    std::shared_ptr<boost::asio::io_context> io() const {
+      return io_;
+    }
+
+    /// Asks bootstrap node for peers, remembers and connects to them
+    bool discoverAndConnect(Client &client) {
+      auto listing = std::make_shared<boost::optional<std::string>>();
+      client.host().newStream(
+          hosts_.front()->getPeerInfo(), kDirectoryProtocol,
+          [listing](Host::StreamResult r) {
+            if (!r) {
+              *listing = std::string{};
+              return;
+            }
+            std::make_shared<DirectoryReader>(
+                r.value(),
+                [listing](std::string text) { *listing = std::move(text); })
+                ->read();
+          });
+      if (!runUntil([&] { return listing->has_value(); })) {
+        return false;
+      }
+
+      auto &addresses =
+          client.host().getPeerRepository().getAddressRepository();
+      std::vector<peer::PeerInfo> peers;
+      std::istringstream lines(listing->value());
+      std::string id;
+      std::string address;
+      while (lines >> id >> address) {
+        auto peer_id = peer::PeerId::fromBase58(id);
+        auto ma = multi::Multiaddress::create(address);
+        if (!peer_id || !ma) {
+          return false;
+        }
+        std::ignore = addresses.upsertAddresses(
+            peer_id.value(), std::vector{ma.value()}, peer::ttl::kAddress);
+        peers.push_back({peer_id.value(), {ma.value()}});
+      }
+      return connectAll(client, peers);
+    }
+
+    /// Connects to peers known by client's peerstore
+    bool connectKnown(Client &client) {
+      auto &addresses =
+          client.host().getPeerRepository().getAddressRepository();
+      std::vector<peer::PeerId> ids;
+      addresses.forEachPeer([&](const peer::PeerId &p) { ids.push_back(p); });
+
+      std::vector<peer::PeerInfo> peers;
+      for (auto &id : ids) {
+        auto known = addresses.getAddresses(id);
+        if (known && !known.value().empty()) {
+          peers.push_back({std::move(id), std::move(known.value())});
+        }
+      }
+      return connectAll(client, peers);
+    }
+
+   private:
+    bool connectAll(Client &client, const std::vector<peer::PeerInfo> &peers) {
+      if (peers.size() != hosts_.size()) {
+        return false;
+      }
+      auto connected = std::make_shared<size_t>(0);
+      auto failed = std::make_shared<size_t>(0);
+      for (const auto &peer : peers) {
+        client.host().connect(peer,
+                              [connected, failed](Host::ConnectionResult r) {
+                                ++*(r ? connected : failed);
+                              });
+      }
+      return runUntil([&] { return *connected + *failed == peers.size(); })
+          && *failed == 0;
+    }
+
+    template <typename Predicate>
+    bool runUntil(Predicate &&done) {
+      auto deadline = Clock::now() + kTimeout;
+      io_->restart();
+      while (!done()) {
+        if (Clock::now() > deadline) {
+          return false;
+        }
+        io_->run_one_for(kTimeout);
+      }
+      return true;
+    }
+
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::vector<std::shared_ptr<Host>> hosts_;
+  };
+
+  void BM_ConnectAfterRestart(benchmark::State &state) {
+    auto persistent = state.range(1) != 0;
+    Network network(state.range(0));
+    if (!network.start()) {
+      state.SkipWithError("cannot listen");
+      return;
+    }
+
+    // the first run discovers peers, the next ones read them from db
+    removeDbFiles();
+    if (persistent) {
+      Client client(network.io(), true);
+      if (!network.discoverAndConnect(client)) {
+        state.SkipWithError("cannot discover peers");
+        return;
+      }
+    }
+
+    benchutil::LatencyRecorder latency(state.max_iterations);
+    for (auto _ : state) {
+      auto started = Clock::now();
+      latency.start();
+      Client client(network.io(), persistent);
+      auto connected = persistent ? network.connectKnown(client)
+                                  : network.discoverAndConnect(client);
+      if (!connected) {
+        state.SkipWithError("cannot connect to peers");
+        break;
+      }
+      latency.stop();
+      state.SetIterationTime(
+          std::chrono::duration<double>(Clock::now() - started).count());
+    }
+
+    latency.report(state);
+    removeDbFiles();
+  }
+
+  void peersAndPersistence(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"peers", "persistent"});
+    for (auto peers : {8, 32, 128}) {
+      for (auto persistent : {0, 1}) {
+        b->Args({peers, persistent});
+      }
+    }
+    b->Iterations(10)->UseManualTime()->Unit(benchmark::kMillisecond);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_ConnectAfterRestart)->Apply(peersAndPersistence);
@@ -0,0 +1,276 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libp2p/multi/uvarint.hpp>
+#include <libp2p/protocol/kademlia/message.hpp>
+
+#include "src/protocol/gossip/impl/message_builder.hpp"
+#include "src/protocol/gossip/impl/message_parser.hpp"
+#include "src/protocol/gossip/impl/message_receiver.hpp"
+
+/**
+ * @file codec_benchmark.cpp
+ * Protobuf codecs of Kademlia and gossip on typical message shapes:
+ *  - Kademlia FIND_NODE request and response with 20 closer peers;
+ *  - gossip RPC with N published messages of 256 bytes, 20 IHAVE ids,
+ *    a GRAFT and a subscription, as a forwarding peer sends them.
+ *    Parsing is measured with the parser reused (one per stream) and with
+ *    a new parser per message.
+ *
+ * Argument of gossip benchmarks: number of published messages.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using protocol::kademlia::Message;
+  namespace gossip = protocol::gossip;
+
+  constexpr size_t kPeers = 20;
+  constexpr size_t kDataSize = 256;
+  constexpr size_t kIHaves = 20;
+
+  std::vector<uint8_t> randomBytes(std::mt19937 &gen, size_t size) {
+    std::uniform_int_distribution<int> dist{0, 255};
+    std::vector<uint8_t> bytes(size);
+    for (auto &b : bytes) {
+      b = static_cast<uint8_t>(dist(gen));
+    }
+    return bytes;
+  }
+
+  peer::PeerId randomPeerId(std::mt19937 &gen) {
+    auto hash = multi::Multihash::create(multi::sha256, randomBytes(gen, 32));
+    return peer::PeerId::fromHash(hash.value()).value();
+  }
+
+  Message::Peer makePeer(std::mt19937 &gen, size_t i) {
+    auto peer_id = randomPeerId(gen);
+    auto n = std::to_string(i + 1);
+    return Message::Peer{
+        peer::PeerInfo{
+            peer_id,
+            {
+                multi::Multiaddress::create("/ip4/10.0.0." + n + "/tcp/30333")
+                    .value(),
+                multi::Multiaddress::create("/ip6/2001:db8::" + n
+                                            + "/tcp/30333")
+                    .value(),
+                multi::Multiaddress::create("/dns4/node-" + n
+                                            + ".example.org/tcp/30333")
+                    .value(),
+            }},
+        Message::Connectedness::CAN_CONNECT};
+  }
+
+  Message makeFindNodeRequest() {
+    std::mt19937 gen{42};  // NOLINT
+    auto self = makePeer(gen, 0);
+    return protocol::kademlia::createFindNodeRequest(randomPeerId(gen),
+                                                     self.info);
+  }
+
+  Message makeFindNodeResponse() {
+    std::mt19937 gen{42};  // NOLINT
+    Message msg;
+    msg.type = Message::Type::kFindNode;
+    msg.key = randomPeerId(gen).toVector();
+    msg.closer_peers.emplace();
+    for (size_t i = 0; i < kPeers; ++i) {
+      msg.closer_peers->push_back(makePeer(gen, i));
+    }
+    return msg;
+  }
+
+  /// Serialized message without varint length prefix
+  std::vector<uint8_t> serialized(const Message &msg) {
+    std::vector<uint8_t> buffer;
+    msg.serialize(buffer);
+    auto prefix = multi::UVarint::calculateSize(buffer);
+    buffer.erase(buffer.begin(), buffer.begin() + prefix);
+    return buffer;
+  }
+
+  void kademliaSerialize(benchmark::State &state, const Message &msg) {
+    std::vector<uint8_t> buffer;
+    for (auto _ : state) {
+      msg.serialize(buffer);
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+  }
+
+  void kademliaDeserialize(benchmark::State &state, const Message &src) {
+    auto bytes = serialized(src);
+    Message msg;
+    for (auto _ : state) {
+      if (!msg.deserialize(bytes.data(), bytes.size())) {
+        state.SkipWithError(msg.errorMessage().c_str());
+        break;
+      }
+      benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+  }
+
+  void BM_KademliaRequestSerialize(benchmark::State &state) {
+    kademliaSerialize(state, makeFindNodeRequest());
+  }
+
+  void BM_KademliaRequestDeserialize(benchmark::State &state) {
+    kademliaDeserialize(state, makeFindNodeRequest());
+  }
+
+  void BM_KademliaResponseSerialize(benchmark::State &state) {
+    kademliaSerialize(state, makeFindNodeResponse());
+  }
+
+  void BM_KademliaResponseDeserialize(benchmark::State &state) {
+    kademliaDeserialize(state, makeFindNodeResponse());
+  }
+
+  /// Content of gossip RPC
+  struct GossipContent {
+    std::vector<gossip::TopicMessage> messages;
+    std::vector<gossip::MessageId> message_ids;
+    std::vector<gossip::MessageId> ihaves;
+    gossip::TopicId topic = "/benchmark/topic/1";
+  };
+
+  GossipContent makeGossipContent(size_t messages) {
+    std::mt19937 gen{42};  // NOLINT
+    GossipContent content;
+    auto from = randomPeerId(gen);
+    for (size_t i = 0; i < messages; ++i) {
+      content.messages.emplace_back(from, i, randomBytes(gen, kDataSize));
+      auto &msg = content.messages.back();
+      msg.topic_ids.push_back(content.topic);
+      content.message_ids.push_back(
+          gossip::createMessageId(msg.from, msg.seq_no, msg.data));
+    }
+    for (size_t i = 0; i < kIHaves; ++i) {
+      content.ihaves.push_back(randomBytes(gen, 42));
+    }
+    return content;
+  }
+
+  void build(gossip::MessageBuilder &builder, const GossipContent &content) {
+    builder.addSubscription(true, content.topic);
+    builder.addGraft(content.topic);
+    for (const auto &id : content.ihaves) {
+      builder.addIHave(content.topic, id);
+    }
+    for (size_t i = 0; i < content.messages.size(); ++i) {
+      builder.addMessage(content.messages[i], content.message_ids[i]);
+    }
+  }
+
+  /// Counts what is dispatched
+  class CountingReceiver : public gossip::MessageReceiver {
+   public:
+    void onSubscription(const gossip::PeerContextPtr &, bool,
+                        const gossip::TopicId &) override {
+      ++count;
+    }
+    void onIHave(const gossip::PeerContextPtr &, const gossip::TopicId &,
+                 const gossip::MessageId &) override {
+      ++count;
+    }
+    void onIWant(const gossip::PeerContextPtr &,
+                 const gossip::MessageId &) override {
+      ++count;
+    }
+    void onGraft(const gossip::PeerContextPtr &,
+                 const gossip::TopicId &) override {
+      ++count;
+    }
+    void onPrune(const gossip::PeerContextPtr &, const gossip::TopicId &,
+                 uint64_t) override {
+      ++count;
+    }
+    void onTopicMessage(const gossip::PeerContextPtr &,
+                        gossip::TopicMessage::Ptr) override {
+      ++count;
+    }
+    void onMessageEnd(const gossip::PeerContextPtr &) override {}
+
+    size_t count = 0;
+  };
+
+  void BM_GossipBuild(benchmark::State &state) {
+    auto content = makeGossipContent(state.range(0));
+    gossip::MessageBuilder builder;
+    size_t bytes = 0;
+    for (auto _ : state) {
+      build(builder, content);
+      auto res = builder.serialize();
+      bytes = res.value()->size();
+      benchmark::DoNotOptimize(res);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+  }
+
+  /// Serialized gossip RPC without varint length prefix
+  std::vector<uint8_t> makeGossipRpc(size_t messages) {
+    gossip::MessageBuilder builder;
+    build(builder, makeGossipContent(messages));
+    auto buffer = builder.serialize().value();
+    auto prefix = multi::UVarint::calculateSize(*buffer);
+    return {buffer->begin() + prefix, buffer->end()};
+  }
+
+  bool parse(gossip::MessageParser &parser, gsl::span<const uint8_t> bytes,
+             CountingReceiver &receiver) {
+    if (!parser.parse(bytes)) {
+      return false;
+    }
+    parser.dispatch(nullptr, receiver);
+    return true;
+  }
+
+  void BM_GossipParse(benchmark::State &state) {
+    auto bytes = makeGossipRpc(state.range(0));
+    gossip::MessageParser parser;
+    CountingReceiver receiver;
+    for (auto _ : state) {
+      if (!parse(parser, bytes, receiver)) {
+        state.SkipWithError("parse error");
+        break;
+      }
+    }
+    benchmark::DoNotOptimize(receiver.count);
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+  }
+
+  void BM_GossipParseNewParser(benchmark::State &state) {
+    auto bytes = makeGossipRpc(state.range(0));
+    CountingReceiver receiver;
+    for (auto _ : state) {
+      gossip::MessageParser parser;
+      if (!parse(parser, bytes, receiver)) {
+        state.SkipWithError("parse error");
+        break;
+      }
+    }
+    benchmark::DoNotOptimize(receiver.count);
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+  }
+
+  void messages(benchmark::internal::Benchmark *b) {
+    b->ArgName("messages")->Arg(1)->Arg(10);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_KademliaRequestSerialize);
+BENCHMARK(BM_KademliaRequestDeserialize);
+BENCHMARK(BM_KademliaResponseSerialize);
+BENCHMARK(BM_KademliaResponseDeserialize);
+BENCHMARK(BM_GossipBuild)->Apply(messages);
+BENCHMARK(BM_GossipParse)->Apply(messages);
+BENCHMARK(BM_GossipParseNewParser)->Apply(messages);
@@ -0,0 +1,264 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <ctime>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libp2p/protocol/gossip/gossip.hpp>
+#include <libp2p/transport/memory.hpp>
+
+#include "benchutil/latency_recorder.hpp"
+#include "benchutil/loopback_hosts.hpp"
+
+/**
+ * @file gossip_mesh_benchmark.cpp
+ * Gossip scalability benchmark: N gossip hosts live in one process, share
+ * one io_context and are connected via in-memory transport, which the
+ * benchmark binds instead of TCP. Each node bootstraps to a few random
+ * previously created nodes, then meshes are built by the gossip itself. Random nodes publish
+ * messages of the given size at the given rate, every other node must receive
+ * every message.
+ *
+ * Arguments: {number of hosts, message size, publish rate (msgs/s, 0 means
+ * as fast as possible)}.
+ *
+ * Reported counters:
+ *  - p50_us, p99_us: delivery latency (from publish to local subscriber),
+ *  - duplicate_ratio: redundant message copies received per delivery,
+ *  - amplification: payload bytes received from the network per payload
+ *    byte delivered to subscribers,
+ *  - cpu_us_per_msg: process CPU time per published message.
+ */
+
+using namespace libp2p;  // NOLINT
+namespace gossip = libp2p::protocol::gossip;
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  const gossip::TopicId kTopic = "benchmark";
+
+  /// Number of peers each node bootstraps to
+  constexpr size_t kBootstrapPeers = 3;
+
+  /// Number of messages published in each iteration
+  constexpr size_t kMessagesPerIteration = 10;
+
+  /// Time given to gossip to build meshes before measurements
+  constexpr std::chrono::milliseconds kWarmupTime{3000};
+
+  /// Time to wait for all the deliveries of an iteration
+  constexpr std::chrono::milliseconds kDeliveryTimeout{30000};
+
+  /// Delivery statistics shared by all nodes
+  struct MeshStats {
+    size_t published = 0;
+    size_t delivered = 0;
+    size_t copies_received = 0;
+    benchutil::LatencyRecorder latency;
+  };
+
+  /// Gossip node with its own host and scheduler
+  struct Node {
+    std::shared_ptr<Host> host;
+    std::shared_ptr<gossip::Gossip> gossip;
+    protocol::Subscription subscription;
+  };
+
+  /// Writes publish time into first bytes of the payload
+  void stampPayload(gossip::ByteArray &payload) {
+    auto ts = Clock::now().time_since_epoch().count();
+    std::memcpy(payload.data(), &ts, sizeof(ts));
+  }
+
+  Clock::duration payloadAge(const gossip::ByteArray &payload) {
+    Clock::rep ts = 0;
+    std::memcpy(&ts, payload.data(), sizeof(ts));
+    return Clock::now().time_since_epoch() - Clock::duration(ts);
+  }
+
+  class GossipMesh {
+   public:
+    GossipMesh(size_t size, const gossip::Config &config,
+               std::shared_ptr<MeshStats> stats)
+        : io_(std::make_shared<boost::asio::io_context>()),
+          stats_(std::move(stats)) {
+      nodes_.reserve(size);
+      std::mt19937 rng(size);
+
+      for (size_t i = 0; i < size; ++i) {
+        auto injector =
+            benchutil::makeInjector<security::Plaintext, muxer::Yamux>(
+                io_,
+                injector::useTransportAdaptors<transport::MemoryTransport>());
+        Node node;
+        node.host = injector.template create<std::shared_ptr<Host>>();
+        node.gossip = gossip::create(
+            injector.template create<std::shared_ptr<basic::Scheduler>>(),
+            node.host, config);
+
+        // message id fn is called for every copy of message which came from
+        // the network and once for every local publish
+        node.gossip->setMessageIdFn([stats = stats_](const auto &from,
+                                                     const auto &seq,
+                                                     const auto &data) {
+          ++stats->copies_received;
+          gossip::ByteArray id(from);
+          id.insert(id.end(), seq.begin(), seq.end());
+          return id;
+        });
+
+        node.subscription = node.gossip->subscribe(
+            {kTopic}, [stats = stats_](gossip::Gossip::SubscriptionData d) {
+              if (d) {
+                ++stats->delivered;
+                stats->latency.add(payloadAge(d->data));
+              }
+            });
+
+        auto address = benchutil::nextMemoryAddress();
+        if (!node.host->listen(address)) {
+          throw std::runtime_error("cannot listen to "
+                                   + address.getStringAddress());
+        }
+
+        for (size_t n = 0; n < std::min(i, kBootstrapPeers); ++n) {
+          const auto &peer = nodes_[rng() % i];
+          node.gossip->addBootstrapPeer(peer.host->getId(),
+                                        peer.host->getAddresses().front());
+        }
+        nodes_.push_back(std::move(node));
+      }
+
+      for (auto &node : nodes_) {
+        node.host->start();
+        node.gossip->start();
+      }
+      io_->run_for(kWarmupTime);
+    }
+
+    ~GossipMesh() {
+      for (auto &node : nodes_) {
+        node.gossip->stop();
+        node.host->stop();
+      }
+      io_->restart();
+      io_->poll();
+    }
+
+    size_t size() const {
+      return nodes_.size();
+    }
+
+    bool publish(size_t node_index, gossip::ByteArray payload) {
+      stampPayload(payload);
+      ++stats_->published;
+      return nodes_[node_index].gossip->publish({kTopic}, std::move(payload));
+    }
+
+    void runFor(std::chrono::microseconds interval) {
+      io_->restart();
+      io_->run_for(interval);
+    }
+
+    template <typename Predicate>
+    bool runUntil(Predicate &&done, std::chrono::milliseconds timeout) {
+      auto deadline = Clock::now() + timeout;
+      io_->restart();
+      while (!done()) {
+        if (Clock::now() > deadline) {
+          return false;
+        }
+        io_->run_one_for(timeout);
+      }
+      return true;
+    }
+
+   private:
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::shared_ptr<MeshStats> stats_;
+    std::vector<Node> nodes_;
+  };
+
+  void BM_GossipMesh(benchmark::State &state) {
+    const auto hosts = static_cast<size_t>(state.range(0));
+    const auto msg_size =
+        std::max(sizeof(Clock::rep), static_cast<size_t>(state.range(1)));
+    const auto rate = static_cast<size_t>(state.range(2));
+    const std::chrono::microseconds publish_interval{
+        rate == 0 ? 0 : 1000000 / rate};
+
+    gossip::Config config;
+    config.heartbeat_interval_msec = std::chrono::milliseconds(100);
+    config.max_message_size = std::max(config.max_message_size, msg_size * 2);
+
+    auto stats = std::make_shared<MeshStats>();
+    std::unique_ptr<GossipMesh> mesh;
+    try {
+      mesh = std::make_unique<GossipMesh>(hosts, config, stats);
+    } catch (const std::exception &e) {
+      state.SkipWithError(e.what());
+      return;
+    }
+
+    // warmup traffic (subscriptions, grafts) is not counted
+    *stats = MeshStats{};
+
+    std::mt19937 rng(hosts);
+    gossip::ByteArray payload(msg_size, 0x42);
+    auto cpu_started = std::clock();
+
+    for (auto _ : state) {
+      for (size_t i = 0; i < kMessagesPerIteration; ++i) {
+        if (!mesh->publish(rng() % hosts, payload)) {
+          state.SkipWithError("publish failed");
+          break;
+        }
+        if (publish_interval.count() > 0) {
+          mesh->runFor(publish_interval);
+        }
+      }
+      const auto expected = stats->published * (hosts - 1);
+      if (!mesh->runUntil([&] { return stats->delivered >= expected; },
+                          kDeliveryTimeout)) {
+        state.SkipWithError("messages were not delivered to all the hosts");
+        break;
+      }
+    }
+
+    auto cpu_us = 1e6 * static_cast<double>(std::clock() - cpu_started)
+        / CLOCKS_PER_SEC;
+    auto published = static_cast<double>(stats->published);
+    auto delivered = static_cast<double>(stats->delivered);
+    auto network_copies =
+        static_cast<double>(stats->copies_received) - published;
+
+    state.SetItemsProcessed(static_cast<int64_t>(stats->published));
+    if (delivered > 0) {
+      state.counters["duplicate_ratio"] =
+          (network_copies - delivered) / delivered;
+      state.counters["amplification"] = network_copies / delivered;
+    }
+    if (published > 0) {
+      state.counters["cpu_us_per_msg"] = cpu_us / published;
+    }
+    stats->latency.report(state);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_GossipMesh)
+    ->ArgNames({"hosts", "msg_size", "rate"})
+    ->Args({50, 256, 0})
+    ->Args({50, 64 * 1024, 0})
+    ->Args({50, 256, 1000})
+    ->Args({100, 256, 0})
+    ->Args({200, 256, 0})
+    ->Args({500, 256, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Iterations(10);
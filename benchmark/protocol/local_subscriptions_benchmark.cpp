@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "src/protocol/gossip/impl/local_subscriptions.hpp"
+
+/**
+ * @file local_subscriptions_benchmark.cpp
+ * Dispatch of gossip messages to in-process subscribers: N subscriptions,
+ * each to 2 of 100 topics, and messages to a single topic, so that only a
+ * few subscribers are interested in each message.
+ *
+ * Argument: number of subscriptions.
+ */
+
+using namespace libp2p::protocol;  // NOLINT
+
+namespace {
+  constexpr size_t kTopics = 100;
+
+  gossip::TopicId topicName(size_t i) {
+    return "/benchmark/topic/" + std::to_string(i % kTopics);
+  }
+
+  void BM_ForwardMessage(benchmark::State &state) {
+    auto subs = std::make_shared<gossip::LocalSubscriptions>(
+        [](bool, const gossip::TopicId &) {});
+
+    size_t received = 0;
+    std::vector<Subscription> subscriptions;
+    for (size_t i = 0; i < static_cast<size_t>(state.range(0)); ++i) {
+      subscriptions.push_back(subs->subscribe(
+          {topicName(i), topicName(i * 7 + 3)},
+          [&](gossip::Gossip::SubscriptionData) { ++received; }));
+    }
+
+    std::vector<gossip::TopicMessage::Ptr> messages;
+    for (size_t i = 0; i < kTopics; ++i) {
+      auto msg = std::make_shared<gossip::TopicMessage>(
+          gossip::ByteArray{1, 2, 3}, gossip::ByteArray{4},
+          gossip::ByteArray{5});
+      msg->topic_ids.push_back(topicName(i));
+      messages.push_back(std::move(msg));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+      subs->forwardMessage(messages[i++ % messages.size()]);
+    }
+    benchmark::DoNotOptimize(received);
+    state.SetItemsProcessed(state.iterations());
+  }
+
+}  // namespace
+
+BENCHMARK(BM_ForwardMessage)
+    ->ArgName("subscriptions")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
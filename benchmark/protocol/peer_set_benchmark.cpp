@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "src/protocol/gossip/impl/peer_set.hpp"
+
+/**
+ * @file peer_set_benchmark.cpp
+ * Operations on gossip peer sets with N peers, as done per message and per
+ * heartbeat: sampling of D_max * 2 random subscribers to announce the message
+ * to, iteration over the set, lookup by id and churn (erase and insert).
+ *
+ * Argument: number of peers in the set.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  namespace gossip = protocol::gossip;
+
+  constexpr size_t kSample = 24;
+
+  std::vector<gossip::PeerContextPtr> makePeers(size_t n) {
+    std::mt19937 gen{42};  // NOLINT
+    std::uniform_int_distribution<int> dist{0, 255};
+    std::vector<gossip::PeerContextPtr> peers;
+    for (size_t i = 0; i < n; ++i) {
+      std::vector<uint8_t> bytes(32);
+      for (auto &b : bytes) {
+        b = static_cast<uint8_t>(dist(gen));
+      }
+      auto hash = multi::Multihash::create(multi::sha256, bytes);
+      peers.push_back(std::make_shared<gossip::PeerContext>(
+          peer::PeerId::fromHash(hash.value()).value()));
+    }
+    return peers;
+  }
+
+  gossip::PeerSet makeSet(const std::vector<gossip::PeerContextPtr> &peers) {
+    gossip::PeerSet set;
+    for (const auto &p : peers) {
+      set.insert(p);
+    }
+    return set;
+  }
+
+  void BM_SelectRandomPeers(benchmark::State &state) {
+    auto set = makeSet(makePeers(state.range(0)));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(set.selectRandomPeers(kSample));
+    }
+  }
+
+  void BM_SelectAll(benchmark::State &state) {
+    auto set = makeSet(makePeers(state.range(0)));
+    size_t count = 0;
+    for (auto _ : state) {
+      set.selectAll([&](const gossip::PeerContextPtr &) { ++count; });
+    }
+    benchmark::DoNotOptimize(count);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_Find(benchmark::State &state) {
+    auto peers = makePeers(state.range(0));
+    auto set = makeSet(peers);
+    size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(set.find(peers[i++ % peers.size()]->peer_id));
+    }
+  }
+
+  void BM_EraseInsert(benchmark::State &state) {
+    auto peers = makePeers(state.range(0));
+    auto set = makeSet(peers);
+    size_t i = 0;
+    for (auto _ : state) {
+      const auto &p = peers[i++ % peers.size()];
+      set.erase(p->peer_id);
+      set.insert(p);
+    }
+  }
+
+  void peers(benchmark::internal::Benchmark *b) {
+    b->ArgName("peers")->Arg(50)->Arg(500);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_SelectRandomPeers)->Apply(peers);
+BENCHMARK(BM_SelectAll)->Apply(peers);
+BENCHMARK(BM_Find)->Apply(peers);
+BENCHMARK(BM_EraseInsert)->Apply(peers);
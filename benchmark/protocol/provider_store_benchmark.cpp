@@ -0,0 +1,146 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <libp2p/protocol/kademlia/impl/provider_store.hpp>
+
+/**
+ * @file provider_store_benchmark.cpp
+ * Kademlia provider records store filled with N records of N / 8 contents,
+ * provided by N / 4 peers: throughput of adding records, of looking up
+ * providers and of batched expiration, and heap bytes per record.
+ *
+ * Argument: number of records.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  namespace kademlia = protocol::kademlia;
+
+  constexpr size_t kProvidersPerContent = 8;
+  constexpr size_t kContentsPerPeer = 2;
+  constexpr size_t kExpirationBatch = 1000;
+
+  struct Records {
+    explicit Records(size_t n) {
+      std::mt19937 gen{42};  // NOLINT
+      std::uniform_int_distribution<int> dist{0, 255};
+      for (size_t i = 0; i < n / kProvidersPerContent; ++i) {
+        contents.emplace_back(std::to_string(i));
+      }
+      for (size_t i = 0; i < n / kProvidersPerContent * kContentsPerPeer;
+           ++i) {
+        std::vector<uint8_t> bytes(32);
+        for (auto &b : bytes) {
+          b = static_cast<uint8_t>(dist(gen));
+        }
+        auto hash = multi::Multihash::create(multi::sha256, bytes);
+        peers.push_back(peer::PeerId::fromHash(hash.value()).value());
+      }
+    }
+
+    /// Adds all the records, expiring at the time of adding
+    void addTo(kademlia::ProviderStore &store) const {
+      kademlia::Time time = 0;
+      for (size_t i = 0; i < contents.size() * kProvidersPerContent; ++i) {
+        store.addProvider(contents[i % contents.size()],
+                          peers[i % peers.size()], ++time);
+      }
+    }
+
+    std::vector<kademlia::ContentId> contents;
+    std::vector<peer::PeerId> peers;
+  };
+
+  kademlia::Config makeConfig(size_t records) {
+    kademlia::Config config;
+    config.maxProvidersPerKey = kProvidersPerContent;
+    config.maxProviderRecords = records;
+    return config;
+  }
+
+  void BM_AddProviders(benchmark::State &state) {
+    Records records(state.range(0));
+    auto config = makeConfig(state.range(0));
+    for (auto _ : state) {
+      kademlia::ProviderStore store(config);
+      records.addTo(store);
+      benchmark::DoNotOptimize(store.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  /// Refreshes of full store evict the least recently refreshed records
+  void BM_AddProvidersAboveLimit(benchmark::State &state) {
+    Records records(state.range(0));
+    auto config = makeConfig(state.range(0) / 2);
+    kademlia::ProviderStore store(config);
+    records.addTo(store);
+    for (auto _ : state) {
+      records.addTo(store);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_GetProviders(benchmark::State &state) {
+    Records records(state.range(0));
+    auto config = makeConfig(state.range(0));
+    kademlia::ProviderStore store(config);
+    records.addTo(store);
+    size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(store.getProviders(
+          records.contents[i++ % records.contents.size()], 0));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_RemoveExpired(benchmark::State &state) {
+    Records records(state.range(0));
+    auto config = makeConfig(state.range(0));
+    for (auto _ : state) {
+      state.PauseTiming();
+      kademlia::ProviderStore store(config);
+      records.addTo(store);
+      state.ResumeTiming();
+      while (!store.removeExpired(state.range(0), kExpirationBatch)) {
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_MemoryPerRecord(benchmark::State &state) {
+    Records records(state.range(0));
+    auto config = makeConfig(state.range(0));
+    kademlia::ProviderStore store(config);
+    records.addTo(store);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(store.memoryUsage());
+    }
+    state.counters["bytes_per_record"] =
+        static_cast<double>(store.memoryUsage()) / store.size();
+  }
+
+  void recordCounts(benchmark::internal::Benchmark *b) {
+    b->ArgName("records");
+    for (auto n : {1 << 12, 1 << 16, 1 << 20}) {
+      b->Arg(n);
+    }
+  }
+
+}  // namespace
+
+BENCHMARK(BM_AddProviders)->Apply(recordCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AddProvidersAboveLimit)
+    ->Apply(recordCounts)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetProviders)->Apply(recordCounts);
+BENCHMARK(BM_RemoveExpired)
+    ->Apply(recordCounts)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MemoryPerRecord)->Apply(recordCounts)->Iterations(1);
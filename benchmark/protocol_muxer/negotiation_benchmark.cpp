@@ -0,0 +1,127 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <array>
+
+#include <benchmark/benchmark.h>
+#include <libp2p/protocol_muxer/multiselect.hpp>
+
+#include "benchutil/latency_recorder.hpp"
+#include "testutil/libp2p/stream_pair.hpp"
+
+/**
+ * @file negotiation_benchmark.cpp
+ * Time to first byte on a new outbound stream: the client negotiates the
+ * protocol, sends a request and waits for the first byte of the response.
+ * Streams are connected by in-memory link with a given one way delay.
+ * Simple negotiation costs 2 round trips, lazy negotiation costs 1.
+ *
+ * Argument: one way delay in microseconds.
+ *
+ * Reported counters:
+ *  - p50_us, p99_us: time to first byte percentiles.
+ */
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using protocol_muxer::multiselect::Multiselect;
+  using protocol_muxer::multiselect::MultiselectConfig;
+  using testutil::PipeStream;
+  using StreamSPtr = std::shared_ptr<connection::Stream>;
+
+  const peer::Protocol kProtocol = "/benchmark/ping/1.0.0";
+
+  constexpr std::array<uint8_t, 4> kRequest{'p', 'i', 'n', 'g'};
+
+  /// Server side: accepts the protocol, reads the request and replies
+  void serve(Multiselect &muxer, const std::shared_ptr<PipeStream> &stream) {
+    std::array<peer::Protocol, 1> protocols{kProtocol};
+    muxer.selectOneOf(
+        protocols, stream, false, true,
+        [stream](outcome::result<peer::Protocol> res) {
+          if (!res) {
+            return;
+          }
+          auto buf = std::make_shared<std::array<uint8_t, kRequest.size()>>();
+          stream->read(*buf, buf->size(),
+                       [stream, buf](outcome::result<size_t> res) {
+                         if (res) {
+                           stream->write(*buf, buf->size(),
+                                         [](outcome::result<size_t>) {});
+                         }
+                       });
+        });
+  }
+
+  /// Client side: negotiates, sends the request and reads the first byte
+  void request(Multiselect &muxer, const std::shared_ptr<PipeStream> &stream,
+               bool &done) {
+    muxer.simpleStreamNegotiate(
+        stream, kProtocol, [&done](outcome::result<StreamSPtr> res) {
+          if (!res) {
+            return;
+          }
+          auto stream = std::move(res.value());
+          stream->write(kRequest, kRequest.size(),
+                        [](outcome::result<size_t>) {});
+          auto buf = std::make_shared<uint8_t>();
+          stream->read(gsl::span<uint8_t>(buf.get(), 1), 1,
+                       [stream, buf, &done](outcome::result<size_t> res) {
+                         done = res.has_value();
+                       });
+        });
+  }
+
+  void timeToFirstByte(benchmark::State &state, bool lazy) {
+    PipeStream::Delay delay(state.range(0));
+    Multiselect client_muxer(MultiselectConfig{lazy});
+    Multiselect server_muxer;
+    benchutil::LatencyRecorder latency;
+
+    for (auto _ : state) {
+      boost::asio::io_context io;
+      auto [client, server] = PipeStream::makePair(io, delay);
+      serve(server_muxer, server);
+
+      bool done = false;
+      latency.start();
+      request(client_muxer, client, done);
+      while (!done && io.run_one() > 0) {
+      }
+      latency.stop();
+      io.run();
+
+      if (!done) {
+        state.SkipWithError("request failed");
+        break;
+      }
+    }
+
+    latency.report(state);
+  }
+
+  void BM_SimpleNegotiation(benchmark::State &state) {
+    timeToFirstByte(state, false);
+  }
+
+  void BM_LazyNegotiation(benchmark::State &state) {
+    timeToFirstByte(state, true);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_SimpleNegotiation)
+    ->ArgName("delay_us")
+    ->Arg(0)
+    ->Arg(500)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LazyNegotiation)
+    ->ArgName("delay_us")
+    ->Arg(0)
+    ->Arg(500)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -37,6 +37,18 @@ function(addtest_part test_name)
       )
 endfunction()
 
+function(addbenchmark benchmark_name)
+  add_executable(${benchmark_name} ${ARGN})
+  target_link_libraries(${benchmark_name}
+      p2p_benchmark_main
+      benchmark::benchmark
+      )
+  set_target_properties(${benchmark_name} PROPERTIES
+      RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/benchmark_bin
+      )
+  disable_clang_tidy(${benchmark_name})
+endfunction()
+
 # conditionally applies flag. If flag is supported by current compiler, it will be added to compile options.
 function(add_flag flag)
   check_cxx_compiler_flag(${flag} FLAG_${flag})
@@ -0,0 +1,95 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BASIC_COROUTINE_HPP
+#define LIBP2P_BASIC_COROUTINE_HPP
+
+#include <cassert>
+#include <memory>
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/optional.hpp>
+#include <libp2p/basic/reader.hpp>
+#include <libp2p/basic/writer.hpp>
+
+namespace libp2p::basic {
+
+  /**
+   * @brief Base for stackless coroutines over Reader and Writer.
+   *
+   * Derived class implements resume(outcome::result<size_t>) with its body
+   * inside BOOST_ASIO_CORO_REENTER(this) and suspends on I/O with
+   * BOOST_ASIO_CORO_YIELD awaitRead(...), awaitReadSome(...) or
+   * awaitWrite(...). Result of the operation is passed to the next resume().
+   * State kept across suspension points must be stored in members.
+   *
+   * Unlike chains of callbacks, where each step captures shared_from_this()
+   * and copies of its buffers, state lives in the coroutine object and each
+   * operation allocates only its completion handler. The pending handler is
+   * the owner of the coroutine: it is alive from spawn() while an operation
+   * is in flight, and is destroyed with the last handler when the body
+   * completes or a stream drops the handler without calling it (e.g. after
+   * reset()).
+   *
+   * Operations completed synchronously do not recurse into the body, they
+   * are resumed from a loop in the outermost resume.
+   *
+   * @tparam Derived coroutine implementation
+   */
+  template <typename Derived>
+  class Coroutine : public boost::asio::coroutine {
+   protected:
+    using Result = outcome::result<size_t>;
+
+    /// Runs the coroutine until its first suspension point
+    void spawn(std::shared_ptr<Derived> self) {
+      assert(self.get() == static_cast<Derived *>(this));
+      assert(self_.expired());
+      self_ = self;
+      resumeWith(Result{0});
+    }
+
+    void awaitRead(Reader &reader, gsl::span<uint8_t> out, size_t bytes) {
+      reader.read(out, bytes, resumer());
+    }
+
+    void awaitReadSome(Reader &reader, gsl::span<uint8_t> out, size_t bytes) {
+      reader.readSome(out, bytes, resumer());
+    }
+
+    void awaitWrite(Writer &writer, gsl::span<const uint8_t> in,
+                    size_t bytes) {
+      writer.write(in, bytes, resumer());
+    }
+
+   private:
+    std::function<void(Result)> resumer() {
+      return [self{self_.lock()}](Result res) { self->resumeWith(res); };
+    }
+
+    void resumeWith(Result res) {
+      pending_ = res;
+      if (running_) {
+        // completed synchronously, will be resumed by the outer loop
+        return;
+      }
+
+      running_ = true;
+      while (pending_) {
+        auto next = std::move(pending_.value());
+        pending_.reset();
+        static_cast<Derived *>(this)->resume(next);
+      }
+      running_ = false;
+    }
+
+    std::weak_ptr<Derived> self_;
+    boost::optional<Result> pending_;
+    bool running_ = false;
+  };
+
+}  // namespace libp2p::basic
+
+#endif  // LIBP2P_BASIC_COROUTINE_HPP
@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BASIC_FRAMED_READER_HPP
+#define LIBP2P_BASIC_FRAMED_READER_HPP
+
+#include <memory>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <gsl/span>
+#include <libp2p/basic/reader.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::basic {
+
+  /**
+   * Reads uvarint length-prefixed frames from a stream. Data is read ahead
+   * with readSome() into a reusable buffer, so that one read may deliver
+   * several frames, and length prefixes are parsed without per-byte reads.
+   *
+   * N.B. Bytes following the last delivered frame may be consumed from the
+   * stream, so the reader must be the only reader of the stream
+   */
+  class FramedReader : public std::enable_shared_from_this<FramedReader> {
+   public:
+    enum class Error {
+      FRAME_TOO_LONG = 1,
+      BAD_LENGTH_PREFIX,
+      READ_IN_PROGRESS,
+      STREAM_CLOSED,
+    };
+
+    /// Frame bytes, valid until the callback returns
+    using Frame = gsl::span<const uint8_t>;
+
+    using FrameCallback = std::function<void(outcome::result<Frame>)>;
+
+    static constexpr size_t kDefaultReadAhead = 4096;
+
+    /**
+     * @param stream to read frames from
+     * @param max_frame_size frames above this size are rejected before
+     * memory is allocated for them
+     * @param read_ahead size of the reusable buffer and of readSome() calls
+     */
+    FramedReader(std::shared_ptr<Reader> stream, size_t max_frame_size,
+                 size_t read_ahead = kDefaultReadAhead);
+
+    /**
+     * Reads the next frame. Callback is never called before read() returns.
+     * Only one read may be active at a time, read() may be called from
+     * inside the callback to continue reading
+     */
+    void read(FrameCallback cb);
+
+   private:
+    /// Delivers buffered frames while there is a pending callback
+    void dispatch();
+
+    /// Parses the frame at the buffer head. Returns empty optional if more
+    /// bytes are needed, in that case wanted_ is set
+    outcome::result<boost::optional<Frame>> nextFrame();
+
+    /// Issues readSome() for at least wanted_ bytes
+    void readMore();
+
+    void onDataRead(outcome::result<size_t> res);
+
+    /// Completes the active read operation
+    void complete(outcome::result<Frame> res);
+
+    std::shared_ptr<Reader> stream_;
+    const size_t max_frame_size_;
+    const size_t read_ahead_;
+
+    std::vector<uint8_t> buffer_;
+
+    /// Unconsumed bytes are buffer_[begin_, end_)
+    size_t begin_ = 0;
+    size_t end_ = 0;
+
+    /// Size of the incomplete frame at buffer head including prefix
+    size_t wanted_ = 0;
+
+    FrameCallback cb_;
+    bool dispatching_ = false;
+    bool reading_ = false;
+  };
+
+}  // namespace libp2p::basic
+
+OUTCOME_HPP_DECLARE_ERROR(libp2p::basic, FramedReader::Error);
+
+#endif  // LIBP2P_BASIC_FRAMED_READER_HPP
@@ -6,6 +6,8 @@
 #ifndef LIBP2P_GARBAGE_COLLECTABLE_HPP
 #define LIBP2P_GARBAGE_COLLECTABLE_HPP
 
+#include <cstddef>
+
 namespace libp2p::basic {
 
   /**
@@ -24,6 +26,20 @@ namespace libp2p::basic {
      * thread only.
      */
     virtual void collectGarbage() = 0;
+
+    /**
+     * @brief Cleanup a part of garbage, touching at most {@param budget}
+     * entries, so that the calling thread is not stalled for long. Structures,
+     * which cannot collect garbage incrementally, collect it all at once.
+     * @return true if there is no more garbage to collect
+     *
+     * @note Caller must ensure that this method is called from the single
+     * thread only.
+     */
+    virtual bool collectSomeGarbage([[maybe_unused]] size_t budget) {
+      collectGarbage();
+      return true;
+    }
   };
 
 }  // namespace libp2p::basic
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_BASIC_GARBAGE_COLLECTOR_HPP
+#define LIBP2P_BASIC_GARBAGE_COLLECTOR_HPP
+
+#include <vector>
+
+#include <libp2p/basic/garbage_collectable.hpp>
+#include <libp2p/basic/scheduler.hpp>
+
+namespace libp2p::basic {
+
+  /**
+   * Collects garbage of registered structures periodically. Each pass is
+   * split into steps of limited budget, the next step is deferred through
+   * scheduler, so that other callbacks run in between
+   */
+  class GarbageCollector {
+   public:
+    struct Config {
+      /// Interval between passes
+      std::chrono::milliseconds interval = std::chrono::seconds(60);
+
+      /// How many entries a structure may touch in one step
+      size_t step_budget = 1000;
+    };
+
+    GarbageCollector(std::shared_ptr<Scheduler> scheduler, Config config);
+
+    GarbageCollector(const GarbageCollector &) = delete;
+    GarbageCollector &operator=(const GarbageCollector &) = delete;
+
+    /// Registers structure, which is collected while it is alive
+    void add(std::weak_ptr<GarbageCollectable> collectable);
+
+    /// Starts periodic passes
+    void start();
+
+    /// Stops collecting, a pass in progress is abandoned
+    void stop();
+
+   private:
+    /// Makes one step of the current pass
+    void step();
+
+    std::shared_ptr<Scheduler> scheduler_;
+    const Config config_;
+    std::vector<std::weak_ptr<GarbageCollectable>> collectables_;
+
+    /// Collectables not finished in the current pass
+    std::vector<std::weak_ptr<GarbageCollectable>> pending_;
+
+    /// Timer of the next pass or step
+    Scheduler::Handle handle_;
+  };
+
+}  // namespace libp2p::basic
+
+#endif  // LIBP2P_BASIC_GARBAGE_COLLECTOR_HPP
@@ -24,6 +24,9 @@ namespace libp2p::basic {
     using ReadCallback = outcome::result<ResultType>;
     using ReadCallbackFunc = std::function<void(ReadCallback)>;
 
+    /// Fills the message bytes, called synchronously
+    using Serializer = std::function<void(gsl::span<uint8_t>)>;
+
     virtual ~MessageReadWriter() = default;
 
     /**
@@ -41,6 +44,25 @@ namespace libp2p::basic {
      */
     virtual void write(gsl::span<const uint8_t> buffer,
                        Writer::WriteCallbackFunc cb) = 0;
+
+    /**
+     * Writes a message of known size and preprends its length. The message
+     * is serialized right into the output buffer, implementations may
+     * override this to avoid copying
+     * @param size - size of the message
+     * @param serialize - fills the message bytes
+     * @param cb is called when the message is written or an error happened.
+     * Quantity of bytes written is passed as an argument in case of success
+     */
+    virtual void writeSerialized(size_t size, const Serializer &serialize,
+                                 Writer::WriteCallbackFunc cb) {
+      auto buffer = std::make_shared<std::vector<uint8_t>>(size);
+      serialize(*buffer);
+      write(*buffer,
+            [buffer, cb = std::move(cb)](outcome::result<size_t> res) {
+              cb(res);
+            });
+    }
   };
 }  // namespace libp2p::basic
 
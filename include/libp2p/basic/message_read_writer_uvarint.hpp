@@ -43,7 +43,22 @@ namespace libp2p::basic {
     void write(gsl::span<const uint8_t> buffer,
                Writer::WriteCallbackFunc cb) override;
 
+    /**
+     * Write a message serialized right after the uvarint prefix, so that one
+     * buffer is allocated and the message is not copied
+     * @param size - size of the message
+     * @param serialize - fills the message bytes
+     * @param cb, which is called, when the message is written or error happens
+     */
+    void writeSerialized(size_t size, const Serializer &serialize,
+                         Writer::WriteCallbackFunc cb) override;
+
    private:
+    /// Writes the message prefixed with uvarint of the size, the message
+    /// bytes are filled by the serializer
+    void writeMessage(size_t size, const Serializer &serialize,
+                      Writer::WriteCallbackFunc cb);
+
     std::shared_ptr<ReadWriter> conn_;
   };
 }  // namespace libp2p::basic
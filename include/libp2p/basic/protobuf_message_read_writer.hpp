@@ -69,18 +69,16 @@ namespace libp2p::basic {
                   std::is_default_constructible<ProtoMsgType>::value>>
     void write(const ProtoMsgType &msg, Writer::WriteCallbackFunc cb,
                const std::shared_ptr<std::vector<uint8_t>> &bytes = nullptr) {
-      auto msg_bytes =
-          std::make_shared<std::vector<uint8_t>>(msg.ByteSize(), 0);
-      msg.SerializeToArray(msg_bytes->data(), msg.ByteSize());
-      if (bytes) {
-        bytes->clear();
-        std::copy(msg_bytes->begin(), msg_bytes->end(),
-                  std::back_inserter(*bytes));
-      }
-      read_writer_->write(*msg_bytes,
-                          [cb = std::move(cb), msg_bytes](auto &&res) {
-                            cb(std::forward<decltype(res)>(res));
-                          });
+      // serialized right into the output buffer of read_writer_
+      read_writer_->writeSerialized(
+          msg.ByteSizeLong(),
+          [&msg, &bytes](gsl::span<uint8_t> out) {
+            msg.SerializeWithCachedSizesToArray(out.data());
+            if (bytes) {
+              bytes->assign(out.begin(), out.end());
+            }
+          },
+          std::move(cb));
     }
 
    private:
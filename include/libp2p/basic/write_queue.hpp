@@ -28,6 +28,9 @@ namespace libp2p::basic {
     /// Returns bytes enqueued and not yet sent
     size_t unsentBytes() const;
 
+    /// Returns bytes referenced by queued messages, sent or not
+    size_t queuedBytes() const;
+
     /// Enqueues data
     void enqueue(DataRef data, bool some, basic::Writer::WriteCallbackFunc cb);
 
@@ -80,6 +83,7 @@ namespace libp2p::basic {
     size_t size_limit_;
     size_t active_index_ = 0;
     size_t total_unsent_size_ = 0;
+    size_t total_queued_size_ = 0;
     std::deque<Data> queue_;
   };
 
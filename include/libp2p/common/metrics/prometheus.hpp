@@ -0,0 +1,25 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_COMMON_METRICS_PROMETHEUS_HPP
+#define LIBP2P_COMMON_METRICS_PROMETHEUS_HPP
+
+#include <libp2p/common/metrics/registry.hpp>
+
+namespace libp2p::metrics {
+
+  /**
+   * Renders current values of all the registry metrics in Prometheus text
+   * exposition format (version 0.0.4). Pull-based: intended to be called
+   * from an HTTP handler or a periodic dump, costs nothing between calls
+   * @param registry - metrics to export
+   * @return text ready to be served with
+   * "Content-Type: text/plain; version=0.0.4"
+   */
+  std::string toPrometheusText(const Registry &registry);
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_COMMON_METRICS_PROMETHEUS_HPP
@@ -0,0 +1,195 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_COMMON_METRICS_REGISTRY_HPP
+#define LIBP2P_COMMON_METRICS_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace libp2p::metrics {
+
+  /// Metric labels, e.g. {{"executor", "find_peer"}}
+  using Labels = std::vector<std::pair<std::string, std::string>>;
+
+  namespace detail {
+    /// Number of per-thread shards of a counter
+    constexpr size_t kCounterShards = 16;
+
+    /// Shard index of the calling thread, threads are distributed over shards
+    /// round robin in order of their first metrics update
+    inline size_t threadShard() {
+      static std::atomic_size_t next_shard{0};
+      thread_local const size_t shard =
+          next_shard.fetch_add(1, std::memory_order_relaxed) % kCounterShards;
+      return shard;
+    }
+  }  // namespace detail
+
+  /**
+   * Monotonic counter. Increments go to per-thread shards on separate cache
+   * lines, so concurrent updates don't contend. Reading sums up the shards
+   */
+  class Counter {
+   public:
+    void inc(uint64_t n = 1) {
+      shards_[detail::threadShard()].value.fetch_add(
+          n, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const;
+
+   private:
+    struct alignas(64) Shard {
+      std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, detail::kCounterShards> shards_;
+  };
+
+  /// Value which can go up and down, e.g. queue depth
+  class Gauge {
+   public:
+    void set(int64_t value) {
+      value_.store(value, std::memory_order_relaxed);
+    }
+
+    void inc(int64_t n = 1) {
+      value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void dec(int64_t n = 1) {
+      value_.fetch_sub(n, std::memory_order_relaxed);
+    }
+
+    int64_t value() const {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<int64_t> value_{0};
+  };
+
+  /**
+   * Histogram with fixed bucket upper bounds given at construction,
+   * observation is a binary search, a relaxed atomic increment and a CAS
+   * loop on the sum
+   */
+  class Histogram {
+   public:
+    /// Buckets for durations in seconds, from 100us to 10s
+    static const std::vector<double> &durationBuckets();
+
+    /// @param bounds - sorted upper bounds of buckets, +Inf bucket is implicit
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    /// Observes duration in seconds
+    template <typename Rep, typename Period>
+    void observe(std::chrono::duration<Rep, Period> duration) {
+      observe(std::chrono::duration<double>(duration).count());
+    }
+
+    const std::vector<double> &bounds() const {
+      return bounds_;
+    }
+
+    /// Non-cumulative count of the i-th bucket, i == bounds().size() is +Inf
+    uint64_t bucketCount(size_t i) const {
+      return buckets_[i].load(std::memory_order_relaxed);
+    }
+
+    /// Total number of observations
+    uint64_t count() const;
+
+    double sum() const {
+      return sum_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+    std::atomic<double> sum_{0};
+  };
+
+  /// Measures time from construction to destruction into histogram
+  class ScopedTimer {
+   public:
+    explicit ScopedTimer(Histogram &histogram)
+        : histogram_(histogram), started_(std::chrono::steady_clock::now()) {}
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ~ScopedTimer() {
+      histogram_.observe(std::chrono::steady_clock::now() - started_);
+    }
+
+   private:
+    Histogram &histogram_;
+    std::chrono::steady_clock::time_point started_;
+  };
+
+  enum class MetricType { COUNTER, GAUGE, HISTOGRAM };
+
+  /**
+   * Registry of named metrics. Metrics are created on first request and
+   * live as long as the registry, so references returned can be cached
+   * by callers (e.g. in function-local statics) and updated without any
+   * lookups or locks
+   */
+  class Registry {
+   public:
+    /// All the metrics of one name, distinguished by labels
+    struct Family {
+      MetricType type;
+      std::string help;
+      std::map<Labels, std::unique_ptr<Counter>> counters;
+      std::map<Labels, std::unique_ptr<Gauge>> gauges;
+      std::map<Labels, std::unique_ptr<Histogram>> histograms;
+    };
+
+    /// Process-wide registry used by libp2p components
+    static Registry &global();
+
+    Counter &counter(const std::string &name, const std::string &help,
+                     const Labels &labels = {});
+
+    Gauge &gauge(const std::string &name, const std::string &help,
+                 const Labels &labels = {});
+
+    /// Bounds are used only when metric with such name and labels is created
+    Histogram &histogram(const std::string &name, const std::string &help,
+                         const std::vector<double> &bounds,
+                         const Labels &labels = {});
+
+    /// Calls visitor(name, family) for all families ordered by name
+    template <typename Visitor>
+    void visit(Visitor &&visitor) const {
+      std::lock_guard lock(mutex_);
+      for (const auto &[name, family] : families_) {
+        visitor(name, family);
+      }
+    }
+
+   private:
+    Family &family(const std::string &name, const std::string &help,
+                   MetricType type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+  };
+
+}  // namespace libp2p::metrics
+
+#endif  // LIBP2P_COMMON_METRICS_REGISTRY_HPP
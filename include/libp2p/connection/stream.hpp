@@ -95,6 +95,19 @@ namespace libp2p::connection {
     virtual void adjustWindowSize(uint32_t new_size,
                                   VoidResultHandlerFunc cb) = 0;
 
+    /// Weight of the stream in outbound bandwidth of its connection
+    using Priority = uint8_t;
+    static constexpr Priority kDefaultPriority = 16;
+
+    /**
+     * Set a share of connection's outbound bandwidth, which this stream gets
+     * while other streams are writing too, it is proportional to priority.
+     * Ignored by streams, which don't share connection with others or
+     * write frames in order of writes
+     * @param priority from 1 (lowest) to 255
+     */
+    virtual void setPriority([[maybe_unused]] Priority priority) {}
+
     /**
      * Is that stream opened over a connection, which was an initiator?
      */
@@ -28,6 +28,7 @@
 #include <libp2p/network/impl/dnsaddr_resolver_impl.hpp>
 #include <libp2p/network/impl/listener_manager_impl.hpp>
 #include <libp2p/network/impl/network_impl.hpp>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
 #include <libp2p/network/impl/router_impl.hpp>
 #include <libp2p/network/impl/transport_manager_impl.hpp>
 #include <libp2p/peer/impl/identity_manager_impl.hpp>
@@ -57,6 +58,8 @@
  * - Plaintext as security
  * - Yamux as muxer
  * - Random keypair is generated
+ * - Resources are accounted, but not limited; bind
+ *   network::ResourceManagerConfig to set budgets
  *
  * List of libraries that should be linked to your lib/exe:
  *  - libp2p_network
@@ -282,16 +285,21 @@ namespace libp2p::injector {
         // internal
         di::bind<network::DnsaddrResolver>().template to <network::DnsaddrResolverImpl>(),
         di::bind<network::Router>().template to<network::RouterImpl>(),
+        di::bind<network::ConnectionManagerConfig>.template to(network::ConnectionManagerConfig{}),
         di::bind<network::ConnectionManager>().template to<network::ConnectionManagerImpl>(),
         di::bind<network::ListenerManager>().template to<network::ListenerManagerImpl>(),
+        di::bind<network::ResourceManagerConfig>.template to(network::ResourceManagerConfig{}),
+        di::bind<network::ResourceManager>().template to<network::ResourceManagerImpl>(),
         di::bind<network::Dialer>().template to<network::DialerImpl>(),
         di::bind<network::Network>().template to<network::NetworkImpl>(),
         di::bind<network::TransportManager>().template to<network::TransportManagerImpl>(),
         di::bind<transport::Upgrader>().template to<transport::UpgraderImpl>(),
+        di::bind<protocol_muxer::multiselect::MultiselectConfig>.template to(protocol_muxer::multiselect::MultiselectConfig{}),
         di::bind<protocol_muxer::ProtocolMuxer>().template to<protocol_muxer::multiselect::Multiselect>(),
 
         // default adaptors
         di::bind<muxer::MuxedConnectionConfig>.template to(muxer::MuxedConnectionConfig{}),
+        di::bind<security::TlsConfig>.template to(security::TlsConfig{}),
         di::bind<security::SecurityAdaptor *[]>().template to<security::Plaintext, security::Secio, security::Noise, security::TlsAdaptor>(),  // NOLINT
         di::bind<muxer::MuxerAdaptor *[]>().template to<muxer::Yamux, muxer::Mplex>(),  // NOLINT
         di::bind<transport::TransportAdaptor *[]>().template to<transport::TcpTransport>(),  // NOLINT
@@ -0,0 +1,57 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_LOG_LAZY_HPP
+#define LIBP2P_LOG_LAZY_HPP
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+#include <fmt/format.h>
+#include <libp2p/multi/multiaddress.hpp>
+
+namespace libp2p::log {
+
+  /**
+   * Log argument, which is converted to string only when the record is
+   * actually written, i.e. after the level check:
+   * @code
+   * log_->debug("connected to {}", log::address(address));
+   * @endcode
+   * Referenced values must outlive the log call
+   */
+  template <typename F>
+  struct Lazy {
+    F format;
+  };
+
+  /// Makes lazy log argument from function returning string
+  template <typename F>
+  Lazy<std::decay_t<F>> lazy(F &&f) {
+    return {std::forward<F>(f)};
+  }
+
+  /// Multiaddress in string form
+  inline auto address(const multi::Multiaddress &ma) {
+    return lazy([&ma] { return ma.getStringAddress(); });
+  }
+
+}  // namespace libp2p::log
+
+template <typename F>
+struct fmt::formatter<libp2p::log::Lazy<F>> {
+  constexpr auto parse(format_parse_context &ctx) {
+    return ctx.begin();
+  }
+
+  template <typename FormatContext>
+  auto format(const libp2p::log::Lazy<F> &value, FormatContext &ctx) const {
+    const auto &str = value.format();
+    return std::copy(str.begin(), str.end(), ctx.out());
+  }
+};
+
+#endif  // LIBP2P_LOG_LAZY_HPP
@@ -36,9 +36,14 @@ namespace libp2p::log {
           prefix_(makePrefix(prefix, instance)),
           prefix_size_(prefix_.size()) {}
 
+    /// Returns true if records of the level are written
+    bool isEnabled(soralog::Level level) const {
+      return log_->level() >= level;
+    }
+
     template <typename... Args>
     void log(soralog::Level level, std::string_view fmt, const Args &... args) {
-      if (log_->level() >= level) {
+      if (isEnabled(level)) {
         prefix_.append(fmt.data(), fmt.size());
         log_->log(level, prefix_, args...);
         prefix_.resize(prefix_size_);
@@ -100,4 +105,18 @@ namespace libp2p::log {
   };
 }  // namespace libp2p::log
 
+/// Logs via SubLogger, arguments are evaluated only if the level is enabled
+#define SUBLOG(logger, level, ...)        \
+  do {                                    \
+    if ((logger).isEnabled(level)) {      \
+      (logger).log((level), __VA_ARGS__); \
+    }                                     \
+  } while (false)
+
+#define SUBLOG_TRACE(logger, ...) \
+  SUBLOG(logger, ::libp2p::log::Level::TRACE, __VA_ARGS__)
+
+#define SUBLOG_DEBUG(logger, ...) \
+  SUBLOG(logger, ::libp2p::log::Level::DEBUG, __VA_ARGS__)
+
 #endif  // LIBP2P_PROTOCOL_COMMON_SUBLOGGER_HPP
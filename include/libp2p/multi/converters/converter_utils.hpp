@@ -47,6 +47,41 @@ namespace libp2p::multi::converters {
   auto bytesToMultiaddrString(gsl::span<const uint8_t> bytes)
       -> outcome::result<std::string>;
 
+  /**
+   * Component of a binary multiaddr: protocol and its value bytes (without
+   * varint length prefix, if the protocol has variable length)
+   */
+  struct MultiaddrComponent {
+    const Protocol *protocol = nullptr;
+    gsl::span<const uint8_t> value;
+  };
+
+  /**
+   * Reads the first component of a binary multiaddr without allocations
+   * @param bytes of multiaddr, not empty
+   * @param component to be filled
+   * @return size of the component in bytes, error if the protocol is unknown
+   * or the value is truncated
+   */
+  auto readMultiaddrComponent(gsl::span<const uint8_t> bytes,
+                              MultiaddrComponent &component)
+      -> outcome::result<size_t>;
+
+  /**
+   * Checks in a single pass that the byte sequence is a multiaddr, which
+   * can be rendered by bytesToMultiaddrString()
+   */
+  auto validateMultiaddrBytes(gsl::span<const uint8_t> bytes)
+      -> outcome::result<void>;
+
+  /**
+   * Appends human-readable form of the component value (without slashes) to
+   * the string
+   */
+  auto appendMultiaddrValue(std::string &out,
+                            const MultiaddrComponent &component)
+      -> outcome::result<void>;
+
 }  // namespace libp2p::multi::converters
 
 #endif  // LIBP2P_CONVERTER_UTILS_HPP
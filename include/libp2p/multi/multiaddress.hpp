@@ -22,7 +22,9 @@
 namespace libp2p::multi {
 
   /**
-   * Address format, used by Libp2p
+   * Address format, used by Libp2p. The binary form is canonical: it is
+   * validated once on creation and used for comparison and hashing, the
+   * textual form is rendered only when requested
    */
   class Multiaddress {
    private:
@@ -32,6 +34,14 @@ namespace libp2p::multi {
    public:
     Multiaddress() = delete;
 
+    // the cached string may be set by a concurrent getStringAddress() of the
+    // source, so it is copied atomically
+    Multiaddress(const Multiaddress &other);
+    Multiaddress &operator=(const Multiaddress &other);
+    Multiaddress(Multiaddress &&other) noexcept;
+    Multiaddress &operator=(Multiaddress &&other) noexcept;
+    ~Multiaddress() = default;
+
     enum class Error {
       INVALID_INPUT = 1,      ///< input contains invalid multiaddress
       PROTOCOL_NOT_FOUND,     ///< given protocol can not be found
@@ -103,10 +113,11 @@ namespace libp2p::multi {
     bool hasProtocol(Protocol::Code code) const;
 
     /**
-     * Get the textual representation of the address inside
+     * Get the textual representation of the address inside, it is rendered
+     * on the first call and cached
      * @return stringified address
      */
-    std::string_view getStringAddress() const;
+    std::string getStringAddress() const;
 
     /**
      * Get the byte representation of the address inside
@@ -154,7 +165,7 @@ namespace libp2p::multi {
     bool operator==(const Multiaddress &other) const;
 
     /**
-     * Lexicographical comparison of string representations of the
+     * Lexicographical comparison of binary representations of the
      * Multiaddresses
      */
     bool operator<(const Multiaddress &other) const;
@@ -174,23 +185,19 @@ namespace libp2p::multi {
 
    private:
     /**
-     * Construct a multiaddress instance from both address and bytes
-     * @param address to be in the multiaddress
+     * Construct a multiaddress instance from validated bytes
      * @param bytes to be in the multiaddress
      */
-    Multiaddress(std::string &&address, ByteBuffer &&bytes);
+    explicit Multiaddress(ByteBuffer &&bytes);
 
-    /**
-     * Decapsulate a given string, which represents a protocol, from the address
-     * @return true, if it was found and removed, false otherwise
-     */
-    bool decapsulateStringFromAddress(std::string_view proto,
-                                      const ByteBuffer &bytes);
+    /// Drops the string rendered from the previous bytes
+    void bytesChanged();
 
-    std::string stringified_address_;
+    /// Canonical form, validated on creation
     ByteBuffer bytes_;
 
-    boost::optional<std::string> peer_id_;
+    /// Textual form, rendered on first use, accessed atomically
+    mutable std::shared_ptr<const std::string> stringified_address_;
   };
 }  // namespace libp2p::multi
 
@@ -52,6 +52,7 @@ namespace libp2p::multi {
       P2P_WEBRTC_STAR = 275,
       P2P_WEBRTC_DIRECT = 276,
       P2P_CIRCUIT = 290,
+      MEMORY = 777,
     };
 
     constexpr bool operator==(const Protocol &p) const {
@@ -71,7 +72,7 @@ namespace libp2p::multi {
     /**
      * The total number of known protocols
      */
-    static const std::size_t kProtocolsNum = 28;
+    static const std::size_t kProtocolsNum = 29;
 
     /**
      * Returns a protocol with the corresponding name if it exists, or nullptr
@@ -145,6 +146,7 @@ namespace libp2p::multi {
         {Protocol::Code::P2P_WEBRTC_STAR, 0, "p2p-webrtc-star"},
         {Protocol::Code::P2P_WEBRTC_DIRECT, 0, "p2p-webrtc-direct"},
         {Protocol::Code::P2P_CIRCUIT, 0, "p2p-circuit"},
+        {Protocol::Code::MEMORY, 64, "memory"},
     };
   };
 
@@ -8,16 +8,25 @@
 
 #include <optional>
 
+#include <gsl/span>
 #include <libp2p/common/types.hpp>
 #include <libp2p/outcome/outcome.hpp>
 
 /**
  * Encode/decode to/from base58 format
- * Implementation is taken from
- * https://github.com/bitcoin/bitcoin/blob/master/src/base58.h
+ * Algorithm is based on
+ * https://github.com/bitcoin/bitcoin/blob/master/src/base58.h, but works
+ * with multi-digit limbs and has no heap scratch for short inputs
  */
 namespace libp2p::multi::detail {
 
+  /**
+   * Encode bytes to base58 string
+   * @param bytes to be encoded
+   * @return encoded string
+   */
+  std::string encodeBase58(gsl::span<const uint8_t> bytes);
+
   /**
    * Encode bytes to base58 string
    * @param bytes to be encoded
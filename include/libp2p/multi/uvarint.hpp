@@ -81,6 +81,20 @@ namespace libp2p::multi {
      */
     static size_t calculateSize(gsl::span<const uint8_t> varint_bytes);
 
+    /**
+     * @param number an integer to be encoded
+     * @return the size of varint representation of the number
+     */
+    static size_t encodedSize(uint64_t number);
+
+    /**
+     * Encodes the number into the buffer without allocations
+     * @param number an integer to be encoded
+     * @param out buffer of at least encodedSize(number) bytes
+     * @return the number of bytes written
+     */
+    static size_t encode(uint64_t number, gsl::span<uint8_t> out);
+
    private:
     /// private ctor for unsafe creation
     UVarint(gsl::span<const uint8_t> varint_bytes, size_t varint_size);
@@ -7,11 +7,7 @@
 #define LIBP2P_MPLEX_FRAME_HPP
 
 #include <cstdint>
-#include <functional>
-#include <memory>
 
-#include <boost/optional.hpp>
-#include <libp2p/basic/readwriter.hpp>
 #include <libp2p/common/types.hpp>
 #include <libp2p/muxer/mplex/mplex_stream.hpp>
 #include <libp2p/outcome/outcome.hpp>
@@ -52,6 +48,16 @@ namespace libp2p::connection {
                                      MplexStream::StreamNumber stream_number,
                                      common::ByteArray data = {});
 
+  /**
+   * Append bytes of an MplexFrame to the buffer: the header and the data are
+   * written in place, without temporary buffers
+   * @param out - buffer to append the frame to
+   * @param data of the frame
+   */
+  void appendFrame(common::ByteArray &out, MplexFrame::Flag flag,
+                   MplexStream::StreamNumber stream_number,
+                   gsl::span<const uint8_t> data = {});
+
   /**
    * Create an MplexFrame
    * @param id_flag - stream_id and flag, joined in a specific way, came from
@@ -61,14 +67,6 @@ namespace libp2p::connection {
    */
   outcome::result<MplexFrame> createFrame(uint64_t id_flag,
                                           common::ByteArray data);
-
-  /**
-   * Read and parse MplexFrame bytes
-   * @param reader, from which to read the bytes
-   * @param cb, which is called, when bytes are and parsed, or error happens
-   */
-  void readFrame(std::shared_ptr<basic::ReadWriter> reader,
-                 std::function<void(outcome::result<MplexFrame>)> cb);
 }  // namespace libp2p::connection
 
 #endif  // LIBP2P_MPLEX_FRAME_HPP
@@ -0,0 +1,65 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MPLEX_READING_STATE_HPP
+#define LIBP2P_MPLEX_READING_STATE_HPP
+
+#include <functional>
+
+#include <libp2p/basic/varint_prefix_reader.hpp>
+#include <libp2p/muxer/mplex/mplex_frame.hpp>
+
+namespace libp2p::connection {
+
+  /// Segmenter of mplex inbound data into frames. Frame data is passed as
+  /// slices of bytes received, without copying and allocations
+  class MplexReadingState {
+   public:
+    /// Callback on headers (frame data is empty, length is set), returns
+    /// false to terminate further processing
+    using HeaderCallback =
+        std::function<bool(outcome::result<MplexFrame> header)>;
+
+    /// Callback on data fragments of the current frame
+    using DataCallback = std::function<void(gsl::span<const uint8_t> segment)>;
+
+    MplexReadingState(HeaderCallback on_header, DataCallback on_data);
+
+    /// Data received from wire, segments it into frames
+    void onDataReceived(gsl::span<const uint8_t> bytes_read);
+
+    /// Discards data of the current frame, called from header callback for
+    /// frames whose data is not needed
+    void discardData();
+
+    /// Resets everything to reading header state
+    void reset();
+
+   private:
+    /// Processes header bytes, returns false to terminate processing
+    bool processHeader(gsl::span<const uint8_t> &bytes_read);
+
+    /// Processes data fragment of the current frame
+    void processData(gsl::span<const uint8_t> &bytes_read);
+
+    HeaderCallback on_header_;
+    DataCallback on_data_;
+
+    /// Reader of stream number and flag varint
+    basic::VarintPrefixReader id_flag_;
+
+    /// Reader of length varint
+    basic::VarintPrefixReader length_;
+
+    /// Data bytes of the current frame not yet received
+    uint64_t data_bytes_unread_ = 0;
+
+    /// If true, data of the current frame is passed to data callback
+    bool pass_data_ = false;
+  };
+
+}  // namespace libp2p::connection
+
+#endif  // LIBP2P_MPLEX_READING_STATE_HPP
@@ -6,9 +6,6 @@
 #ifndef LIBP2P_MPLEX_STREAM_HPP
 #define LIBP2P_MPLEX_STREAM_HPP
 
-#include <deque>
-#include <mutex>
-
 #include <boost/asio/streambuf.hpp>
 #include <boost/noncopyable.hpp>
 #include <libp2p/connection/stream.hpp>
@@ -106,19 +103,12 @@ namespace libp2p::connection {
     std::function<void(outcome::result<size_t>)> data_notifyee_;
     bool data_notified_ = false;
 
-    /// Queue of write requests that were received when stream was writing
-    std::deque<std::tuple<std::vector<uint8_t>, size_t, WriteCallbackFunc>>
-        write_queue_{};
-
-    mutable std::mutex write_queue_mutex_;
-
     /// is the stream opened for reads?
     bool is_readable_ = true;
     bool is_reading_ = false;
 
     /// is the stream opened for writes?
     bool is_writable_ = true;
-    bool is_writing_ = false;
 
     /// was the stream reset?
     bool is_reset_ = false;
@@ -6,17 +6,17 @@
 #ifndef LIBP2P_MPLEXED_CONNECTION_HPP
 #define LIBP2P_MPLEXED_CONNECTION_HPP
 
-#include <queue>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <libp2p/connection/capable_connection.hpp>
 #include <libp2p/log/logger.hpp>
+#include <libp2p/muxer/mplex/mplex_reading_state.hpp>
 #include <libp2p/muxer/mplex/mplex_stream.hpp>
 #include <libp2p/muxer/muxed_connection_config.hpp>
 
 namespace libp2p::connection {
-  struct MplexFrame;
 
   class MplexedConnection
       : public CapableConnection,
@@ -78,20 +78,43 @@ namespace libp2p::connection {
     void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
 
    private:
-    struct WriteData {
+    /// Frames, which are written to the connection in one write
+    struct WriteBatch {
+      /// Bytes of frames
       common::ByteArray data;
-      WriteCallbackFunc cb;
+
+      /// Frame sizes and callbacks to be called when they are written
+      std::vector<std::pair<size_t, WriteCallbackFunc>> callbacks;
     };
-    std::queue<WriteData> write_queue_;
+
+    /// Frames appended while the connection is writing, they go out with the
+    /// next write
+    WriteBatch pending_batch_;
+
+    /// Frames being written
+    WriteBatch writing_batch_;
+
     bool is_writing_ = false;
 
+    /// Inbound bytes are read here and sliced into frames in place
+    common::ByteArray read_buffer_;
+
+    /// Segmenter of inbound bytes into frames
+    MplexReadingState reading_state_;
+
+    /// Stream, which receives data of the frame being read
+    boost::optional<MplexStream::StreamId> reading_stream_;
+
     /**
-     * Write (\param data) to the connection
+     * Append a frame to the pending batch and start writing, if not yet
+     * @param cb - callback to be called with the frame size or error
      */
-    void write(WriteData data);
+    void writeFrame(MplexFrame::Flag flag,
+                    MplexStream::StreamNumber stream_number,
+                    gsl::span<const uint8_t> data, WriteCallbackFunc cb);
 
     /**
-     * Write next message from the queue
+     * Write the pending batch
      */
     void doWrite();
 
@@ -101,14 +124,25 @@ namespace libp2p::connection {
     void onWriteCompleted(outcome::result<size_t> write_res);
 
     /**
-     * Read next frame from the connection
+     * Read next bytes from the connection
+     */
+    void continueReading();
+
+    /**
+     * Called, when bytes are read from the connection
+     */
+    void onRead(outcome::result<size_t> read_res);
+
+    /**
+     * Process a received frame header (\param frame)
+     * @return false, if reading must be stopped
      */
-    void readNextFrame();
+    bool processFrame(outcome::result<MplexFrame> frame);
 
     /**
-     * Process a received (\param frame)
+     * Process a fragment of data of the current message frame
      */
-    void processFrame(const MplexFrame &frame);
+    void processData(gsl::span<const uint8_t> segment);
 
     /**
      * Process a new stream (\package frame)
@@ -177,8 +211,8 @@ namespace libp2p::connection {
     friend class MplexStream;
 
     /**
-     * Write bytes to the connection; before calling this method, the stream
-     * must ensure that no write operations are currently running
+     * Write bytes to the connection; they are copied into the write batch
+     * at once, so the stream may write again before the callback is called
      * @param stream_id, for which the bytes are to be written
      * @param in - bytes to be written
      * @param bytes - number of bytes to be written
@@ -15,10 +15,18 @@ namespace libp2p::muxer {
    * Config of muxed connection
    */
   struct MuxedConnectionConfig {
-    /// how much unconsumed data each stream can have stored locally
-    static constexpr size_t kDefaultMaxWindowSize = 64 * 1024 * 1024;
+    /// how much unconsumed data each stream can have stored locally.
+    /// Receive windows of streams grow up to it automatically, if the
+    /// application reads data faster than the windows pass it in round trip
+    static constexpr size_t kDefaultMaxWindowSize = 16 * 1024 * 1024;
     size_t maximum_window_size = kDefaultMaxWindowSize;
 
+    /// how much receive windows of all streams of a connection can grow in
+    /// total over their initial size, both automatically and by
+    /// Stream::adjustWindowSize()
+    static constexpr size_t kDefaultConnectionWindowBudget = 32 * 1024 * 1024;
+    size_t connection_window_budget = kDefaultConnectionWindowBudget;
+
     /// how much streams can be supported by Yamux at one time
     static constexpr size_t kDefaultMaxStreamsNumber = 1000;
     size_t maximum_streams = kDefaultMaxStreamsNumber;
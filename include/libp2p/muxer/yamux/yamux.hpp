@@ -10,6 +10,7 @@
 #include <libp2p/muxer/muxed_connection_config.hpp>
 #include <libp2p/muxer/muxer_adaptor.hpp>
 #include <libp2p/network/connection_manager.hpp>
+#include <libp2p/network/resource_manager.hpp>
 
 namespace libp2p::muxer {
   class Yamux : public MuxerAdaptor {
@@ -22,10 +23,13 @@ namespace libp2p::muxer {
      * @param scheduler scheduler
      * @param cmgr connection manager. May be nullptr in tests, otherwise
      * close_cb_ is created using it
+     * @param resource_manager limits streams and buffered bytes of muxed
+     * connections, may be nullptr
      */
     Yamux(MuxedConnectionConfig config,
           std::shared_ptr<basic::Scheduler> scheduler,
-          std::shared_ptr<network::ConnectionManager> cmgr);
+          std::shared_ptr<network::ConnectionManager> cmgr,
+          std::shared_ptr<network::ResourceManager> resource_manager = nullptr);
 
     peer::Protocol getProtocolId() const noexcept override;
 
@@ -36,6 +40,7 @@ namespace libp2p::muxer {
     MuxedConnectionConfig config_;
     std::shared_ptr<basic::Scheduler> scheduler_;
     connection::CapableConnection::ConnectionClosedCallback close_cb_;
+    std::shared_ptr<network::ResourceManager> resource_manager_;
   };
 }  // namespace libp2p::muxer
 
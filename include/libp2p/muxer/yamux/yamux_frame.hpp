@@ -41,6 +41,10 @@ namespace libp2p::connection {
     static constexpr uint8_t kDefaultVersion = 0;
     static constexpr uint32_t kInitialWindowSize = 256 * 1024;
 
+    /// Stream data is written in frames of this size at most, so that other
+    /// streams' frames are not delayed long behind a frame being written
+    static constexpr uint32_t kMaxDataFrameSize = 64 * 1024;
+
     uint8_t version;
     FrameType type;
     uint16_t flags;
@@ -6,6 +6,8 @@
 #ifndef LIBP2P_YAMUX_STREAM_HPP
 #define LIBP2P_YAMUX_STREAM_HPP
 
+#include <chrono>
+
 #include <libp2p/basic/read_buffer.hpp>
 #include <libp2p/basic/write_queue.hpp>
 #include <libp2p/common/metrics/instance_count.hpp>
@@ -20,7 +22,9 @@ namespace libp2p::connection {
    public:
     virtual ~YamuxStreamFeedback() = default;
 
-    /// Stream transfers data to connection
+    /// Stream transfers data to connection, one frame of
+    /// YamuxFrame::kMaxDataFrameSize bytes at most, which is acknowledged
+    /// with YamuxStream::onDataWritten()
     virtual void writeStreamData(uint32_t stream_id,
                                  gsl::span<const uint8_t> data, bool some) = 0;
 
@@ -35,17 +39,49 @@ namespace libp2p::connection {
 
     /// Stream closed, remove from active streams if 2FINs were sent
     virtual void streamClosed(uint32_t stream_id) = 0;
+
+    /// Stream is going to buffer more bytes (receive window growth or
+    /// queued writes), returns error if resource limits don't allow it
+    virtual outcome::result<void> reserveMemory(size_t bytes) = 0;
+
+    /// Stream releases bytes previously reserved
+    virtual void releaseMemory(size_t bytes) = 0;
+
+    /// Stream is going to grow its receive window, returns error if
+    /// connection window budget or resource limits don't allow it
+    virtual outcome::result<void> reserveWindow(size_t bytes) = 0;
+
+    /// Stream shrinks its receive window
+    virtual void releaseWindow(size_t bytes) = 0;
+
+    /// Current time, for receive window tuning
+    virtual std::chrono::milliseconds now() const = 0;
+
+    /// Round trip time measured by pings, zero if not known yet
+    virtual std::chrono::milliseconds rtt() const = 0;
+
+    /// Stream changes its share in connection's outbound bandwidth
+    virtual void setStreamPriority(uint32_t stream_id,
+                                   Stream::Priority priority) = 0;
   };
 
   /// Stream implementation, used by Yamux multiplexer
   class YamuxStream final : public Stream,
                             public std::enable_shared_from_this<YamuxStream> {
    public:
+    /// Receive window grows if its half was consumed faster than in this
+    /// number of round trips
+    static constexpr int kWindowGrowthRtts = 2;
+
+    /// Receive window shrinks back to its minimum size if the stream had
+    /// nothing consumed for this interval
+    static constexpr std::chrono::milliseconds kWindowIdleInterval{10000};
+
     YamuxStream(const YamuxStream &other) = delete;
     YamuxStream &operator=(const YamuxStream &other) = delete;
     YamuxStream(YamuxStream &&other) = delete;
     YamuxStream &operator=(YamuxStream &&other) = delete;
-    ~YamuxStream() override = default;
+    ~YamuxStream() override;
 
     YamuxStream(std::shared_ptr<connection::SecureConnection> connection,
                 YamuxStreamFeedback &feedback, uint32_t stream_id,
@@ -80,6 +116,8 @@ namespace libp2p::connection {
 
     void adjustWindowSize(uint32_t new_size, VoidResultHandlerFunc cb) override;
 
+    void setPriority(Priority priority) override;
+
     outcome::result<peer::PeerId> remotePeerId() const override;
 
     outcome::result<bool> isInitiator() const override;
@@ -114,6 +152,17 @@ namespace libp2p::connection {
     /// Connection closed by network error
     void closedByConnection(std::error_code ec);
 
+    /// Called from Connection, which removes the stream. Memory reserved by
+    /// the stream is returned while the connection is alive, the stream
+    /// makes no more reservations
+    void detachedFromConnection();
+
+    /// Called from Connection periodically and when window budget is short.
+    /// If nothing was consumed for kWindowIdleInterval, the stream starts to
+    /// shrink its receive window to minimum by withholding consumed bytes
+    /// from window updates
+    void shrinkIdleWindow(std::chrono::milliseconds now);
+
    private:
     /// Performs close-related cleanup and notifications
     void doClose(std::error_code ec, bool notify_read_side);
@@ -126,6 +175,14 @@ namespace libp2p::connection {
     [[nodiscard]] std::pair<ReadCallbackFunc, outcome::result<size_t>>
     readCompleted();
 
+    /// Returns bytes consumed by client to peer's send window. Window updates
+    /// are sent when half of the receive window is consumed, the window grows
+    /// if it was consumed fast enough and shrinks after idle period
+    void onBytesConsumed(size_t bytes);
+
+    /// Shrinks receive window and releases reserved bytes
+    void shrinkWindow(size_t bytes);
+
     /// Dequeues data from write queue and sends to the wire in async manner
     void doWrite();
 
@@ -137,6 +194,12 @@ namespace libp2p::connection {
     [[nodiscard]] std::pair<VoidResultHandlerFunc, outcome::result<void>>
     closeCompleted();
 
+    /// Releases memory reserved for written data which left the write queue
+    void releaseWrittenBytes();
+
+    /// Releases all the memory reserved by this stream
+    void releaseAllMemory();
+
     /// Underlying connection (secured)
     std::shared_ptr<connection::SecureConnection> connection_;
 
@@ -170,9 +233,36 @@ namespace libp2p::connection {
     /// Maximum window size allowed for peer
     size_t maximum_window_size_;
 
+    /// Receive window doesn't shrink below this size: initial or adjusted
+    /// by client
+    size_t minimum_window_size_;
+
+    /// Bytes consumed by client, not yet returned to peer by window update
+    size_t unacked_bytes_ = 0;
+
+    /// Time of the last window update, consumption rate is measured from it
+    std::chrono::milliseconds epoch_start_;
+
+    /// Time when client consumed bytes last time
+    std::chrono::milliseconds last_consumed_;
+
+    /// True if idle stream shrinks its receive window, consumed bytes are
+    /// not returned to peer until the window reaches minimum size
+    bool window_shrinking_ = false;
+
     /// Write queue with callbacks
     basic::WriteQueue write_queue_;
 
+    /// Bytes reserved for receive window growth over the initial size,
+    /// counted in connection window budget
+    size_t reserved_window_bytes_ = 0;
+
+    /// Bytes reserved for data in write queue
+    size_t reserved_write_bytes_ = 0;
+
+    /// True after connection removed the stream
+    bool detached_ = false;
+
     /// Internal read buffer, stores bytes received between read()s
     basic::ReadBuffer internal_read_buffer_;
 
@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_YAMUX_WRITE_SCHEDULER_HPP
+#define LIBP2P_YAMUX_WRITE_SCHEDULER_HPP
+
+#include <deque>
+#include <unordered_map>
+
+#include <libp2p/common/types.hpp>
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/muxer/yamux/yamux_frame.hpp>
+
+namespace libp2p::connection {
+
+  /// Outbound frames queue of yamux connection. Control frames (pings,
+  /// window updates, SYN/ACK) are written first, then frames of streams
+  /// are interleaved by deficit round robin weighted by stream priorities
+  class YamuxWriteScheduler {
+   public:
+    using StreamId = YamuxFrame::StreamId;
+    using Buffer = common::ByteArray;
+
+    /// Bytes a stream of priority 1 may write per scheduling round
+    static constexpr size_t kQuantum = 4096;
+
+    struct Item {
+      // TODO(artem): reform in buffers (shared + vector writes)
+
+      Buffer packet;
+
+      /// If not zero, the stream is acknowledged about data written
+      StreamId stream_id;
+
+      /// Packet may be written partially
+      bool some;
+    };
+
+    /// Enqueues control frame
+    void pushControl(Item item);
+
+    /// Enqueues frame of stream, frames of the same stream are written in
+    /// order. If glued, the next frame of the stream is written right after
+    /// this one (i.e. data frame header and payload)
+    void pushStreamFrame(StreamId stream_id, Item item, bool glued = false);
+
+    /// Sets share of the stream in outbound bandwidth
+    void setPriority(StreamId stream_id, Stream::Priority priority);
+
+    /// Forgets stream priority, frames already enqueued will be written
+    void removeStream(StreamId stream_id);
+
+    /// Dequeues the next frame to be written, queue must not be empty
+    Item pop();
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    /// Drops everything
+    void clear();
+
+   private:
+    struct Frame {
+      Item item;
+      bool glued;
+    };
+
+    struct Lane {
+      std::deque<Frame> frames;
+
+      /// Bytes the stream may write in the current round
+      size_t deficit = 0;
+
+      /// True if quantum was added to deficit in the current round
+      bool in_turn = false;
+    };
+
+    /// Takes the front frame of the lane, which is the first active one
+    Item popFrame(StreamId stream_id, Lane &lane);
+
+    /// Control frames
+    std::deque<Item> control_;
+
+    /// Streams' frames
+    std::unordered_map<StreamId, Lane> lanes_;
+
+    /// Streams having frames, round robin order
+    std::deque<StreamId> active_;
+
+    /// Priorities other than default
+    std::unordered_map<StreamId, Stream::Priority> priorities_;
+
+    /// Stream whose frame must be continued, zero if none
+    StreamId glued_ = 0;
+
+    /// Frames enqueued
+    size_t size_ = 0;
+  };
+
+}  // namespace libp2p::connection
+
+#endif  // LIBP2P_YAMUX_WRITE_SCHEDULER_HPP
@@ -15,6 +15,8 @@
 #include <libp2p/muxer/muxed_connection_config.hpp>
 #include <libp2p/muxer/yamux/yamux_reading_state.hpp>
 #include <libp2p/muxer/yamux/yamux_stream.hpp>
+#include <libp2p/muxer/yamux/yamux_write_scheduler.hpp>
+#include <libp2p/network/resource_manager.hpp>
 
 namespace libp2p::connection {
 
@@ -35,18 +37,21 @@ namespace libp2p::connection {
     YamuxedConnection &operator=(const YamuxedConnection &other) = delete;
     YamuxedConnection(YamuxedConnection &&other) = delete;
     YamuxedConnection &operator=(YamuxedConnection &&other) = delete;
-    ~YamuxedConnection() override = default;
+    ~YamuxedConnection() override;
 
     /**
      * Create a new YamuxedConnection instance
      * @param connection to be multiplexed by this instance
      * @param config to configure this instance
-     * @param logger to output messages
+     * @param resource_manager to limit streams and buffered bytes of the
+     * remote peer, may be nullptr
      */
-    explicit YamuxedConnection(std::shared_ptr<SecureConnection> connection,
-                               std::shared_ptr<basic::Scheduler> scheduler,
-                               ConnectionClosedCallback closed_callback,
-                               muxer::MuxedConnectionConfig config = {});
+    explicit YamuxedConnection(
+        std::shared_ptr<SecureConnection> connection,
+        std::shared_ptr<basic::Scheduler> scheduler,
+        ConnectionClosedCallback closed_callback,
+        muxer::MuxedConnectionConfig config = {},
+        std::shared_ptr<network::ResourceManager> resource_manager = nullptr);
 
     void start() override;
 
@@ -86,13 +91,7 @@ namespace libp2p::connection {
 
     using Buffer = common::ByteArray;
 
-    struct WriteQueueItem {
-      // TODO(artem): reform in buffers (shared + vector writes)
-
-      Buffer packet;
-      StreamId stream_id;
-      bool some;
-    };
+    using WriteQueueItem = YamuxWriteScheduler::Item;
 
     // YamuxStreamFeedback interface overrides
 
@@ -111,6 +110,29 @@ namespace libp2p::connection {
 
     void streamClosed(uint32_t stream_id) override;
 
+    /// Reserves memory in remote peer's scope of resource manager
+    outcome::result<void> reserveMemory(size_t bytes) override;
+
+    /// Releases memory in remote peer's scope of resource manager
+    void releaseMemory(size_t bytes) override;
+
+    /// Reserves receive window growth in connection window budget and
+    /// resource manager
+    outcome::result<void> reserveWindow(size_t bytes) override;
+
+    /// Releases receive window growth reserved
+    void releaseWindow(size_t bytes) override;
+
+    /// Returns scheduler's time
+    std::chrono::milliseconds now() const override;
+
+    /// Returns smoothed RTT
+    std::chrono::milliseconds rtt() const override;
+
+    /// Sets stream's weight in write scheduler
+    void setStreamPriority(uint32_t stream_id,
+                           Stream::Priority priority) override;
+
     /// usage of these four methods is highly not recommended or even forbidden:
     /// use stream over this connection instead
     void read(gsl::span<uint8_t> out, size_t bytes,
@@ -154,13 +176,30 @@ namespace libp2p::connection {
     /// Processes incoming WINDOW_UPDATE message
     bool processWindowUpdate(const YamuxFrame &frame);
 
+    /// Sends ping, RTT is measured when the response comes
+    void sendPing();
+
+    /// Updates RTT estimate on ping response
+    void processPong(uint32_t value);
+
+    /// Lets idle streams shrink their receive windows, so that their window
+    /// growth returns to connection window budget
+    void shrinkIdleWindows();
+
     /// Closes everything, notifies streams and handlers
     void close(std::error_code notify_streams_code,
                boost::optional<YamuxFrame::GoAwayError> reply_to_peer_code);
 
-    /// Writes data to underlying connection or (if is_writing_) enqueues them
-    /// If stream_id != 0, stream will be acknowledged about data written
-    void enqueue(Buffer packet, StreamId stream_id = 0, bool some = false);
+    /// Writes control frame to underlying connection or (if is_writing_)
+    /// enqueues it ahead of streams' frames
+    void enqueue(Buffer packet);
+
+    /// Writes frame of stream to underlying connection or (if is_writing_)
+    /// enqueues it in stream's order
+    void enqueue(StreamId stream_id, WriteQueueItem item, bool glued = false);
+
+    /// Starts writing the next frame from write queue, if not writing now
+    void writeNext();
 
     /// Performs write into connection
     void doWrite(WriteQueueItem packet);
@@ -178,6 +217,12 @@ namespace libp2p::connection {
     /// Erases entry from pending streams, may affect incactivity timer
     void erasePendingOutboundStream(PendingOutboundStreams::iterator it);
 
+    /// Reserves a stream in resource manager (if any)
+    outcome::result<void> reserveStream();
+
+    /// Releases streams reserved in resource manager
+    void releaseStreams(size_t count);
+
     /// Sets expire timer if last stream was just closed. Called from erase*()
     /// functions
     void adjustExpireTimer();
@@ -207,7 +252,7 @@ namespace libp2p::connection {
     bool is_writing_ = false;
 
     /// Write queue
-    std::deque<WriteQueueItem> write_queue_;
+    YamuxWriteScheduler write_queue_;
 
     /// Active streams
     Streams streams_;
@@ -228,6 +273,21 @@ namespace libp2p::connection {
     /// Timer handle for pings
     basic::Scheduler::Handle ping_handle_;
 
+    /// Value of the last ping sent
+    uint32_t ping_counter_ = 0;
+
+    /// Time the last ping was sent, none if the response has come
+    boost::optional<std::chrono::milliseconds> ping_sent_at_;
+
+    /// Smoothed round trip time, zero if not measured yet
+    std::chrono::milliseconds rtt_{};
+
+    /// Receive window growth reserved by streams over initial window size
+    size_t window_bytes_reserved_ = 0;
+
+    /// Timer handle for shrinking receive windows of idle streams
+    basic::Scheduler::Handle window_check_handle_;
+
     /// Cleanup for detached streams
     basic::Scheduler::Handle cleanup_handle_;
 
@@ -240,6 +300,10 @@ namespace libp2p::connection {
     /// Remote peer saved here
     peer::PeerId remote_peer_;
 
+    /// Resource manager, optional. Every entry of streams_ and
+    /// pending_outbound_streams_ holds one stream reservation
+    std::shared_ptr<network::ResourceManager> resource_manager_;
+
    public:
     LIBP2P_METRICS_INSTANCE_COUNT_IF_ENABLED(
         libp2p::connection::YamuxedConnection);
@@ -6,7 +6,9 @@
 #ifndef LIBP2P_CONNECTION_MANAGER_HPP
 #define LIBP2P_CONNECTION_MANAGER_HPP
 
+#include <functional>
 #include <memory>
+#include <string>
 
 #include <libp2p/basic/garbage_collectable.hpp>
 #include <libp2p/connection/capable_connection.hpp>
@@ -34,12 +36,22 @@ namespace libp2p::network {
   struct ConnectionManager : public basic::GarbageCollectable {
     using Connection = connection::CapableConnection;
     using ConnectionSPtr = std::shared_ptr<Connection>;
+    using ConnectionVisitor = std::function<void(const ConnectionSPtr &)>;
+    using PeerVisitor = std::function<void(const peer::PeerId &)>;
 
     ~ConnectionManager() override = default;
 
     // get list of all connections (including inbound and outbound)
     virtual std::vector<ConnectionSPtr> getConnections() const = 0;
 
+    // visit all connections without copying them, visitor must not add or
+    // close connections
+    virtual void forEachConnection(const ConnectionVisitor &visitor) const = 0;
+
+    // visit peers having connections, visitor must not add or close
+    // connections
+    virtual void forEachConnectedPeer(const PeerVisitor &visitor) const = 0;
+
     // get list of all inbound or outbound connections to a given peer.
     virtual std::vector<ConnectionSPtr> getConnectionsToPeer(
         const peer::PeerId &p) const = 0;
@@ -55,6 +67,17 @@ namespace libp2p::network {
     // closes all connections (outbound and inbound) to given peer
     virtual void closeConnectionsToPeer(const peer::PeerId &p) = 0;
 
+    // protects connections to given peer from trimming until all the tags
+    // are removed, each subsystem uses its own tag
+    virtual void protectPeer(const peer::PeerId &p, const std::string &tag) = 0;
+
+    // removes protection tag set by protectPeer
+    virtual void unprotectPeer(const peer::PeerId &p,
+                               const std::string &tag) = 0;
+
+    // checks if given peer has protection tags
+    virtual bool isProtected(const peer::PeerId &p) const = 0;
+
     // called from connections when they are closed
     // TODO(artem) connection IDs instead of indexing by sptr
     virtual void onConnectionClosed(
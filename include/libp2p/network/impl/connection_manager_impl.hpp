@@ -6,8 +6,12 @@
 #ifndef LIBP2P_CONNECTION_MANAGER_IMPL_HPP
 #define LIBP2P_CONNECTION_MANAGER_IMPL_HPP
 
-#include <unordered_set>
+#include <chrono>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
+#include <libp2p/basic/scheduler.hpp>
 #include <libp2p/event/bus.hpp>
 #include <libp2p/network/connection_manager.hpp>
 #include <libp2p/network/transport_manager.hpp>
@@ -15,12 +19,67 @@
 
 namespace libp2p::network {
 
+  /// What is known about a connection when choosing the best one to its peer
+  struct ConnectionInfo {
+    std::shared_ptr<connection::CapableConnection> connection;
+    /// When the connection was added to the manager
+    std::chrono::steady_clock::time_point added;
+  };
+
+  /**
+   * Score of a connection, the best connection to a peer has the highest one.
+   * Among connections with equal scores the oldest one is the best
+   */
+  using ConnectionScore = std::function<int64_t(const ConnectionInfo &)>;
+
+  /// Prefers outbound connections over inbound ones
+  int64_t outboundFirst(const ConnectionInfo &info);
+
+  /**
+   * Bounds of total connections count. When the count exceeds the high
+   * watermark, connections are trimmed down to the low watermark
+   */
+  struct ConnectionManagerConfig {
+    /// Trimming starts above this count, 0 disables trimming
+    size_t high_watermark = 0;
+
+    /// Trimming stops at this count
+    size_t low_watermark = 0;
+
+    /// New connections are not trimmed during this period
+    std::chrono::milliseconds grace_period = std::chrono::seconds(20);
+
+    /// How often the count is checked besides adding connections
+    std::chrono::milliseconds check_interval = std::chrono::seconds(10);
+  };
+
   class ConnectionManagerImpl : public ConnectionManager {
    public:
-    explicit ConnectionManagerImpl(std::shared_ptr<libp2p::event::Bus> bus);
+    /**
+     * Ctor.
+     * @param bus event bus
+     * @param scheduler drives trimming, if nullptr then connections are
+     * trimmed only by explicit trimConnections() calls
+     * @param config trimming watermarks
+     */
+    explicit ConnectionManagerImpl(
+        std::shared_ptr<libp2p::event::Bus> bus,
+        std::shared_ptr<basic::Scheduler> scheduler = nullptr,
+        ConnectionManagerConfig config = {});
+
+    /**
+     * Sets how the best connection to a peer is chosen, by default it is the
+     * oldest one. Scores are evaluated when connections to the peer are added
+     * or removed, not on each getBestConnectionForPeer()
+     */
+    void setConnectionScore(ConnectionScore score);
 
     std::vector<ConnectionSPtr> getConnections() const override;
 
+    void forEachConnection(const ConnectionVisitor &visitor) const override;
+
+    void forEachConnectedPeer(const PeerVisitor &visitor) const override;
+
     std::vector<ConnectionSPtr> getConnectionsToPeer(
         const peer::PeerId &p) const override;
 
@@ -33,16 +92,58 @@ namespace libp2p::network {
 
     void closeConnectionsToPeer(const peer::PeerId &p) override;
 
+    void protectPeer(const peer::PeerId &p, const std::string &tag) override;
+
+    void unprotectPeer(const peer::PeerId &p, const std::string &tag) override;
+
+    bool isProtected(const peer::PeerId &p) const override;
+
+    /**
+     * If connections count exceeds the high watermark, closes connections
+     * down to the low watermark. Connections of protected peers and ones in
+     * grace period are not closed. Redundant connections to a peer are closed
+     * first, then ones with the lowest score, then the youngest ones
+     * @return number of connections closed
+     */
+    size_t trimConnections();
+
     void onConnectionClosed(
         const peer::PeerId &peer_id,
         const std::shared_ptr<connection::CapableConnection> &conn) override;
 
    private:
-    std::unordered_map<peer::PeerId, std::unordered_set<ConnectionSPtr>>
-        connections_;
+    struct PeerConnections {
+      std::vector<ConnectionInfo> connections;
+      /// Index of the best connection
+      size_t best = 0;
+    };
+
+    /// Chooses the best connection among non-empty peer's connections
+    void updateBest(PeerConnections &peer) const;
+
+    std::unordered_map<peer::PeerId, PeerConnections> connections_;
+
+    /// Total number of connections to all the peers
+    size_t connections_count_ = 0;
+
+    ConnectionScore score_;
 
     std::shared_ptr<libp2p::event::Bus> bus_;
 
+    std::shared_ptr<basic::Scheduler> scheduler_;
+
+    const ConnectionManagerConfig config_;
+
+    /// Protection tags of peers
+    std::unordered_map<peer::PeerId, std::set<std::string>> protected_;
+
+    /// Periodic trimming
+    basic::Scheduler::Handle trim_handle_;
+
+    /// Trimming deferred after adding a connection above the high watermark
+    basic::Scheduler::Handle trim_now_handle_;
+    bool trim_scheduled_ = false;
+
     /// Reentrancy resolver between closeConnectionsToPeer and
     /// onConnectionClosed
     boost::optional<peer::PeerId> closing_connections_to_peer_;
@@ -9,6 +9,7 @@
 #include <libp2p/connection/capable_connection.hpp>
 #include <libp2p/network/connection_manager.hpp>
 #include <libp2p/network/listener_manager.hpp>
+#include <libp2p/network/resource_manager.hpp>
 #include <libp2p/network/transport_manager.hpp>
 #include <libp2p/peer/address_repository.hpp>
 #include <libp2p/protocol_muxer/protocol_muxer.hpp>
@@ -19,10 +20,15 @@ namespace libp2p::network {
    public:
     ~ListenerManagerImpl() override = default;
 
+    /**
+     * @param resource_manager - limits connections and inbound streams per
+     * protocol, may be nullptr (no limits)
+     */
     ListenerManagerImpl(
         std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect,
         std::shared_ptr<Router> router, std::shared_ptr<TransportManager> tmgr,
-        std::shared_ptr<ConnectionManager> cmgr);
+        std::shared_ptr<ConnectionManager> cmgr,
+        std::shared_ptr<ResourceManager> resource_manager = nullptr);
 
     bool isStarted() const override;
 
@@ -65,6 +71,7 @@ namespace libp2p::network {
     std::shared_ptr<network::Router> router_;
     std::shared_ptr<TransportManager> tmgr_;
     std::shared_ptr<ConnectionManager> cmgr_;
+    std::shared_ptr<ResourceManager> resource_manager_;
   };
 
 }  // namespace libp2p::network
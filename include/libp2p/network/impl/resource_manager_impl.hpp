@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NETWORK_RESOURCE_MANAGER_IMPL_HPP
+#define LIBP2P_NETWORK_RESOURCE_MANAGER_IMPL_HPP
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <libp2p/network/resource_manager.hpp>
+
+namespace libp2p::network {
+
+  /**
+   * Resource manager with fixed budgets. Connections and protocol streams
+   * are tracked by weak pointers and pruned lazily when they are closed: on
+   * reaching a limit or doubling since the last pruning. Muxed streams and
+   * memory are counted by explicit reserve/release calls
+   */
+  class ResourceManagerImpl : public ResourceManager {
+   public:
+    explicit ResourceManagerImpl(ResourceManagerConfig config = {});
+
+    outcome::result<void> addConnection(
+        const peer::PeerId &peer,
+        const std::shared_ptr<connection::CapableConnection> &conn) override;
+
+    outcome::result<void> reserveStream(const peer::PeerId &peer) override;
+
+    void releaseStream(const peer::PeerId &peer) override;
+
+    outcome::result<void> addProtocolStream(
+        const peer::Protocol &protocol,
+        const std::shared_ptr<connection::Stream> &stream) override;
+
+    outcome::result<void> reserveMemory(const peer::PeerId &peer,
+                                        size_t bytes) override;
+
+    void releaseMemory(const peer::PeerId &peer, size_t bytes) override;
+
+    ResourceUsage systemUsage() const override;
+
+    ResourceUsage peerUsage(const peer::PeerId &peer) const override;
+
+   private:
+    /// Tracked connections or streams are not pruned below this number
+    static constexpr size_t kMinPruneSize = 64;
+
+    struct PeerScope {
+      std::vector<std::weak_ptr<connection::CapableConnection>> connections;
+      size_t streams = 0;
+      size_t memory = 0;
+    };
+
+    /// Removes closed connections from the scope and system usage
+    void pruneConnections(PeerScope &scope);
+
+    /// Prunes connections of all the peers, drops empty scopes
+    void pruneAllConnections();
+
+    /// Drops scope of the peer if it has no resources
+    void dropIfEmpty(
+        std::unordered_map<peer::PeerId, PeerScope>::iterator it);
+
+    size_t protocolStreamsLimit(const peer::Protocol &protocol) const;
+
+    struct ProtocolScope {
+      std::vector<std::weak_ptr<connection::Stream>> streams;
+
+      /// Closed streams are pruned when this number is reached
+      size_t prune_at = kMinPruneSize;
+    };
+
+    const ResourceManagerConfig config_;
+
+    mutable std::mutex mutex_;
+    ResourceUsage system_;
+    std::unordered_map<peer::PeerId, PeerScope> peers_;
+    std::unordered_map<peer::Protocol, ProtocolScope> protocols_;
+
+    /// Closed connections of all the peers are pruned when system usage
+    /// reaches this number
+    size_t prune_connections_at_ = kMinPruneSize;
+  };
+
+}  // namespace libp2p::network
+
+#endif  // LIBP2P_NETWORK_RESOURCE_MANAGER_IMPL_HPP
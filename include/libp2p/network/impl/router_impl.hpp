@@ -7,6 +7,7 @@
 #define LIBP2P_ROUTER_IMPL_HPP
 
 #include <tsl/htrie_map.h>
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/network/router.hpp>
 
 namespace libp2p::network {
@@ -24,6 +25,9 @@ namespace libp2p::network {
 
     std::vector<peer::Protocol> getSupportedProtocols() const override;
 
+    std::shared_ptr<const std::vector<peer::ProtocolId>>
+    getSupportedProtocolIds() const override;
+
     void removeProtocolHandlers(const peer::Protocol &protocol) override;
 
     void removeAll() override;
@@ -35,11 +39,21 @@ namespace libp2p::network {
         std::shared_ptr<connection::Stream> stream) override;
 
    private:
+    /// Rebuilds supported_ after handlers update
+    void updateSupportedProtocols();
+
     struct PredicateAndHandler {
       ProtoPredicate predicate;
       ProtoHandler handler;
+
+      /// Inbound streams of the protocol, resolved on registration
+      metrics::Counter *streams;
     };
     tsl::htrie_map<char, PredicateAndHandler> proto_handlers_;
+
+    /// Keys of proto_handlers_, interned, in the trie order
+    std::shared_ptr<const std::vector<peer::ProtocolId>> supported_ =
+        std::make_shared<std::vector<peer::ProtocolId>>();
   };
 
 }  // namespace libp2p::network
@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_NETWORK_RESOURCE_MANAGER_HPP
+#define LIBP2P_NETWORK_RESOURCE_MANAGER_HPP
+
+#include <limits>
+#include <map>
+#include <memory>
+
+#include <libp2p/connection/capable_connection.hpp>
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/outcome/outcome.hpp>
+#include <libp2p/peer/peer_id.hpp>
+#include <libp2p/peer/protocol.hpp>
+
+namespace libp2p::network {
+
+  /// Limit value, which means no limit
+  constexpr size_t kUnlimited = std::numeric_limits<size_t>::max();
+
+  /// Limits of one resource scope
+  struct ResourceLimits {
+    /// Open connections
+    size_t connections = kUnlimited;
+    /// Open muxed streams
+    size_t streams = kUnlimited;
+    /// Bytes which may be buffered: receive windows above the initial
+    /// one and outgoing data queued in streams
+    size_t memory = kUnlimited;
+  };
+
+  /**
+   * Budgets of resource scopes: the whole system, each peer, each protocol.
+   * Nothing is limited by default, e.g. system {1024, 16384, 1GiB} and peer
+   * {16, 2048, 128MiB} suit a node with moderate resources.
+   * @note muxed streams and buffered memory are accounted by Yamux only,
+   * Mplex streams are limited per protocol (inbound) only
+   */
+  struct ResourceManagerConfig {
+    ResourceLimits system;
+
+    ResourceLimits peer;
+
+    /// Default limit of inbound streams per protocol
+    size_t protocol_streams = kUnlimited;
+
+    /// Per protocol overrides of protocol_streams
+    std::map<peer::Protocol, size_t> protocol_streams_overrides;
+  };
+
+  /// Resources in use by a scope
+  struct ResourceUsage {
+    size_t connections = 0;
+    size_t streams = 0;
+    size_t memory = 0;
+  };
+
+  /**
+   * @brief Enforces scoped budgets on connections, streams and buffered
+   * memory. Components ask the manager before allocating a resource and
+   * reject the peer's request (or the local operation) when the budget is
+   * exhausted
+   */
+  class ResourceManager {
+   public:
+    enum class Error {
+      SYSTEM_LIMIT_EXCEEDED = 1,
+      PEER_LIMIT_EXCEEDED,
+      PROTOCOL_LIMIT_EXCEEDED,
+    };
+
+    virtual ~ResourceManager() = default;
+
+    /**
+     * Accounts a new connection. The connection is accounted until it is
+     * closed or destroyed, no release is needed
+     * @return error if system or peer limit is exceeded
+     */
+    virtual outcome::result<void> addConnection(
+        const peer::PeerId &peer,
+        const std::shared_ptr<connection::CapableConnection> &conn) = 0;
+
+    /**
+     * Reserves a muxed stream, each successful call must be paired with
+     * releaseStream()
+     */
+    virtual outcome::result<void> reserveStream(const peer::PeerId &peer) = 0;
+
+    virtual void releaseStream(const peer::PeerId &peer) = 0;
+
+    /**
+     * Accounts an inbound stream of the negotiated protocol until the stream
+     * is closed or destroyed
+     */
+    virtual outcome::result<void> addProtocolStream(
+        const peer::Protocol &protocol,
+        const std::shared_ptr<connection::Stream> &stream) = 0;
+
+    /**
+     * Reserves memory for buffering data of the peer, each successful call
+     * must be paired with releaseMemory() of the same size
+     */
+    virtual outcome::result<void> reserveMemory(const peer::PeerId &peer,
+                                                size_t bytes) = 0;
+
+    virtual void releaseMemory(const peer::PeerId &peer, size_t bytes) = 0;
+
+    /// Resources used by the whole system
+    virtual ResourceUsage systemUsage() const = 0;
+
+    /// Resources used by the peer
+    virtual ResourceUsage peerUsage(const peer::PeerId &peer) const = 0;
+  };
+
+}  // namespace libp2p::network
+
+OUTCOME_HPP_DECLARE_ERROR(libp2p::network, ResourceManager::Error);
+
+#endif  // LIBP2P_NETWORK_RESOURCE_MANAGER_HPP
@@ -11,6 +11,7 @@
 
 #include <libp2p/connection/stream.hpp>
 #include <libp2p/event/bus.hpp>
+#include <libp2p/peer/interned_protocol.hpp>
 #include <libp2p/peer/protocol.hpp>
 #include <libp2p/outcome/outcome.hpp>
 
@@ -71,6 +72,15 @@ namespace libp2p::network {
      */
     virtual std::vector<peer::Protocol> getSupportedProtocols() const = 0;
 
+    /**
+     * Get handled protocols, interned
+     * @return snapshot of supported protocols, the same as
+     * getSupportedProtocols() returns; it is not changed by further
+     * handlers updates
+     */
+    virtual std::shared_ptr<const std::vector<peer::ProtocolId>>
+    getSupportedProtocolIds() const = 0;
+
     /**
      * Remove handlers, associated with the given protocol prefix
      * @param protocol prefix, for which the handlers are to be removed
@@ -146,6 +146,19 @@ namespace libp2p::peer {
      */
     virtual std::unordered_set<PeerId> getPeers() const = 0;
 
+    /**
+     * @brief Calls {@param visitor} for each peer known by this repository,
+     * without collecting them into a set. Visitor must not modify the
+     * repository.
+     */
+    virtual void forEachPeer(
+        const std::function<PeerVisitor> &visitor) const = 0;
+
+    /**
+     * @brief Checks if peer {@param p} is known by this repository.
+     */
+    virtual bool hasPeer(const PeerId &p) const = 0;
+
     /**
      * @brief Attach slot to a signal 'onAddressAdded'. Is triggered whenever
      * any peer adds new address.
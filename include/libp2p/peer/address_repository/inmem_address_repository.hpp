@@ -24,7 +24,9 @@ namespace libp2p::peer {
   using Clock = std::chrono::steady_clock;
 
   /**
-   * @brief IN-memory implementation of Address repository.
+   * @brief IN-memory implementation of Address repository. Expiration times
+   * of addresses are indexed by min-heap, so that garbage collection touches
+   * expired addresses only.
    */
   class InmemAddressRepository
       : public AddressRepository,
@@ -54,22 +56,61 @@ namespace libp2p::peer {
 
     void collectGarbage() override;
 
+    bool collectSomeGarbage(size_t budget) override;
+
     void clear(const PeerId &p) override;
 
     std::unordered_set<PeerId> getPeers() const override;
 
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
+    bool hasPeer(const PeerId &p) const override;
+
    private:
     using ttlmap = std::unordered_map<multi::Multiaddress, Clock::time_point>;
     using ttlmap_ptr = std::shared_ptr<ttlmap>;
     using peer_db = std::unordered_map<PeerId, ttlmap_ptr>;
 
+    /// Expiration index entry, outdated if address expiration time was
+    /// changed after the entry was made
+    struct Expiry {
+      Clock::time_point expires_at;
+      PeerId peer;
+      multi::Multiaddress address;
+    };
+
+    struct ExpiresLater {
+      bool operator()(const Expiry &a, const Expiry &b) const {
+        return a.expires_at > b.expires_at;
+      }
+    };
+
     bool isNewDnsAddr(const multi::Multiaddress &ma);
 
     peer_db::iterator findOrInsert(const PeerId &p);
 
+    /// Sets expiration time of the address and indexes it
+    void setExpiry(const PeerId &p, ttlmap::iterator it,
+                   Clock::time_point expires_at);
+
+    /// Removes the address if index entry is not outdated
+    void expire(const Expiry &expiry);
+
+    /// Rebuilds index if there are too many outdated entries
+    void compactIndex();
+
     std::shared_ptr<network::DnsaddrResolver> dnsaddr_resolver_;
     peer_db db_;
     std::set<multi::Multiaddress> resolved_dns_addrs_;
+
+    /// Min-heap of expiration times
+    std::vector<Expiry> expiry_index_;
+
+    /// Number of addresses in db_
+    size_t addresses_count_ = 0;
+
+    /// Peers which may have no addresses left, they are evicted by GC
+    std::vector<PeerId> maybe_empty_;
   };
 
 }  // namespace libp2p::peer
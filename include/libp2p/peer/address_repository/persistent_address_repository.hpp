@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PERSISTENT_ADDRESS_REPOSITORY_HPP
+#define LIBP2P_PERSISTENT_ADDRESS_REPOSITORY_HPP
+
+#include <libp2p/peer/address_repository.hpp>
+
+#include <memory>
+#include <unordered_set>
+
+#include <libp2p/peer/impl/peerstore_db.hpp>
+
+namespace libp2p::peer {
+
+  /**
+   * @brief Address repository, which survives restarts. Addresses are kept in
+   * the in-memory cache repository and written behind to peerstore db
+   * together with their expiration times. Addresses are read at construction
+   * or, if PeerstoreDb::Config::preload is off, on the first access to the
+   * peer. Loading doesn't emit onAddressAdded. Expired addresses are neither
+   * loaded nor kept in db longer than a garbage collection pass.
+   *
+   * @note addresses resolved by bootstrap() are not persisted
+   */
+  class PersistentAddressRepository : public AddressRepository {
+   public:
+    PersistentAddressRepository(std::shared_ptr<AddressRepository> cache,
+                                std::shared_ptr<PeerstoreDb> db);
+
+    ~PersistentAddressRepository() override = default;
+
+    void bootstrap(const multi::Multiaddress &ma,
+                   std::function<BootstrapCallback> cb) override;
+
+    outcome::result<bool> addAddresses(const PeerId &p,
+                                       gsl::span<const multi::Multiaddress> ma,
+                                       Milliseconds ttl) override;
+
+    outcome::result<bool> upsertAddresses(
+        const PeerId &p, gsl::span<const multi::Multiaddress> ma,
+        Milliseconds ttl) override;
+
+    outcome::result<void> updateAddresses(const PeerId &p,
+                                          Milliseconds ttl) override;
+
+    outcome::result<std::vector<multi::Multiaddress>> getAddresses(
+        const PeerId &p) const override;
+
+    void collectGarbage() override;
+
+    /// Also removes expired addresses from db and forgets peers evicted
+    /// from cache, when cache collection is finished
+    bool collectSomeGarbage(size_t budget) override;
+
+    void clear(const PeerId &p) override;
+
+    std::unordered_set<PeerId> getPeers() const override;
+
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
+    bool hasPeer(const PeerId &p) const override;
+
+   private:
+    using StatementHandle = storage::SQLite::StatementHandle;
+
+    /// Loads all the addresses into cache, after that cache is the source of
+    /// truth
+    void preload();
+
+    /// Loads peer's addresses into cache on the first access, after that
+    /// cache is the source of truth for the peer
+    void load(const PeerId &p) const;
+
+    /// Puts address read from db into cache
+    void loadAddress(const PeerId &p,
+                     gsl::span<const uint8_t> address,
+                     PeerstoreDb::Timestamp expires_at) const;
+
+    std::shared_ptr<AddressRepository> cache_;
+    std::shared_ptr<PeerstoreDb> db_;
+
+    /// All the addresses were loaded at construction
+    bool preloaded_ = false;
+
+    /// Peers, whose addresses were loaded
+    mutable std::unordered_set<PeerId> loaded_;
+
+    /// Addresses are being loaded into cache, its signals are not forwarded
+    mutable bool loading_ = false;
+
+    StatementHandle select_all_;
+    StatementHandle select_addresses_;
+    StatementHandle select_peers_;
+    StatementHandle select_peer_;
+    StatementHandle insert_;
+    StatementHandle upsert_;
+    StatementHandle update_;
+    StatementHandle delete_peer_;
+    StatementHandle delete_expired_;
+
+    boost::signals2::scoped_connection on_added_;
+    boost::signals2::scoped_connection on_removed_;
+  };
+
+}  // namespace libp2p::peer
+
+#endif  // LIBP2P_PERSISTENT_ADDRESS_REPOSITORY_HPP
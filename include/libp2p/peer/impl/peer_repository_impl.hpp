@@ -24,6 +24,8 @@ namespace libp2p::peer {
 
     std::unordered_set<PeerId> getPeers() const override;
 
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
     PeerInfo getPeerInfo(const PeerId &peer_id) const override;
 
    private:
@@ -0,0 +1,117 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PEER_PEERSTORE_DB_HPP
+#define LIBP2P_PEER_PEERSTORE_DB_HPP
+
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include <libp2p/basic/scheduler.hpp>
+#include <libp2p/storage/sqlite.hpp>
+
+namespace libp2p::peer {
+
+  /**
+   * SQLite database shared by persistent peer repositories. Repositories
+   * keep their data in memory and journal changes here, journal is written
+   * behind in batches, each batch is one transaction. Database is switched
+   * to WAL mode, so that commits don't rewrite the main file.
+   *
+   * Schema of all the repositories is created here: keys and protocols of
+   * peers, which have no addresses left, are collected by their
+   * repositories
+   */
+  class PeerstoreDb {
+   public:
+    /// Milliseconds since system clock epoch, expiration times are stored so
+    /// to survive restarts
+    using Timestamp = sqlite3_int64;
+
+    /// Expiration time of permanent records
+    static constexpr Timestamp kNever = std::numeric_limits<Timestamp>::max();
+
+    /// Journaled write, executes prepared statements
+    using Write = std::function<void(storage::SQLite &)>;
+
+    struct Config {
+      /// Max delay of a journaled write
+      std::chrono::milliseconds flush_interval = std::chrono::seconds(1);
+
+      /// Journal is written at once when it grows to this size
+      size_t max_batch = 1024;
+
+      /// Repositories read all the records at construction, one query per
+      /// table. Otherwise records of a peer are read on its first access,
+      /// which is a synchronous query on the calling thread
+      bool preload = true;
+
+      /// Wall clock, source of Timestamp
+      std::function<Timestamp()> clock = [] {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+      };
+    };
+
+    PeerstoreDb(std::shared_ptr<storage::SQLite> db,
+                std::shared_ptr<basic::Scheduler> scheduler, Config config);
+
+    PeerstoreDb(const PeerstoreDb &) = delete;
+    PeerstoreDb &operator=(const PeerstoreDb &) = delete;
+
+    /// Writes what is left in journal
+    ~PeerstoreDb();
+
+    /// Database for prepared statements and reads
+    storage::SQLite &db() {
+      return *db_;
+    }
+
+    const Config &config() const {
+      return config_;
+    }
+
+    /// Journals write, it is executed on the next flush
+    void enqueue(Write write);
+
+    /// Writes journal in one transaction
+    void flush();
+
+    /// Number of writes waiting in journal
+    size_t pending() const {
+      return journal_.size();
+    }
+
+    Timestamp now() const {
+      return config_.clock();
+    }
+
+    /// Expiration time for ttl, saturates at kNever
+    Timestamp expiresAt(std::chrono::milliseconds ttl) const;
+
+    /// Time left to expiration, milliseconds::max() for kNever
+    std::chrono::milliseconds ttl(Timestamp expires_at) const;
+
+   private:
+    std::shared_ptr<storage::SQLite> db_;
+    std::shared_ptr<basic::Scheduler> scheduler_;
+    const Config config_;
+
+    storage::SQLite::StatementHandle begin_;
+    storage::SQLite::StatementHandle commit_;
+
+    std::vector<Write> journal_;
+
+    /// Timer of the next flush, armed while journal is not empty
+    basic::Scheduler::Handle flush_handle_;
+    bool flush_scheduled_ = false;
+  };
+
+}  // namespace libp2p::peer
+
+#endif  // LIBP2P_PEER_PEERSTORE_DB_HPP
@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PEER_INTERNED_PROTOCOL_HPP
+#define LIBP2P_PEER_INTERNED_PROTOCOL_HPP
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <gsl/span>
+#include <libp2p/peer/protocol.hpp>
+
+namespace libp2p::peer {
+
+  /**
+   * Protocol name, interned in process-wide registry, together with its
+   * multistream-select encoding. There is only one instance per name while
+   * it is referenced, so that protocols may be compared by pointer and
+   * negotiated without string allocations or re-encoding
+   */
+  class InternedProtocol {
+   public:
+    InternedProtocol(const InternedProtocol &) = delete;
+    InternedProtocol &operator=(const InternedProtocol &) = delete;
+
+    const Protocol &name() const {
+      return name_;
+    }
+
+    /// Varint length prefix, name and newline. Empty if the name exceeds
+    /// multistream message size limit
+    gsl::span<const uint8_t> multistreamLine() const {
+      return gsl::span<const uint8_t>(encoded_).subspan(header_size_);
+    }
+
+    /// Multistream header line followed by multistreamLine(), i.e. the
+    /// proposal on a fresh stream. Empty if the name is too long
+    gsl::span<const uint8_t> multistreamProposal() const {
+      return encoded_;
+    }
+
+   private:
+    friend std::shared_ptr<const InternedProtocol> internProtocol(
+        std::string_view name);
+
+    explicit InternedProtocol(std::string_view name);
+
+    Protocol name_;
+    std::vector<uint8_t> encoded_;
+    size_t header_size_ = 0;
+  };
+
+  /// Stable id of protocol
+  using ProtocolId = std::shared_ptr<const InternedProtocol>;
+
+  /**
+   * Returns interned protocol for the name, creates it on the first use.
+   * Unreferenced protocols are removed from the registry. Thread-safe
+   */
+  ProtocolId internProtocol(std::string_view name);
+
+  /// Orders protocol ids by name, also compares them with names
+  struct ProtocolIdLess {
+    using is_transparent = void;
+
+    bool operator()(const ProtocolId &a, const ProtocolId &b) const {
+      return a->name() < b->name();
+    }
+
+    bool operator()(const ProtocolId &a, std::string_view b) const {
+      return a->name() < b;
+    }
+
+    bool operator()(std::string_view a, const ProtocolId &b) const {
+      return a < b->name();
+    }
+  };
+
+}  // namespace libp2p::peer
+
+#endif  // LIBP2P_PEER_INTERNED_PROTOCOL_HPP
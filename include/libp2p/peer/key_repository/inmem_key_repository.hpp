@@ -32,6 +32,10 @@ namespace libp2p::peer {
 
     std::unordered_set<PeerId> getPeers() const override;
 
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
+    bool hasPeer(const PeerId &p) const override;
+
    private:
     std::unordered_map<PeerId, PubVecPtr> pub_;
     KeyPairVecPtr kp_;
@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PERSISTENT_KEY_REPOSITORY_HPP
+#define LIBP2P_PERSISTENT_KEY_REPOSITORY_HPP
+
+#include <libp2p/peer/key_repository.hpp>
+
+#include <memory>
+#include <unordered_set>
+
+#include <libp2p/basic/garbage_collectable.hpp>
+#include <libp2p/peer/impl/peerstore_db.hpp>
+
+namespace libp2p::peer {
+
+  /**
+   * @brief Key repository, which survives restarts. Public keys of peers are
+   * kept in the in-memory cache repository and written behind to peerstore
+   * db, they are loaded at construction or, if PeerstoreDb::Config::preload
+   * is off, on the first access to the peer. Keys of peers, which have no
+   * addresses in db, are removed by garbage collection.
+   *
+   * @note key pairs of this peer are never persisted
+   */
+  class PersistentKeyRepository : public KeyRepository,
+                                  public basic::GarbageCollectable {
+   public:
+    PersistentKeyRepository(std::shared_ptr<KeyRepository> cache,
+                            std::shared_ptr<PeerstoreDb> db);
+
+    ~PersistentKeyRepository() override = default;
+
+    void clear(const PeerId &p) override;
+
+    outcome::result<PubVecPtr> getPublicKeys(const PeerId &p) override;
+
+    outcome::result<void> addPublicKey(const PeerId &p,
+                                       const crypto::PublicKey &pub) override;
+
+    outcome::result<KeyPairVecPtr> getKeyPairs() override;
+
+    outcome::result<void> addKeyPair(const KeyPair &kp) override;
+
+    std::unordered_set<PeerId> getPeers() const override;
+
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
+    bool hasPeer(const PeerId &p) const override;
+
+    /// Removes keys of peers without addresses from db and cache
+    void collectGarbage() override;
+
+   private:
+    using StatementHandle = storage::SQLite::StatementHandle;
+
+    /// Loads all the keys into cache, after that cache is the source of truth
+    void preload();
+
+    /// Loads peer's keys into cache on the first access
+    void load(const PeerId &p);
+
+    /// Puts key read from db into cache
+    void loadKey(const PeerId &p, int type, std::vector<uint8_t> data);
+
+    std::shared_ptr<KeyRepository> cache_;
+    std::shared_ptr<PeerstoreDb> db_;
+
+    /// All the keys were loaded at construction
+    bool preloaded_ = false;
+
+    /// Peers, whose keys were loaded
+    std::unordered_set<PeerId> loaded_;
+
+    StatementHandle select_all_;
+    StatementHandle select_keys_;
+    StatementHandle select_peers_;
+    StatementHandle select_peer_;
+    StatementHandle insert_;
+    StatementHandle delete_peer_;
+    StatementHandle delete_orphans_;
+  };
+
+}  // namespace libp2p::peer
+
+#endif  // LIBP2P_PERSISTENT_KEY_REPOSITORY_HPP
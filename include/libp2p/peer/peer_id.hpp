@@ -6,6 +6,9 @@
 #ifndef LIBP2P_PEER_ID_HPP
 #define LIBP2P_PEER_ID_HPP
 
+#include <memory>
+#include <string>
+
 #include <libp2p/crypto/key.hpp>
 #include <libp2p/crypto/protobuf/protobuf_key.hpp>
 #include <libp2p/multi/multihash.hpp>
@@ -21,10 +24,12 @@ namespace libp2p::peer {
     using FactoryResult = outcome::result<PeerId>;
 
    public:
-    PeerId(const PeerId &other) = default;
-    PeerId &operator=(const PeerId &other) = default;
-    PeerId(PeerId &&other) noexcept = default;
-    PeerId &operator=(PeerId &&other) noexcept = default;
+    // the cached base58 form may be set by a concurrent toBase58() of the
+    // source, so it is copied atomically
+    PeerId(const PeerId &other);
+    PeerId &operator=(const PeerId &other);
+    PeerId(PeerId &&other) noexcept;
+    PeerId &operator=(PeerId &&other) noexcept;
     ~PeerId() = default;
 
     enum class FactoryError { SUCCESS = 0, SHA256_EXPECTED = 1 };
@@ -59,7 +64,8 @@ namespace libp2p::peer {
     static FactoryResult fromHash(const multi::Multihash &hash);
 
     /**
-     * Get a base58 (not Multibase58!) representation of this PeerId
+     * Get a base58 (not Multibase58!) representation of this PeerId. It is
+     * encoded once and shared by copies of this PeerId
      * @return base58-encoded SHA256 multihash of the peer's ID
      */
     std::string toBase58() const;
@@ -96,8 +102,14 @@ namespace libp2p::peer {
     explicit PeerId(multi::Multihash hash);
 
     multi::Multihash hash_;
+
+    /// Cached base58 form, set once, accessed atomically
+    mutable std::shared_ptr<const std::string> base58_;
   };
 
+  /// Callback of iteration over known peers
+  using PeerVisitor = void(const PeerId &);
+
 }  // namespace libp2p::peer
 
 namespace std {
@@ -46,6 +46,14 @@ namespace libp2p::peer {
      */
     virtual std::unordered_set<PeerId> getPeers() const = 0;
 
+    /**
+     * @brief Calls {@param visitor} once for each peer known by this peer
+     * repository, without collecting them into a set. Visitor must not modify
+     * the repository.
+     */
+    virtual void forEachPeer(
+        const std::function<PeerVisitor> &visitor) const = 0;
+
     /**
      * @brief Derive a PeerInfo object from the PeerId; can be useful, for
      * example, to establish connections, when only a PeerId is known at the
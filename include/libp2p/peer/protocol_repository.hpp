@@ -6,6 +6,7 @@
 #ifndef LIBP2P_PROTOCOL_REPOSITORY_HPP
 #define LIBP2P_PROTOCOL_REPOSITORY_HPP
 
+#include <functional>
 #include <set>
 #include <unordered_set>
 #include <vector>
@@ -77,6 +78,19 @@ namespace libp2p::peer {
      * @return unordered set of peers
      */
     virtual std::unordered_set<PeerId> getPeers() const = 0;
+
+    /**
+     * @brief Calls {@param visitor} for each peer known by this repository,
+     * without collecting them into a set. Visitor must not modify the
+     * repository.
+     */
+    virtual void forEachPeer(
+        const std::function<PeerVisitor> &visitor) const = 0;
+
+    /**
+     * @brief Checks if peer {@param p} is known by this repository.
+     */
+    virtual bool hasPeer(const PeerId &p) const = 0;
   };
 
 }  // namespace libp2p::peer
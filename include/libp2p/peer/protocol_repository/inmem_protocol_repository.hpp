@@ -9,13 +9,15 @@
 #include <set>
 #include <unordered_map>
 
+#include <libp2p/peer/interned_protocol.hpp>
 #include <libp2p/peer/protocol_repository.hpp>
 
 namespace libp2p::peer {
 
   /**
    * @brief In-memory implementation of Protocol repository. For each peer
-   * stores ordered set of protocols.
+   * stores ordered set of protocols. Protocols are interned, so peers
+   * supporting the same protocols share their names.
    */
   class InmemProtocolRepository : public ProtocolRepository {
    public:
@@ -37,16 +39,25 @@ namespace libp2p::peer {
 
     void collectGarbage() override;
 
+    bool collectSomeGarbage(size_t budget) override;
+
     std::unordered_set<PeerId> getPeers() const override;
 
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
+    bool hasPeer(const PeerId &p) const override;
+
    private:
-    using set = std::set<Protocol>;
+    using set = std::set<ProtocolId, ProtocolIdLess>;
     using set_ptr = std::shared_ptr<set>;
 
     outcome::result<set_ptr> getProtocolSet(const PeerId &p) const;
     set_ptr getOrAllocateProtocolSet(const PeerId &p);
 
     std::unordered_map<PeerId, set_ptr> db_;
+
+    /// Peers which may have no protocols left, they are evicted by GC
+    std::vector<PeerId> maybe_empty_;
   };
 
 }  // namespace libp2p::peer
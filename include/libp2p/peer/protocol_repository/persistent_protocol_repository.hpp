@@ -0,0 +1,95 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PERSISTENT_PROTOCOL_REPOSITORY_HPP
+#define LIBP2P_PERSISTENT_PROTOCOL_REPOSITORY_HPP
+
+#include <libp2p/peer/protocol_repository.hpp>
+
+#include <memory>
+#include <unordered_set>
+
+#include <libp2p/peer/impl/peerstore_db.hpp>
+
+namespace libp2p::peer {
+
+  /**
+   * @brief Protocol repository, which survives restarts. Protocols are kept
+   * in the in-memory cache repository and written behind to peerstore db,
+   * they are loaded at construction or, if PeerstoreDb::Config::preload is
+   * off, on the first access to the peer. Protocols of peers, which have no
+   * addresses in db, are removed by garbage collection.
+   */
+  class PersistentProtocolRepository : public ProtocolRepository {
+   public:
+    PersistentProtocolRepository(std::shared_ptr<ProtocolRepository> cache,
+                                 std::shared_ptr<PeerstoreDb> db);
+
+    ~PersistentProtocolRepository() override = default;
+
+    outcome::result<void> addProtocols(const PeerId &p,
+                                       gsl::span<const Protocol> ms) override;
+
+    outcome::result<void> removeProtocols(
+        const PeerId &p, gsl::span<const Protocol> ms) override;
+
+    outcome::result<std::vector<Protocol>> getProtocols(
+        const PeerId &p) const override;
+
+    outcome::result<std::vector<Protocol>> supportsProtocols(
+        const PeerId &p, const std::set<Protocol> &protocols) const override;
+
+    void clear(const PeerId &p) override;
+
+    void collectGarbage() override;
+
+    /// Removes protocols of peers without addresses from db and cache at the
+    /// start of collection, forgets peers evicted from cache at its end
+    bool collectSomeGarbage(size_t budget) override;
+
+    std::unordered_set<PeerId> getPeers() const override;
+
+    void forEachPeer(const std::function<PeerVisitor> &visitor) const override;
+
+    bool hasPeer(const PeerId &p) const override;
+
+   private:
+    using StatementHandle = storage::SQLite::StatementHandle;
+
+    /// Removes protocols of peers, which have no addresses in db
+    void collectOrphans();
+
+    /// Loads all the protocols into cache, after that cache is the source of
+    /// truth
+    void preload();
+
+    /// Loads peer's protocols into cache on the first access
+    void load(const PeerId &p) const;
+
+    std::shared_ptr<ProtocolRepository> cache_;
+    std::shared_ptr<PeerstoreDb> db_;
+
+    /// All the protocols were loaded at construction
+    bool preloaded_ = false;
+
+    /// Orphans were collected in the current collection
+    bool orphans_collected_ = false;
+
+    /// Peers, whose protocols were loaded
+    mutable std::unordered_set<PeerId> loaded_;
+
+    StatementHandle select_all_;
+    StatementHandle select_protocols_;
+    StatementHandle select_peers_;
+    StatementHandle select_peer_;
+    StatementHandle insert_;
+    StatementHandle delete_;
+    StatementHandle delete_peer_;
+    StatementHandle delete_orphans_;
+  };
+
+}  // namespace libp2p::peer
+
+#endif  // LIBP2P_PERSISTENT_PROTOCOL_REPOSITORY_HPP
@@ -57,19 +57,7 @@ namespace libp2p::protocol {
         }
       }
 
-      inside_publish_ = false;
-
-      // maybe someone unsubscribed inside callbacks
-      for (auto &ticket : being_canceled_) {
-        subscriptions_.erase(ticket);
-      }
-      being_canceled_.clear();
-
-      // and maybe someone subscribed inside callbacks
-      for (auto& [ticket, cb] : being_subscribed_) {
-        subscriptions_[ticket] = std::move(cb);
-      }
-      being_subscribed_.clear();
+      endPublish();
     }
 
    protected:
@@ -80,6 +68,28 @@ namespace libp2p::protocol {
     /// Used by derived classes to make filters
     uint64_t lastTicket() { return last_ticket_; }
 
+    /// Forwards data to the given tickets only, without calling filter().
+    /// For derived classes which index tickets by themselves
+    template <typename Tickets>
+    void publishTo(const Tickets &tickets, Args... args) {
+      if (empty()) {
+        return;
+      }
+
+      inside_publish_ = true;
+
+      for (auto ticket : tickets) {
+        if (being_canceled_.count(ticket) == 0) {
+          auto it = subscriptions_.find(ticket);
+          if (it != subscriptions_.end()) {
+            it->second(args...);
+          }
+        }
+      }
+
+      endPublish();
+    }
+
     void unsubscribe(uint64_t ticket) override {
       if (inside_publish_) {
         being_canceled_.emplace(ticket);
@@ -90,6 +100,22 @@ namespace libp2p::protocol {
 
    private:
 
+    void endPublish() {
+      inside_publish_ = false;
+
+      // maybe someone unsubscribed inside callbacks
+      for (auto &ticket : being_canceled_) {
+        subscriptions_.erase(ticket);
+      }
+      being_canceled_.clear();
+
+      // and maybe someone subscribed inside callbacks
+      for (auto& [ticket, cb] : being_subscribed_) {
+        subscriptions_[ticket] = std::move(cb);
+      }
+      being_subscribed_.clear();
+    }
+
     uint64_t last_ticket_ = 0;
     std::unordered_map<uint64_t, Callback> subscriptions_;
     std::unordered_map<uint64_t, Callback> being_subscribed_;
@@ -8,6 +8,7 @@
 
 #include <vector>
 
+#include <libp2p/basic/coroutine.hpp>
 #include <libp2p/connection/stream.hpp>
 #include <libp2p/log/logger.hpp>
 #include <libp2p/protocol/echo/echo_config.hpp>
@@ -15,10 +16,17 @@
 namespace libp2p::protocol {
 
   /**
-   * @brief Echo session created by server.
+   * @brief Echo session created by server. Reads the stream and writes the
+   * data back from the same buffer, as a coroutine.
+   *
+   * Unlike the former callback version, which wrote a copy of each message
+   * while already reading the next one, the next read starts after the write
+   * completes: a peer, which does not read echoed data, cannot make the
+   * session queue unbounded copies of it
    */
   class ServerEchoSession
-      : public std::enable_shared_from_this<ServerEchoSession> {
+      : public std::enable_shared_from_this<ServerEchoSession>,
+        public basic::Coroutine<ServerEchoSession> {
    public:
     explicit ServerEchoSession(std::shared_ptr<connection::Stream> stream,
                                EchoConfig config = {});
@@ -30,20 +38,19 @@ namespace libp2p::protocol {
     void stop();
 
    private:
+    friend class basic::Coroutine<ServerEchoSession>;
+
+    /// Session body, continues after each read or write completion
+    void resume(outcome::result<size_t> res);
+
+    bool canRead() const;
+
     std::shared_ptr<connection::Stream> stream_;
     std::vector<uint8_t> buf_;
     EchoConfig config_;
     log::Logger log_ = log::createLogger("ServerEchoSession");
 
     bool repeat_infinitely_;
-
-    void doRead();
-
-    void onRead(outcome::result<size_t> rread);
-
-    void doWrite(size_t size);
-
-    void onWrite(outcome::result<size_t> rwrite);
   };
 
 }  // namespace libp2p::protocol
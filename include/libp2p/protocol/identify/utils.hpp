@@ -13,16 +13,28 @@
 
 #include <libp2p/connection/stream.hpp>
 #include <libp2p/host/host.hpp>
+#include <libp2p/log/lazy.hpp>
 #include <libp2p/network/connection_manager.hpp>
 #include <libp2p/peer/protocol.hpp>
 
 namespace libp2p::protocol::detail {
   /**
-   * Get a tuple of stringified <PeerId, Multiaddress> of the peer the (\param
-   * stream) is connected to
+   * Get a tuple of <PeerId, Multiaddress> of the peer the (\param stream) is
+   * connected to, which are stringified lazily, only when written to log
    */
-  std::tuple<std::string, std::string> getPeerIdentity(
-      const std::shared_ptr<libp2p::connection::Stream> &stream);
+  inline auto getPeerIdentity(
+      const std::shared_ptr<libp2p::connection::Stream> &stream) {
+    auto id = log::lazy([stream] {
+      auto id_res = stream->remotePeerId();
+      return id_res ? id_res.value().toBase58() : std::string("unknown");
+    });
+    auto addr = log::lazy([stream] {
+      auto addr_res = stream->remoteMultiaddr();
+      return addr_res ? addr_res.value().getStringAddress()
+                      : std::string("unknown");
+    });
+    return std::make_tuple(std::move(id), std::move(addr));
+  }
 
   /**
    * Get collection of peers, to which we have at least one active connection
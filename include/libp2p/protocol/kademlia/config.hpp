@@ -117,6 +117,13 @@ namespace libp2p::protocol::kademlia {
      */
     size_t maxProvidersPerKey = 6;
 
+    /**
+     * Max number of provider records stored, the least recently refreshed
+     * records are evicted above it. Bounds memory of provider records
+     * @note Default: 1M
+     */
+    size_t maxProviderRecords = 1 << 20;
+
     /**
      * Maximum size of bucket
      * This is implementation specified property.
@@ -124,6 +131,12 @@ namespace libp2p::protocol::kademlia {
      */
     size_t maxBucketSize = 20;
 
+    /**
+     * Maximum size of incoming message, larger messages close the session
+     * @note Default: 4MiB
+     */
+    size_t maxMessageSize = 4 * 1024 * 1024;
+
     /**
      * Maximum time to waiting response
      * This is implementation specified property.
@@ -8,45 +8,13 @@
 
 #include <libp2p/protocol/kademlia/impl/content_routing_table.hpp>
 
-#include <boost/multi_index/hashed_index_fwd.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index_fwd.hpp>
-#include <boost/multi_index_container_fwd.hpp>
-
 #include <libp2p/protocol/common/scheduler.hpp>
 #include <libp2p/protocol/kademlia/common.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
+#include <libp2p/protocol/kademlia/impl/provider_store.hpp>
 
 namespace libp2p::protocol::kademlia {
 
-  struct ByKey;
-  struct ByExpireTime;
-
-  namespace {
-
-    namespace mi = boost::multi_index;
-
-    struct Record {
-      ContentId key;
-      peer::PeerId peer;
-      scheduler::Ticks expire_time = scheduler::Ticks{};
-    };
-
-    /// Table of Record with 2 indices (by key and expire time)
-    using Table = boost::multi_index_container<
-        Record,
-        mi::indexed_by<
-            // hashed_non_unique by key means unordered index, non-unique
-            mi::hashed_non_unique<mi::tag<ByKey>,
-                                  mi::member<Record, ContentId, &Record::key>,
-                                  std::hash<ContentId>>,
-            // ordered_non_unique by expire time means accending order
-            mi::ordered_non_unique<
-                mi::tag<ByExpireTime>,
-                mi::member<Record, scheduler::Ticks, &Record::expire_time>>>>;
-
-  }  // namespace
-
   class ContentRoutingTableImpl
       : public ContentRoutingTable,
         public std::enable_shared_from_this<ContentRoutingTableImpl> {
@@ -70,7 +38,7 @@ namespace libp2p::protocol::kademlia {
     const Config& config_;
     Scheduler &scheduler_;
     std::shared_ptr<event::Bus> bus_;
-    std::unique_ptr<Table> table_;
+    ProviderStore store_;
     Scheduler::Handle cleanup_timer_;
   };
 
@@ -0,0 +1,31 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PROTOCOL_KADEMLIA_EXECUTORMETRICS
+#define LIBP2P_PROTOCOL_KADEMLIA_EXECUTORMETRICS
+
+#include <libp2p/common/metrics/registry.hpp>
+
+namespace libp2p::protocol::kademlia {
+
+  /// Metrics of one kind of executors, labelled by executor name
+  struct ExecutorMetrics {
+    explicit ExecutorMetrics(const std::string &executor);
+
+    /// Executors started
+    metrics::Counter &started;
+    /// Executors finished with result
+    metrics::Counter &succeeded;
+    /// Executors finished without result
+    metrics::Counter &failed;
+    /// Streams to remote peers opened or failed to open
+    metrics::Counter &requests;
+    /// Streams to remote peers failed to open
+    metrics::Counter &request_failures;
+  };
+
+}  // namespace libp2p::protocol::kademlia
+
+#endif  // LIBP2P_PROTOCOL_KADEMLIA_EXECUTORMETRICS
@@ -81,7 +81,8 @@ namespace libp2p::protocol::kademlia {
     bool started_ = false;
     std::atomic_bool done_ = false;
 
-    std::unordered_set<PeerId> providers_;
+    /// Providers found, up to Config::maxProvidersPerKey
+    std::vector<PeerId> providers_;
 
     log::SubLogger log_;
   };
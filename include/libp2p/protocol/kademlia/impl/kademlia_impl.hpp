@@ -138,6 +138,11 @@ namespace libp2p::protocol::kademlia {
     // Subscribtion to new connections
     event::Handle new_connection_subscription_;
 
+    // Subscriptions to routing table changes, connections to its members are
+    // protected from trimming
+    event::Handle peer_added_subscription_;
+    event::Handle peer_removed_subscription_;
+
     struct StreamPtrComparator {
       bool operator()(const std::shared_ptr<connection::Stream> &lhs,
                       const std::shared_ptr<connection::Stream> &rhs) const {
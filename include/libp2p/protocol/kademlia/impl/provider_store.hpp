@@ -0,0 +1,204 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PROTOCOL_KADEMLIA_PROVIDERSTORE
+#define LIBP2P_PROTOCOL_KADEMLIA_PROVIDERSTORE
+
+#include <limits>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <gsl/span>
+#include <libp2p/protocol/kademlia/common.hpp>
+#include <libp2p/protocol/kademlia/config.hpp>
+
+namespace libp2p::protocol::kademlia {
+
+  /**
+   * Provider records of content, bounded by Config::maxProviderRecords in
+   * total and by Config::maxProvidersPerKey per content. Content is keyed by
+   * multihash of its CID, so that CIDs of the same content with different
+   * versions or codecs share records, as go-libp2p does. Keys, which are not
+   * CIDs, are taken whole. Keys are kept in flat hash table. Provider peer
+   * ids are interned, records refer to them by index.
+   *
+   * Records are chained in the order of refreshing. As they have the same
+   * TTL, the least recently refreshed record is the first to expire and the
+   * first to be evicted, so that neither expiration nor eviction scan the
+   * store
+   */
+  class ProviderStore {
+   public:
+    explicit ProviderStore(const Config &config);
+
+    /**
+     * Adds provider of content or refreshes its record. Expiration times are
+     * expected to grow with calls, as with the same TTL
+     * @return true if provider is new
+     */
+    bool addProvider(const ContentId &key, const PeerId &peer, Time expires);
+
+    /// Providers of content, whose records are not expired by now, up to
+    /// limit (0 means no limit)
+    std::vector<PeerId> getProviders(const ContentId &key, Time now,
+                                     size_t limit = 0) const;
+
+    /**
+     * Removes records expired by now, the oldest first
+     * @param budget - max records to remove
+     * @return false if there are more expired records
+     */
+    bool removeExpired(Time now, size_t budget);
+
+    /// Number of records
+    size_t size() const {
+      return size_;
+    }
+
+    /// Number of content keys
+    size_t keys() const {
+      return keys_.size() - free_keys_.size();
+    }
+
+    /// Number of distinct providers
+    size_t peers() const {
+      return peers_.size() - free_peers_.size();
+    }
+
+    /// Approximate heap memory used, in bytes
+    size_t memoryUsage() const;
+
+   private:
+    using Index = uint32_t;
+    using Multihash = gsl::span<const uint8_t>;
+
+    static constexpr Index kNone = std::numeric_limits<Index>::max();
+
+    /// Open addressing hash table of indices into storage vectors. Hashes
+    /// are kept with indices, so that the table grows without access to
+    /// storage
+    class FlatIndex {
+     public:
+      template <typename Equal>
+      Index find(size_t hash, Equal &&equal) const {
+        if (slots_.empty()) {
+          return kNone;
+        }
+        auto mask = slots_.size() - 1;
+        auto h = static_cast<uint32_t>(hash);
+        for (auto i = h & mask;; i = (i + 1) & mask) {
+          const auto &slot = slots_[i];
+          if (slot.index == kNone) {
+            return kNone;
+          }
+          if (slot.hash == h && equal(slot.index)) {
+            return slot.index;
+          }
+        }
+      }
+
+      void insert(size_t hash, Index index);
+
+      /// Erases index, which must be present
+      void erase(size_t hash, Index index);
+
+      size_t memoryUsage() const {
+        return slots_.capacity() * sizeof(Slot);
+      }
+
+     private:
+      struct Slot {
+        uint32_t hash = 0;
+        Index index = kNone;
+      };
+
+      void place(uint32_t hash, Index index);
+
+      void grow();
+
+      std::vector<Slot> slots_;
+      size_t size_ = 0;
+    };
+
+    struct Key {
+      std::vector<uint8_t> multihash;
+
+      /// The first record of content
+      Index head = kNone;
+
+      /// Records of content, zero if the key is free
+      uint32_t count = 0;
+    };
+
+    struct Peer {
+      boost::optional<PeerId> id;
+
+      /// Records of peer, zero if the entry is free
+      uint32_t refs = 0;
+    };
+
+    struct Record {
+      Time expires = 0;
+      Index key = kNone;
+      Index peer = kNone;
+
+      /// The next record of the same content
+      Index next = kNone;
+
+      /// Neighbours in refresh order
+      Index newer = kNone;
+      Index older = kNone;
+    };
+
+    /// Multihash of CID, or the whole key if it is not a CID
+    static Multihash multihashOf(const ContentId &key);
+
+    static size_t hashOf(Multihash multihash);
+
+    Index findKey(Multihash multihash, size_t hash) const;
+
+    Index findPeer(const PeerId &peer) const;
+
+    Index internKey(Multihash multihash, size_t hash);
+
+    Index internPeer(const PeerId &peer);
+
+    void releasePeer(Index peer);
+
+    /// Removes record and releases its key and peer
+    void removeRecord(Index record);
+
+    /// Makes the record the newest one
+    void linkNewest(Index record);
+
+    void unlink(Index record);
+
+    const Config &config_;
+
+    std::vector<Key> keys_;
+    std::vector<Index> free_keys_;
+    FlatIndex key_index_;
+
+    std::vector<Peer> peers_;
+    std::vector<Index> free_peers_;
+    FlatIndex peer_index_;
+
+    /// Bytes of content keys
+    size_t key_bytes_ = 0;
+
+    /// Bytes of interned peer ids
+    size_t peer_bytes_ = 0;
+
+    std::vector<Record> records_;
+    std::vector<Index> free_records_;
+    size_t size_ = 0;
+
+    Index newest_ = kNone;
+    Index oldest_ = kNone;
+  };
+
+}  // namespace libp2p::protocol::kademlia
+
+#endif  // LIBP2P_PROTOCOL_KADEMLIA_PROVIDERSTORE
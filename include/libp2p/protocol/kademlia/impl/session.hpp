@@ -8,9 +8,9 @@
 
 #include <functional>
 
+#include <libp2p/basic/framed_reader.hpp>
 #include <libp2p/connection/stream.hpp>
 #include <libp2p/log/sublogger.hpp>
-#include <libp2p/multi/uvarint.hpp>
 #include <libp2p/protocol/common/scheduler.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
 #include <libp2p/protocol/kademlia/impl/response_handler.hpp>
@@ -25,6 +25,7 @@ namespace libp2p::protocol::kademlia {
     Session(std::weak_ptr<SessionHost> session_host,
             std::weak_ptr<Scheduler> scheduler,
             std::shared_ptr<connection::Stream> stream,
+            size_t max_message_size,
             scheduler::Ticks operations_timeout = 0);
 
     ~Session();
@@ -49,9 +50,7 @@ namespace libp2p::protocol::kademlia {
     void close(outcome::result<void> = outcome::success());
 
    private:
-    void onLengthRead(outcome::result<multi::UVarint> varint);
-
-    void onMessageRead(outcome::result<size_t> res);
+    void onMessageRead(outcome::result<basic::FramedReader::Frame> res);
 
     void onMessageWritten(
         outcome::result<size_t> res,
@@ -72,7 +71,7 @@ namespace libp2p::protocol::kademlia {
     std::weak_ptr<Scheduler> scheduler_;
     std::shared_ptr<connection::Stream> stream_;
 
-    std::vector<uint8_t> inner_buffer_;
+    std::shared_ptr<basic::FramedReader> reader_;
 
     std::atomic_size_t reading_ = 0;
     std::atomic_size_t writing_ = 0;
@@ -15,11 +15,21 @@ namespace libp2p::protocol_muxer::multiselect {
 
   class MultiselectInstance;
 
+  struct MultiselectConfig {
+    /// Outbound streams are returned before the protocol is accepted by the
+    /// other side, the proposal goes together with the first written data,
+    /// so the negotiation round trip is saved. If the protocol is rejected,
+    /// the first read fails with NEGOTIATION_FAILED
+    bool lazy_negotiation = false;
+  };
+
   /// Multiselect protocol implementation of ProtocolMuxer
   class Multiselect : public protocol_muxer::ProtocolMuxer {
    public:
     using Instance = std::shared_ptr<MultiselectInstance>;
 
+    explicit Multiselect(MultiselectConfig config = {});
+
     ~Multiselect() override = default;
 
     /// Implements ProtocolMuxer API
@@ -28,6 +38,12 @@ namespace libp2p::protocol_muxer::multiselect {
                      bool is_initiator, bool negotiate_multiselect,
                      ProtocolHandlerFunc cb) override;
 
+    /// Implements ProtocolMuxer API
+    void selectOneOf(gsl::span<const peer::ProtocolId> protocols,
+                     std::shared_ptr<basic::ReadWriter> connection,
+                     bool is_initiator, bool negotiate_multiselect,
+                     ProtocolIdHandlerFunc cb) override;
+
     /// Simple single stream negotiate procedure
     void simpleStreamNegotiate(
         const std::shared_ptr<connection::Stream> &stream,
@@ -37,13 +53,15 @@ namespace libp2p::protocol_muxer::multiselect {
             cb) override;
 
     /// Called from instance on close
-    void instanceClosed(Instance instance, const ProtocolHandlerFunc &cb,
-                        outcome::result<peer::Protocol> result);
+    void instanceClosed(Instance instance, const ProtocolIdHandlerFunc &cb,
+                        outcome::result<peer::ProtocolId> result);
 
    private:
     /// Returns instance either from cache or creates a new one
     Instance getInstance();
 
+    const MultiselectConfig config_;
+
     /// Active instances, keep them here to hold shared ptrs alive
     std::unordered_set<Instance> active_instances_;
 
@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_PROTOCOL_MUXER_MULTISELECT_LAZY_STREAM_HPP
+#define LIBP2P_PROTOCOL_MUXER_MULTISELECT_LAZY_STREAM_HPP
+
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/peer/interned_protocol.hpp>
+#include <libp2p/peer/peer_id.hpp>
+#include <libp2p/protocol_muxer/multiselect/common.hpp>
+
+namespace libp2p::protocol_muxer::multiselect {
+
+  /**
+   * Outbound stream, which is returned to the user before the protocol is
+   * accepted by the other side ("lazy" multistream negotiation).
+   * Multistream header and protocol proposal are sent together with the
+   * first written data (or before the first read if the user reads first).
+   * The reply is verified before the first read completes, "na" or
+   * anything else but the exact echo fails the read with
+   * NEGOTIATION_FAILED and resets the stream
+   */
+  class LazyStream : public connection::Stream,
+                     public std::enable_shared_from_this<LazyStream> {
+   public:
+    /**
+     * Ctor.
+     * @param stream fresh outbound stream
+     * @param protocol protocol to propose, its multistream proposal is sent
+     * and the exact echo of it is expected in reply
+     */
+    LazyStream(std::shared_ptr<connection::Stream> stream,
+               peer::ProtocolId protocol);
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void deferReadCallback(outcome::result<size_t> res,
+                           ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
+
+    bool isClosedForRead() const override;
+
+    bool isClosedForWrite() const override;
+
+    bool isClosed() const override;
+
+    void close(VoidResultHandlerFunc cb) override;
+
+    void reset() override;
+
+    void adjustWindowSize(uint32_t new_size, VoidResultHandlerFunc cb) override;
+
+    void setPriority(Priority priority) override;
+
+    outcome::result<bool> isInitiator() const override;
+
+    outcome::result<peer::PeerId> remotePeerId() const override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() const override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() const override;
+
+   private:
+    /// Writes proposal followed by user data in one packet
+    void writeWithProposal(gsl::span<const uint8_t> in, size_t bytes,
+                           WriteCallbackFunc cb);
+
+    /// Reads and verifies the reply, then proceeds with user's read
+    void readWithReply(gsl::span<uint8_t> out, size_t bytes,
+                       ReadCallbackFunc cb, bool some);
+
+    /// Called when the first part of reply (up to protocol's varint
+    /// prefix) is read
+    void onReplyHeaderRead(gsl::span<uint8_t> out, size_t bytes,
+                           ReadCallbackFunc cb, bool some,
+                           outcome::result<size_t> res);
+
+    /// Called when the whole reply is read
+    void onReplyRead(gsl::span<uint8_t> out, size_t bytes, ReadCallbackFunc cb,
+                     bool some, outcome::result<size_t> res);
+
+    /// Resets the stream and fails the pending read
+    void failed(const ReadCallbackFunc &cb, std::error_code ec);
+
+    /// Underlying stream
+    std::shared_ptr<connection::Stream> stream_;
+
+    /// Protocol proposed
+    peer::ProtocolId protocol_;
+
+    /// Proposal, which is also the expected reply
+    gsl::span<const uint8_t> proposal_;
+
+    /// Reply buffer
+    MsgBuf reply_;
+
+    /// Proposal was sent (or is being sent)
+    bool proposal_sent_ = false;
+
+    /// Reply was received and verified
+    bool negotiated_ = false;
+  };
+
+}  // namespace libp2p::protocol_muxer::multiselect
+
+#endif  // LIBP2P_PROTOCOL_MUXER_MULTISELECT_LAZY_STREAM_HPP
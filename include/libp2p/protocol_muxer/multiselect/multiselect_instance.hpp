@@ -24,16 +24,21 @@ namespace libp2p::protocol_muxer::multiselect {
     explicit MultiselectInstance(Multiselect &owner);
 
     /// Implements ProtocolMuxer API
-    void selectOneOf(gsl::span<const peer::Protocol> protocols,
+    void selectOneOf(gsl::span<const peer::ProtocolId> protocols,
                      std::shared_ptr<basic::ReadWriter> connection,
                      bool is_initiator, bool negotiate_multiselect,
-                     Multiselect::ProtocolHandlerFunc cb);
+                     Multiselect::ProtocolIdHandlerFunc cb);
 
    private:
-    using Protocols = boost::container::small_vector<std::string, 4>;
-    using Packet = std::shared_ptr<MsgBuf>;
+    using Protocols = boost::container::small_vector<peer::ProtocolId, 4>;
     using Parser = detail::Parser;
-    using MaybeResult = boost::optional<outcome::result<std::string>>;
+    using MaybeResult = boost::optional<outcome::result<peer::ProtocolId>>;
+
+    /// Bytes to send and the object which owns them
+    struct Packet {
+      gsl::span<const uint8_t> bytes;
+      std::shared_ptr<const void> holder;
+    };
 
     /// Sends the first message with multistream protocol ID
     void sendOpening();
@@ -47,9 +52,12 @@ namespace libp2p::protocol_muxer::multiselect {
     /// Sends NA reply message
     void sendNA();
 
-    /// Makes a packet and sends it on success, reports error to callback on
-    /// failure (too long messages are not supported)
-    void send(outcome::result<MsgBuf> msg);
+    /// Sends protocol line, reports error to callback if the protocol
+    /// cannot be encoded (too long messages are not supported)
+    void send(const peer::ProtocolId &protocol, bool with_header);
+
+    /// Reports error to callback
+    void sendError(std::error_code ec);
 
     /// Sends packet to wire (or enqueues if there are uncompted send
     /// operations)
@@ -59,7 +67,7 @@ namespace libp2p::protocol_muxer::multiselect {
     void onDataWritten(outcome::result<size_t> res);
 
     /// Closes the negotiation session with result, returns instance to owner
-    void close(outcome::result<std::string> result);
+    void close(outcome::result<peer::ProtocolId> result);
 
     /// Initiates async read operation
     void receive();
@@ -90,7 +98,7 @@ namespace libp2p::protocol_muxer::multiselect {
     std::shared_ptr<basic::ReadWriter> connection_;
 
     /// ProtocolMuxer callback
-    Multiselect::ProtocolHandlerFunc callback_;
+    Multiselect::ProtocolIdHandlerFunc callback_;
 
     /// True for client-side instance
     bool is_initiator_ = false;
@@ -126,10 +134,7 @@ namespace libp2p::protocol_muxer::multiselect {
     bool is_writing_ = false;
 
     /// Cache: serialized LS response
-    boost::optional<Packet> ls_response_;
-
-    /// Cache: serialized NA response
-    boost::optional<Packet> na_response_;
+    std::shared_ptr<MsgBuf> ls_response_;
   };
 
 }  // namespace libp2p::protocol_muxer::multiselect
@@ -19,6 +19,15 @@ namespace libp2p::protocol_muxer::multiselect {
       std::function<void(outcome::result<std::shared_ptr<connection::Stream>>)>
           cb);
 
+  /// Implements "lazy" negotiation of a single protocol on a fresh outbound
+  /// stream: the stream is returned at once, the proposal is sent with the
+  /// first written data and the reply is verified on the first read
+  void lazyStreamNegotiateImpl(
+      const std::shared_ptr<connection::Stream> &stream,
+      const peer::Protocol &protocol_id,
+      std::function<void(outcome::result<std::shared_ptr<connection::Stream>>)>
+          cb);
+
 }  // namespace libp2p::protocol_muxer::multiselect
 
 #endif  // LIBP2P_PROTOCOL_MUXER_SIMPLE_STREAM_NEGOTIATE_HPP
@@ -10,6 +10,7 @@
 
 #include <gsl/span>
 #include <libp2p/connection/stream.hpp>
+#include <libp2p/peer/interned_protocol.hpp>
 #include <libp2p/peer/protocol.hpp>
 
 namespace libp2p::protocol_muxer {
@@ -49,6 +50,17 @@ namespace libp2p::protocol_muxer {
                              bool is_initiator, bool negotiate_multistream,
                              ProtocolHandlerFunc cb) = 0;
 
+    using ProtocolIdHandlerFunc =
+        std::function<void(outcome::result<peer::ProtocolId>)>;
+    /**
+     * Select a protocol for a given connection, the same as above but takes
+     * and returns interned protocols, so that no strings are allocated
+     */
+    virtual void selectOneOf(gsl::span<const peer::ProtocolId> protocols,
+                             std::shared_ptr<basic::ReadWriter> connection,
+                             bool is_initiator, bool negotiate_multistream,
+                             ProtocolIdHandlerFunc cb) = 0;
+
     /**
      * Simple (Yes/No) negotiation of a single protocol on a fresh outbound
      * stream
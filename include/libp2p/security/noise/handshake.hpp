@@ -6,6 +6,8 @@
 #ifndef LIBP2P_INCLUDE_LIBP2P_SECURITY_NOISE_HANDSHAKE_HPP
 #define LIBP2P_INCLUDE_LIBP2P_SECURITY_NOISE_HANDSHAKE_HPP
 
+#include <chrono>
+
 #include <libp2p/connection/raw_connection.hpp>
 #include <libp2p/crypto/crypto_provider.hpp>
 #include <libp2p/crypto/key_marshaller.hpp>
@@ -79,6 +81,7 @@ namespace libp2p::security::noise {
     std::shared_ptr<CipherState> dec_;
     boost::optional<peer::PeerId> remote_peer_id_;
     boost::optional<crypto::PublicKey> remote_peer_pubkey_;
+    std::chrono::steady_clock::time_point started_;
 
     log::Logger log_ = log::createLogger("NoiseHandshake");
   };
@@ -16,6 +16,20 @@
 
 namespace libp2p::security {
 
+  namespace tls_details {
+    class SessionCache;
+  }  // namespace tls_details
+
+  /// TLS adaptor settings
+  struct TlsConfig {
+    /// Resume sessions with recently connected peers using TLS 1.3 session
+    /// tickets, reconnect skips certificate exchange and signatures
+    bool session_resumption = true;
+
+    /// Max number of peers whose sessions are kept for resumption
+    size_t session_cache_size = 1024;
+  };
+
   /// TLS 1.3 security adaptor
   class TlsAdaptor : public SecurityAdaptor,
                      public std::enable_shared_from_this<TlsAdaptor> {
@@ -27,7 +41,8 @@ namespace libp2p::security {
     TlsAdaptor(
         std::shared_ptr<peer::IdentityManager> idmgr,
         std::shared_ptr<boost::asio::io_context> io_context,
-        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller);
+        std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+        TlsConfig config = {});
 
     /// Returns "/tls/1.0.0"
     peer::Protocol getProtocolId() const override;
@@ -41,9 +56,13 @@ namespace libp2p::security {
                         const peer::PeerId &p, SecConnCallbackFunc cb) override;
 
    private:
-    /// Creates shared SSL context, generates certificate and private key
+    /// Creates shared SSL context, generates certificate and private key.
+    /// They are reused by all the connections
     outcome::result<void> setupContext();
 
+    /// Configures session tickets and client session cache
+    void setupSessionResumption();
+
     /// Creates TLSConnection and starts handshake
     void asyncHandshake(std::shared_ptr<connection::RawConnection> conn,
                          boost::optional<peer::PeerId> remote_peer,
@@ -58,8 +77,14 @@ namespace libp2p::security {
     /// Key marshaller, needed for custom cert extension
     std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller_;
 
+    /// Settings
+    TlsConfig config_;
+
     /// Shared ssl context
     std::shared_ptr<boost::asio::ssl::context> ssl_context_;
+
+    /// Sessions of outbound connections, nullptr if resumption is disabled
+    std::shared_ptr<tls_details::SessionCache> session_cache_;
   };
 }  // namespace libp2p::security
 
@@ -0,0 +1,11 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_HPP
+#define LIBP2P_MEMORY_HPP
+
+#include <libp2p/transport/memory/memory_transport.hpp>
+
+#endif  // LIBP2P_MEMORY_HPP
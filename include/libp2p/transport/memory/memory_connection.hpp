@@ -0,0 +1,126 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_CONNECTION_HPP
+#define LIBP2P_MEMORY_CONNECTION_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <boost/circular_buffer.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <libp2p/common/metrics/instance_count.hpp>
+#include <libp2p/connection/raw_connection.hpp>
+#include <libp2p/multi/multiaddress.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief In-process raw connection. Data written to one side is appended
+   * into the other side's ring buffer, so there are no syscalls involved.
+   * Callbacks are always deferred to the next event loop cycle.
+   *
+   * Both sides of the connection are expected to be served by the same
+   * (single-threaded) io_context
+   */
+  class MemoryConnection
+      : public connection::RawConnection,
+        public std::enable_shared_from_this<MemoryConnection>,
+        private boost::noncopyable {
+   public:
+    using ConnectionPair = std::pair<std::shared_ptr<MemoryConnection>,
+                                     std::shared_ptr<MemoryConnection>>;
+
+    /// Initial capacity of inbound buffer, it grows on demand
+    static constexpr size_t kInitialBufferSize = 64 * 1024;
+
+    MemoryConnection(boost::asio::io_context &context,
+                     multi::Multiaddress local, multi::Multiaddress remote,
+                     bool initiator);
+
+    ~MemoryConnection() override;
+
+    /**
+     * @brief Creates two connected sides of in-process connection
+     * @param context io_context, which serves callbacks of both sides
+     * @param initiator_address local address of initiator's side
+     * @param acceptor_address local address of acceptor's (listener's) side
+     * @return pair of {initiator's side, acceptor's side}
+     */
+    static ConnectionPair makePair(boost::asio::io_context &context,
+                                   const multi::Multiaddress &initiator_address,
+                                   const multi::Multiaddress &acceptor_address);
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override;
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override;
+
+    void deferReadCallback(outcome::result<size_t> res,
+                           ReadCallbackFunc cb) override;
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override;
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override;
+
+    void deferWriteCallback(std::error_code ec, WriteCallbackFunc cb) override;
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() override;
+
+    outcome::result<multi::Multiaddress> localMultiaddr() override;
+
+    bool isInitiator() const noexcept override;
+
+    outcome::result<void> close() override;
+
+    bool isClosed() const override;
+
+   private:
+    struct PendingRead {
+      gsl::span<uint8_t> out;
+      size_t bytes;
+      size_t done;
+      bool some;
+      ReadCallbackFunc cb;
+    };
+
+    void doRead(gsl::span<uint8_t> out, size_t bytes, bool some,
+                ReadCallbackFunc cb);
+
+    /// Called by the peer after it wrote data into our buffer
+    void onPeerData(gsl::span<const uint8_t> data);
+
+    /// Called by the peer when it is closed
+    void onPeerClosed();
+
+    /// Serves pending read operation from buffered data
+    void processPendingRead();
+
+    /// Completes pending read (if any) with the result given
+    void completePendingRead(outcome::result<size_t> res);
+
+    template <typename Callback, typename Arg>
+    void post(Callback cb, Arg arg);
+
+    boost::asio::io_context &context_;
+    multi::Multiaddress local_;
+    multi::Multiaddress remote_;
+    bool initiator_;
+    std::weak_ptr<MemoryConnection> peer_;
+    boost::circular_buffer<uint8_t> inbound_;
+    boost::optional<PendingRead> pending_read_;
+    bool closed_by_host_ = false;
+    bool closed_by_peer_ = false;
+
+   public:
+    LIBP2P_METRICS_INSTANCE_COUNT_IF_ENABLED(
+        libp2p::transport::MemoryConnection);
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_CONNECTION_HPP
@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_LISTENER_HPP
+#define LIBP2P_MEMORY_LISTENER_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <boost/optional.hpp>
+#include <libp2p/transport/memory/memory_connection.hpp>
+#include <libp2p/transport/memory/memory_util.hpp>
+#include <libp2p/transport/transport_listener.hpp>
+#include <libp2p/transport/upgrader.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief In-process listener, bound to /memory/<id> address. Listeners are
+   * registered in process-wide table, so that any MemoryTransport instance
+   * can dial to them. /memory/0 means "choose any free id"
+   */
+  class MemoryListener : public TransportListener,
+                         public std::enable_shared_from_this<MemoryListener> {
+   public:
+    ~MemoryListener() override;
+
+    MemoryListener(boost::asio::io_context &context,
+                   std::shared_ptr<Upgrader> upgrader,
+                   TransportListener::HandlerFunc handler);
+
+    outcome::result<void> listen(const multi::Multiaddress &address) override;
+
+    bool canListen(const multi::Multiaddress &ma) const override;
+
+    outcome::result<multi::Multiaddress> getListenMultiaddr() const override;
+
+    bool isClosed() const override;
+
+    outcome::result<void> close() override;
+
+    /**
+     * @brief Finds active listener by its id
+     * @return listener or nullptr if nobody listens to the id
+     */
+    static std::shared_ptr<MemoryListener> find(uint64_t id);
+
+    /**
+     * @brief Accepts incoming in-process connection, acceptor's side of the
+     * connection goes through upgrader to listener's handler
+     * @return initiator's side of the connection
+     */
+    std::shared_ptr<MemoryConnection> accept();
+
+   private:
+    boost::asio::io_context &context_;
+    std::shared_ptr<Upgrader> upgrader_;
+    TransportListener::HandlerFunc handle_;
+    boost::optional<uint64_t> id_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_LISTENER_HPP
@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_TRANSPORT_HPP
+#define LIBP2P_MEMORY_TRANSPORT_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <libp2p/transport/memory/memory_listener.hpp>
+#include <libp2p/transport/transport_adaptor.hpp>
+#include <libp2p/transport/upgrader.hpp>
+
+namespace libp2p::transport {
+
+  /**
+   * @brief In-process transport for /memory/<id> addresses. Connections
+   * go through the same upgrade pipeline as TCP ones, but bytes are passed
+   * via in-memory buffers, so multi-host tests and simulations are free of
+   * syscalls and port management.
+   *
+   * All the hosts using memory transport must share one io_context
+   */
+  class MemoryTransport : public TransportAdaptor,
+                          public std::enable_shared_from_this<MemoryTransport> {
+   public:
+    ~MemoryTransport() override = default;
+
+    MemoryTransport(std::shared_ptr<boost::asio::io_context> context,
+                    std::shared_ptr<Upgrader> upgrader);
+
+    void dial(const peer::PeerId &remoteId, multi::Multiaddress address,
+              TransportAdaptor::HandlerFunc handler) override;
+
+    void dial(const peer::PeerId &remoteId, multi::Multiaddress address,
+              TransportAdaptor::HandlerFunc handler,
+              std::chrono::milliseconds timeout) override;
+
+    std::shared_ptr<TransportListener> createListener(
+        TransportListener::HandlerFunc handler) override;
+
+    bool canDial(const multi::Multiaddress &ma) const override;
+
+    peer::Protocol getProtocolId() const override;
+
+   private:
+    std::shared_ptr<boost::asio::io_context> context_;
+    std::shared_ptr<Upgrader> upgrader_;
+  };
+
+}  // namespace libp2p::transport
+
+#endif  // LIBP2P_MEMORY_TRANSPORT_HPP
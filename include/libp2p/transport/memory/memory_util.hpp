@@ -0,0 +1,45 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_MEMORY_UTIL_HPP
+#define LIBP2P_MEMORY_UTIL_HPP
+
+#include <string>
+#include <system_error>  // for std::errc
+
+#include <libp2p/multi/multiaddress.hpp>
+#include <libp2p/outcome/outcome.hpp>
+
+namespace libp2p::transport::detail {
+
+  /// Returns true if multiaddress starts with /memory/<id>
+  inline bool supportsMemory(const multi::Multiaddress &ma) {
+    auto pvs = ma.getProtocolsWithValues();
+    return !pvs.empty()
+        && pvs.front().first.code == multi::Protocol::Code::MEMORY;
+  }
+
+  /// Extracts in-process listener id from /memory/<id> multiaddress
+  inline outcome::result<uint64_t> getMemoryId(const multi::Multiaddress &ma) {
+    if (!supportsMemory(ma)) {
+      return std::errc::address_family_not_supported;
+    }
+    OUTCOME_TRY(value,
+                ma.getFirstValueForProtocol(multi::Protocol::Code::MEMORY));
+    try {
+      return std::stoull(value);
+    } catch (const std::exception &) {
+      return std::errc::invalid_argument;
+    }
+  }
+
+  /// Makes /memory/<id> multiaddress
+  inline multi::Multiaddress makeMemoryAddress(uint64_t id) {
+    return multi::Multiaddress::create("/memory/" + std::to_string(id)).value();
+  }
+
+}  // namespace libp2p::transport::detail
+
+#endif  // LIBP2P_MEMORY_UTIL_HPP
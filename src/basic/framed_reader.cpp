@@ -0,0 +1,180 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/basic/framed_reader.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#include <libp2p/basic/varint_prefix_reader.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(libp2p::basic, FramedReader::Error, e) {
+  using E = libp2p::basic::FramedReader::Error;
+  switch (e) {
+    case E::FRAME_TOO_LONG:
+      return "Frame length exceeds the limit";
+    case E::BAD_LENGTH_PREFIX:
+      return "Frame length prefix is not a valid uvarint";
+    case E::READ_IN_PROGRESS:
+      return "Frame read is already in progress";
+    case E::STREAM_CLOSED:
+      return "Stream closed before frame was read";
+  }
+  return "Unknown error";
+}
+
+namespace libp2p::basic {
+
+  FramedReader::FramedReader(std::shared_ptr<Reader> stream,
+                             size_t max_frame_size, size_t read_ahead)
+      : stream_(std::move(stream)),
+        max_frame_size_(max_frame_size),
+        read_ahead_(read_ahead) {
+    assert(stream_);
+    assert(read_ahead_ > 0);
+  }
+
+  void FramedReader::read(FrameCallback cb) {
+    assert(cb);
+
+    if (cb_) {
+      return stream_->deferReadCallback(
+          0, [cb = std::move(cb)](outcome::result<size_t>) {
+            cb(Error::READ_IN_PROGRESS);
+          });
+    }
+
+    cb_ = std::move(cb);
+
+    if (dispatching_ || reading_) {
+      // will be completed from the dispatch loop or by read completion
+      return;
+    }
+
+    if (begin_ == end_) {
+      // nothing buffered, readSome() never calls back synchronously
+      wanted_ = 1;
+      return readMore();
+    }
+
+    stream_->deferReadCallback(
+        0, [wptr = weak_from_this()](outcome::result<size_t>) {
+          if (auto self = wptr.lock()) {
+            self->dispatch();
+          }
+        });
+  }
+
+  void FramedReader::dispatch() {
+    dispatching_ = true;
+    while (cb_) {
+      auto res = nextFrame();
+      if (!res) {
+        complete(res.error());
+        break;
+      }
+      if (!res.value()) {
+        readMore();
+        break;
+      }
+      complete(res.value().value());
+    }
+    dispatching_ = false;
+  }
+
+  outcome::result<boost::optional<FramedReader::Frame>>
+  FramedReader::nextFrame() {
+    auto buffered = end_ - begin_;
+    auto data = gsl::make_span(buffer_).subspan(begin_, buffered);
+
+    Frame frame = data;
+    VarintPrefixReader varint;
+    auto state = varint.consume(frame);
+
+    if (state == VarintPrefixReader::kUnderflow) {
+      wanted_ = buffered + 1;
+      return boost::none;
+    }
+    if (state != VarintPrefixReader::kReady) {
+      return Error::BAD_LENGTH_PREFIX;
+    }
+
+    auto length = varint.value();
+    if (length > max_frame_size_) {
+      return Error::FRAME_TOO_LONG;
+    }
+
+    auto prefix_size = buffered - static_cast<size_t>(frame.size());
+    if (static_cast<size_t>(frame.size()) < length) {
+      wanted_ = prefix_size + length;
+      return boost::none;
+    }
+
+    begin_ += prefix_size + length;
+    return frame.first(length);
+  }
+
+  void FramedReader::readMore() {
+    if (begin_ == end_) {
+      begin_ = end_ = 0;
+      if (buffer_.size() > read_ahead_) {
+        // give back memory taken by a large frame
+        buffer_.resize(read_ahead_);
+        buffer_.shrink_to_fit();
+      }
+    }
+
+    auto needed = std::max(wanted_, read_ahead_);
+    if (buffer_.size() - begin_ < needed) {
+      std::copy(buffer_.begin() + begin_, buffer_.begin() + end_,
+                buffer_.begin());
+      end_ -= begin_;
+      begin_ = 0;
+      if (buffer_.size() < needed) {
+        buffer_.resize(needed);
+      }
+    }
+
+    auto free_space = buffer_.size() - end_;
+    assert(free_space > 0);
+
+    reading_ = true;
+
+    // the buffer must outlive the operation, so self is captured
+    stream_->readSome(
+        gsl::make_span(buffer_).subspan(end_, free_space), free_space,
+        [self{shared_from_this()}](outcome::result<size_t> res) {
+          self->onDataRead(res);
+        });
+  }
+
+  void FramedReader::onDataRead(outcome::result<size_t> res) {
+    reading_ = false;
+
+    if (!cb_) {
+      return;
+    }
+
+    if (!res) {
+      return complete(res.error());
+    }
+
+    if (res.value() == 0) {
+      return complete(Error::STREAM_CLOSED);
+    }
+
+    end_ += res.value();
+    assert(end_ <= buffer_.size());
+
+    dispatch();
+  }
+
+  void FramedReader::complete(outcome::result<Frame> res) {
+    FrameCallback cb;
+    cb.swap(cb_);
+    cb(res);
+  }
+
+}  // namespace libp2p::basic
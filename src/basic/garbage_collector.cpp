@@ -0,0 +1,60 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/basic/garbage_collector.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace libp2p::basic {
+
+  GarbageCollector::GarbageCollector(std::shared_ptr<Scheduler> scheduler,
+                                     Config config)
+      : scheduler_(std::move(scheduler)), config_(config) {
+    assert(scheduler_);
+    assert(config_.step_budget > 0);
+  }
+
+  void GarbageCollector::add(std::weak_ptr<GarbageCollectable> collectable) {
+    collectables_.push_back(std::move(collectable));
+  }
+
+  void GarbageCollector::start() {
+    handle_ = scheduler_->scheduleWithHandle(
+        [this] {
+          // expired registrations are dropped
+          collectables_.erase(
+              std::remove_if(collectables_.begin(), collectables_.end(),
+                             [](const auto &c) { return c.expired(); }),
+              collectables_.end());
+          pending_ = collectables_;
+          step();
+        },
+        config_.interval);
+  }
+
+  void GarbageCollector::stop() {
+    handle_.cancel();
+    pending_.clear();
+  }
+
+  void GarbageCollector::step() {
+    auto finished = std::remove_if(
+        pending_.begin(), pending_.end(), [this](const auto &weak) {
+          auto collectable = weak.lock();
+          return !collectable
+              || collectable->collectSomeGarbage(config_.step_budget);
+        });
+    pending_.erase(finished, pending_.end());
+
+    if (pending_.empty()) {
+      start();
+      return;
+    }
+
+    handle_ = scheduler_->scheduleWithHandle([this] { step(); });
+  }
+
+}  // namespace libp2p::basic
@@ -48,18 +48,31 @@ namespace libp2p::basic {
 
   void MessageReadWriterUvarint::write(gsl::span<const uint8_t> buffer,
                                        Writer::WriteCallbackFunc cb) {
-    auto varint_len = multi::UVarint{static_cast<uint64_t>(buffer.size())};
+    writeMessage(
+        buffer.size(),
+        [buffer](gsl::span<uint8_t> out) {
+          std::copy(buffer.begin(), buffer.end(), out.begin());
+        },
+        std::move(cb));
+  }
+
+  void MessageReadWriterUvarint::writeSerialized(size_t size,
+                                                 const Serializer &serialize,
+                                                 Writer::WriteCallbackFunc cb) {
+    writeMessage(size, serialize, std::move(cb));
+  }
+
+  void MessageReadWriterUvarint::writeMessage(size_t size,
+                                              const Serializer &serialize,
+                                              Writer::WriteCallbackFunc cb) {
+    auto varint_size = multi::UVarint::encodedSize(size);
 
-    auto msg_bytes = std::make_shared<std::vector<uint8_t>>();
-    msg_bytes->reserve(varint_len.size() + buffer.size());
-    msg_bytes->insert(msg_bytes->end(),
-                      std::make_move_iterator(varint_len.toVector().begin()),
-                      std::make_move_iterator(varint_len.toVector().end()));
-    msg_bytes->insert(msg_bytes->end(), buffer.begin(), buffer.end());
+    auto msg_bytes = std::make_shared<std::vector<uint8_t>>(varint_size + size);
+    multi::UVarint::encode(size, *msg_bytes);
+    serialize(gsl::make_span(*msg_bytes).subspan(varint_size));
 
     conn_->write(*msg_bytes, msg_bytes->size(),
-                 [cb = std::move(cb), varint_size = varint_len.size(),
-                  msg_bytes](auto &&res) {
+                 [cb = std::move(cb), varint_size, msg_bytes](auto &&res) {
                    if (!res) {
                      return cb(res.error());
                    }
@@ -17,6 +17,10 @@ namespace libp2p::basic {
     return total_unsent_size_;
   }
 
+  size_t WriteQueue::queuedBytes() const {
+    return total_queued_size_;
+  }
+
   void WriteQueue::enqueue(DataRef data, bool some,
                            Writer::WriteCallbackFunc cb) {
     auto data_sz = static_cast<size_t>(data.size());
@@ -25,6 +29,7 @@ namespace libp2p::basic {
     assert(canEnqueue(data_sz));
 
     total_unsent_size_ += data_sz;
+    total_queued_size_ += data_sz;
     queue_.push_back({data, 0, 0, data_sz, some, std::move(cb)});
   }
 
@@ -122,6 +127,8 @@ namespace libp2p::basic {
     result.size_to_ack = total_size;
     result.data_consistent = true;
 
+    assert(total_queued_size_ >= static_cast<size_t>(item.data.size()));
+    total_queued_size_ -= static_cast<size_t>(item.data.size());
     queue_.pop_front();
     if (queue_.empty()) {
       assert(total_unsent_size_ == 0);
@@ -149,6 +156,7 @@ namespace libp2p::basic {
   void WriteQueue::clear() {
     active_index_ = 0;
     total_unsent_size_ = 0;
+    total_queued_size_ = 0;
     std::deque<Data> tmp_queue;
     queue_.swap(tmp_queue);
   }
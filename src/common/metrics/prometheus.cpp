@@ -0,0 +1,136 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/common/metrics/prometheus.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace libp2p::metrics {
+
+  namespace {
+    void writeEscaped(std::ostream &out, const std::string &s,
+                      bool escape_quotes) {
+      for (auto c : s) {
+        if (c == '\\') {
+          out << "\\\\";
+        } else if (c == '\n') {
+          out << "\\n";
+        } else if (c == '"' && escape_quotes) {
+          out << "\\\"";
+        } else {
+          out << c;
+        }
+      }
+    }
+
+    void writeDouble(std::ostream &out, double value) {
+      if (std::isinf(value)) {
+        out << (value > 0 ? "+Inf" : "-Inf");
+      } else if (std::isnan(value)) {
+        out << "NaN";
+      } else {
+        // shortest of the two precisions which reads back exactly
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.15g", value);
+        if (std::strtod(buf, nullptr) != value) {
+          std::snprintf(buf, sizeof(buf), "%.17g", value);
+        }
+        out << buf;
+      }
+    }
+
+    /// Writes name{labels,extra="value"}
+    void writeSeries(std::ostream &out, const std::string &name,
+                     const Labels &labels,
+                     const std::pair<std::string, std::string> *extra) {
+      out << name;
+      if (labels.empty() && extra == nullptr) {
+        return;
+      }
+      out << '{';
+      bool first = true;
+      auto write_label = [&](const auto &label) {
+        if (!first) {
+          out << ',';
+        }
+        first = false;
+        out << label.first << "=\"";
+        writeEscaped(out, label.second, true);
+        out << '"';
+      };
+      for (const auto &label : labels) {
+        write_label(label);
+      }
+      if (extra != nullptr) {
+        write_label(*extra);
+      }
+      out << '}';
+    }
+
+    const char *typeName(MetricType type) {
+      switch (type) {
+        case MetricType::COUNTER:
+          return "counter";
+        case MetricType::GAUGE:
+          return "gauge";
+        case MetricType::HISTOGRAM:
+          return "histogram";
+      }
+      return "untyped";
+    }
+  }  // namespace
+
+  std::string toPrometheusText(const Registry &registry) {
+    std::ostringstream out;
+
+    registry.visit([&](const std::string &name,
+                       const Registry::Family &family) {
+      out << "# HELP " << name << ' ';
+      writeEscaped(out, family.help, false);
+      out << "\n# TYPE " << name << ' ' << typeName(family.type) << '\n';
+
+      switch (family.type) {
+        case MetricType::COUNTER:
+          for (const auto &[labels, counter] : family.counters) {
+            writeSeries(out, name, labels, nullptr);
+            out << ' ' << counter->value() << '\n';
+          }
+          break;
+        case MetricType::GAUGE:
+          for (const auto &[labels, gauge] : family.gauges) {
+            writeSeries(out, name, labels, nullptr);
+            out << ' ' << gauge->value() << '\n';
+          }
+          break;
+        case MetricType::HISTOGRAM:
+          for (const auto &[labels, histogram] : family.histograms) {
+            const auto &bounds = histogram->bounds();
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i <= bounds.size(); ++i) {
+              cumulative += histogram->bucketCount(i);
+              std::ostringstream le;
+              writeDouble(le, i < bounds.size() ? bounds[i] : INFINITY);
+              std::pair<std::string, std::string> le_label{"le", le.str()};
+              writeSeries(out, name + "_bucket", labels, &le_label);
+              out << ' ' << cumulative << '\n';
+            }
+            writeSeries(out, name + "_sum", labels, nullptr);
+            out << ' ';
+            writeDouble(out, histogram->sum());
+            out << '\n';
+            writeSeries(out, name + "_count", labels, nullptr);
+            out << ' ' << cumulative << '\n';
+          }
+          break;
+      }
+    });
+
+    return out.str();
+  }
+
+}  // namespace libp2p::metrics
@@ -0,0 +1,106 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/common/metrics/registry.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace libp2p::metrics {
+
+  uint64_t Counter::value() const {
+    uint64_t sum = 0;
+    for (const auto &shard : shards_) {
+      sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  const std::vector<double> &Histogram::durationBuckets() {
+    static const std::vector<double> buckets{
+        0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10};
+    return buckets;
+  }
+
+  Histogram::Histogram(std::vector<double> bounds)
+      : bounds_(std::move(bounds)),
+        buckets_(new std::atomic<uint64_t>[bounds_.size() + 1]) {
+    assert(std::is_sorted(bounds_.begin(), bounds_.end()));
+    for (size_t i = 0; i <= bounds_.size(); ++i) {
+      buckets_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void Histogram::observe(double value) {
+    auto i = static_cast<size_t>(
+        std::lower_bound(bounds_.begin(), bounds_.end(), value)
+        - bounds_.begin());
+    buckets_[i].fetch_add(1, std::memory_order_relaxed);
+    auto sum = sum_.load(std::memory_order_relaxed);
+    while (!sum_.compare_exchange_weak(sum, sum + value,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t Histogram::count() const {
+    uint64_t count = 0;
+    for (size_t i = 0; i <= bounds_.size(); ++i) {
+      count += bucketCount(i);
+    }
+    return count;
+  }
+
+  Registry &Registry::global() {
+    static Registry registry;
+    return registry;
+  }
+
+  Registry::Family &Registry::family(const std::string &name,
+                                     const std::string &help,
+                                     MetricType type) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+      it = families_.emplace(name, Family{type, help, {}, {}, {}}).first;
+    }
+    // the same name must not be used for metrics of different types
+    assert(it->second.type == type);
+    return it->second;
+  }
+
+  Counter &Registry::counter(const std::string &name, const std::string &help,
+                             const Labels &labels) {
+    std::lock_guard lock(mutex_);
+    auto &metric =
+        family(name, help, MetricType::COUNTER).counters[labels];
+    if (!metric) {
+      metric = std::make_unique<Counter>();
+    }
+    return *metric;
+  }
+
+  Gauge &Registry::gauge(const std::string &name, const std::string &help,
+                         const Labels &labels) {
+    std::lock_guard lock(mutex_);
+    auto &metric = family(name, help, MetricType::GAUGE).gauges[labels];
+    if (!metric) {
+      metric = std::make_unique<Gauge>();
+    }
+    return *metric;
+  }
+
+  Histogram &Registry::histogram(const std::string &name,
+                                 const std::string &help,
+                                 const std::vector<double> &bounds,
+                                 const Labels &labels) {
+    std::lock_guard lock(mutex_);
+    auto &metric =
+        family(name, help, MetricType::HISTOGRAM).histograms[labels];
+    if (!metric) {
+      metric = std::make_unique<Histogram>(bounds);
+    }
+    return *metric;
+  }
+
+}  // namespace libp2p::metrics
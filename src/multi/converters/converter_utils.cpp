@@ -5,6 +5,9 @@
 
 #include <libp2p/multi/converters/converter_utils.hpp>
 
+#include <algorithm>
+#include <cctype>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/asio/ip/address_v6.hpp>
@@ -15,14 +18,14 @@
 #include <libp2p/multi/converters/ip_v4_converter.hpp>
 #include <libp2p/multi/converters/ip_v6_converter.hpp>
 #include <libp2p/multi/converters/ipfs_converter.hpp>
+#include <libp2p/multi/converters/memory_converter.hpp>
 #include <libp2p/multi/converters/tcp_converter.hpp>
 #include <libp2p/multi/converters/udp_converter.hpp>
 #include <libp2p/multi/multiaddress_protocol_list.hpp>
-#include <libp2p/multi/multibase_codec/multibase_codec_impl.hpp>
+#include <libp2p/multi/multibase_codec/codecs/base58.hpp>
 #include <libp2p/multi/uvarint.hpp>
 #include <libp2p/outcome/outcome.hpp>
 
-using libp2p::common::hex_upper;
 using libp2p::common::unhex;
 
 namespace libp2p::multi::converters {
@@ -90,6 +93,8 @@ namespace libp2p::multi::converters {
         return UdpConverter::addressToHex(addr);
       case Protocol::Code::P2P:
         return IpfsConverter::addressToHex(addr);
+      case Protocol::Code::MEMORY:
+        return MemoryConverter::addressToHex(addr);
 
       case Protocol::Code::DNS:
       case Protocol::Code::DNS4:
@@ -113,134 +118,160 @@ namespace libp2p::multi::converters {
     }
   }
 
-  outcome::result<std::string> bytesToMultiaddrString(
-      gsl::span<const uint8_t> bytes) {
-    std::string results;
-
-    size_t lastpos = 0;
+  namespace {
+    /// Reads varint without allocations, returns its size or 0 on error
+    size_t readVarint(gsl::span<const uint8_t> bytes, uint64_t &value) {
+      auto size = UVarint::calculateSize(bytes);
+      value = 0;
+      for (size_t i = 0; i < size; ++i) {
+        value |= static_cast<uint64_t>(bytes[i] & 0x7f) << (7 * i);
+      }
+      return size;
+    }
 
-    // set up variables
-    const std::string hex = hex_upper(bytes);
+    bool isDomainName(gsl::span<const uint8_t> value) {
+      return std::all_of(value.begin(), value.end(), [](uint8_t c) {
+        return std::isalnum(c) || c == '-' || c == '.';
+      });
+    }
 
-    // Process Hex String
-    while (lastpos < (size_t)bytes.size() * 2) {
-      gsl::span<const uint8_t, -1> pid_bytes{bytes};
-      int protocol_int = UVarint(pid_bytes.subspan(lastpos / 2)).toUInt64();
-      Protocol const *protocol =
-          ProtocolList::get(static_cast<Protocol::Code>(protocol_int));
-      if (protocol == nullptr) {
-        return ConversionError::NO_SUCH_PROTOCOL;
+    /// Reads big-endian unsigned integer of value size
+    uint64_t readBigEndian(gsl::span<const uint8_t> value) {
+      uint64_t n = 0;
+      for (auto byte : value) {
+        n = (n << 8) | byte;
       }
+      return n;
+    }
 
-      if (protocol->code != Protocol::Code::P2P) {
-        lastpos = lastpos
-            + UVarint::calculateSize(pid_bytes.subspan(lastpos / 2)) * 2;
-        std::string address;
-        address = hex.substr(lastpos, protocol->size / 4);
+    /// Checks if the value can be rendered, sizes are checked by reader
+    outcome::result<void> checkValue(const MultiaddrComponent &component) {
+      switch (component.protocol->code) {
+        case Protocol::Code::IP4:
+        case Protocol::Code::IP6:
+        case Protocol::Code::TCP:
+        case Protocol::Code::UDP:
+        case Protocol::Code::MEMORY:
+        case Protocol::Code::P2P:
+          return outcome::success();
+
+        case Protocol::Code::DNS:
+        case Protocol::Code::DNS4:
+        case Protocol::Code::DNS6:
+        case Protocol::Code::DNS_ADDR:
+          if (!isDomainName(component.value)) {
+            return ConversionError::INVALID_ADDRESS;
+          }
+          return outcome::success();
 
-        lastpos = lastpos + (protocol->size / 4);
+        default:
+          if (component.protocol->size == 0) {
+            return outcome::success();
+          }
+          return ConversionError::NOT_IMPLEMENTED;
+      }
+    }
+  }  // namespace
 
-        results += "/";
-        results += protocol->name;
+  outcome::result<size_t> readMultiaddrComponent(
+      gsl::span<const uint8_t> bytes, MultiaddrComponent &component) {
+    uint64_t code = 0;
+    auto code_size = readVarint(bytes, code);
+    if (code_size == 0) {
+      return ConversionError::INVALID_ADDRESS;
+    }
+    component.protocol =
+        ProtocolList::get(static_cast<Protocol::Code>(code));
+    if (component.protocol == nullptr) {
+      return ConversionError::NO_SUCH_PROTOCOL;
+    }
+    auto rest = bytes.subspan(code_size);
+
+    uint64_t value_size = 0;
+    size_t prefix_size = 0;
+    if (component.protocol->size == Protocol::kVarLen) {
+      prefix_size = readVarint(rest, value_size);
+      if (prefix_size == 0) {
+        return ConversionError::INVALID_ADDRESS;
+      }
+      rest = rest.subspan(prefix_size);
+    } else {
+      value_size = component.protocol->size / 8;
+    }
+    if (value_size > static_cast<uint64_t>(rest.size())) {
+      return ConversionError::INVALID_ADDRESS;
+    }
 
-        if (protocol->size == 0) {
-          continue;
-        }
+    component.value = rest.first(value_size);
+    return code_size + prefix_size + value_size;
+  }
 
-        try {
-          switch (protocol->code) {
-            case Protocol::Code::DNS:
-            case Protocol::Code::DNS4:
-            case Protocol::Code::DNS6:
-            case Protocol::Code::DNS_ADDR: {
-              // fetch the size of the address based on the varint prefix
-              auto prefixedvarint = hex.substr(lastpos, 2);
-              OUTCOME_TRY(prefixBytes, unhex(prefixedvarint));
-
-              auto addrsize = UVarint(prefixBytes).toUInt64();
-
-              // get the ipfs address as hex values
-              auto hex_domain_name = hex.substr(lastpos + 2, addrsize * 2);
-              OUTCOME_TRY(domain_name, unhex(hex_domain_name));
-
-              lastpos += addrsize * 2 + 2;
-
-              // Add domain name
-              results += "/";
-              results += std::string(domain_name.begin(), domain_name.end());
-
-              auto i = std::find_if_not(
-                  domain_name.begin(), domain_name.end(), [](auto c) {
-                    return std::isalnum(c) || c == '-' || c == '.';
-                  });
-              if (i != domain_name.end()) {
-                return ConversionError::INVALID_ADDRESS;
-              }
-              break;
-            }
-
-            case Protocol::Code::IP4: {
-              // Add IP
-              results += "/";
-              results += boost::asio::ip::make_address_v4(
-                             std::stoul(address, nullptr, 16))
-                             .to_string();
-              break;
-            }
-
-            case Protocol::Code::IP6: {
-              // Add IP
-              OUTCOME_TRY(addr_bytes, unhex(address));
-              std::array<uint8_t, 16> arr{};
-              std::copy_n(addr_bytes.begin(), 16, arr.begin());
-              results += "/";
-              results += boost::asio::ip::make_address_v6(arr).to_string();
-              break;
-            }
-
-            case Protocol::Code::TCP:
-            case Protocol::Code::UDP: {
-              // Add port
-              results += "/";
-              results += std::to_string(std::stoul(address, nullptr, 16));
-              break;
-            }
-
-            case Protocol::Code::QUIC:
-            case Protocol::Code::WS:
-            case Protocol::Code::WSS:
-              // No details
-              break;
-
-            default:
-              return ConversionError::NOT_IMPLEMENTED;
-          }
-        } catch (const std::exception &e) {
-          return ConversionError::INVALID_ADDRESS;
-        }
+  outcome::result<void> validateMultiaddrBytes(
+      gsl::span<const uint8_t> bytes) {
+    MultiaddrComponent component;
+    while (!bytes.empty()) {
+      OUTCOME_TRY(size, readMultiaddrComponent(bytes, component));
+      OUTCOME_TRY(checkValue(component));
+      bytes = bytes.subspan(size);
+    }
+    return outcome::success();
+  }
 
-      } else {
-        lastpos = lastpos + 4;
-        // fetch the size of the address based on the varint prefix
-        auto prefixedvarint = hex.substr(lastpos, 2);
-        OUTCOME_TRY(prefixBytes, unhex(prefixedvarint));
-
-        auto addrsize = UVarint(prefixBytes).toUInt64();
-
-        // get the ipfs address as hex values
-        auto ipfsAddr = hex.substr(lastpos + 2, addrsize * 2);
-
-        // convert the address from hex values to a binary array
-        OUTCOME_TRY(addrbuf, unhex(ipfsAddr));
-        auto encode_res = MultibaseCodecImpl{}.encode(
-            addrbuf, MultibaseCodecImpl::Encoding::BASE58);
-        encode_res.erase(0, 1);  // because multibase contains a char that
-                                 // denotes which base is used
-        results += "/p2p/" + encode_res;
-        lastpos += addrsize * 2 + 2;
+  outcome::result<void> appendMultiaddrValue(
+      std::string &out, const MultiaddrComponent &component) {
+    OUTCOME_TRY(checkValue(component));
+    const auto &value = component.value;
+    switch (component.protocol->code) {
+      case Protocol::Code::IP4:
+        out += boost::asio::ip::make_address_v4(
+                   static_cast<uint32_t>(readBigEndian(value)))
+                   .to_string();
+        break;
+
+      case Protocol::Code::IP6: {
+        boost::asio::ip::address_v6::bytes_type arr{};
+        std::copy(value.begin(), value.end(), arr.begin());
+        out += boost::asio::ip::make_address_v6(arr).to_string();
+        break;
       }
+
+      case Protocol::Code::TCP:
+      case Protocol::Code::UDP:
+      case Protocol::Code::MEMORY:
+        out += std::to_string(readBigEndian(value));
+        break;
+
+      case Protocol::Code::DNS:
+      case Protocol::Code::DNS4:
+      case Protocol::Code::DNS6:
+      case Protocol::Code::DNS_ADDR:
+        out.append(value.begin(), value.end());
+        break;
+
+      case Protocol::Code::P2P:
+        out += detail::encodeBase58(value);
+        break;
+
+      default:
+        break;
     }
+    return outcome::success();
+  }
 
+  outcome::result<std::string> bytesToMultiaddrString(
+      gsl::span<const uint8_t> bytes) {
+    std::string results;
+    MultiaddrComponent component;
+    while (!bytes.empty()) {
+      OUTCOME_TRY(size, readMultiaddrComponent(bytes, component));
+      results += '/';
+      results += component.protocol->name;
+      if (component.protocol->size != 0) {
+        results += '/';
+        OUTCOME_TRY(appendMultiaddrValue(results, component));
+      }
+      bytes = bytes.subspan(size);
+    }
     return results;
   }
 
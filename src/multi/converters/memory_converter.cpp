@@ -0,0 +1,34 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/multi/converters/memory_converter.hpp>
+
+#include <cctype>
+#include <string>
+
+#include <libp2p/common/hexutil.hpp>
+#include <libp2p/multi/converters/conversion_error.hpp>
+
+namespace libp2p::multi::converters {
+
+  auto MemoryConverter::addressToHex(std::string_view addr)
+      -> outcome::result<std::string> {
+    if (addr.empty()) {
+      return ConversionError::INVALID_ADDRESS;
+    }
+    for (auto &c : addr) {
+      if (std::isdigit(c) == 0) {
+        return ConversionError::INVALID_ADDRESS;
+      }
+    }
+    uint64_t n = 0;
+    try {
+      n = std::stoull(std::string(addr));
+    } catch (std::exception &e) {
+      return ConversionError::INVALID_ADDRESS;
+    }
+    return common::int_to_hex(n, 16);
+  }
+}  // namespace libp2p::multi::converters
@@ -6,32 +6,40 @@
 #include <libp2p/multi/multiaddress.hpp>
 
 #include <algorithm>
-#include <numeric>
-#include <stdexcept>
+#include <atomic>
 
-#include <boost/algorithm/string/classification.hpp>
-#include <boost/algorithm/string/split.hpp>
+#include <boost/assert.hpp>
 #include <libp2p/multi/converters/converter_utils.hpp>
 
-using std::string_literals::operator""s;
-
 namespace {
+  using libp2p::multi::converters::MultiaddrComponent;
 
   /**
-   * Find all occurrences of the string in other string
-   * @param string to search in
-   * @param substring to be searched for
-   * @return vector with positions of all occurrences of that substring
+   * Calls f(component, offset of the component) for each component of
+   * validated multiaddr bytes while f returns true
    */
-  std::vector<size_t> findSubstringOccurrences(std::string_view string,
-                                               std::string_view substring) {
-    std::vector<size_t> occurrences;
-    auto occurrence = string.find(substring);
-    while (occurrence != std::string_view::npos) {
-      occurrences.push_back(occurrence);
-      occurrence = string.find(substring, occurrence + substring.size());
+  template <typename F>
+  void forEachComponent(gsl::span<const uint8_t> bytes, const F &f) {
+    MultiaddrComponent component;
+    size_t offset = 0;
+    while (offset < static_cast<size_t>(bytes.size())) {
+      auto size_res = libp2p::multi::converters::readMultiaddrComponent(
+          bytes.subspan(offset), component);
+      BOOST_ASSERT(size_res.has_value());
+      if (!size_res or !f(component, offset)) {
+        return;
+      }
+      offset += size_res.value();
     }
-    return occurrences;
+  }
+
+  /// Renders value of validated component
+  std::string valueToString(const MultiaddrComponent &component) {
+    std::string value;
+    auto res = libp2p::multi::converters::appendMultiaddrValue(value,
+                                                               component);
+    BOOST_ASSERT(res.has_value());
+    return value;
   }
 }  // namespace
 
@@ -50,118 +58,144 @@ OUTCOME_CPP_DEFINE_CATEGORY(libp2p::multi, Multiaddress::Error, e) {
 }
 
 namespace libp2p::multi {
-  using std::string_literals::operator""s;
 
   Multiaddress::FactoryResult Multiaddress::create(std::string_view address) {
     // convert string address to bytes and make sure they represent valid
     // address
     auto bytes_result = converters::multiaddrToBytes(address);
-    if (!bytes_result) {
+    if (!bytes_result
+        or !converters::validateMultiaddrBytes(bytes_result.value())) {
       return Error::INVALID_INPUT;
     }
-    auto &&bytes = bytes_result.value();
-
-    auto str_res = converters::bytesToMultiaddrString(bytes);
-    BOOST_ASSERT(str_res.has_value());
-    auto &&str = str_res.value();
-
-    return Multiaddress{
-        std::move(str),
-        ByteBuffer{std::vector<uint8_t>{bytes.begin(), bytes.end()}}};
+    return Multiaddress{std::move(bytes_result.value())};
   }
 
   Multiaddress::FactoryResult Multiaddress::create(
       gsl::span<const uint8_t> bytes) {
-    auto conversion_res = converters::bytesToMultiaddrString(bytes);
-    if (!conversion_res) {
+    if (!converters::validateMultiaddrBytes(bytes)) {
       return Error::INVALID_INPUT;
     }
-
-    std::string s = conversion_res.value();
-    return Multiaddress{std::move(s), ByteBuffer(bytes.begin(), bytes.end())};
+    return Multiaddress{ByteBuffer(bytes.begin(), bytes.end())};
   }
 
   Multiaddress::FactoryResult Multiaddress::create(const ByteBuffer &bytes) {
     return create(gsl::span<const uint8_t>(bytes));
   }
 
-  Multiaddress::Multiaddress(std::string &&address, ByteBuffer &&bytes)
-      : stringified_address_{std::move(address)}, bytes_{std::move(bytes)} {}
+  Multiaddress::Multiaddress(ByteBuffer &&bytes) : bytes_{std::move(bytes)} {}
 
-  void Multiaddress::encapsulate(const Multiaddress &address) {
-    stringified_address_ += address.stringified_address_;
+  Multiaddress::Multiaddress(const Multiaddress &other)
+      : bytes_{other.bytes_},
+        stringified_address_{std::atomic_load(&other.stringified_address_)} {}
+
+  Multiaddress &Multiaddress::operator=(const Multiaddress &other) {
+    if (this != &other) {
+      bytes_ = other.bytes_;
+      std::atomic_store(&stringified_address_,
+                        std::atomic_load(&other.stringified_address_));
+    }
+    return *this;
+  }
+
+  Multiaddress::Multiaddress(Multiaddress &&other) noexcept
+      : bytes_{std::move(other.bytes_)},
+        stringified_address_{
+            std::atomic_exchange(&other.stringified_address_,
+                                 std::shared_ptr<const std::string>{})} {}
+
+  Multiaddress &Multiaddress::operator=(Multiaddress &&other) noexcept {
+    if (this != &other) {
+      bytes_ = std::move(other.bytes_);
+      std::atomic_store(
+          &stringified_address_,
+          std::atomic_exchange(&other.stringified_address_,
+                               std::shared_ptr<const std::string>{}));
+    }
+    return *this;
+  }
+
+  void Multiaddress::bytesChanged() {
+    std::atomic_store(&stringified_address_, {});
+  }
 
+  void Multiaddress::encapsulate(const Multiaddress &address) {
     const auto &other_bytes = address.bytes_;
     bytes_.insert(bytes_.end(), other_bytes.begin(), other_bytes.end());
+    bytesChanged();
   }
 
   bool Multiaddress::decapsulate(const Multiaddress &address) {
-    return decapsulateStringFromAddress(address.stringified_address_,
-                                        address.bytes_);
-  }
-
-  bool Multiaddress::decapsulate(Protocol::Code proto) {
-    auto p = ProtocolList::get(proto);
-    if (p == nullptr) {
+    const auto &other = address.bytes_;
+    boost::optional<size_t> found;
+    auto matches = [&](size_t offset) {
+      return bytes_.size() - offset >= other.size()
+          and std::equal(other.begin(), other.end(), bytes_.begin() + offset);
+    };
+    forEachComponent(bytes_, [&](const MultiaddrComponent &, size_t offset) {
+      if (matches(offset)) {
+        found = offset;
+      }
+      return true;
+    });
+    if (not found and matches(bytes_.size())) {
+      found = bytes_.size();
+    }
+    if (not found) {
       return false;
     }
+    bytes_.resize(*found);
+    bytesChanged();
+    return true;
+  }
 
-    std::string proto_str = '/' + std::string(p->name);
-    auto proto_bytes = converters::multiaddrToBytes(proto_str);
-    if (!proto_bytes) {
+  bool Multiaddress::decapsulate(Protocol::Code proto) {
+    boost::optional<size_t> found;
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t offset) {
+                       if (component.protocol->code == proto) {
+                         found = offset;
+                       }
+                       return true;
+                     });
+    if (not found) {
       return false;
     }
-    return decapsulateStringFromAddress(proto_str, proto_bytes.value());
+    bytes_.resize(*found);
+    bytesChanged();
+    return true;
   }
 
   std::pair<Multiaddress, boost::optional<Multiaddress>>
   Multiaddress::splitFirst() const {
-    auto second_slash = stringified_address_.find('/', 1);
-    if (second_slash == std::string::npos) {
-      return {*this, boost::none};
-    }
-
-    auto third_slash = stringified_address_.find('/', second_slash + 1);
-    if (third_slash == std::string::npos) {
-      return {*this, boost::none};
-    }
-
-    // it's safe to get values in-place, as parts of Multiaddress are guaranteed
-    // to be valid Multiaddresses themselves
-    return {create(stringified_address_.substr(0, third_slash)).value(),
-            create(stringified_address_.substr(third_slash)).value()};
-  }
-
-  bool Multiaddress::decapsulateStringFromAddress(std::string_view proto,
-                                                  const ByteBuffer &bytes) {
-    auto str_pos = stringified_address_.rfind(proto);
-    if (proto == "/p2p" or proto == "/ipfs") {
-      auto alt_pos =
-          stringified_address_.rfind(proto == "/ipfs" ? "/p2p" : "/ipfs");
-      if (alt_pos != std::string::npos) {
-        if (str_pos == std::string::npos) {
-          str_pos = alt_pos;
-        } else {
-          str_pos = std::max(str_pos, alt_pos);
-        }
+    size_t first_size = bytes_.size();
+    forEachComponent(bytes_, [&](const MultiaddrComponent &, size_t offset) {
+      if (offset == 0) {
+        return true;
       }
-    }
-    if (str_pos == std::string::npos) {
+      first_size = offset;
       return false;
+    });
+    if (first_size == bytes_.size()) {
+      return {*this, boost::none};
     }
-    stringified_address_.erase(str_pos);
 
-    const auto &this_bytes = bytes_;
-    const auto &other_bytes = bytes;
-    auto bytes_pos = std::find_end(this_bytes.begin(), this_bytes.end(),
-                                   other_bytes.begin(), other_bytes.end());
-    bytes_ = ByteBuffer{this_bytes.begin(), bytes_pos};
-
-    return true;
+    // parts of Multiaddress are guaranteed to be valid Multiaddresses
+    // themselves
+    return {Multiaddress{ByteBuffer(bytes_.begin(),
+                                    bytes_.begin() + first_size)},
+            Multiaddress{
+                ByteBuffer(bytes_.begin() + first_size, bytes_.end())}};
   }
 
-  std::string_view Multiaddress::getStringAddress() const {
-    return stringified_address_;
+  std::string Multiaddress::getStringAddress() const {
+    auto cached = std::atomic_load(&stringified_address_);
+    if (!cached) {
+      auto str_res = converters::bytesToMultiaddrString(bytes_);
+      BOOST_ASSERT(str_res.has_value());
+      cached = std::make_shared<const std::string>(std::move(str_res.value()));
+      std::atomic_store(&stringified_address_, cached);
+    }
+    return *cached;
   }
 
   const Multiaddress::ByteBuffer &Multiaddress::getBytesAddress() const {
@@ -169,120 +203,93 @@ namespace libp2p::multi {
   }
 
   boost::optional<std::string> Multiaddress::getPeerId() const {
-    auto peer_id = getValuesForProtocol(Protocol::Code::P2P);
-    if (peer_id.empty()) {
-      return {};
-    }
-    return peer_id[0];
+    boost::optional<std::string> peer_id;
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t) {
+                       if (component.protocol->code != Protocol::Code::P2P) {
+                         return true;
+                       }
+                       peer_id = valueToString(component);
+                       return false;
+                     });
+    return peer_id;
   }
 
   std::vector<std::string> Multiaddress::getValuesForProtocol(
       Protocol::Code proto) const {
     std::vector<std::string> values;
-    auto protocol = ProtocolList::get(proto);
-    if (protocol == nullptr) {
-      return {};
-    }
-    auto proto_str = "/"s + std::string(protocol->name) + "/";
-    auto proto_positions =
-        findSubstringOccurrences(stringified_address_, proto_str);
-    if (proto == Protocol::Code::P2P) {  // ipfs and p2p are equivalent
-      auto ipfs_occurences =
-          findSubstringOccurrences(stringified_address_, "/ipfs"s);
-      proto_positions.insert(proto_positions.end(), ipfs_occurences.begin(),
-                             ipfs_occurences.end());
-    }
-
-    for (const auto &pos : proto_positions) {
-      auto value_pos = stringified_address_.find_first_of('/', pos + 1) + 1;
-      auto value_end = stringified_address_.find_first_of('/', value_pos);
-      values.push_back(
-          stringified_address_.substr(value_pos, value_end - value_pos));
-    }
-
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t) {
+                       if (component.protocol->code == proto) {
+                         values.push_back(valueToString(component));
+                       }
+                       return true;
+                     });
     return values;
   }
 
   std::list<Protocol> Multiaddress::getProtocols() const {
-    std::string_view addr{stringified_address_};
-    addr.remove_prefix(1);
-
-    std::list<std::string> tokens;
-
-    boost::algorithm::split(tokens, addr, boost::algorithm::is_any_of("/"));
-
     std::list<Protocol> protocols;
-    for (auto &token : tokens) {
-      auto p = ProtocolList::get(token);
-      if (p != nullptr) {
-        protocols.emplace_back(*p);
-      }
-    }
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t) {
+                       protocols.emplace_back(*component.protocol);
+                       return true;
+                     });
     return protocols;
   }
 
   std::vector<std::pair<Protocol, std::string>>
   Multiaddress::getProtocolsWithValues() const {
-    std::string_view addr{stringified_address_};
-    addr.remove_prefix(1);
-    if (addr.back() == '/') {
-      addr.remove_suffix(1);
-    }
-
-    std::vector<std::string> tokens;
-
-    boost::algorithm::split(tokens, addr, boost::algorithm::is_any_of("/"));
-
     std::vector<std::pair<Protocol, std::string>> pvs;
-    for (auto &token : tokens) {
-      auto p = ProtocolList::get(token);
-      if (p != nullptr) {
-        pvs.emplace_back(*p, "");
-      } else {
-        auto &s = pvs.back().second;
-        if (!s.empty()) {
-          s += "/";
-        }
-        s += token;
-      }
-    }
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t) {
+                       pvs.emplace_back(*component.protocol,
+                                        valueToString(component));
+                       return true;
+                     });
     return pvs;
   }
 
   bool Multiaddress::operator==(const Multiaddress &other) const {
-    return this->stringified_address_ == other.stringified_address_
-        && this->bytes_ == other.bytes_;
+    return this->bytes_ == other.bytes_;
   }
 
   outcome::result<std::string> Multiaddress::getFirstValueForProtocol(
       Protocol::Code proto) const {
-    // TODO(@warchant): refactor it to be more performant. this isn't best
-    // solution
-    auto vec = getValuesForProtocol(proto);
-    if (vec.empty()) {
+    boost::optional<std::string> value;
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t) {
+                       if (component.protocol->code != proto) {
+                         return true;
+                       }
+                       value = valueToString(component);
+                       return false;
+                     });
+    if (not value) {
       return Error::PROTOCOL_NOT_FOUND;
     }
-
-    return vec[0];
+    return std::move(*value);
   }
 
   bool Multiaddress::operator<(const Multiaddress &other) const {
-    return this->stringified_address_ < other.stringified_address_;
+    return this->bytes_ < other.bytes_;
   }
 
   bool Multiaddress::hasProtocol(Protocol::Code code) const {
-    auto p = ProtocolList::get(code);
-    if (p == nullptr) {
-      return false;
-    }
-
-    auto str = '/' + std::string(p->name) + '/';
-    return this->stringified_address_.find(str) != std::string::npos;
+    bool found = false;
+    forEachComponent(bytes_,
+                     [&](const MultiaddrComponent &component, size_t) {
+                       found = component.protocol->code == code;
+                       return not found;
+                     });
+    return found;
   }
 
 }  // namespace libp2p::multi
 
 size_t std::hash<libp2p::multi::Multiaddress>::operator()(
     const libp2p::multi::Multiaddress &x) const {
-  return std::hash<std::string_view>()(x.getStringAddress());
+  const auto &bytes = x.getBytesAddress();
+  return std::hash<std::string_view>()(std::string_view(
+      reinterpret_cast<const char *>(bytes.data()), bytes.size()));
 }
@@ -6,9 +6,8 @@
 #include <libp2p/multi/multibase_codec/codecs/base58.hpp>
 
 #include <array>
-#include <cstring>
+#include <vector>
 
-#include <boost/optional.hpp>
 #include <libp2p/multi/multibase_codec/codecs/base_error.hpp>
 
 namespace {
@@ -48,134 +47,174 @@ namespace {
     return c == ' ' || c == '\f' || c == '\n' || c == '\r' || c == '\t'
         || c == '\v';
   }
-}  // namespace
 
-namespace libp2p::multi::detail {
+  /// Base58 digits are processed in groups of 5, which fit uint32 limb
+  constexpr size_t kDigitsPerLimb = 5;
+  constexpr uint64_t kBase58Limb = 58ull * 58 * 58 * 58 * 58;
 
-  /**
-   * Actual implementation of the encoding
-   * @param pbegin - pointer to the beginning of bytes collection
-   * @param pend - pointer to the end of bytes collection
-   * @return encoded string
-   */
-  std::string encodeImpl(const unsigned char *pbegin,
-                         const unsigned char *pend) {
-    // Skip & count leading zeroes.
-    int zeroes = 0;
-    int length = 0;
-    while (pbegin != pend && *pbegin == 0) {
-      std::advance(pbegin, 1);
-      zeroes++;
-    }
-    // Allocate enough space in big-endian base58 representation.
-    // log(256) / log(58), rounded up.
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    int size = (pend - pbegin) * 138 / 100 + 1;
-    std::vector<unsigned char> b58(size);
-    // Process the bytes.
-    while (pbegin != pend) {
-      int carry = *pbegin;
-      int i = 0;
-      // Apply "b58 = b58 * 256 + ch".
-      for (auto it = b58.rbegin();
-           (carry != 0 || i < length) && (it != b58.rend()); it++, i++) {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
-      }
+  /// Bytes are processed in groups of 4, i.e. base 2^32 limbs
+  constexpr size_t kBytesPerLimb = 4;
 
-      length = i;
-      std::advance(pbegin, 1);
+  /// Scratch limbs are on stack up to this count, which covers multihashes
+  /// of peer ids and keys; longer inputs use heap
+  constexpr size_t kStackLimbs = 32;
+
+  /// Big number as big-endian sequence of limbs
+  class Limbs {
+   public:
+    explicit Limbs(size_t size) : size_(size) {
+      if (size_ > kStackLimbs) {
+        heap_.resize(size_);
+      }
     }
-    // Skip leading zeroes in base58 result.
-    auto it = b58.begin() + (size - length);
-    while (it != b58.end() && *it == 0) {
-      it++;
+
+    uint32_t *begin() {
+      return heap_.empty() ? stack_.data() : heap_.data();
     }
-    // Translate the result into a string.
-    std::string str;
-    str.reserve(zeroes + (b58.end() - it));
-    str.assign(zeroes, '1');
-    while (it != b58.end()) {
-      str += pszBase58[*it];
-      std::advance(it, 1);
+
+    uint32_t *end() {
+      return begin() + size_;
     }
-    return str;
-  }
+
+   private:
+    size_t size_;
+    std::array<uint32_t, kStackLimbs> stack_{};
+    std::vector<uint32_t> heap_;
+  };
 
   /**
-   * Actual implementation of the decoding
-   * @param psz - pointer to the string to be decoded
-   * @return decoded bytes, if the process went successfully, none otherwise
+   * Multiplies big number of limbs [begin, end) by multiplier and adds
+   * value, base of limbs is given. Only lowest "used" limbs can be nonzero.
+   * @return new count of used limbs
    */
-  boost::optional<std::vector<unsigned char>> decodeImpl(const char *psz) {
-    // Skip leading spaces.
-    while ((*psz != '0') && isSpace(*psz)) {
-      std::advance(psz, 1);
+  size_t mulAdd(uint32_t *begin, uint32_t *end, size_t used,
+                uint64_t multiplier, uint64_t value, uint64_t base) {
+    uint64_t carry = value;
+    size_t i = 0;
+    for (auto it = end; it != begin && (carry != 0 || i < used); ++i) {
+      --it;
+      carry += *it * multiplier;
+      *it = static_cast<uint32_t>(carry % base);
+      carry /= base;
+    }
+    return i;
+  }
+}  // namespace
+
+namespace libp2p::multi::detail {
+
+  std::string encodeBase58(gsl::span<const uint8_t> bytes) {
+    auto begin = bytes.begin();
+    auto end = bytes.end();
+
+    size_t zeroes = 0;
+    while (begin != end && *begin == 0) {
+      ++begin;
+      ++zeroes;
     }
-    // Skip and count leading '1's.
-    int zeroes = 0;
-    int length = 0;
-    while (*psz == '1') {
-      zeroes++;
-      std::advance(psz, 1);
+    auto size = static_cast<size_t>(end - begin);
+
+    // log(256) / log(58^5), rounded up
+    Limbs b58(size * 138 / 100 / kDigitsPerLimb + 2);
+    size_t used = 0;
+
+    // "b58 = b58 * 256^n + next n bytes", first group is the shortest one
+    auto group = size % kBytesPerLimb;
+    if (group == 0) {
+      group = kBytesPerLimb;
     }
-    // Allocate enough space in big-endian base256 representation.
-    // log(58) / log(256), rounded up.
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    int size = strlen(psz) * 733 / 1000 + 1;
-    std::vector<unsigned char> b256(size);
-    // Process the characters.
-    while (*psz && !isSpace(*psz)) {  // NOLINT
-      // Decode base58 character
-      int carry = mapBase58.at(static_cast<uint8_t>(*psz));
-      if (carry == -1) {  // Invalid b58 character
-        return {};
+    while (begin != end) {
+      uint64_t value = 0;
+      for (size_t i = 0; i < group; ++i, ++begin) {
+        value = (value << 8) | *begin;
       }
-      int i = 0;
-      for (auto it = b256.rbegin();
-           (carry != 0 || i < length) && (it != b256.rend()); ++it, ++i) {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
+      used = mulAdd(b58.begin(), b58.end(), used, 1ull << (8 * group), value,
+                    kBase58Limb);
+      group = kBytesPerLimb;
+    }
+
+    std::array<char, kDigitsPerLimb> digits{};
+    std::string str;
+    str.reserve(zeroes + used * kDigitsPerLimb);
+    str.assign(zeroes, '1');
+    for (auto it = b58.end() - used; it != b58.end(); ++it) {
+      uint32_t limb = *it;
+      for (auto d = digits.rbegin(); d != digits.rend(); ++d) {
+        *d = pszBase58[limb % 58];
+        limb /= 58;
       }
-      if (carry != 0) {
-        return {};
+      auto first = digits.begin();
+      if (str.size() == zeroes) {
+        // skip leading zero digits of the most significant limb
+        while (first != digits.end() && *first == '1') {
+          ++first;
+        }
       }
-      length = i;
-      std::advance(psz, 1);
+      str.append(first, digits.end());
     }
-    // Skip trailing spaces.
-    while (isSpace(*psz)) {
-      std::advance(psz, 1);
-    }
-    if (*psz != 0) {
-      return {};
-    }
-    // Skip leading zeroes in b256.
-    auto it = b256.begin() + (size - length);
-    while (it != b256.end() && *it == 0) {
-      it++;
-    }
-    // Copy result into output vector.
-    std::vector<unsigned char> vch(zeroes + (b256.end() - it));
-    vch.assign(zeroes, 0x00);
-    while (it != b256.end()) {
-      vch.push_back(*(it++));
-    }
-    return vch;
+    return str;
   }
 
   std::string encodeBase58(const common::ByteArray &bytes) {
-    return encodeImpl(bytes.begin().base(), bytes.end().base());
+    return encodeBase58(gsl::span<const uint8_t>(bytes));
   }
 
   outcome::result<common::ByteArray> decodeBase58(std::string_view string) {
-    auto decoded_bytes = decodeImpl(string.data());
-    if (decoded_bytes) {
-      return common::ByteArray{*decoded_bytes};
+    auto begin = string.begin();
+    auto end = string.end();
+
+    while (begin != end && isSpace(*begin)) {
+      ++begin;
+    }
+    while (end != begin && isSpace(*(end - 1))) {
+      --end;
+    }
+
+    size_t zeroes = 0;
+    while (begin != end && *begin == '1') {
+      ++begin;
+      ++zeroes;
+    }
+    auto size = static_cast<size_t>(end - begin);
+
+    // log(58) / log(2^32), rounded up
+    Limbs b256(size * 733 / 1000 / kBytesPerLimb + 2);
+    size_t used = 0;
+
+    // "b256 = b256 * 58^n + next n digits", first group is the shortest one
+    auto group = size % kDigitsPerLimb;
+    if (group == 0) {
+      group = kDigitsPerLimb;
+    }
+    while (begin != end) {
+      uint64_t value = 0;
+      uint64_t multiplier = 1;
+      for (size_t i = 0; i < group; ++i, ++begin) {
+        auto digit = mapBase58[static_cast<uint8_t>(*begin)];
+        if (digit == -1) {
+          return BaseError::INVALID_BASE58_INPUT;
+        }
+        value = value * 58 + digit;
+        multiplier *= 58;
+      }
+      used = mulAdd(b256.begin(), b256.end(), used, multiplier, value,
+                    1ull << 32);
+      group = kDigitsPerLimb;
+    }
+
+    common::ByteArray result;
+    result.reserve(zeroes + used * kBytesPerLimb);
+    result.assign(zeroes, 0);
+    for (auto it = b256.end() - used; it != b256.end(); ++it) {
+      for (int shift = 24; shift >= 0; shift -= 8) {
+        auto byte = static_cast<uint8_t>(*it >> shift);
+        // skip leading zero bytes of the most significant limb
+        if (byte != 0 || result.size() != zeroes) {
+          result.push_back(byte);
+        }
+      }
     }
-    return BaseError::INVALID_BASE58_INPUT;
+    return result;
   }
 
 }  // namespace libp2p::multi::detail
@@ -10,14 +10,8 @@
 namespace libp2p::multi {
   using common::hex_upper;
 
-  UVarint::UVarint(uint64_t number) {
-    do {
-      uint8_t byte = static_cast<uint8_t>(number) & 0x7f;
-      number >>= 7;
-      if (number != 0)
-        byte |= 0x80;
-      bytes_.push_back(byte);
-    } while (number != 0);
+  UVarint::UVarint(uint64_t number) : bytes_(encodedSize(number)) {
+    encode(number, bytes_);
   }
 
   UVarint::UVarint(gsl::span<const uint8_t> varint_bytes)
@@ -101,4 +95,25 @@ namespace libp2p::multi {
     return last_byte_found ? size : 0;
   }
 
+  size_t UVarint::encodedSize(uint64_t number) {
+    size_t size = 1;
+    while (number >= 0x80) {
+      number >>= 7;
+      ++size;
+    }
+    return size;
+  }
+
+  size_t UVarint::encode(uint64_t number, gsl::span<uint8_t> out) {
+    size_t size = 0;
+    do {
+      uint8_t byte = static_cast<uint8_t>(number) & 0x7f;
+      number >>= 7;
+      if (number != 0)
+        byte |= 0x80;
+      out[size++] = byte;
+    } while (number != 0);
+    return size;
+  }
+
 }  // namespace libp2p::multi
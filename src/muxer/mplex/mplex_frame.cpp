@@ -5,31 +5,41 @@
 
 #include <libp2p/muxer/mplex/mplex_frame.hpp>
 
-#include <libp2p/basic/varint_reader.hpp>
 #include <libp2p/multi/uvarint.hpp>
 #include <libp2p/muxer/mplex/mplexed_connection.hpp>
 
 namespace libp2p::connection {
   common::ByteArray MplexFrame::toBytes() const {
     common::ByteArray result;
-
-    uint64_t id_and_flag = (stream_number << 3) | static_cast<uint8_t>(flag);
-    multi::UVarint id_and_flag_varint{id_and_flag};
-    multi::UVarint length_varint{length};
-
-    result.insert(result.end(), id_and_flag_varint.toVector().begin(),
-                  id_and_flag_varint.toVector().end());
-    result.insert(result.end(), length_varint.toVector().begin(),
-                  length_varint.toVector().end());
-    result.insert(result.end(), data.begin(), data.end());
+    appendFrame(result, flag, stream_number, data);
     return result;
   }
 
   common::ByteArray createFrameBytes(MplexFrame::Flag flag,
                                      MplexStream::StreamNumber stream_number,
                                      common::ByteArray data) {
-    return MplexFrame{flag, stream_number, data.size(), std::move(data)}
-        .toBytes();
+    common::ByteArray result;
+    appendFrame(result, flag, stream_number, data);
+    return result;
+  }
+
+  void appendFrame(common::ByteArray &out, MplexFrame::Flag flag,
+                   MplexStream::StreamNumber stream_number,
+                   gsl::span<const uint8_t> data) {
+    uint64_t id_and_flag = (static_cast<uint64_t>(stream_number) << 3)
+        | static_cast<uint8_t>(flag);
+    auto length = static_cast<uint64_t>(data.size());
+
+    auto offset = out.size();
+    auto header_size = multi::UVarint::encodedSize(id_and_flag)
+        + multi::UVarint::encodedSize(length);
+    out.resize(offset + header_size);
+    gsl::span<uint8_t> header(out);
+    header = header.subspan(offset);
+    header = header.subspan(multi::UVarint::encode(id_and_flag, header));
+    multi::UVarint::encode(length, header);
+
+    out.insert(out.end(), data.begin(), data.end());
   }
 
   outcome::result<MplexFrame> createFrame(uint64_t id_flag,
@@ -67,45 +77,4 @@ namespace libp2p::connection {
                       static_cast<MplexStream::StreamNumber>(id_flag >> 3),
                       data.size(), std::move(data)};
   }
-
-  void readFrame(std::shared_ptr<basic::ReadWriter> reader,
-                 std::function<void(outcome::result<MplexFrame>)> cb) {
-    // read first varint
-    basic::VarintReader::readVarint(
-        reader, [reader, cb{std::move(cb)}](auto &&varint_res) mutable {
-          if (varint_res.has_error()) {
-            return cb(varint_res.error());
-          }
-
-          // read second varint
-          basic::VarintReader::readVarint(
-              reader,
-              [reader, cb{std::move(cb)},
-               id_flag =
-                   varint_res.value().toUInt64()](auto &&varint_res) mutable {
-                if (varint_res.has_error()) {
-                  return cb(varint_res.error());
-                }
-
-                auto length = varint_res.value().toUInt64();
-                if (length == 0) {
-                  // no data in this frame
-                  return cb(createFrame(id_flag, {}));
-                }
-
-                // read data
-                std::shared_ptr<common::ByteArray> data =
-                    std::make_shared<common::ByteArray>(length, 0);
-                reader->read(*data, length,
-                             [id_flag, data,
-                              cb{std::move(cb)}](auto &&read_res) mutable {
-                               if (!read_res) {
-                                 return cb(read_res.error());
-                               }
-
-                               cb(createFrame(id_flag, std::move(*data)));
-                             });
-              });
-        });
-  }
 }  // namespace libp2p::connection
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/muxer/mplex/mplex_reading_state.hpp>
+
+#include <cassert>
+
+#include <libp2p/connection/raw_connection.hpp>
+
+namespace libp2p::connection {
+
+  MplexReadingState::MplexReadingState(HeaderCallback on_header,
+                                       DataCallback on_data)
+      : on_header_(std::move(on_header)), on_data_(std::move(on_data)) {
+    assert(on_header_);
+    assert(on_data_);
+  }
+
+  void MplexReadingState::onDataReceived(gsl::span<const uint8_t> bytes_read) {
+    bool proceed = true;
+    while (!bytes_read.empty() && proceed) {
+      if (data_bytes_unread_ == 0) {
+        proceed = processHeader(bytes_read);
+      } else {
+        processData(bytes_read);
+      }
+    }
+  }
+
+  bool MplexReadingState::processHeader(gsl::span<const uint8_t> &bytes_read) {
+    using basic::VarintPrefixReader;
+
+    if (id_flag_.state() != VarintPrefixReader::kReady) {
+      auto state = id_flag_.consume(bytes_read);
+      if (state == VarintPrefixReader::kUnderflow) {
+        return true;
+      }
+      if (state != VarintPrefixReader::kReady) {
+        reset();
+        return on_header_(RawConnection::Error::CONNECTION_PROTOCOL_ERROR);
+      }
+    }
+
+    auto state = length_.consume(bytes_read);
+    if (state == VarintPrefixReader::kUnderflow) {
+      return true;
+    }
+    if (state != VarintPrefixReader::kReady) {
+      reset();
+      return on_header_(RawConnection::Error::CONNECTION_PROTOCOL_ERROR);
+    }
+
+    auto header = createFrame(id_flag_.value(), {});
+    if (header) {
+      header.value().length = length_.value();
+    }
+    data_bytes_unread_ = length_.value();
+    pass_data_ = true;
+    id_flag_.reset();
+    length_.reset();
+
+    if (!header) {
+      reset();
+    }
+    return on_header_(std::move(header));
+  }
+
+  void MplexReadingState::processData(gsl::span<const uint8_t> &bytes_read) {
+    assert(data_bytes_unread_ > 0);
+
+    auto n = std::min<uint64_t>(data_bytes_unread_, bytes_read.size());
+    auto segment = bytes_read.first(n);
+    bytes_read = bytes_read.subspan(n);
+    data_bytes_unread_ -= n;
+
+    if (pass_data_) {
+      on_data_(segment);
+    }
+  }
+
+  void MplexReadingState::discardData() {
+    pass_data_ = false;
+  }
+
+  void MplexReadingState::reset() {
+    id_flag_.reset();
+    length_.reset();
+    data_bytes_unread_ = 0;
+    pass_data_ = false;
+  }
+
+}  // namespace libp2p::connection
@@ -112,36 +112,21 @@ namespace libp2p::connection {
     if (bytes == 0 || in.empty() || static_cast<size_t>(in.size()) < bytes) {
       return cb(Error::STREAM_INVALID_ARGUMENT);
     }
-    if (is_writing_) {
-      std::vector<uint8_t> in_vector(in.begin(), in.end());
-      std::lock_guard<std::mutex> lock(write_queue_mutex_);
-      write_queue_.emplace_back(in_vector, bytes, cb);
-      return;
-    }
     if (connection_.expired()) {
       return cb(Error::STREAM_RESET_BY_HOST);
     }
 
-    is_writing_ = true;
+    // the connection copies data into its write batch at once, so writes
+    // issued while the previous one is in progress are just appended to it
     connection_.lock()->streamWrite(
         stream_id_, in, bytes,
         [self{shared_from_this()}, cb{std::move(cb)}](auto &&write_res) {
-          self->is_writing_ = false;
           if (!write_res) {
             self->log_->error("write for stream {} failed: {}",
                               self->stream_id_.toString(),
                               write_res.error().message());
           }
           cb(std::forward<decltype(write_res)>(write_res));
-
-          std::lock_guard<std::mutex> lock(self->write_queue_mutex_);
-          // check if new write messages were received while stream was writing
-          // and propagate these messages
-          if (not self->write_queue_.empty()) {
-            auto [in, bytes, cb] = self->write_queue_.front();
-            self->write_queue_.pop_front();
-            self->write(in, bytes, cb);
-          }
         });
   }
 
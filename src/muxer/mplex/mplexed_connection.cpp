@@ -11,10 +11,27 @@
 namespace libp2p::connection {
   using StreamId = MplexStream::StreamId;
 
+  namespace {
+    /// Size of the buffer, inbound bytes are read to
+    constexpr size_t kReadBufferSize = 64 * 1024;
+
+    /// Write buffers above this capacity are freed after write
+    constexpr size_t kMaxRetainedWriteBuffer = 1024 * 1024;
+  }  // namespace
+
   MplexedConnection::MplexedConnection(
       std::shared_ptr<SecureConnection> connection,
       muxer::MuxedConnectionConfig config)
-      : connection_{std::move(connection)}, config_{config} {
+      : read_buffer_(kReadBufferSize),
+        reading_state_(
+            [this](outcome::result<MplexFrame> header) {
+              return processFrame(std::move(header));
+            },
+            [this](gsl::span<const uint8_t> segment) {
+              processData(segment);
+            }),
+        connection_{std::move(connection)},
+        config_{config} {
     BOOST_ASSERT(connection_);
   }
 
@@ -24,7 +41,7 @@ namespace libp2p::connection {
 
     is_active_ = true;
     log_->info("starting an mplex connection");
-    readNextFrame();
+    continueReading();
   }
 
   void MplexedConnection::stop() {
@@ -43,9 +60,8 @@ namespace libp2p::connection {
     }
 
     StreamId new_stream_id{last_issued_stream_number_++, true};
-    auto new_stream_frame =
-        createFrameBytes(MplexFrame::Flag::NEW_STREAM, new_stream_id.number);
-    write({std::move(new_stream_frame), [](auto &&) {}});
+    writeFrame(MplexFrame::Flag::NEW_STREAM, new_stream_id.number, {},
+               [](auto &&) {});
 
     auto new_stream =
         std::make_shared<MplexStream>(shared_from_this(), new_stream_id);
@@ -64,22 +80,20 @@ namespace libp2p::connection {
     }
 
     StreamId new_stream_id{last_issued_stream_number_++, true};
-    auto new_stream_frame =
-        createFrameBytes(MplexFrame::Flag::NEW_STREAM, new_stream_id.number);
-    write({std::move(new_stream_frame),
-           [self{shared_from_this()}, cb{std::move(cb)},
-            new_stream_id](auto &&create_res) {
-             if (!create_res) {
-               self->log_->error("stream creation failed: {}",
-                                 create_res.error().message());
-               return cb(create_res.error());
-             }
-
-             auto new_stream =
-                 std::make_shared<MplexStream>(self, new_stream_id);
-             self->streams_[new_stream_id] = new_stream;
-             cb(std::move(new_stream));
-           }});
+    writeFrame(MplexFrame::Flag::NEW_STREAM, new_stream_id.number, {},
+               [self{shared_from_this()}, cb{std::move(cb)},
+                new_stream_id](auto &&create_res) {
+                 if (!create_res) {
+                   self->log_->error("stream creation failed: {}",
+                                     create_res.error().message());
+                   return cb(create_res.error());
+                 }
+
+                 auto new_stream =
+                     std::make_shared<MplexStream>(self, new_stream_id);
+                 self->streams_[new_stream_id] = new_stream;
+                 cb(std::move(new_stream));
+               });
   }
 
   void MplexedConnection::onStream(NewStreamHandlerFunc cb) {
@@ -152,28 +166,32 @@ namespace libp2p::connection {
     connection_->deferWriteCallback(ec, std::move(cb));
   }
 
-  void MplexedConnection::write(WriteData data) {
-    write_queue_.push(std::move(data));
-    if (is_writing_) {
-      return;
+  void MplexedConnection::writeFrame(MplexFrame::Flag flag,
+                                     MplexStream::StreamNumber stream_number,
+                                     gsl::span<const uint8_t> data,
+                                     WriteCallbackFunc cb) {
+    auto offset = pending_batch_.data.size();
+    appendFrame(pending_batch_.data, flag, stream_number, data);
+    pending_batch_.callbacks.emplace_back(
+        pending_batch_.data.size() - offset, std::move(cb));
+    if (!is_writing_) {
+      doWrite();
     }
-    doWrite();
   }
 
   void MplexedConnection::doWrite() {
-    auto queue_empty = write_queue_.empty();
-    if (queue_empty || isClosed()) {
-      if (!queue_empty) {
-        decltype(write_queue_){}.swap(write_queue_);
-      }
+    if (pending_batch_.callbacks.empty() || isClosed()) {
+      pending_batch_.data.clear();
+      pending_batch_.callbacks.clear();
       is_writing_ = false;
       return;
     }
 
+    // frames appended from now on go to the next batch
     is_writing_ = true;
-    const auto &write_data = write_queue_.front();
-    return connection_->write(
-        write_data.data, write_data.data.size(),
+    std::swap(writing_batch_, pending_batch_);
+    connection_->write(
+        writing_batch_.data, writing_batch_.data.size(),
         [self{shared_from_this()}](auto &&res) {
           self->onWriteCompleted(std::forward<decltype(res)>(res));
         });
@@ -184,31 +202,63 @@ namespace libp2p::connection {
       log_->error("data write failed: {}", write_res.error().message());
     }
 
-    write_queue_.front().cb(std::forward<decltype(write_res)>(write_res));
-    write_queue_.pop();
+    // is_writing_ is still set, so frames appended by callbacks go to the
+    // pending batch and are written after all callbacks are called
+    for (auto &[size, cb] : writing_batch_.callbacks) {
+      if (write_res) {
+        cb(size);
+      } else {
+        cb(write_res.error());
+      }
+    }
+    writing_batch_.callbacks.clear();
+    writing_batch_.data.clear();
+    if (writing_batch_.data.capacity() > kMaxRetainedWriteBuffer) {
+      writing_batch_.data.shrink_to_fit();
+    }
+
     doWrite();
   }
 
-  void MplexedConnection::readNextFrame() {
+  void MplexedConnection::continueReading() {
     if (isClosed()) {
       return;
     }
 
-    readFrame(connection_,
-              [self{shared_from_this()}](auto &&frame_res) mutable {
-                if (!frame_res) {
-                  self->log_->error("cannot read frame from the connection: {}",
-                                    frame_res.error().message());
-                  return self->closeSession();
-                }
+    connection_->readSome(read_buffer_, read_buffer_.size(),
+                          [self{shared_from_this()}](auto &&read_res) {
+                            self->onRead(read_res);
+                          });
+  }
+
+  void MplexedConnection::onRead(outcome::result<size_t> read_res) {
+    if (!read_res) {
+      log_->error("cannot read frame from the connection: {}",
+                  read_res.error().message());
+      return closeSession();
+    }
 
-                self->processFrame(std::move(frame_res.value()));
-              });
+    auto bytes_read = gsl::span<const uint8_t>(read_buffer_)
+                          .first(static_cast<ssize_t>(read_res.value()));
+    reading_state_.onDataReceived(bytes_read);
+
+    continueReading();
   }
 
-  void MplexedConnection::processFrame(const MplexFrame &frame) {
+  bool MplexedConnection::processFrame(outcome::result<MplexFrame> frame_res) {
     using Flag = MplexFrame::Flag;
 
+    // data of frames other than messages to known streams is discarded
+    reading_stream_.reset();
+
+    if (!frame_res) {
+      log_->error("cannot read frame from the connection: {}",
+                  frame_res.error().message());
+      closeSession();
+      return false;
+    }
+    const auto &frame = frame_res.value();
+
     // we are initiators of this connection, if the other side is a receiver of
     // this connection (o rly?)
     auto this_side_is_initiator = (frame.flag != Flag::NEW_STREAM)
@@ -235,10 +285,30 @@ namespace libp2p::connection {
         break;
       default:
         log_->critical("garbage in frame's flag");
-        return closeSession();
+        closeSession();
+        return false;
     }
 
-    readNextFrame();
+    return !isClosed();
+  }
+
+  void MplexedConnection::processData(gsl::span<const uint8_t> segment) {
+    if (!reading_stream_) {
+      return reading_state_.discardData();
+    }
+    auto stream_opt = findStream(*reading_stream_);
+    if (!stream_opt) {
+      return reading_state_.discardData();
+    }
+
+    // there is some data for this stream - commit it
+    auto commit_res = (*stream_opt)->commitData(segment, segment.size());
+    if (!commit_res) {
+      log_->error("failed to commit data for stream {}: {}",
+                  reading_stream_->toString(), commit_res.error().message());
+      reading_stream_.reset();
+      reading_state_.discardData();
+    }
   }
 
   void MplexedConnection::processNewStreamFrame(const MplexFrame &frame,
@@ -269,12 +339,18 @@ namespace libp2p::connection {
                                               StreamId stream_id) {
     FIND_STREAM_OR_RESET(stream, stream_id)
 
-    // there is some data for this stream - commit it
-    auto commit_res = stream->commitData(frame.data, frame.data.size());
-    if (!commit_res) {
-      return log_->error("failed to commit data for stream {}: {}",
-                         stream_id.toString(), commit_res.error().message());
+    if (frame.length == 0) {
+      // the stream takes empty data for the end of it
+      auto commit_res = stream->commitData({}, 0);
+      if (!commit_res) {
+        log_->error("failed to commit data for stream {}: {}",
+                    stream_id.toString(), commit_res.error().message());
+      }
+      return;
     }
+
+    // data fragments follow, they are committed as they arrive
+    reading_stream_ = stream_id;
   }
 
   void MplexedConnection::processCloseFrame(const MplexFrame &frame,
@@ -314,17 +390,16 @@ namespace libp2p::connection {
   }
 
   void MplexedConnection::resetStream(StreamId stream_id) {
-    write({createFrameBytes(stream_id.initiator
-                                ? MplexFrame::Flag::RESET_INITIATOR
-                                : MplexFrame::Flag::RESET_RECEIVER,
-                            stream_id.number),
-           [self{shared_from_this()}, stream_id](auto &&reset_res) {
-             if (!reset_res) {
-               self->log_->error("cannot reset stream {}: {}",
-                                 stream_id.toString(),
-                                 reset_res.error().message());
-             }
-           }});
+    writeFrame(stream_id.initiator ? MplexFrame::Flag::RESET_INITIATOR
+                                   : MplexFrame::Flag::RESET_RECEIVER,
+               stream_id.number, {},
+               [self{shared_from_this()}, stream_id](auto &&reset_res) {
+                 if (!reset_res) {
+                   self->log_->error("cannot reset stream {}: {}",
+                                     stream_id.toString(),
+                                     reset_res.error().message());
+                 }
+               });
   }
 
   void MplexedConnection::resetAllStreams() {
@@ -349,31 +424,29 @@ namespace libp2p::connection {
   void MplexedConnection::streamWrite(StreamId stream_id,
                                       gsl::span<const uint8_t> in, size_t bytes,
                                       basic::Writer::WriteCallbackFunc cb) {
-    common::ByteArray data{in.begin(), in.begin() + bytes};
-    auto data_frame = createFrameBytes(stream_id.initiator
-                                           ? MplexFrame::Flag::MESSAGE_INITIATOR
-                                           : MplexFrame::Flag::MESSAGE_RECEIVER,
-                                       stream_id.number, std::move(data));
-    write({std::move(data_frame), [cb{std::move(cb)}, bytes](auto &&write_res) {
-             if (!write_res) {
-               return cb(write_res.error());
-             }
-             cb(bytes);
-           }});
+    // the frame is built in the write batch, no other copies are made
+    writeFrame(stream_id.initiator ? MplexFrame::Flag::MESSAGE_INITIATOR
+                                   : MplexFrame::Flag::MESSAGE_RECEIVER,
+               stream_id.number, in.first(static_cast<ssize_t>(bytes)),
+               [cb{std::move(cb)}, bytes](auto &&write_res) {
+                 if (!write_res) {
+                   return cb(write_res.error());
+                 }
+                 cb(bytes);
+               });
   }
 
   void MplexedConnection::streamClose(
       StreamId stream_id, std::function<void(outcome::result<void>)> cb) {
-    auto close_frame =
-        createFrameBytes(stream_id.initiator ? MplexFrame::Flag::CLOSE_INITIATOR
-                                             : MplexFrame::Flag::CLOSE_RECEIVER,
-                         stream_id.number);
-    write({std::move(close_frame), [cb{std::move(cb)}](auto &&write_res) {
-             if (!write_res) {
-               return cb(write_res.error());
-             }
-             cb(outcome::success());
-           }});
+    writeFrame(stream_id.initiator ? MplexFrame::Flag::CLOSE_INITIATOR
+                                   : MplexFrame::Flag::CLOSE_RECEIVER,
+               stream_id.number, {},
+               [cb{std::move(cb)}](auto &&write_res) {
+                 if (!write_res) {
+                   return cb(write_res.error());
+                 }
+                 cb(outcome::success());
+               });
   }
 
   void MplexedConnection::streamReset(StreamId stream_id) {
@@ -11,8 +11,11 @@
 namespace libp2p::muxer {
   Yamux::Yamux(MuxedConnectionConfig config,
                std::shared_ptr<basic::Scheduler> scheduler,
-               std::shared_ptr<network::ConnectionManager> cmgr)
-      : config_{config}, scheduler_{std::move(scheduler)} {
+               std::shared_ptr<network::ConnectionManager> cmgr,
+               std::shared_ptr<network::ResourceManager> resource_manager)
+      : config_{config},
+        scheduler_{std::move(scheduler)},
+        resource_manager_{std::move(resource_manager)} {
     assert(scheduler_);
     if (cmgr) {
       std::weak_ptr<network::ConnectionManager> w(cmgr);
@@ -43,6 +46,6 @@ namespace libp2p::muxer {
       return cb(res.error());
     }
     cb(std::make_shared<connection::YamuxedConnection>(
-        std::move(conn), scheduler_, close_cb_, config_));
+        std::move(conn), scheduler_, close_cb_, config_, resource_manager_));
   }
 }  // namespace libp2p::muxer
@@ -7,6 +7,7 @@
 
 #include <cassert>
 
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/muxer/yamux/yamux_frame.hpp>
 
 #define TRACE_ENABLED 0
@@ -19,6 +20,13 @@ namespace libp2p::connection {
       static auto logger = log::createLogger("yx-stream");
       return logger.get();
     }
+
+    metrics::Counter &windowStalls() {
+      static auto &counter = metrics::Registry::global().counter(
+          "libp2p_yamux_window_stalls_total",
+          "Times stream writes were blocked by exhausted send window");
+      return counter;
+    }
   }  // namespace
 
   YamuxStream::YamuxStream(
@@ -31,6 +39,9 @@ namespace libp2p::connection {
         window_size_(YamuxFrame::kInitialWindowSize),
         peers_window_size_(YamuxFrame::kInitialWindowSize),
         maximum_window_size_(maximum_window_size),
+        minimum_window_size_(YamuxFrame::kInitialWindowSize),
+        epoch_start_(feedback_.now()),
+        last_consumed_(epoch_start_),
         write_queue_(write_queue_limit) {
     assert(connection_);
     assert(stream_id_ > 0);
@@ -39,6 +50,8 @@ namespace libp2p::connection {
     assert(write_queue_limit >= maximum_window_size_);
   }
 
+  YamuxStream::~YamuxStream() = default;
+
   void YamuxStream::read(gsl::span<uint8_t> out, size_t bytes,
                          ReadCallbackFunc cb) {
     doRead(out, bytes, std::move(cb), false);
@@ -148,20 +161,37 @@ namespace libp2p::connection {
                                      VoidResultHandlerFunc cb) {
     std::error_code ec = close_reason_;
     if (!ec) {
-      if (!is_readable_) {
+      if (!is_readable_ || detached_) {
         ec = Error::STREAM_NOT_READABLE;
       } else if (new_size > maximum_window_size_
-                 || new_size < peers_window_size_) {
+                 || new_size < minimum_window_size_) {
         ec = Error::STREAM_INVALID_WINDOW_SIZE;
       }
     }
 
+    if (!ec) {
+      // idle window shrinks before, not while the window grows
+      shrinkIdleWindow(feedback_.now());
+    }
+
     if (!ec && new_size > peers_window_size_) {
       // Doing this optimistic way, if other side don't like the window update
       // then it would RST
 
-      feedback_.ackReceivedBytes(stream_id_, new_size - peers_window_size_);
-      peers_window_size_ = new_size;
+      auto delta = new_size - peers_window_size_;
+      if (auto res = feedback_.reserveWindow(delta); !res) {
+        ec = res.error();
+      } else {
+        reserved_window_bytes_ += delta;
+        feedback_.ackReceivedBytes(stream_id_, delta);
+        peers_window_size_ = new_size;
+      }
+    }
+
+    if (!ec) {
+      // the window may be already grown by auto tuning, the size adjusted
+      // is kept as minimum
+      minimum_window_size_ = new_size;
     }
 
     if (cb) {
@@ -182,6 +212,12 @@ namespace libp2p::connection {
     }
   }
 
+  void YamuxStream::setPriority(Priority priority) {
+    if (!close_reason_) {
+      feedback_.setStreamPriority(stream_id_, priority);
+    }
+  }
+
   outcome::result<peer::PeerId> YamuxStream::remotePeerId() const {
     return connection_->remotePeer();
   }
@@ -259,17 +295,16 @@ namespace libp2p::connection {
       internal_read_buffer_.add(bytes);
     }
 
-    if (!internal_read_buffer_.empty()) {
-      overflow = (internal_read_buffer_.size() > peers_window_size_);
-      if (overflow) {
-        log()->debug("read buffer overflow {} > {}, stream {}",
-                     internal_read_buffer_.size(), peers_window_size_,
-                     stream_id_);
-      } else {
-        TRACE("stream {} receive window reduced by {} to {}", stream_id_,
-              internal_read_buffer_.size(),
-              peers_window_size_ - internal_read_buffer_.size());
-      }
+    // bytes consumed but not yet acknowledged are still out of peer's window
+    auto window_used =
+        internal_read_buffer_.size() + unacked_bytes_ + bytes_consumed;
+    overflow = (window_used > peers_window_size_);
+    if (overflow) {
+      log()->debug("read buffer overflow {} > {}, stream {}", window_used,
+                   peers_window_size_, stream_id_);
+    } else {
+      TRACE("stream {} receive window reduced by {} to {}", stream_id_,
+            window_used, peers_window_size_ - window_used);
     }
 
     if (isClosed()) {
@@ -280,9 +315,7 @@ namespace libp2p::connection {
     if (overflow) {
       doClose(Error::STREAM_RECEIVE_OVERFLOW, false);
     } else if (bytes_consumed > 0) {
-      feedback_.ackReceivedBytes(stream_id_, bytes_consumed);
-      TRACE("stream {} receive window increased by {} to {}", stream_id_,
-            bytes_consumed, peers_window_size_ - internal_read_buffer_.size());
+      onBytesConsumed(bytes_consumed);
     }
 
     if (read_cb_and_res.first) {
@@ -336,15 +369,107 @@ namespace libp2p::connection {
       return;
     }
 
+    releaseWrittenBytes();
+
     if (result.cb && !no_more_callbacks_) {
       result.cb(result.size_to_ack);
     }
   }
 
+  void YamuxStream::onBytesConsumed(size_t bytes) {
+    unacked_bytes_ += bytes;
+
+    auto now = feedback_.now();
+    shrinkIdleWindow(now);
+    last_consumed_ = now;
+
+    if (unacked_bytes_ < peers_window_size_ / 2) {
+      return;
+    }
+
+    auto delta = unacked_bytes_;
+
+    // half of the window was consumed within few round trips, so the window
+    // limits throughput rather than the client
+    auto rtt = feedback_.rtt();
+    if (!detached_ && rtt.count() > 0
+        && now - epoch_start_ < rtt * kWindowGrowthRtts
+        && peers_window_size_ < maximum_window_size_) {
+      auto growth = std::min(peers_window_size_,
+                             maximum_window_size_ - peers_window_size_);
+      if (feedback_.reserveWindow(growth)) {
+        reserved_window_bytes_ += growth;
+        peers_window_size_ += growth;
+        delta += growth;
+        TRACE("stream {} receive window grown to {}", stream_id_,
+              peers_window_size_);
+      }
+    }
+
+    epoch_start_ = now;
+    unacked_bytes_ = 0;
+    feedback_.ackReceivedBytes(stream_id_, delta);
+  }
+
+  void YamuxStream::shrinkIdleWindow(std::chrono::milliseconds now) {
+    if (now - last_consumed_ >= kWindowIdleInterval
+        && peers_window_size_ > minimum_window_size_) {
+      window_shrinking_ = true;
+    }
+    if (!window_shrinking_) {
+      return;
+    }
+
+    // credit given to peer cannot be taken back, so the window shrinks by
+    // bytes consumed, which are not returned to peer
+    auto n = std::min(unacked_bytes_, peers_window_size_ - minimum_window_size_);
+    if (n > 0) {
+      unacked_bytes_ -= n;
+      shrinkWindow(n);
+    }
+    window_shrinking_ = (peers_window_size_ > minimum_window_size_);
+    epoch_start_ = now;
+  }
+
+  void YamuxStream::shrinkWindow(size_t bytes) {
+    peers_window_size_ -= bytes;
+    auto released = std::min(bytes, reserved_window_bytes_);
+    if (released > 0) {
+      reserved_window_bytes_ -= released;
+      feedback_.releaseWindow(released);
+    }
+    TRACE("stream {} receive window shrunk to {}", stream_id_,
+          peers_window_size_);
+  }
+
+  void YamuxStream::releaseWrittenBytes() {
+    auto queued = write_queue_.queuedBytes();
+    if (queued < reserved_write_bytes_) {
+      feedback_.releaseMemory(reserved_write_bytes_ - queued);
+      reserved_write_bytes_ = queued;
+    }
+  }
+
+  void YamuxStream::releaseAllMemory() {
+    if (reserved_window_bytes_ > 0) {
+      feedback_.releaseWindow(reserved_window_bytes_);
+      reserved_window_bytes_ = 0;
+    }
+    if (reserved_write_bytes_ > 0) {
+      feedback_.releaseMemory(reserved_write_bytes_);
+      reserved_write_bytes_ = 0;
+    }
+  }
+
   void YamuxStream::closedByConnection(std::error_code ec) {
     doClose(ec, true);
   }
 
+  void YamuxStream::detachedFromConnection() {
+    detached_ = true;
+    releaseAllMemory();
+  }
+
   void YamuxStream::doClose(std::error_code ec, bool notify_read_side) {
     assert(ec);
 
@@ -370,6 +495,8 @@ namespace libp2p::connection {
 
     write_queue_.clear();
 
+    releaseAllMemory();
+
     auto close_cb_and_res = closeCompleted();
 
     VoidResultHandlerFunc window_size_cb;
@@ -429,7 +556,7 @@ namespace libp2p::connection {
       assert(consumed > 0);
 
       if (is_readable_) {
-        feedback_.ackReceivedBytes(stream_id_, consumed);
+        onBytesConsumed(consumed);
       }
       return deferReadCallback(consumed, std::move(cb));
     }
@@ -458,6 +585,7 @@ namespace libp2p::connection {
       internal_read_buffer_.consume(external_read_buffer_);
       external_read_buffer_ =
           external_read_buffer_.subspan(bytes_available_now);
+      onBytesConsumed(bytes_available_now);
     }
   }
 
@@ -490,7 +618,11 @@ namespace libp2p::connection {
     gsl::span<const uint8_t> data;
     bool some = false;
     while (!close_reason_) {
-      window_size_ = write_queue_.dequeue(window_size_, data, some);
+      // dequeued by frames, so writeSome() writes one frame at most
+      auto frame_size =
+          std::min<size_t>(window_size_, YamuxFrame::kMaxDataFrameSize);
+      auto left = write_queue_.dequeue(frame_size, data, some);
+      window_size_ -= frame_size - left;
       if (data.empty()) {
         break;
       }
@@ -502,6 +634,9 @@ namespace libp2p::connection {
     if (initial_window_size != window_size_) {
       TRACE("stream {} send window size reduced from {} to {}", stream_id_,
             initial_window_size, window_size_);
+      if (window_size_ == 0 && write_queue_.unsentBytes() > 0) {
+        windowStalls().inc();
+      }
     }
 
     if (!is_writable_ && !close_reason_ && window_size_ > 0) {
@@ -538,6 +673,15 @@ namespace libp2p::connection {
       return deferWriteCallback(Error::STREAM_WRITE_OVERFLOW, std::move(cb));
     }
 
+    if (detached_) {
+      return deferWriteCallback(Error::STREAM_NOT_WRITABLE, std::move(cb));
+    }
+
+    if (auto res = feedback_.reserveMemory(bytes); !res) {
+      return deferWriteCallback(res.error(), std::move(cb));
+    }
+    reserved_write_bytes_ += bytes;
+
     write_queue_.enqueue(in.first(bytes), some, std::move(cb));
     doWrite();
   }
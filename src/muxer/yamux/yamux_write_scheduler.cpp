@@ -0,0 +1,108 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/muxer/yamux/yamux_write_scheduler.hpp>
+
+#include <cassert>
+
+namespace libp2p::connection {
+
+  void YamuxWriteScheduler::pushControl(Item item) {
+    control_.push_back(std::move(item));
+    ++size_;
+  }
+
+  void YamuxWriteScheduler::pushStreamFrame(StreamId stream_id, Item item,
+                                            bool glued) {
+    auto &lane = lanes_[stream_id];
+    if (lane.frames.empty()) {
+      active_.push_back(stream_id);
+    }
+    lane.frames.push_back({std::move(item), glued});
+    ++size_;
+  }
+
+  void YamuxWriteScheduler::setPriority(StreamId stream_id,
+                                        Stream::Priority priority) {
+    if (priority == Stream::kDefaultPriority) {
+      priorities_.erase(stream_id);
+    } else {
+      priorities_[stream_id] = std::max<Stream::Priority>(priority, 1);
+    }
+  }
+
+  void YamuxWriteScheduler::removeStream(StreamId stream_id) {
+    priorities_.erase(stream_id);
+  }
+
+  YamuxWriteScheduler::Item YamuxWriteScheduler::pop() {
+    assert(size_ > 0);
+    --size_;
+
+    if (glued_ != 0) {
+      // the rest of frame, its cost was accounted with the header
+      assert(!active_.empty() && active_.front() == glued_);
+      return popFrame(glued_, lanes_.at(glued_));
+    }
+
+    if (!control_.empty()) {
+      auto item = std::move(control_.front());
+      control_.pop_front();
+      return item;
+    }
+
+    assert(!active_.empty());
+
+    while (true) {
+      auto stream_id = active_.front();
+      auto &lane = lanes_.at(stream_id);
+
+      if (!lane.in_turn) {
+        auto it = priorities_.find(stream_id);
+        lane.deficit += kQuantum
+            * (it == priorities_.end() ? Stream::kDefaultPriority : it->second);
+        lane.in_turn = true;
+      }
+
+      const auto &front = lane.frames.front();
+      auto cost = front.item.packet.size();
+      if (front.glued) {
+        cost += lane.frames[1].item.packet.size();
+      }
+
+      if (cost <= lane.deficit) {
+        lane.deficit -= cost;
+        return popFrame(stream_id, lane);
+      }
+
+      // the rest of deficit is kept for the next round
+      lane.in_turn = false;
+      active_.pop_front();
+      active_.push_back(stream_id);
+    }
+  }
+
+  YamuxWriteScheduler::Item YamuxWriteScheduler::popFrame(StreamId stream_id,
+                                                          Lane &lane) {
+    auto frame = std::move(lane.frames.front());
+    lane.frames.pop_front();
+    glued_ = frame.glued ? stream_id : 0;
+    if (lane.frames.empty()) {
+      assert(!frame.glued);
+      active_.pop_front();
+      lanes_.erase(stream_id);
+    }
+    return std::move(frame.item);
+  }
+
+  void YamuxWriteScheduler::clear() {
+    control_.clear();
+    lanes_.clear();
+    active_.clear();
+    glued_ = 0;
+    size_ = 0;
+  }
+
+}  // namespace libp2p::connection
@@ -7,6 +7,7 @@
 
 #include <boost/asio/error.hpp>
 
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/log/logger.hpp>
 
 namespace libp2p::connection {
@@ -17,6 +18,26 @@ namespace libp2p::connection {
       return logger;
     }
 
+    struct YamuxStats {
+      metrics::Counter &bytes_received = metrics::Registry::global().counter(
+          "libp2p_yamux_bytes_received_total",
+          "Bytes read by yamux from underlying connections");
+      metrics::Counter &bytes_sent = metrics::Registry::global().counter(
+          "libp2p_yamux_bytes_sent_total",
+          "Bytes written by yamux to underlying connections");
+      metrics::Histogram &write_queue_depth =
+          metrics::Registry::global().histogram(
+              "libp2p_yamux_write_queue_depth",
+              "Frames waiting in connection write queue when a new frame "
+              "is enqueued",
+              {0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024});
+    };
+
+    YamuxStats &stats() {
+      static YamuxStats stats;
+      return stats;
+    }
+
     inline bool isOutbound(uint32_t our_stream_id, uint32_t their_stream_id) {
       // streams id oddness and evenness, depends on connection direction,
       // outbound or inbound, resp.
@@ -29,7 +50,8 @@ namespace libp2p::connection {
       std::shared_ptr<SecureConnection> connection,
       std::shared_ptr<basic::Scheduler> scheduler,
       ConnectionClosedCallback closed_callback,
-      muxer::MuxedConnectionConfig config)
+      muxer::MuxedConnectionConfig config,
+      std::shared_ptr<network::ResourceManager> resource_manager)
       : config_(config),
         connection_(std::move(connection)),
         scheduler_(std::move(scheduler)),
@@ -53,7 +75,8 @@ namespace libp2p::connection {
         closed_callback_(std::move(closed_callback)),
 
         // yes, sort of assert
-        remote_peer_(std::move(connection_->remotePeer().value())) {
+        remote_peer_(std::move(connection_->remotePeer().value())),
+        resource_manager_(std::move(resource_manager)) {
     assert(scheduler_);
     assert(config_.maximum_streams > 0);
     assert(config_.maximum_window_size >= YamuxFrame::kInitialWindowSize);
@@ -62,6 +85,13 @@ namespace libp2p::connection {
     new_stream_id_ = (connection_->isInitiator() ? 1 : 2);
   }
 
+  YamuxedConnection::~YamuxedConnection() {
+    for (auto &[_, stream] : streams_) {
+      stream->detachedFromConnection();
+    }
+    releaseStreams(streams_.size() + pending_outbound_streams_.size());
+  }
+
   void YamuxedConnection::start() {
     if (started_) {
       log()->error("already started (double start)");
@@ -77,28 +107,42 @@ namespace libp2p::connection {
             for (auto &[id, stream] : streams_) {
               if (stream.use_count() == 1) {
                 abandoned.push_back(id);
-                enqueue(resetStreamMsg(id));
+                enqueue(id, {resetStreamMsg(id), 0, false});
               }
             }
             if (!abandoned.empty()) {
               log()->info("cleaning up {} abandoned streams", abandoned.size());
               for (const auto id : abandoned) {
+                streams_[id]->detachedFromConnection();
                 streams_.erase(id);
+                write_queue_.removeStream(id);
               }
+              releaseStreams(abandoned.size());
             }
             std::ignore = cleanup_handle_.reschedule(kCleanupInterval);
           }
         },
         kCleanupInterval);
 
+    window_check_handle_ = scheduler_->scheduleWithHandle(
+        [this]() {
+          if (started_) {
+            shrinkIdleWindows();
+            std::ignore = window_check_handle_.reschedule(
+                YamuxStream::kWindowIdleInterval);
+          }
+        },
+        YamuxStream::kWindowIdleInterval);
+
     if (config_.ping_interval != std::chrono::milliseconds::zero()) {
+      // the first ping measures RTT for receive windows tuning
+      sendPing();
       ping_handle_ = scheduler_->scheduleWithHandle(
-          [this, ping_counter = 0u]() mutable {
+          [this]() {
             if (started_) {
               // dont send pings if something is being written
               if (!is_writing_) {
-                enqueue(pingOutMsg(++ping_counter));
-                SL_TRACE(log(), "written ping message #{}", ping_counter);
+                sendPing();
               }
               std::ignore = ping_handle_.reschedule(config_.ping_interval);
             }
@@ -126,6 +170,8 @@ namespace libp2p::connection {
       return Error::CONNECTION_TOO_MANY_STREAMS;
     }
 
+    OUTCOME_TRY(reserveStream());
+
     auto stream_id = new_stream_id_;
     new_stream_id_ += 2;
     enqueue(newStreamMsg(stream_id));
@@ -148,6 +194,12 @@ namespace libp2p::connection {
           });
     }
 
+    if (auto res = reserveStream(); !res) {
+      return connection_->deferWriteCallback(
+          res.error(),
+          [cb = std::move(cb), ec = res.error()](auto) { cb(ec); });
+    }
+
     auto stream_id = new_stream_id_;
     new_stream_id_ += 2;
     enqueue(newStreamMsg(stream_id));
@@ -255,6 +307,7 @@ namespace libp2p::connection {
 
     auto n = res.value();
     gsl::span<uint8_t> bytes_read(*raw_read_buffer_);
+    stats().bytes_received.inc(n);
 
     SL_TRACE(log(), "read {} bytes", n);
 
@@ -379,7 +432,7 @@ namespace libp2p::connection {
 
     if (result == YamuxStream::kRemoveStreamAndSendRst) {
       // overflow, reset this stream
-      enqueue(resetStreamMsg(stream_id));
+      enqueue(stream_id, {resetStreamMsg(stream_id), 0, false});
     }
   }
 
@@ -430,6 +483,13 @@ namespace libp2p::connection {
       return false;
     }
 
+    if (auto res = reserveStream(); !res) {
+      SL_DEBUG(log(), "rejecting inbound stream {}: {}", frame.stream_id,
+               res.error().message());
+      enqueue(resetStreamMsg(frame.stream_id));
+      return true;
+    }
+
     SL_DEBUG(log(), "creating inbound stream {}", frame.stream_id);
     std::ignore = createStream(frame.stream_id);
 
@@ -451,7 +511,7 @@ namespace libp2p::connection {
         SL_DEBUG(log(), "received ACK on zero stream id");
         ok = false;
       } else {
-        // pong has come. TODO(artem): measure latency
+        processPong(frame.length);
         return true;
       }
 
@@ -469,7 +529,9 @@ namespace libp2p::connection {
         ok = false;
       }
       stream_handler = std::move(it->second);
-      erasePendingOutboundStream(it);
+      // the stream keeps its reservation and the expire timer is cancelled
+      // by createStream() below
+      pending_outbound_streams_.erase(it);
     }
 
     if (!ok) {
@@ -541,7 +603,7 @@ namespace libp2p::connection {
       return;
     }
 
-    auto stream = std::move(it->second);
+    auto stream = it->second;
     eraseStream(stream_id);
     stream->onRSTReceived();
   }
@@ -558,6 +620,28 @@ namespace libp2p::connection {
     return true;
   }
 
+  void YamuxedConnection::sendPing() {
+    enqueue(pingOutMsg(++ping_counter_));
+    ping_sent_at_ = scheduler_->now();
+    SL_TRACE(log(), "written ping message #{}", ping_counter_);
+  }
+
+  void YamuxedConnection::processPong(uint32_t value) {
+    if (value != ping_counter_ || !ping_sent_at_) {
+      return;
+    }
+
+    // scheduler time is in milliseconds, so faster links are rounded up
+    auto sample = std::max(scheduler_->now() - ping_sent_at_.value(),
+                           std::chrono::milliseconds(1));
+    ping_sent_at_.reset();
+
+    // the same smoothing as TCP does
+    rtt_ = (rtt_ == basic::kZeroTime) ? sample : (rtt_ * 7 + sample) / 8;
+    SL_TRACE(log(), "ping #{} RTT {} msec, smoothed {} msec", value,
+             sample.count(), rtt_.count());
+  }
+
   void YamuxedConnection::close(
       std::error_code notify_streams_code,
       boost::optional<YamuxFrame::GoAwayError> reply_to_peer_code) {
@@ -582,7 +666,10 @@ namespace libp2p::connection {
     PendingOutboundStreams pending_streams;
     pending_streams.swap(pending_outbound_streams_);
 
+    releaseStreams(streams.size() + pending_streams.size());
+
     for (auto [_, stream] : streams) {
+      stream->detachedFromConnection();
       stream->closedByConnection(notify_streams_code);
     }
 
@@ -598,17 +685,22 @@ namespace libp2p::connection {
   void YamuxedConnection::writeStreamData(uint32_t stream_id,
                                           gsl::span<const uint8_t> data,
                                           bool some) {
+    // streams split data into frames, so that each frame is acknowledged
+    // to stream once
+    assert(data.size() <= YamuxFrame::kMaxDataFrameSize);
+
     if (some) {
       // header must be written not partially, even some == true
-      enqueue(dataMsg(stream_id, data.size(), false));
-      enqueue(Buffer(data.begin(), data.end()), stream_id, true);
+      enqueue(stream_id, {dataMsg(stream_id, data.size(), false), 0, false},
+              true);
+      enqueue(stream_id, {Buffer(data.begin(), data.end()), stream_id, true});
     } else {
       // if !some then we can write a whole packet
       auto packet = dataMsg(stream_id, data.size(), true);
 
       // will add support for vector writes some time
       packet.insert(packet.end(), data.begin(), data.end());
-      enqueue(std::move(packet), stream_id);
+      enqueue(stream_id, {std::move(packet), stream_id, false});
     }
   }
 
@@ -616,6 +708,58 @@ namespace libp2p::connection {
     enqueue(windowUpdateMsg(stream_id, bytes));
   }
 
+  outcome::result<void> YamuxedConnection::reserveMemory(size_t bytes) {
+    if (resource_manager_) {
+      return resource_manager_->reserveMemory(remote_peer_, bytes);
+    }
+    return outcome::success();
+  }
+
+  void YamuxedConnection::releaseMemory(size_t bytes) {
+    if (resource_manager_) {
+      resource_manager_->releaseMemory(remote_peer_, bytes);
+    }
+  }
+
+  void YamuxedConnection::shrinkIdleWindows() {
+    auto now = scheduler_->now();
+    for (auto &[_, stream] : streams_) {
+      stream->shrinkIdleWindow(now);
+    }
+  }
+
+  outcome::result<void> YamuxedConnection::reserveWindow(size_t bytes) {
+    if (window_bytes_reserved_ + bytes > config_.connection_window_budget) {
+      // budget may be held by streams, which haven't consumed for a while
+      shrinkIdleWindows();
+    }
+    if (window_bytes_reserved_ + bytes > config_.connection_window_budget) {
+      return Stream::Error::STREAM_INVALID_WINDOW_SIZE;
+    }
+    OUTCOME_TRY(reserveMemory(bytes));
+    window_bytes_reserved_ += bytes;
+    return outcome::success();
+  }
+
+  void YamuxedConnection::releaseWindow(size_t bytes) {
+    assert(window_bytes_reserved_ >= bytes);
+    window_bytes_reserved_ -= bytes;
+    releaseMemory(bytes);
+  }
+
+  std::chrono::milliseconds YamuxedConnection::now() const {
+    return scheduler_->now();
+  }
+
+  std::chrono::milliseconds YamuxedConnection::rtt() const {
+    return rtt_;
+  }
+
+  void YamuxedConnection::setStreamPriority(uint32_t stream_id,
+                                            Stream::Priority priority) {
+    write_queue_.setPriority(stream_id, priority);
+  }
+
   void YamuxedConnection::deferCall(std::function<void()> cb) {
     connection_->deferWriteCallback(std::error_code{},
                                     [cb = std::move(cb)](auto) { cb(); });
@@ -623,7 +767,7 @@ namespace libp2p::connection {
 
   void YamuxedConnection::resetStream(StreamId stream_id) {
     SL_DEBUG(log(), "RST from stream {}", stream_id);
-    enqueue(resetStreamMsg(stream_id));
+    enqueue(stream_id, {resetStreamMsg(stream_id), 0, false});
     eraseStream(stream_id);
   }
 
@@ -639,7 +783,7 @@ namespace libp2p::connection {
       return;
     }
 
-    enqueue(closeStreamMsg(stream_id));
+    enqueue(stream_id, {closeStreamMsg(stream_id), 0, false});
 
     auto &stream = it->second;
     assert(stream->isClosedForWrite());
@@ -649,13 +793,30 @@ namespace libp2p::connection {
     }
   }
 
-  void YamuxedConnection::enqueue(Buffer packet, StreamId stream_id,
-                                  bool some) {
+  void YamuxedConnection::enqueue(Buffer packet) {
     if (is_writing_) {
-      write_queue_.push_back(
-          WriteQueueItem{std::move(packet), stream_id, some});
-    } else {
-      doWrite(WriteQueueItem{std::move(packet), stream_id, some});
+      stats().write_queue_depth.observe(
+          static_cast<double>(write_queue_.size()));
+    }
+    write_queue_.pushControl(WriteQueueItem{std::move(packet), 0, false});
+    writeNext();
+  }
+
+  void YamuxedConnection::enqueue(StreamId stream_id, WriteQueueItem item,
+                                  bool glued) {
+    if (is_writing_) {
+      stats().write_queue_depth.observe(
+          static_cast<double>(write_queue_.size()));
+    }
+    write_queue_.pushStreamFrame(stream_id, std::move(item), glued);
+    if (!glued) {
+      writeNext();
+    }
+  }
+
+  void YamuxedConnection::writeNext() {
+    if (!is_writing_ && !write_queue_.empty()) {
+      doWrite(write_queue_.pop());
     }
   }
 
@@ -684,6 +845,7 @@ namespace libp2p::connection {
       close(res.error(), boost::none);
       return;
     }
+    stats().bytes_sent.inc(res.value());
 
     // this instance may be killed inside further callback
     auto wptr = weak_from_this();
@@ -720,10 +882,8 @@ namespace libp2p::connection {
 
     is_writing_ = false;
 
-    if (started_ && !write_queue_.empty()) {
-      auto next_packet = std::move(write_queue_.front());
-      write_queue_.pop_front();
-      doWrite(std::move(next_packet));
+    if (started_) {
+      writeNext();
     }
   }
 
@@ -738,7 +898,13 @@ namespace libp2p::connection {
 
   void YamuxedConnection::eraseStream(StreamId stream_id) {
     SL_DEBUG(log(), "erasing stream {}", stream_id);
-    streams_.erase(stream_id);
+    write_queue_.removeStream(stream_id);
+    auto it = streams_.find(stream_id);
+    if (it != streams_.end()) {
+      it->second->detachedFromConnection();
+      streams_.erase(it);
+      releaseStreams(1);
+    }
     adjustExpireTimer();
   }
 
@@ -746,9 +912,25 @@ namespace libp2p::connection {
       PendingOutboundStreams::iterator it) {
     SL_TRACE(log(), "erasing pending outbound stream {}", it->first);
     pending_outbound_streams_.erase(it);
+    releaseStreams(1);
     adjustExpireTimer();
   }
 
+  outcome::result<void> YamuxedConnection::reserveStream() {
+    if (resource_manager_) {
+      return resource_manager_->reserveStream(remote_peer_);
+    }
+    return outcome::success();
+  }
+
+  void YamuxedConnection::releaseStreams(size_t count) {
+    if (resource_manager_) {
+      for (size_t i = 0; i < count; ++i) {
+        resource_manager_->releaseStream(remote_peer_);
+      }
+    }
+  }
+
   void YamuxedConnection::adjustExpireTimer() {
     if (config_.no_streams_interval > basic::kZeroTime && streams_.empty()
         && pending_outbound_streams_.empty()) {
@@ -7,6 +7,8 @@
 
 #include <algorithm>
 
+#include <boost/assert.hpp>
+
 namespace libp2p::network {
 
   namespace {
@@ -14,6 +16,20 @@ namespace libp2p::network {
       static auto logger = libp2p::log::createLogger("ConnectionManager");
       return logger.get();
     }
+
+    auto findConnection(
+        std::vector<ConnectionInfo> &connections,
+        const std::shared_ptr<connection::CapableConnection> &conn) {
+      return std::find_if(connections.begin(),
+                          connections.end(),
+                          [&conn](const ConnectionInfo &info) {
+                            return info.connection == conn;
+                          });
+    }
+  }
+
+  int64_t outboundFirst(const ConnectionInfo &info) {
+    return info.connection->isInitiator() ? 1 : 0;
   }
 
   std::vector<ConnectionManager::ConnectionSPtr>
@@ -23,21 +39,31 @@ namespace libp2p::network {
       return {};
     }
 
-    return std::vector<ConnectionManager::ConnectionSPtr>(it->second.begin(),
-                                                          it->second.end());
+    std::vector<ConnectionSPtr> out;
+    out.reserve(it->second.connections.size());
+    for (const auto &info : it->second.connections) {
+      out.push_back(info.connection);
+    }
+    return out;
   }
 
   ConnectionManager::ConnectionSPtr
   ConnectionManagerImpl::getBestConnectionForPeer(const peer::PeerId &p) const {
-    // TODO(warchant): maybe make pluggable strategies
-
     auto it = connections_.find(p);
-    if (it != connections_.end()) {
-      for (const auto &conn : it->second) {
-        if (!conn->isClosed()) {
-          // for now, return first connection
-          return conn;
-        }
+    if (it == connections_.end()) {
+      return nullptr;
+    }
+
+    const auto &peer = it->second;
+    const auto &best = peer.connections[peer.best].connection;
+    if (!best->isClosed()) {
+      return best;
+    }
+
+    // closed, but not reported to onConnectionClosed yet
+    for (const auto &info : peer.connections) {
+      if (!info.connection->isClosed()) {
+        return info.connection;
       }
     }
     return nullptr;
@@ -50,47 +76,107 @@ namespace libp2p::network {
       return;
     }
 
-    auto it = connections_.find(p);
-    if (it == connections_.end()) {
-      connections_.insert({p, {c}});
-    } else {
-      connections_[p].insert(c);
+    auto &peer = connections_[p];
+    if (findConnection(peer.connections, c) == peer.connections.end()) {
+      peer.connections.push_back({c, std::chrono::steady_clock::now()});
+      ++connections_count_;
+      updateBest(peer);
     }
     bus_->getChannel<event::OnNewConnectionChannel>().publish(c);
+
+    if (scheduler_ && config_.high_watermark != 0
+        && connections_count_ > config_.high_watermark && !trim_scheduled_) {
+      trim_scheduled_ = true;
+      trim_now_handle_ = scheduler_->scheduleWithHandle([this] {
+        trim_scheduled_ = false;
+        trimConnections();
+      });
+    }
   }
 
   std::vector<ConnectionManager::ConnectionSPtr>
   ConnectionManagerImpl::getConnections() const {
     std::vector<ConnectionSPtr> out;
-    out.reserve(connections_.size());
+    out.reserve(connections_count_);
 
-    for (auto &&entry : connections_) {
-      out.insert(out.end(), entry.second.begin(), entry.second.end());
-    }
+    forEachConnection([&out](const ConnectionSPtr &c) { out.push_back(c); });
 
     return out;
   }
 
+  void ConnectionManagerImpl::forEachConnection(
+      const ConnectionVisitor &visitor) const {
+    for (const auto &entry : connections_) {
+      for (const auto &info : entry.second.connections) {
+        visitor(info.connection);
+      }
+    }
+  }
+
+  void ConnectionManagerImpl::forEachConnectedPeer(
+      const PeerVisitor &visitor) const {
+    for (const auto &entry : connections_) {
+      visitor(entry.first);
+    }
+  }
+
   ConnectionManagerImpl::ConnectionManagerImpl(
-      std::shared_ptr<libp2p::event::Bus> bus)
-      : bus_(std::move(bus)) {}
+      std::shared_ptr<libp2p::event::Bus> bus,
+      std::shared_ptr<basic::Scheduler> scheduler,
+      ConnectionManagerConfig config)
+      : bus_(std::move(bus)),
+        scheduler_(std::move(scheduler)),
+        config_(config) {
+    BOOST_ASSERT(config_.low_watermark <= config_.high_watermark);
+    if (scheduler_ && config_.high_watermark != 0) {
+      trim_handle_ = scheduler_->scheduleWithHandle(
+          [this] {
+            trimConnections();
+            std::ignore = trim_handle_.reschedule(config_.check_interval);
+          },
+          config_.check_interval);
+    }
+  }
+
+  void ConnectionManagerImpl::setConnectionScore(ConnectionScore score) {
+    score_ = std::move(score);
+    for (auto &entry : connections_) {
+      updateBest(entry.second);
+    }
+  }
+
+  void ConnectionManagerImpl::updateBest(PeerConnections &peer) const {
+    peer.best = 0;
+    if (!score_) {
+      // connections are stored in order of addition, the first is the oldest
+      return;
+    }
+
+    auto best_score = score_(peer.connections.front());
+    for (size_t i = 1; i < peer.connections.size(); ++i) {
+      auto score = score_(peer.connections[i]);
+      if (score > best_score) {
+        best_score = score;
+        peer.best = i;
+      }
+    }
+  }
 
   void ConnectionManagerImpl::collectGarbage() {
     for (auto it = connections_.begin(); it != connections_.end();) {
-      auto &cs = it->second;
-      for (auto it2 = cs.begin(); it2 != cs.end();) {
-        const auto &conn = *it2;
-        if (conn->isClosed()) {
-          it2 = cs.erase(it2);
-        } else {
-          ++it2;
-        }
-      }
+      auto &cs = it->second.connections;
+      auto closed =
+          std::remove_if(cs.begin(), cs.end(), [](const ConnectionInfo &info) {
+            return info.connection->isClosed();
+          });
+      connections_count_ -= cs.end() - closed;
+      cs.erase(closed, cs.end());
 
       // if peer has no connections, remove peer
       if (cs.empty()) {
         it = connections_.erase(it);
       } else {
+        updateBest(it->second);
         ++it;
       }
     }
@@ -102,8 +188,9 @@ namespace libp2p::network {
       return;
     }
 
-    auto connections = std::move(it->second);
+    auto connections = std::move(it->second.connections);
     connections_.erase(it);
+    connections_count_ -= connections.size();
 
     if (connections.empty()) {
       log()->error("inconsistency: iterator and no peers");
@@ -112,10 +199,10 @@ namespace libp2p::network {
 
     closing_connections_to_peer_ = p;
 
-    for (const auto &conn : connections) {
-      if (!conn->isClosed()) {
+    for (const auto &info : connections) {
+      if (!info.connection->isClosed()) {
         // ignore errors
-        (void)conn->close();
+        (void)info.connection->close();
       }
     }
 
@@ -129,6 +216,90 @@ namespace libp2p::network {
     }
   }
 
+  void ConnectionManagerImpl::protectPeer(const peer::PeerId &p,
+                                          const std::string &tag) {
+    protected_[p].insert(tag);
+  }
+
+  void ConnectionManagerImpl::unprotectPeer(const peer::PeerId &p,
+                                            const std::string &tag) {
+    auto it = protected_.find(p);
+    if (it == protected_.end()) {
+      return;
+    }
+    it->second.erase(tag);
+    if (it->second.empty()) {
+      protected_.erase(it);
+    }
+  }
+
+  bool ConnectionManagerImpl::isProtected(const peer::PeerId &p) const {
+    return protected_.count(p) != 0;
+  }
+
+  size_t ConnectionManagerImpl::trimConnections() {
+    if (config_.high_watermark == 0
+        || connections_count_ <= config_.high_watermark) {
+      return 0;
+    }
+
+    // closed connections not reported to onConnectionClosed are counted too
+    collectGarbage();
+    if (connections_count_ <= config_.high_watermark) {
+      return 0;
+    }
+
+    struct Candidate {
+      ConnectionSPtr connection;
+      bool is_best;
+      int64_t score;
+      std::chrono::steady_clock::time_point added;
+
+      bool operator<(const Candidate &other) const {
+        if (is_best != other.is_best) {
+          return !is_best;
+        }
+        if (score != other.score) {
+          return score < other.score;
+        }
+        return added > other.added;
+      }
+    };
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<Candidate> candidates;
+    for (const auto &[peer_id, peer] : connections_) {
+      if (isProtected(peer_id)) {
+        continue;
+      }
+      for (size_t i = 0; i < peer.connections.size(); ++i) {
+        const auto &info = peer.connections[i];
+        if (now - info.added < config_.grace_period) {
+          continue;
+        }
+        candidates.push_back({info.connection, i == peer.best,
+                              score_ ? score_(info) : 0, info.added});
+      }
+    }
+
+    auto to_close = std::min(connections_count_ - config_.low_watermark,
+                             candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + to_close,
+                      candidates.end());
+    candidates.resize(to_close);
+
+    log()->info("trimming {} of {} connections", to_close, connections_count_);
+
+    // closing may call onConnectionClosed and modify connections_
+    for (const auto &candidate : candidates) {
+      if (!candidate.connection->isClosed()) {
+        // ignore errors
+        (void)candidate.connection->close();
+      }
+    }
+    return to_close;
+  }
+
   void ConnectionManagerImpl::onConnectionClosed(
       const peer::PeerId &peer_id,
       const std::shared_ptr<connection::CapableConnection> &conn) {
@@ -142,14 +313,20 @@ namespace libp2p::network {
       return;
     }
 
-    [[maybe_unused]] auto erased = it->second.erase(conn);
-    if (erased == 0) {
+    auto &cs = it->second.connections;
+    auto conn_it = findConnection(cs, conn);
+    if (conn_it == cs.end()) {
       log()->error("inconsistency in onConnectionClosed, connection not found");
+      return;
     }
+    cs.erase(conn_it);
+    --connections_count_;
 
-    if (it->second.empty()) {
-      connections_.erase(peer_id);
+    if (cs.empty()) {
+      connections_.erase(it);
       bus_->getChannel<event::OnPeerDisconnectedChannel>().publish(peer_id);
+    } else {
+      updateBest(it->second);
     }
   }
 
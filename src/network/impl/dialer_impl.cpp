@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/connection/stream.hpp>
 #include <libp2p/log/logger.hpp>
 #include <libp2p/network/impl/dialer_impl.hpp>
@@ -12,12 +13,39 @@
 
 namespace libp2p::network {
 
+  namespace {
+    struct DialerStats {
+      metrics::Counter &reused = metrics::Registry::global().counter(
+          "libp2p_dialer_connections_reused_total",
+          "Dials satisfied by already existing connections");
+      metrics::Counter &attempts = metrics::Registry::global().counter(
+          "libp2p_dialer_attempts_total",
+          "Transport dial attempts, one per peer address");
+      metrics::Counter &attempt_failures = metrics::Registry::global().counter(
+          "libp2p_dialer_attempt_failures_total",
+          "Failed transport dial attempts");
+      metrics::Counter &failures = metrics::Registry::global().counter(
+          "libp2p_dialer_failures_total",
+          "Dials failed on all the peer addresses");
+      metrics::Histogram &duration = metrics::Registry::global().histogram(
+          "libp2p_dialer_dial_duration_seconds",
+          "Time to the first upgraded connection to the peer",
+          metrics::Histogram::durationBuckets());
+    };
+
+    DialerStats &stats() {
+      static DialerStats stats;
+      return stats;
+    }
+  }  // namespace
+
   void DialerImpl::dial(const peer::PeerInfo &p, DialResultFunc cb,
                         std::chrono::milliseconds timeout) {
     if (auto c = cmgr_->getBestConnectionForPeer(p.id); c != nullptr) {
       // we have connection to this peer
 
       TRACE("reusing connection to peer {}", p.id.toBase58().substr(46));
+      stats().reused.inc();
       scheduler_->schedule([cb{std::move(cb)}, c{std::move(c)}] () mutable {
         cb(std::move(c));
       });
@@ -28,6 +56,7 @@ namespace libp2p::network {
     // did user supply its addresses in {@param p}?
     if (p.addresses.empty()) {
       // we don't have addresses of peer p
+      stats().failures.inc();
       scheduler_->schedule([cb{std::move(cb)}] {
         cb(std::errc::destination_address_required);
       });
@@ -38,9 +67,13 @@ namespace libp2p::network {
       bool connected;
       size_t calls_remain;
       DialResultFunc cb;
+      std::chrono::steady_clock::time_point started;
 
       DialHandlerCtx(size_t addresses, DialResultFunc cb)
-          : connected(false), calls_remain(addresses), cb{std::move(cb)} {}
+          : connected(false),
+            calls_remain(addresses),
+            cb{std::move(cb)},
+            started{std::chrono::steady_clock::now()} {}
     };
     auto handler_ctx = std::make_shared<DialHandlerCtx>(p.addresses.size(), cb);
     auto dial_handler =
@@ -65,6 +98,8 @@ namespace libp2p::network {
           if (connection_result) {
             // we've got the first successful connection to the peer, hooray!
             ctx->connected = true;
+            stats().duration.observe(std::chrono::steady_clock::now()
+                                     - ctx->started);
             // allow the connection accept inbound streams
             listener->onConnection(connection_result);
             // return connection to the user
@@ -73,7 +108,9 @@ namespace libp2p::network {
           }
 
           // here we handle failed attempt to connect
+          stats().attempt_failures.inc();
           if (0 == ctx->calls_remain) {
+            stats().failures.inc();
             // that was the last attempt to connect and we are still not
             // connected so lets report an error to the user
             ctx->cb(connection_result.error());
@@ -91,6 +128,7 @@ namespace libp2p::network {
       if (auto tr = this->tmgr_->findBest(ma); tr != nullptr) {
         // we can dial to this peer!
         dialled = true;
+        stats().attempts.inc();
         // dial using best transport
         tr->dial(p.id, ma, dial_handler, timeout);
         // All the dials are still to be executed sequentially within the single
@@ -102,6 +140,7 @@ namespace libp2p::network {
 
     if (not dialled) {
       // we did not find supported transport
+      stats().failures.inc();
       scheduler_->schedule([cb{std::move(cb)}] {
         cb(std::errc::address_family_not_supported);
       });
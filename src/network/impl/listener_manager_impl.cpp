@@ -5,6 +5,7 @@
 
 #include <libp2p/network/impl/listener_manager_impl.hpp>
 
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/log/logger.hpp>
 
 namespace libp2p::network {
@@ -14,17 +15,44 @@ namespace libp2p::network {
       static log::Logger logger = log::createLogger("ListenerManager");
       return logger;
     }
+
+    struct ListenerStats {
+      metrics::Counter &inbound_connections =
+          metrics::Registry::global().counter(
+              "libp2p_connections_total",
+              "Upgraded connections which started to serve streams",
+              {{"direction", "inbound"}});
+      metrics::Counter &outbound_connections =
+          metrics::Registry::global().counter(
+              "libp2p_connections_total",
+              "Upgraded connections which started to serve streams",
+              {{"direction", "outbound"}});
+      metrics::Counter &upgrade_failures = metrics::Registry::global().counter(
+          "libp2p_listener_upgrade_failures_total",
+          "Inbound connections failed to be upgraded");
+      metrics::Counter &negotiation_failures =
+          metrics::Registry::global().counter(
+              "libp2p_inbound_stream_negotiation_failures_total",
+              "Inbound streams reset because of no common protocol");
+    };
+
+    ListenerStats &stats() {
+      static ListenerStats stats;
+      return stats;
+    }
   }  // namespace
 
   ListenerManagerImpl::ListenerManagerImpl(
       std::shared_ptr<protocol_muxer::ProtocolMuxer> multiselect,
       std::shared_ptr<network::Router> router,
       std::shared_ptr<TransportManager> tmgr,
-      std::shared_ptr<ConnectionManager> cmgr)
+      std::shared_ptr<ConnectionManager> cmgr,
+      std::shared_ptr<ResourceManager> resource_manager)
       : multiselect_(std::move(multiselect)),
         router_(std::move(router)),
         tmgr_(std::move(tmgr)),
-        cmgr_(std::move(cmgr)) {
+        cmgr_(std::move(cmgr)),
+        resource_manager_(std::move(resource_manager)) {
     BOOST_ASSERT(multiselect_ != nullptr);
     BOOST_ASSERT(router_ != nullptr);
     BOOST_ASSERT(tmgr_ != nullptr);
@@ -182,9 +210,13 @@ namespace libp2p::network {
     if (!rconn) {
       log()->warn("can not accept valid connection, {}",
                  rconn.error().message());
+      stats().upgrade_failures.inc();
       return;  // ignore
     }
     auto &&conn = rconn.value();
+    (conn->isInitiator() ? stats().outbound_connections
+                         : stats().inbound_connections)
+        .inc();
 
     auto rid = conn->remotePeer();
     if (!rid) {
@@ -193,6 +225,15 @@ namespace libp2p::network {
     }
     auto &&id = rid.value();
 
+    if (resource_manager_) {
+      if (auto res = resource_manager_->addConnection(id, conn); !res) {
+        log()->warn("closing connection to {}: {}", id.toBase58(),
+                    res.error().message());
+        std::ignore = conn->close();
+        return;
+      }
+    }
+
     // set onStream handler function
     conn->onStream(
         [this](outcome::result<std::shared_ptr<connection::Stream>> rstream) {
@@ -202,8 +243,8 @@ namespace libp2p::network {
           }
           auto &&stream = rstream.value();
 
-          auto protocols = this->router_->getSupportedProtocols();
-          if (protocols.empty()) {
+          auto protocols = this->router_->getSupportedProtocolIds();
+          if (protocols->empty()) {
             log()->warn("no protocols are served, resetting inbound stream");
             stream->reset();
             return;
@@ -211,18 +252,29 @@ namespace libp2p::network {
 
           // negotiate protocols
           this->multiselect_->selectOneOf(
-              this->router_->getSupportedProtocols(), stream,
-              false /* not initiator */,
+              *protocols, stream, false /* not initiator */,
               true /* need to negotiate multistream itself - SPEC ???*/,
-              [this, stream](outcome::result<peer::Protocol> rproto) {
+              [this, stream](outcome::result<peer::ProtocolId> rproto) {
                 bool success = true;
 
                 if (!rproto) {
                   log()->warn("can not negotiate protocols, {}",
                              rproto.error().message());
+                  stats().negotiation_failures.inc();
                   success = false;
                 } else {
-                  auto &&proto = rproto.value();
+                  const auto &proto = rproto.value()->name();
+
+                  if (this->resource_manager_) {
+                    auto res = this->resource_manager_->addProtocolStream(
+                        proto, stream);
+                    if (!res) {
+                      log()->warn("rejecting {} stream: {}", proto,
+                                  res.error().message());
+                      stream->reset();
+                      return;
+                    }
+                  }
 
                   auto rhandle = this->router_->handle(proto, stream);
                   if (!rhandle) {
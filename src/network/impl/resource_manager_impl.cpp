@@ -0,0 +1,191 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/network/impl/resource_manager_impl.hpp>
+
+#include <algorithm>
+
+OUTCOME_CPP_DEFINE_CATEGORY(libp2p::network, ResourceManager::Error, e) {
+  using E = libp2p::network::ResourceManager::Error;
+  switch (e) {
+    case E::SYSTEM_LIMIT_EXCEEDED:
+      return "System resource limit exceeded";
+    case E::PEER_LIMIT_EXCEEDED:
+      return "Peer resource limit exceeded";
+    case E::PROTOCOL_LIMIT_EXCEEDED:
+      return "Protocol resource limit exceeded";
+  }
+  return "Unknown error";
+}
+
+namespace libp2p::network {
+
+  namespace {
+    /// Removes expired and closed entries, returns number removed
+    template <typename T>
+    size_t pruneClosed(std::vector<std::weak_ptr<T>> &v) {
+      auto end = std::remove_if(v.begin(), v.end(), [](const auto &wptr) {
+        auto ptr = wptr.lock();
+        return !ptr || ptr->isClosed();
+      });
+      auto removed = static_cast<size_t>(v.end() - end);
+      v.erase(end, v.end());
+      return removed;
+    }
+  }  // namespace
+
+  ResourceManagerImpl::ResourceManagerImpl(ResourceManagerConfig config)
+      : config_(std::move(config)) {}
+
+  outcome::result<void> ResourceManagerImpl::addConnection(
+      const peer::PeerId &peer,
+      const std::shared_ptr<connection::CapableConnection> &conn) {
+    std::lock_guard lock(mutex_);
+    if (auto it = peers_.find(peer); it != peers_.end()) {
+      pruneConnections(it->second);
+      if (it->second.connections.size() >= config_.peer.connections) {
+        return Error::PEER_LIMIT_EXCEEDED;
+      }
+    }
+    if (system_.connections
+        >= std::min(config_.system.connections, prune_connections_at_)) {
+      pruneAllConnections();
+      if (system_.connections >= config_.system.connections) {
+        return Error::SYSTEM_LIMIT_EXCEEDED;
+      }
+    }
+    peers_[peer].connections.emplace_back(conn);
+    ++system_.connections;
+    return outcome::success();
+  }
+
+  outcome::result<void> ResourceManagerImpl::reserveStream(
+      const peer::PeerId &peer) {
+    std::lock_guard lock(mutex_);
+    if (system_.streams >= config_.system.streams) {
+      return Error::SYSTEM_LIMIT_EXCEEDED;
+    }
+    auto it = peers_.try_emplace(peer).first;
+    if (it->second.streams >= config_.peer.streams) {
+      dropIfEmpty(it);
+      return Error::PEER_LIMIT_EXCEEDED;
+    }
+    ++it->second.streams;
+    ++system_.streams;
+    return outcome::success();
+  }
+
+  void ResourceManagerImpl::releaseStream(const peer::PeerId &peer) {
+    std::lock_guard lock(mutex_);
+    auto it = peers_.find(peer);
+    if (it == peers_.end() || it->second.streams == 0) {
+      return;
+    }
+    --it->second.streams;
+    --system_.streams;
+    dropIfEmpty(it);
+  }
+
+  outcome::result<void> ResourceManagerImpl::addProtocolStream(
+      const peer::Protocol &protocol,
+      const std::shared_ptr<connection::Stream> &stream) {
+    std::lock_guard lock(mutex_);
+    auto &scope = protocols_[protocol];
+    auto limit = protocolStreamsLimit(protocol);
+    if (scope.streams.size() >= std::min(limit, scope.prune_at)) {
+      pruneClosed(scope.streams);
+      scope.prune_at = std::max(kMinPruneSize, scope.streams.size() * 2);
+      if (scope.streams.size() >= limit) {
+        return Error::PROTOCOL_LIMIT_EXCEEDED;
+      }
+    }
+    scope.streams.emplace_back(stream);
+    return outcome::success();
+  }
+
+  outcome::result<void> ResourceManagerImpl::reserveMemory(
+      const peer::PeerId &peer, size_t bytes) {
+    std::lock_guard lock(mutex_);
+    if (config_.system.memory - system_.memory < bytes) {
+      return Error::SYSTEM_LIMIT_EXCEEDED;
+    }
+    auto it = peers_.try_emplace(peer).first;
+    if (config_.peer.memory - it->second.memory < bytes) {
+      dropIfEmpty(it);
+      return Error::PEER_LIMIT_EXCEEDED;
+    }
+    it->second.memory += bytes;
+    system_.memory += bytes;
+    return outcome::success();
+  }
+
+  void ResourceManagerImpl::releaseMemory(const peer::PeerId &peer,
+                                          size_t bytes) {
+    std::lock_guard lock(mutex_);
+    auto it = peers_.find(peer);
+    if (it == peers_.end()) {
+      return;
+    }
+    bytes = std::min(bytes, it->second.memory);
+    it->second.memory -= bytes;
+    system_.memory -= bytes;
+    dropIfEmpty(it);
+  }
+
+  ResourceUsage ResourceManagerImpl::systemUsage() const {
+    std::lock_guard lock(mutex_);
+    return system_;
+  }
+
+  ResourceUsage ResourceManagerImpl::peerUsage(const peer::PeerId &peer) const {
+    std::lock_guard lock(mutex_);
+    auto it = peers_.find(peer);
+    if (it == peers_.end()) {
+      return {};
+    }
+    ResourceUsage usage;
+    usage.connections = std::count_if(
+        it->second.connections.begin(), it->second.connections.end(),
+        [](const auto &wptr) {
+          auto conn = wptr.lock();
+          return conn && !conn->isClosed();
+        });
+    usage.streams = it->second.streams;
+    usage.memory = it->second.memory;
+    return usage;
+  }
+
+  void ResourceManagerImpl::pruneConnections(PeerScope &scope) {
+    system_.connections -= pruneClosed(scope.connections);
+  }
+
+  void ResourceManagerImpl::pruneAllConnections() {
+    for (auto it = peers_.begin(); it != peers_.end();) {
+      auto next = std::next(it);
+      pruneConnections(it->second);
+      dropIfEmpty(it);
+      it = next;
+    }
+    prune_connections_at_ = std::max(kMinPruneSize, system_.connections * 2);
+  }
+
+  void ResourceManagerImpl::dropIfEmpty(
+      std::unordered_map<peer::PeerId, PeerScope>::iterator it) {
+    const auto &scope = it->second;
+    if (scope.connections.empty() && scope.streams == 0 && scope.memory == 0) {
+      peers_.erase(it);
+    }
+  }
+
+  size_t ResourceManagerImpl::protocolStreamsLimit(
+      const peer::Protocol &protocol) const {
+    auto it = config_.protocol_streams_overrides.find(protocol);
+    if (it != config_.protocol_streams_overrides.end()) {
+      return it->second;
+    }
+    return config_.protocol_streams;
+  }
+
+}  // namespace libp2p::network
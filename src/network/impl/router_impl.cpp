@@ -26,30 +26,49 @@ namespace libp2p::network {
   void RouterImpl::setProtocolHandler(const peer::Protocol &protocol,
                                       const ProtoHandler &handler,
                                       const ProtoPredicate &predicate) {
-    proto_handlers_[protocol] = PredicateAndHandler{predicate, handler};
+    auto &streams = metrics::Registry::global().counter(
+        "libp2p_inbound_streams_total",
+        "Inbound streams by negotiated protocol", {{"protocol", protocol}});
+    proto_handlers_[protocol] =
+        PredicateAndHandler{predicate, handler, &streams};
+    updateSupportedProtocols();
   }
 
   std::vector<peer::Protocol> RouterImpl::getSupportedProtocols() const {
     std::vector<peer::Protocol> protos;
-    if (proto_handlers_.empty()) {
-      return protos;
-    }
-
-    std::string key_buffer;  // a workaround, recommended by the library's devs
-    protos.reserve(proto_handlers_.size());
-    for (auto it = proto_handlers_.begin(); it != proto_handlers_.end(); ++it) {
-      it.key(key_buffer);
-      protos.push_back(std::move(key_buffer));
+    protos.reserve(supported_->size());
+    for (const auto &id : *supported_) {
+      protos.push_back(id->name());
     }
     return protos;
   }
 
+  std::shared_ptr<const std::vector<peer::ProtocolId>>
+  RouterImpl::getSupportedProtocolIds() const {
+    return supported_;
+  }
+
   void RouterImpl::removeProtocolHandlers(const peer::Protocol &protocol) {
     proto_handlers_.erase_prefix(protocol);
+    updateSupportedProtocols();
   }
 
   void RouterImpl::removeAll() {
     proto_handlers_.clear();
+    updateSupportedProtocols();
+  }
+
+  void RouterImpl::updateSupportedProtocols() {
+    // handlers are updated rarely, so the snapshot is rebuilt rather than
+    // patched; streams being negotiated keep the previous one
+    auto supported = std::make_shared<std::vector<peer::ProtocolId>>();
+    supported->reserve(proto_handlers_.size());
+    std::string key_buffer;  // a workaround, recommended by the library's devs
+    for (auto it = proto_handlers_.begin(); it != proto_handlers_.end(); ++it) {
+      it.key(key_buffer);
+      supported->push_back(peer::internProtocol(key_buffer));
+    }
+    supported_ = std::move(supported);
   }
 
   outcome::result<void> RouterImpl::handle(
@@ -64,6 +83,7 @@ namespace libp2p::network {
     const auto &pred_hand = matched_proto.value();
     if (matched_proto.key() == p || pred_hand.predicate(p)) {
       // perfect or predicate match
+      pred_hand.streams->inc();
       pred_hand.handler(std::move(stream));
       return outcome::success();
     }
@@ -73,22 +93,23 @@ namespace libp2p::network {
     // predicate; the longest match is to be called
     auto matched_protos = proto_handlers_.equal_prefix_range_ks(p.data(), 2);
 
-    std::reference_wrapper<const ProtoHandler> longest_match{
-        matched_protos.first.value().handler};
+    std::reference_wrapper<const PredicateAndHandler> longest_match{
+        matched_protos.first.value()};
     size_t longest_match_size = 0;
     for (auto match = matched_protos.first; match != matched_protos.second;
          ++match) {
       if (match.value().predicate(p)
           && match.key().size() > longest_match_size) {
         longest_match_size = match.key().size();
-        longest_match = match.value().handler;
+        longest_match = match.value();
       }
     }
 
     if (longest_match_size == 0) {
       return Error::NO_HANDLER_FOUND;
     }
-    longest_match(std::move(stream));
+    longest_match.get().streams->inc();
+    longest_match.get().handler(std::move(stream));
     return outcome::success();
   }
 
@@ -5,10 +5,29 @@
 
 #include <libp2p/peer/address_repository/inmem_address_repository.hpp>
 
+#include <algorithm>
+#include <limits>
+
 #include <libp2p/peer/errors.hpp>
 
 namespace libp2p::peer {
 
+  namespace {
+    /// Index is rebuilt when outdated entries are more than live ones and
+    /// this number
+    constexpr size_t kMinIndexCompaction = 1024;
+
+    /// Saturates at time_point::max() for permanent addresses
+    Clock::time_point expiresAt(std::chrono::milliseconds ttl) {
+      auto now = Clock::now();
+      if (ttl >= std::chrono::duration_cast<std::chrono::milliseconds>(
+              Clock::time_point::max() - now)) {
+        return Clock::time_point::max();
+      }
+      return now + ttl;
+    }
+  }  // namespace
+
   InmemAddressRepository::InmemAddressRepository(
       std::shared_ptr<network::DnsaddrResolver> dnsaddr_resolver)
       : dnsaddr_resolver_{std::move(dnsaddr_resolver)} {
@@ -79,14 +98,20 @@ namespace libp2p::peer {
     auto peer_it = findOrInsert(p);
     auto &addresses = *peer_it->second;
 
-    auto expires_at = Clock::now() + ttl;
+    auto expires_at = expiresAt(ttl);
     for (const auto &m : ma) {
-      if (addresses.emplace(m, expires_at).second) {
+      auto [addr_it, inserted] = addresses.emplace(m, expires_at);
+      if (inserted) {
+        ++addresses_count_;
+        setExpiry(p, addr_it, expires_at);
         signal_added_(p, m);
         added = true;
       }
     }
 
+    if (addresses.empty()) {
+      maybe_empty_.push_back(p);
+    }
     return added;
   }
 
@@ -97,17 +122,22 @@ namespace libp2p::peer {
     auto peer_it = findOrInsert(p);
     auto &addresses = *peer_it->second;
 
-    auto expires_at = Clock::now() + ttl;
+    auto expires_at = expiresAt(ttl);
     for (const auto &m : ma) {
-      auto [addr_it, added] = addresses.emplace(m, expires_at);
-      if (added) {
+      auto [addr_it, inserted] = addresses.emplace(m, expires_at);
+      if (inserted) {
+        ++addresses_count_;
+        setExpiry(p, addr_it, expires_at);
         signal_added_(p, m);
         added = true;
       } else {
-        addr_it->second = expires_at;
+        setExpiry(p, addr_it, expires_at);
       }
     }
 
+    if (addresses.empty()) {
+      maybe_empty_.push_back(p);
+    }
     return added;
   }
 
@@ -119,9 +149,10 @@ namespace libp2p::peer {
     }
     auto &addresses = *peer_it->second;
 
-    auto expires_at = Clock::now() + ttl;
-    std::for_each(addresses.begin(), addresses.end(),
-                  [expires_at](auto &item) { item.second = expires_at; });
+    auto expires_at = expiresAt(ttl);
+    for (auto it = addresses.begin(); it != addresses.end(); ++it) {
+      setExpiry(p, it, expires_at);
+    }
 
     return outcome::success();
   }  // namespace libp2p::peer
@@ -147,44 +178,93 @@ namespace libp2p::peer {
       for (const auto &item : *it->second) {
         signal_removed_(p, item.first);
       }
+      addresses_count_ -= it->second->size();
       it->second->clear();
+      maybe_empty_.push_back(p);
     }
   }
 
   void InmemAddressRepository::collectGarbage() {
+    std::ignore = collectSomeGarbage(std::numeric_limits<size_t>::max());
+  }
+
+  bool InmemAddressRepository::collectSomeGarbage(size_t budget) {
     auto now = Clock::now();
-    auto peer = db_.begin();
-    auto peer_end = db_.end();
-
-    // for each peer
-    while (peer != peer_end) {
-      auto &&maptr = peer->second;
-
-      // remove all expired addresses
-      auto ma = maptr->begin();
-      auto ma_end = maptr->end();
-      while (ma != ma_end) {
-        if (now >= ma->second) {
-          signal_removed_(peer->first, ma->first);
-          // erase returns element next to deleted
-          ma = maptr->erase(ma);
-        } else {
-          ++ma;
-        }
+
+    // remove expired addresses, peers left without addresses are removed too
+    while (budget > 0 && !expiry_index_.empty()
+           && expiry_index_.front().expires_at <= now) {
+      --budget;
+      std::pop_heap(expiry_index_.begin(), expiry_index_.end(),
+                    ExpiresLater{});
+      auto expiry = std::move(expiry_index_.back());
+      expiry_index_.pop_back();
+      expire(expiry);
+    }
+
+    // peers cleared or added without addresses
+    while (budget > 0 && !maybe_empty_.empty()) {
+      --budget;
+      auto it = db_.find(maybe_empty_.back());
+      if (it != db_.end() && it->second->empty()) {
+        db_.erase(it);
       }
+      maybe_empty_.pop_back();
+    }
 
-      // peer has no more addresses
-      if (peer->second->empty()) {
-        // erase returns element next to deleted
-        peer = db_.erase(peer);
-      } else {
-        ++peer;
+    return maybe_empty_.empty()
+        && (expiry_index_.empty() || expiry_index_.front().expires_at > now);
+  }
+
+  void InmemAddressRepository::setExpiry(const PeerId &p, ttlmap::iterator it,
+                                         Clock::time_point expires_at) {
+    it->second = expires_at;
+    if (expires_at == Clock::time_point::max()) {
+      // permanent addresses are not indexed
+      return;
+    }
+    expiry_index_.push_back({expires_at, p, it->first});
+    std::push_heap(expiry_index_.begin(), expiry_index_.end(), ExpiresLater{});
+    compactIndex();
+  }
+
+  void InmemAddressRepository::expire(const Expiry &expiry) {
+    auto peer_it = db_.find(expiry.peer);
+    if (peer_it == db_.end()) {
+      return;
+    }
+    auto &addresses = *peer_it->second;
+    auto it = addresses.find(expiry.address);
+    if (it == addresses.end() || it->second != expiry.expires_at) {
+      // address was removed or its ttl was updated
+      return;
+    }
+    addresses.erase(it);
+    --addresses_count_;
+    if (addresses.empty()) {
+      db_.erase(peer_it);
+    }
+    signal_removed_(expiry.peer, expiry.address);
+  }
+
+  void InmemAddressRepository::compactIndex() {
+    if (expiry_index_.size() < 2 * addresses_count_ + kMinIndexCompaction) {
+      return;
+    }
+    expiry_index_.clear();
+    for (const auto &[peer, addresses] : db_) {
+      for (const auto &[address, expires_at] : *addresses) {
+        if (expires_at != Clock::time_point::max()) {
+          expiry_index_.push_back({expires_at, peer, address});
+        }
       }
     }
+    std::make_heap(expiry_index_.begin(), expiry_index_.end(), ExpiresLater{});
   }
 
   std::unordered_set<PeerId> InmemAddressRepository::getPeers() const {
     std::unordered_set<PeerId> peers;
+    peers.reserve(db_.size());
     for (const auto &it : db_) {
       peers.insert(it.first);
     }
@@ -192,4 +272,15 @@ namespace libp2p::peer {
     return peers;
   }
 
+  void InmemAddressRepository::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    for (const auto &it : db_) {
+      visitor(it.first);
+    }
+  }
+
+  bool InmemAddressRepository::hasPeer(const PeerId &p) const {
+    return db_.count(p) != 0;
+  }
+
 }  // namespace libp2p::peer
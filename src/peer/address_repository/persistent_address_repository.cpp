@@ -0,0 +1,236 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/address_repository/persistent_address_repository.hpp>
+
+#include <limits>
+
+#include <boost/assert.hpp>
+
+namespace libp2p::peer {
+
+  PersistentAddressRepository::PersistentAddressRepository(
+      std::shared_ptr<AddressRepository> cache, std::shared_ptr<PeerstoreDb> db)
+      : cache_(std::move(cache)), db_(std::move(db)) {
+    BOOST_ASSERT(cache_);
+    BOOST_ASSERT(db_);
+
+    auto &sql = db_->db();
+    select_all_ = sql.createStatement(
+        "SELECT peer, address, expires_at FROM addresses "
+        "WHERE expires_at > ?;");
+    select_addresses_ = sql.createStatement(
+        "SELECT address, expires_at FROM addresses "
+        "WHERE peer = ? AND expires_at > ?;");
+    select_peers_ = sql.createStatement(
+        "SELECT DISTINCT peer FROM addresses WHERE expires_at > ?;");
+    select_peer_ = sql.createStatement(
+        "SELECT EXISTS (SELECT 1 FROM addresses "
+        "WHERE peer = ? AND expires_at > ?);");
+    insert_ = sql.createStatement(
+        "INSERT OR IGNORE INTO addresses VALUES (?, ?, ?);");
+    upsert_ = sql.createStatement(
+        "INSERT OR REPLACE INTO addresses VALUES (?, ?, ?);");
+    update_ = sql.createStatement(
+        "UPDATE addresses SET expires_at = ? "
+        "WHERE peer = ? AND expires_at > ?;");
+    delete_peer_ = sql.createStatement("DELETE FROM addresses WHERE peer = ?;");
+    delete_expired_ =
+        sql.createStatement("DELETE FROM addresses WHERE expires_at <= ?;");
+
+    on_added_ = cache_->onAddressAdded(
+        [this](const PeerId &p, const multi::Multiaddress &ma) {
+          if (!loading_) {
+            signal_added_(p, ma);
+          }
+        });
+    on_removed_ = cache_->onAddressRemoved(
+        [this](const PeerId &p, const multi::Multiaddress &ma) {
+          signal_removed_(p, ma);
+        });
+
+    if (db_->config().preload) {
+      preload();
+    }
+  }
+
+  void PersistentAddressRepository::bootstrap(
+      const multi::Multiaddress &ma, std::function<BootstrapCallback> cb) {
+    cache_->bootstrap(ma, std::move(cb));
+  }
+
+  outcome::result<bool> PersistentAddressRepository::addAddresses(
+      const PeerId &p, gsl::span<const multi::Multiaddress> ma,
+      Milliseconds ttl) {
+    load(p);
+    OUTCOME_TRY(added, cache_->addAddresses(p, ma, ttl));
+
+    auto expires_at = db_->expiresAt(ttl);
+    for (const auto &m : ma) {
+      db_->enqueue([st{insert_}, peer{p.toVector()},
+                    address{m.getBytesAddress()},
+                    expires_at](storage::SQLite &sql) {
+        sql.execCommand(st, peer, address, expires_at);
+      });
+    }
+    return added;
+  }
+
+  outcome::result<bool> PersistentAddressRepository::upsertAddresses(
+      const PeerId &p, gsl::span<const multi::Multiaddress> ma,
+      Milliseconds ttl) {
+    load(p);
+    OUTCOME_TRY(added, cache_->upsertAddresses(p, ma, ttl));
+
+    auto expires_at = db_->expiresAt(ttl);
+    for (const auto &m : ma) {
+      db_->enqueue([st{upsert_}, peer{p.toVector()},
+                    address{m.getBytesAddress()},
+                    expires_at](storage::SQLite &sql) {
+        sql.execCommand(st, peer, address, expires_at);
+      });
+    }
+    return added;
+  }
+
+  outcome::result<void> PersistentAddressRepository::updateAddresses(
+      const PeerId &p, Milliseconds ttl) {
+    load(p);
+    OUTCOME_TRY(cache_->updateAddresses(p, ttl));
+
+    // addresses, which are expired but not collected yet, are not updated in
+    // cache either
+    db_->enqueue([st{update_}, peer{p.toVector()},
+                  expires_at{db_->expiresAt(ttl)},
+                  now{db_->now()}](storage::SQLite &sql) {
+      sql.execCommand(st, expires_at, peer, now);
+    });
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<multi::Multiaddress>>
+  PersistentAddressRepository::getAddresses(const PeerId &p) const {
+    load(p);
+    return cache_->getAddresses(p);
+  }
+
+  void PersistentAddressRepository::clear(const PeerId &p) {
+    load(p);
+    cache_->clear(p);
+    db_->enqueue([st{delete_peer_}, peer{p.toVector()}](storage::SQLite &sql) {
+      sql.execCommand(st, peer);
+    });
+  }
+
+  void PersistentAddressRepository::collectGarbage() {
+    std::ignore = collectSomeGarbage(std::numeric_limits<size_t>::max());
+  }
+
+  bool PersistentAddressRepository::collectSomeGarbage(size_t budget) {
+    if (!cache_->collectSomeGarbage(budget)) {
+      return false;
+    }
+
+    db_->enqueue(
+        [st{delete_expired_}, now{db_->now()}](storage::SQLite &sql) {
+          sql.execCommand(st, now);
+        });
+    db_->flush();
+
+    // db is up to date, peers evicted from cache may be loaded again
+    for (auto it = loaded_.begin(); it != loaded_.end();) {
+      if (cache_->hasPeer(*it)) {
+        ++it;
+      } else {
+        it = loaded_.erase(it);
+      }
+    }
+    return true;
+  }
+
+  std::unordered_set<PeerId> PersistentAddressRepository::getPeers() const {
+    std::unordered_set<PeerId> peers;
+    forEachPeer([&](const PeerId &p) { peers.insert(p); });
+    return peers;
+  }
+
+  void PersistentAddressRepository::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    cache_->forEachPeer(visitor);
+    if (preloaded_) {
+      return;
+    }
+
+    // peers not loaded yet, collected before visiting, so that visitor may
+    // read their addresses
+    std::vector<PeerId> stored;
+    db_->db().execQuery(
+        select_peers_,
+        [&](std::vector<uint8_t> bytes) {
+          auto peer = PeerId::fromBytes(bytes);
+          if (peer && loaded_.count(peer.value()) == 0) {
+            stored.push_back(std::move(peer.value()));
+          }
+        },
+        db_->now());
+    for (const auto &p : stored) {
+      visitor(p);
+    }
+  }
+
+  bool PersistentAddressRepository::hasPeer(const PeerId &p) const {
+    if (preloaded_ || loaded_.count(p) != 0) {
+      return cache_->hasPeer(p);
+    }
+    int exists = 0;
+    db_->db().execQuery(
+        select_peer_, [&](int value) { exists = value; }, p.toVector(),
+        db_->now());
+    return exists != 0;
+  }
+
+  void PersistentAddressRepository::preload() {
+    db_->db().execQuery(
+        select_all_,
+        [&](std::vector<uint8_t> peer,
+            std::vector<uint8_t> bytes,
+            PeerstoreDb::Timestamp expires_at) {
+          if (auto p = PeerId::fromBytes(peer)) {
+            loadAddress(p.value(), bytes, expires_at);
+          }
+        },
+        db_->now());
+    preloaded_ = true;
+  }
+
+  void PersistentAddressRepository::load(const PeerId &p) const {
+    if (preloaded_ || !loaded_.insert(p).second) {
+      return;
+    }
+    db_->db().execQuery(
+        select_addresses_,
+        [&](std::vector<uint8_t> bytes, PeerstoreDb::Timestamp expires_at) {
+          loadAddress(p, bytes, expires_at);
+        },
+        p.toVector(), db_->now());
+  }
+
+  void PersistentAddressRepository::loadAddress(
+      const PeerId &p,
+      gsl::span<const uint8_t> address,
+      PeerstoreDb::Timestamp expires_at) const {
+    auto ma = multi::Multiaddress::create(address);
+    if (!ma) {
+      return;
+    }
+    // addresses were announced when they were added before restart
+    loading_ = true;
+    std::ignore = cache_->upsertAddresses(
+        p, gsl::span<const multi::Multiaddress>(&ma.value(), 1),
+        db_->ttl(expires_at));
+    loading_ = false;
+  }
+
+}  // namespace libp2p::peer
@@ -7,16 +7,6 @@
 
 #include <libp2p/multi/multiaddress.hpp>
 
-namespace {
-
-  template <typename T>
-  inline void merge_sets(std::unordered_set<T> &out,
-                         std::unordered_set<T> &&in) {
-    out.insert(in.begin(), in.end());
-  }
-
-}  // namespace
-
 namespace libp2p::peer {
 
   PeerRepositoryImpl::PeerRepositoryImpl(
@@ -45,12 +35,26 @@ namespace libp2p::peer {
 
   std::unordered_set<PeerId> PeerRepositoryImpl::getPeers() const {
     std::unordered_set<PeerId> peers;
-    merge_sets<PeerId>(peers, addr_->getPeers());
-    merge_sets<PeerId>(peers, key_->getPeers());
-    merge_sets<PeerId>(peers, proto_->getPeers());
+    forEachPeer([&peers](const PeerId &p) { peers.insert(p); });
     return peers;
   }
 
+  void PeerRepositoryImpl::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    // peer known by several repositories is visited by the first of them
+    addr_->forEachPeer(visitor);
+    key_->forEachPeer([&](const PeerId &p) {
+      if (!addr_->hasPeer(p)) {
+        visitor(p);
+      }
+    });
+    proto_->forEachPeer([&](const PeerId &p) {
+      if (!addr_->hasPeer(p) && !key_->hasPeer(p)) {
+        visitor(p);
+      }
+    });
+  }
+
   PeerInfo PeerRepositoryImpl::getPeerInfo(const PeerId &peer_id) const {
     auto peer_addrs_res = addr_->getAddresses(peer_id);
     if (!peer_addrs_res) {
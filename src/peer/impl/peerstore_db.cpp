@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/impl/peerstore_db.hpp>
+
+#include <cassert>
+
+namespace libp2p::peer {
+
+  PeerstoreDb::PeerstoreDb(std::shared_ptr<storage::SQLite> db,
+                           std::shared_ptr<basic::Scheduler> scheduler,
+                           Config config)
+      : db_(std::move(db)),
+        scheduler_(std::move(scheduler)),
+        config_(std::move(config)) {
+    assert(db_);
+    assert(scheduler_);
+    assert(config_.max_batch > 0);
+    assert(config_.clock);
+
+    // in-memory databases stay in "memory" mode
+    std::string journal_mode;
+    *db_ << "PRAGMA journal_mode = WAL;" >> journal_mode;
+    // WAL is synced on checkpoints only, the last batches may be lost on
+    // power failure, which is fine for a cache of peers
+    *db_ << "PRAGMA synchronous = NORMAL;";
+
+    *db_ << "CREATE TABLE IF NOT EXISTS addresses ("
+            "peer BLOB NOT NULL, "
+            "address BLOB NOT NULL, "
+            "expires_at INTEGER NOT NULL, "
+            "PRIMARY KEY (peer, address)) WITHOUT ROWID;";
+    *db_ << "CREATE INDEX IF NOT EXISTS addresses_expires_at "
+            "ON addresses (expires_at);";
+    *db_ << "CREATE TABLE IF NOT EXISTS public_keys ("
+            "peer BLOB NOT NULL, "
+            "type INTEGER NOT NULL, "
+            "data BLOB NOT NULL, "
+            "PRIMARY KEY (peer, type, data)) WITHOUT ROWID;";
+    *db_ << "CREATE TABLE IF NOT EXISTS protocols ("
+            "peer BLOB NOT NULL, "
+            "protocol TEXT NOT NULL, "
+            "PRIMARY KEY (peer, protocol)) WITHOUT ROWID;";
+
+    begin_ = db_->createStatement("BEGIN;");
+    commit_ = db_->createStatement("COMMIT;");
+  }
+
+  PeerstoreDb::~PeerstoreDb() {
+    flush();
+  }
+
+  void PeerstoreDb::enqueue(Write write) {
+    journal_.push_back(std::move(write));
+    if (journal_.size() >= config_.max_batch) {
+      flush();
+      return;
+    }
+    if (!flush_scheduled_) {
+      flush_scheduled_ = true;
+      flush_handle_ =
+          scheduler_->scheduleWithHandle([this] { flush(); },
+                                         config_.flush_interval);
+    }
+  }
+
+  void PeerstoreDb::flush() {
+    flush_handle_.cancel();
+    flush_scheduled_ = false;
+    if (journal_.empty()) {
+      return;
+    }
+
+    std::vector<Write> journal;
+    journal.swap(journal_);
+
+    db_->execCommand(begin_);
+    for (auto &write : journal) {
+      write(*db_);
+    }
+    db_->execCommand(commit_);
+  }
+
+  PeerstoreDb::Timestamp PeerstoreDb::expiresAt(
+      std::chrono::milliseconds ttl) const {
+    auto now_ms = now();
+    if (ttl.count() >= kNever - now_ms) {
+      return kNever;
+    }
+    return now_ms + ttl.count();
+  }
+
+  std::chrono::milliseconds PeerstoreDb::ttl(Timestamp expires_at) const {
+    if (expires_at == kNever) {
+      return std::chrono::milliseconds::max();
+    }
+    return std::chrono::milliseconds(expires_at - now());
+  }
+
+}  // namespace libp2p::peer
@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/interned_protocol.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+#include <libp2p/protocol_muxer/multiselect/common.hpp>
+
+namespace libp2p::peer {
+
+  namespace {
+    using protocol_muxer::multiselect::kMaxMessageSize;
+    using protocol_muxer::multiselect::kMaxVarintSize;
+    using protocol_muxer::multiselect::kNewLine;
+    using protocol_muxer::multiselect::kProtocolId;
+
+    void appendLine(std::vector<uint8_t> &buffer, std::string_view line) {
+      auto size = line.size() + 1;
+      do {
+        uint8_t byte = size & 0x7F;
+        size >>= 7;
+        if (size != 0) {
+          byte |= 0x80;
+        }
+        buffer.push_back(byte);
+      } while (size > 0);
+      buffer.insert(buffer.end(), line.begin(), line.end());
+      buffer.push_back(kNewLine);
+    }
+
+    struct Registry {
+      std::mutex mutex;
+
+      /// Keys point to names of interned protocols
+      std::unordered_map<std::string_view, std::weak_ptr<const InternedProtocol>>
+          protocols;
+    };
+
+    Registry &registry() {
+      // never destroyed, protocol ids may be released by static objects
+      static auto *registry = new Registry();
+      return *registry;
+    }
+  }  // namespace
+
+  InternedProtocol::InternedProtocol(std::string_view name) : name_(name) {
+    if (name.size() + 1 > kMaxMessageSize - kMaxVarintSize) {
+      return;
+    }
+    encoded_.reserve(kProtocolId.size() + name.size() + 2 * kMaxVarintSize
+                     + 2);
+    appendLine(encoded_, kProtocolId);
+    header_size_ = encoded_.size();
+    appendLine(encoded_, name);
+  }
+
+  ProtocolId internProtocol(std::string_view name) {
+    auto &r = registry();
+    std::lock_guard lock(r.mutex);
+
+    auto it = r.protocols.find(name);
+    if (it != r.protocols.end()) {
+      if (auto protocol = it->second.lock()) {
+        return protocol;
+      }
+      // is being released, its deleter will not touch the new entry
+      r.protocols.erase(it);
+    }
+
+    ProtocolId protocol(new InternedProtocol(name),
+                        [](const InternedProtocol *p) {
+                          auto &r = registry();
+                          {
+                            std::lock_guard lock(r.mutex);
+                            auto it = r.protocols.find(p->name());
+                            if (it != r.protocols.end()
+                                && it->first.data() == p->name().data()) {
+                              r.protocols.erase(it);
+                            }
+                          }
+                          delete p;
+                        });
+    r.protocols.emplace(protocol->name(), protocol);
+    return protocol;
+  }
+
+}  // namespace libp2p::peer
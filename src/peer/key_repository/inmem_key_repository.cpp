@@ -15,11 +15,10 @@ namespace libp2p::peer {
   void InmemKeyRepository::clear(const PeerId &p) {
     auto it1 = pub_.find(p);
     if (it1 != pub_.end()) {
-      // if vector is found, then clear it
+      // if vector is found, then clear it, sets returned before stay valid
       it1->second->clear();
+      pub_.erase(it1);
     }
-
-    kp_->clear();
   }
 
   outcome::result<InmemKeyRepository::PubVecPtr>
@@ -62,6 +61,7 @@ namespace libp2p::peer {
 
   std::unordered_set<PeerId> InmemKeyRepository::getPeers() const {
     std::unordered_set<PeerId> peers;
+    peers.reserve(pub_.size());
     for (const auto &it : pub_) {
       peers.insert(it.first);
     }
@@ -69,4 +69,15 @@ namespace libp2p::peer {
     return peers;
   };
 
+  void InmemKeyRepository::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    for (const auto &it : pub_) {
+      visitor(it.first);
+    }
+  }
+
+  bool InmemKeyRepository::hasPeer(const PeerId &p) const {
+    return pub_.count(p) != 0;
+  }
+
 }  // namespace libp2p::peer
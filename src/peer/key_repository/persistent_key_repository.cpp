@@ -0,0 +1,171 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/key_repository/persistent_key_repository.hpp>
+
+#include <boost/assert.hpp>
+
+namespace libp2p::peer {
+
+  PersistentKeyRepository::PersistentKeyRepository(
+      std::shared_ptr<KeyRepository> cache, std::shared_ptr<PeerstoreDb> db)
+      : cache_(std::move(cache)), db_(std::move(db)) {
+    BOOST_ASSERT(cache_);
+    BOOST_ASSERT(db_);
+
+    auto &sql = db_->db();
+    select_all_ =
+        sql.createStatement("SELECT peer, type, data FROM public_keys;");
+    select_keys_ = sql.createStatement(
+        "SELECT type, data FROM public_keys WHERE peer = ?;");
+    select_peers_ =
+        sql.createStatement("SELECT DISTINCT peer FROM public_keys;");
+    select_peer_ = sql.createStatement(
+        "SELECT EXISTS (SELECT 1 FROM public_keys WHERE peer = ?);");
+    insert_ = sql.createStatement(
+        "INSERT OR IGNORE INTO public_keys VALUES (?, ?, ?);");
+    delete_peer_ =
+        sql.createStatement("DELETE FROM public_keys WHERE peer = ?;");
+    delete_orphans_ = sql.createStatement(
+        "DELETE FROM public_keys "
+        "WHERE peer NOT IN (SELECT peer FROM addresses);");
+
+    if (db_->config().preload) {
+      preload();
+    }
+  }
+
+  void PersistentKeyRepository::clear(const PeerId &p) {
+    load(p);
+    cache_->clear(p);
+    db_->enqueue([st{delete_peer_}, peer{p.toVector()}](storage::SQLite &sql) {
+      sql.execCommand(st, peer);
+    });
+  }
+
+  outcome::result<PersistentKeyRepository::PubVecPtr>
+  PersistentKeyRepository::getPublicKeys(const PeerId &p) {
+    load(p);
+    return cache_->getPublicKeys(p);
+  }
+
+  outcome::result<void> PersistentKeyRepository::addPublicKey(
+      const PeerId &p, const crypto::PublicKey &pub) {
+    load(p);
+    OUTCOME_TRY(cache_->addPublicKey(p, pub));
+    db_->enqueue([st{insert_}, peer{p.toVector()},
+                  type{static_cast<int>(pub.type)},
+                  data{pub.data}](storage::SQLite &sql) {
+      sql.execCommand(st, peer, type, data);
+    });
+    return outcome::success();
+  }
+
+  outcome::result<PersistentKeyRepository::KeyPairVecPtr>
+  PersistentKeyRepository::getKeyPairs() {
+    return cache_->getKeyPairs();
+  }
+
+  outcome::result<void> PersistentKeyRepository::addKeyPair(
+      const KeyPair &kp) {
+    return cache_->addKeyPair(kp);
+  }
+
+  std::unordered_set<PeerId> PersistentKeyRepository::getPeers() const {
+    std::unordered_set<PeerId> peers;
+    forEachPeer([&](const PeerId &p) { peers.insert(p); });
+    return peers;
+  }
+
+  void PersistentKeyRepository::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    cache_->forEachPeer(visitor);
+    if (preloaded_) {
+      return;
+    }
+
+    std::vector<PeerId> stored;
+    db_->db().execQuery(select_peers_, [&](std::vector<uint8_t> bytes) {
+      auto peer = PeerId::fromBytes(bytes);
+      if (peer && loaded_.count(peer.value()) == 0) {
+        stored.push_back(std::move(peer.value()));
+      }
+    });
+    for (const auto &p : stored) {
+      visitor(p);
+    }
+  }
+
+  bool PersistentKeyRepository::hasPeer(const PeerId &p) const {
+    if (preloaded_ || loaded_.count(p) != 0) {
+      return cache_->hasPeer(p);
+    }
+    int exists = 0;
+    db_->db().execQuery(
+        select_peer_, [&](int value) { exists = value; }, p.toVector());
+    return exists != 0;
+  }
+
+  void PersistentKeyRepository::collectGarbage() {
+    // journaled after the writes of address repository, which shares db
+    db_->enqueue([st{delete_orphans_}](storage::SQLite &sql) {
+      sql.execCommand(st);
+    });
+    db_->flush();
+
+    std::unordered_set<PeerId> stored;
+    db_->db().execQuery(select_peers_, [&](std::vector<uint8_t> bytes) {
+      if (auto peer = PeerId::fromBytes(bytes)) {
+        stored.insert(std::move(peer.value()));
+      }
+    });
+    for (const auto &p : cache_->getPeers()) {
+      if (stored.count(p) == 0) {
+        cache_->clear(p);
+        loaded_.erase(p);
+      }
+    }
+    for (auto it = loaded_.begin(); it != loaded_.end();) {
+      if (stored.count(*it) == 0) {
+        it = loaded_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void PersistentKeyRepository::preload() {
+    db_->db().execQuery(
+        select_all_,
+        [&](std::vector<uint8_t> peer, int type, std::vector<uint8_t> data) {
+          if (auto p = PeerId::fromBytes(peer)) {
+            loadKey(p.value(), type, std::move(data));
+          }
+        });
+    preloaded_ = true;
+  }
+
+  void PersistentKeyRepository::load(const PeerId &p) {
+    if (preloaded_ || !loaded_.insert(p).second) {
+      return;
+    }
+    db_->db().execQuery(
+        select_keys_,
+        [&](int type, std::vector<uint8_t> data) {
+          loadKey(p, type, std::move(data));
+        },
+        p.toVector());
+  }
+
+  void PersistentKeyRepository::loadKey(const PeerId &p,
+                                        int type,
+                                        std::vector<uint8_t> data) {
+    crypto::PublicKey pub;
+    pub.type = static_cast<crypto::Key::Type>(type);
+    pub.data = std::move(data);
+    std::ignore = cache_->addPublicKey(p, pub);
+  }
+
+}  // namespace libp2p::peer
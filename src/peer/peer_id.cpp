@@ -5,6 +5,9 @@
 
 #include <libp2p/peer/peer_id.hpp>
 
+#include <atomic>
+#include <cctype>
+
 #include <boost/assert.hpp>
 #include <libp2p/crypto/sha/sha256.hpp>
 #include <libp2p/multi/multibase_codec/codecs/base58.hpp>
@@ -28,6 +31,33 @@ namespace libp2p::peer {
 
   PeerId::PeerId(multi::Multihash hash) : hash_{std::move(hash)} {}
 
+  PeerId::PeerId(const PeerId &other)
+      : hash_{other.hash_}, base58_{std::atomic_load(&other.base58_)} {}
+
+  PeerId &PeerId::operator=(const PeerId &other) {
+    if (this != &other) {
+      hash_ = other.hash_;
+      std::atomic_store(&base58_, std::atomic_load(&other.base58_));
+    }
+    return *this;
+  }
+
+  PeerId::PeerId(PeerId &&other) noexcept
+      : hash_{std::move(other.hash_)},
+        base58_{std::atomic_exchange(
+            &other.base58_, std::shared_ptr<const std::string>{})} {}
+
+  PeerId &PeerId::operator=(PeerId &&other) noexcept {
+    if (this != &other) {
+      hash_ = std::move(other.hash_);
+      std::atomic_store(
+          &base58_,
+          std::atomic_exchange(&other.base58_,
+                               std::shared_ptr<const std::string>{}));
+    }
+    return *this;
+  }
+
   PeerId::FactoryResult PeerId::fromPublicKey(const crypto::ProtobufKey &key) {
     std::vector<uint8_t> hash;
 
@@ -53,7 +83,16 @@ namespace libp2p::peer {
       return FactoryError::SHA256_EXPECTED;
     }
 
-    return PeerId{std::move(hash)};
+    // base58 form of bytes is unique, so the input is reused, unless it had
+    // spaces around or non-canonical multihash header
+    auto canonical = !std::isspace(static_cast<unsigned char>(id.front()))
+        && !std::isspace(static_cast<unsigned char>(id.back()))
+        && hash.toBuffer() == decoded_id;
+    PeerId peer_id{std::move(hash)};
+    if (canonical) {
+      peer_id.base58_ = std::make_shared<const std::string>(id);
+    }
+    return peer_id;
   }
 
   PeerId::FactoryResult PeerId::fromHash(const Multihash &hash) {
@@ -78,7 +117,13 @@ namespace libp2p::peer {
   }
 
   std::string PeerId::toBase58() const {
-    return encodeBase58(hash_.toBuffer());
+    auto cached = std::atomic_load(&base58_);
+    if (!cached) {
+      cached =
+          std::make_shared<const std::string>(encodeBase58(hash_.toBuffer()));
+      std::atomic_store(&base58_, cached);
+    }
+    return *cached;
   }
 
   const std::vector<uint8_t>& PeerId::toVector() const {
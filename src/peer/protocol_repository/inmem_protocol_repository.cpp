@@ -5,6 +5,9 @@
 
 #include <libp2p/peer/protocol_repository/inmem_protocol_repository.hpp>
 
+#include <algorithm>
+#include <limits>
+
 #include <libp2p/peer/errors.hpp>
 
 namespace libp2p::peer {
@@ -13,9 +16,14 @@ namespace libp2p::peer {
       const PeerId &p, gsl::span<const Protocol> ms) {
     auto s = getOrAllocateProtocolSet(p);
     for (const auto &m : ms) {
-      s->insert(m);
+      if (s->find(m) == s->end()) {
+        s->insert(internProtocol(m));
+      }
     }
 
+    if (s->empty()) {
+      maybe_empty_.push_back(p);
+    }
     return outcome::success();
   }
 
@@ -24,16 +32,26 @@ namespace libp2p::peer {
     OUTCOME_TRY(s, getProtocolSet(p));
 
     for (const auto &m : ms) {
-      s->erase(m);
+      if (auto it = s->find(m); it != s->end()) {
+        s->erase(it);
+      }
     }
 
+    if (s->empty()) {
+      maybe_empty_.push_back(p);
+    }
     return outcome::success();
   }
 
   outcome::result<std::vector<Protocol>> InmemProtocolRepository::getProtocols(
       const PeerId &p) const {
     OUTCOME_TRY(s, getProtocolSet(p));
-    return std::vector<Protocol>(s->begin(), s->end());
+    std::vector<Protocol> ret;
+    ret.reserve(s->size());
+    for (const auto &id : *s) {
+      ret.push_back(id->name());
+    }
+    return ret;
   }
 
   outcome::result<std::vector<Protocol>>
@@ -46,7 +64,7 @@ namespace libp2p::peer {
     ret.reserve(size);
 
     std::set_intersection(protocols.begin(), protocols.end(), s->begin(),
-                          s->end(), std::back_inserter(ret));
+                          s->end(), std::back_inserter(ret), ProtocolIdLess{});
     return ret;
   }
 
@@ -54,6 +72,7 @@ namespace libp2p::peer {
     auto r = getProtocolSet(p);
     if (r) {
       r.value()->clear();
+      maybe_empty_.push_back(p);
     }
   }
 
@@ -80,20 +99,25 @@ namespace libp2p::peer {
   }
 
   void InmemProtocolRepository::collectGarbage() {
-    auto peer = db_.begin();
-    auto peerend = db_.end();
-    while (peer != peerend) {
-      if (peer->second->empty()) {
-        // erase returns element next to deleted
-        peer = db_.erase(peer);
-      } else {
-        ++peer;
+    std::ignore = collectSomeGarbage(std::numeric_limits<size_t>::max());
+  }
+
+  bool InmemProtocolRepository::collectSomeGarbage(size_t budget) {
+    // only peers, whose protocols were removed, are checked
+    while (budget > 0 && !maybe_empty_.empty()) {
+      --budget;
+      auto it = db_.find(maybe_empty_.back());
+      if (it != db_.end() && it->second->empty()) {
+        db_.erase(it);
       }
+      maybe_empty_.pop_back();
     }
+    return maybe_empty_.empty();
   }
 
   std::unordered_set<PeerId> InmemProtocolRepository::getPeers() const {
     std::unordered_set<PeerId> peers;
+    peers.reserve(db_.size());
     for (const auto &it : db_) {
       peers.insert(it.first);
     }
@@ -101,4 +125,15 @@ namespace libp2p::peer {
     return peers;
   }
 
+  void InmemProtocolRepository::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    for (const auto &it : db_) {
+      visitor(it.first);
+    }
+  }
+
+  bool InmemProtocolRepository::hasPeer(const PeerId &p) const {
+    return db_.count(p) != 0;
+  }
+
 }  // namespace libp2p::peer
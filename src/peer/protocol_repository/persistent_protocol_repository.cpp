@@ -0,0 +1,214 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/protocol_repository/persistent_protocol_repository.hpp>
+
+#include <limits>
+
+#include <boost/assert.hpp>
+#include <boost/optional.hpp>
+
+namespace libp2p::peer {
+
+  PersistentProtocolRepository::PersistentProtocolRepository(
+      std::shared_ptr<ProtocolRepository> cache,
+      std::shared_ptr<PeerstoreDb> db)
+      : cache_(std::move(cache)), db_(std::move(db)) {
+    BOOST_ASSERT(cache_);
+    BOOST_ASSERT(db_);
+
+    auto &sql = db_->db();
+    select_all_ = sql.createStatement(
+        "SELECT peer, protocol FROM protocols ORDER BY peer;");
+    select_protocols_ =
+        sql.createStatement("SELECT protocol FROM protocols WHERE peer = ?;");
+    select_peers_ = sql.createStatement("SELECT DISTINCT peer FROM protocols;");
+    select_peer_ = sql.createStatement(
+        "SELECT EXISTS (SELECT 1 FROM protocols WHERE peer = ?);");
+    insert_ = sql.createStatement(
+        "INSERT OR IGNORE INTO protocols VALUES (?, ?);");
+    delete_ = sql.createStatement(
+        "DELETE FROM protocols WHERE peer = ? AND protocol = ?;");
+    delete_peer_ = sql.createStatement("DELETE FROM protocols WHERE peer = ?;");
+    delete_orphans_ = sql.createStatement(
+        "DELETE FROM protocols "
+        "WHERE peer NOT IN (SELECT peer FROM addresses);");
+
+    if (db_->config().preload) {
+      preload();
+    }
+  }
+
+  outcome::result<void> PersistentProtocolRepository::addProtocols(
+      const PeerId &p, gsl::span<const Protocol> ms) {
+    load(p);
+    OUTCOME_TRY(cache_->addProtocols(p, ms));
+    for (const auto &m : ms) {
+      db_->enqueue([st{insert_}, peer{p.toVector()},
+                    protocol{m}](storage::SQLite &sql) {
+        sql.execCommand(st, peer, protocol);
+      });
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> PersistentProtocolRepository::removeProtocols(
+      const PeerId &p, gsl::span<const Protocol> ms) {
+    load(p);
+    OUTCOME_TRY(cache_->removeProtocols(p, ms));
+    for (const auto &m : ms) {
+      db_->enqueue([st{delete_}, peer{p.toVector()},
+                    protocol{m}](storage::SQLite &sql) {
+        sql.execCommand(st, peer, protocol);
+      });
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<Protocol>>
+  PersistentProtocolRepository::getProtocols(const PeerId &p) const {
+    load(p);
+    return cache_->getProtocols(p);
+  }
+
+  outcome::result<std::vector<Protocol>>
+  PersistentProtocolRepository::supportsProtocols(
+      const PeerId &p, const std::set<Protocol> &protocols) const {
+    load(p);
+    return cache_->supportsProtocols(p, protocols);
+  }
+
+  void PersistentProtocolRepository::clear(const PeerId &p) {
+    load(p);
+    cache_->clear(p);
+    db_->enqueue([st{delete_peer_}, peer{p.toVector()}](storage::SQLite &sql) {
+      sql.execCommand(st, peer);
+    });
+  }
+
+  void PersistentProtocolRepository::collectGarbage() {
+    std::ignore = collectSomeGarbage(std::numeric_limits<size_t>::max());
+  }
+
+  bool PersistentProtocolRepository::collectSomeGarbage(size_t budget) {
+    if (!orphans_collected_) {
+      collectOrphans();
+      orphans_collected_ = true;
+    }
+    if (!cache_->collectSomeGarbage(budget)) {
+      return false;
+    }
+    orphans_collected_ = false;
+
+    // peers are evicted from cache when they have no protocols, which
+    // is the case in db as soon as it is flushed
+    db_->flush();
+    for (auto it = loaded_.begin(); it != loaded_.end();) {
+      if (cache_->hasPeer(*it)) {
+        ++it;
+      } else {
+        it = loaded_.erase(it);
+      }
+    }
+    return true;
+  }
+
+  void PersistentProtocolRepository::collectOrphans() {
+    // journaled after the writes of address repository, which shares db
+    db_->enqueue([st{delete_orphans_}](storage::SQLite &sql) {
+      sql.execCommand(st);
+    });
+    db_->flush();
+
+    std::unordered_set<PeerId> stored;
+    db_->db().execQuery(select_peers_, [&](std::vector<uint8_t> bytes) {
+      if (auto peer = PeerId::fromBytes(bytes)) {
+        stored.insert(std::move(peer.value()));
+      }
+    });
+    // cleared peers are evicted by the following cache collection
+    for (const auto &p : cache_->getPeers()) {
+      if (stored.count(p) == 0) {
+        cache_->clear(p);
+      }
+    }
+  }
+
+  std::unordered_set<PeerId> PersistentProtocolRepository::getPeers() const {
+    std::unordered_set<PeerId> peers;
+    forEachPeer([&](const PeerId &p) { peers.insert(p); });
+    return peers;
+  }
+
+  void PersistentProtocolRepository::forEachPeer(
+      const std::function<PeerVisitor> &visitor) const {
+    cache_->forEachPeer(visitor);
+    if (preloaded_) {
+      return;
+    }
+
+    std::vector<PeerId> stored;
+    db_->db().execQuery(select_peers_, [&](std::vector<uint8_t> bytes) {
+      auto peer = PeerId::fromBytes(bytes);
+      if (peer && loaded_.count(peer.value()) == 0) {
+        stored.push_back(std::move(peer.value()));
+      }
+    });
+    for (const auto &p : stored) {
+      visitor(p);
+    }
+  }
+
+  bool PersistentProtocolRepository::hasPeer(const PeerId &p) const {
+    if (preloaded_ || loaded_.count(p) != 0) {
+      return cache_->hasPeer(p);
+    }
+    int exists = 0;
+    db_->db().execQuery(
+        select_peer_, [&](int value) { exists = value; }, p.toVector());
+    return exists != 0;
+  }
+
+  void PersistentProtocolRepository::preload() {
+    // rows are ordered by peer, so that each peer is added to cache once
+    boost::optional<PeerId> peer;
+    std::vector<Protocol> protocols;
+    auto add = [&] {
+      if (peer && !protocols.empty()) {
+        std::ignore = cache_->addProtocols(*peer, protocols);
+      }
+      protocols.clear();
+    };
+    db_->db().execQuery(
+        select_all_, [&](std::vector<uint8_t> bytes, std::string protocol) {
+          auto p = PeerId::fromBytes(bytes);
+          if (!p) {
+            return;
+          }
+          if (peer != p.value()) {
+            add();
+            peer = std::move(p.value());
+          }
+          protocols.push_back(std::move(protocol));
+        });
+    add();
+    preloaded_ = true;
+  }
+
+  void PersistentProtocolRepository::load(const PeerId &p) const {
+    if (preloaded_ || !loaded_.insert(p).second) {
+      return;
+    }
+    std::vector<Protocol> protocols;
+    db_->db().execQuery(
+        select_protocols_,
+        [&](std::string protocol) { protocols.push_back(std::move(protocol)); },
+        p.toVector());
+    if (!protocols.empty()) {
+      std::ignore = cache_->addProtocols(p, protocols);
+    }
+  }
+
+}  // namespace libp2p::peer
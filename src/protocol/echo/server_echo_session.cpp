@@ -25,7 +25,7 @@ namespace libp2p::protocol {
   }
 
   void ServerEchoSession::start() {
-    doRead();
+    spawn(shared_from_this());
   }
 
   void ServerEchoSession::stop() {
@@ -36,65 +36,55 @@ namespace libp2p::protocol {
     });
   }
 
-  void ServerEchoSession::doRead() {
-    if (stream_->isClosedForRead()
-        || (!repeat_infinitely_ && config_.max_server_repeats == 0)) {
-      return stop();
-    }
-
-    stream_->readSome(
-        buf_, buf_.size(),
-        [self{shared_from_this()}](outcome::result<size_t> rread) {
-          self->onRead(rread);
-        });
+  bool ServerEchoSession::canRead() const {
+    return !stream_->isClosedForRead()
+        && (repeat_infinitely_ || config_.max_server_repeats > 0);
   }
 
-  void ServerEchoSession::onRead(outcome::result<size_t> rread) {
-    if (!rread) {
-      log_->error("error happened during read: {}", rread.error().message());
-      return stop();
-    }
-
+  void ServerEchoSession::resume(outcome::result<size_t> res) {
     static constexpr size_t kMsgSizeThreshold = 120;
 
-    if (rread.value() < kMsgSizeThreshold) {
-      log_->debug("read message: {}",
-                 std::string{buf_.begin(), buf_.begin() + rread.value()});
-    } else {
-      log_->debug("read {} bytes", rread.value());
-    }
-    this->doWrite(rread.value());
-    doRead();
-  }
-
-  void ServerEchoSession::doWrite(size_t size) {
-    if (stream_->isClosedForWrite() || size == 0) {
-      return stop();
-    }
-
-    auto write_buf = std::vector<uint8_t>(buf_.begin(), buf_.begin() + size);
-    gsl::span<const uint8_t> span = write_buf;
-    stream_->write(
-        span, size,
-        [self{shared_from_this()}, write_buf{std::move(write_buf)}](
-            outcome::result<size_t> rwrite) { self->onWrite(rwrite); });
-  }
-
-  void ServerEchoSession::onWrite(outcome::result<size_t> rwrite) {
-    if (!rwrite) {
-      log_->error("error happened during write: {}", rwrite.error().message());
-      return stop();
-    }
-
-    if (rwrite.value() < 120) {
-      log_->info("written message: {}",
-                 std::string{buf_.begin(), buf_.begin() + rwrite.value()});
-    } else {
-      log_->info("written {} bytes", rwrite.value());
-    }
+    BOOST_ASIO_CORO_REENTER(this) {
+      while (canRead()) {
+        BOOST_ASIO_CORO_YIELD awaitReadSome(*stream_, buf_, buf_.size());
+        if (!res) {
+          log_->error("error happened during read: {}", res.error().message());
+          break;
+        }
+
+        if (res.value() < kMsgSizeThreshold) {
+          log_->debug("read message: {}",
+                      std::string{buf_.begin(), buf_.begin() + res.value()});
+        } else {
+          log_->debug("read {} bytes", res.value());
+        }
+
+        if (stream_->isClosedForWrite() || res.value() == 0) {
+          break;
+        }
+
+        // buf_ is not reused until the write completes
+        BOOST_ASIO_CORO_YIELD awaitWrite(
+            *stream_, gsl::make_span(buf_).first(res.value()), res.value());
+        if (!res) {
+          log_->error("error happened during write: {}",
+                      res.error().message());
+          break;
+        }
+
+        if (res.value() < kMsgSizeThreshold) {
+          log_->info("written message: {}",
+                     std::string{buf_.begin(), buf_.begin() + res.value()});
+        } else {
+          log_->info("written {} bytes", res.value());
+        }
+
+        if (!repeat_infinitely_) {
+          --config_.max_server_repeats;
+        }
+      }
 
-    if (!repeat_infinitely_) {
-      --config_.max_server_repeats;
+      stop();
     }
   }
 }  // namespace libp2p::protocol
@@ -159,9 +159,9 @@ namespace libp2p::protocol::gossip {
 
     auto &peer_id = peer_res.value();
 
-    log_.debug("new inbound stream, address={}, peer_id={}",
-               stream->remoteMultiaddr().value().getStringAddress(),
-               peer_id.toBase58());
+    SUBLOG_DEBUG(log_, "new inbound stream, address={}, peer_id={}",
+                 stream->remoteMultiaddr().value().getStringAddress(),
+                 peer_id.toBase58());
 
     PeerContextPtr ctx;
 
@@ -298,9 +298,9 @@ namespace libp2p::protocol::gossip {
 
     auto &peer_id = peer_res.value();
 
-    log_.debug("new outbound stream, address={}, peer_id={}",
-               stream->remoteMultiaddr().value().getStringAddress(),
-               peer_id.toBase58());
+    SUBLOG_DEBUG(log_, "new outbound stream, address={}, peer_id={}",
+                 stream->remoteMultiaddr().value().getStringAddress(),
+                 peer_id.toBase58());
 
     size_t stream_id = 0;
     bool is_new_connection = ctx->inbound_streams.empty();
@@ -413,6 +413,21 @@ namespace libp2p::protocol::gossip {
     writable_peers_low_latency_.clear();
   }
 
+  void Connectivity::peerInMesh(const PeerContextPtr &ctx, bool in_mesh) {
+    static const std::string kProtectionTag = "gossip-mesh";
+    auto &cmgr = host_->getNetwork().getConnectionManager();
+    if (in_mesh) {
+      if (ctx->mesh_topics++ == 0) {
+        cmgr.protectPeer(ctx->peer_id, kProtectionTag);
+      }
+    } else {
+      assert(ctx->mesh_topics > 0);
+      if (--ctx->mesh_topics == 0) {
+        cmgr.unprotectPeer(ctx->peer_id, kProtectionTag);
+      }
+    }
+  }
+
   void Connectivity::onHeartbeat(const std::map<TopicId, bool> &local_changes) {
     if (!started_) {
       return;
@@ -56,6 +56,10 @@ namespace libp2p::protocol::gossip {
     /// Flushes all pending writes for peers in writable set
     void flush();
 
+    /// Peer joined or left the mesh of a topic, connections to mesh members
+    /// are protected from trimming
+    void peerInMesh(const PeerContextPtr &ctx, bool in_mesh);
+
     /// Performs periodic tasks and broadcasts heartbeat message to
     /// all connected peers. The changes are subscribe/unsubscribe events
     void onHeartbeat(const std::map<TopicId, bool> &local_changes);
@@ -8,6 +8,7 @@
 #include <cassert>
 
 #include <libp2p/common/hexutil.hpp>
+#include <libp2p/common/metrics/registry.hpp>
 
 #include "connectivity.hpp"
 #include "local_subscriptions.hpp"
@@ -16,6 +17,31 @@
 
 namespace libp2p::protocol::gossip {
 
+  namespace {
+    struct GossipStats {
+      metrics::Counter &published = metrics::Registry::global().counter(
+          "libp2p_gossip_messages_published_total",
+          "Messages published by local host");
+      metrics::Counter &received = metrics::Registry::global().counter(
+          "libp2p_gossip_messages_received_total",
+          "Messages received on subscribed topics, including duplicates");
+      metrics::Counter &duplicates = metrics::Registry::global().counter(
+          "libp2p_gossip_duplicates_total",
+          "Received messages which were already in message cache");
+      metrics::Counter &invalid = metrics::Registry::global().counter(
+          "libp2p_gossip_invalid_messages_total",
+          "Received messages rejected by topic validators");
+      metrics::Counter &received_bytes = metrics::Registry::global().counter(
+          "libp2p_gossip_received_payload_bytes_total",
+          "Payload bytes of messages received on subscribed topics");
+    };
+
+    GossipStats &stats() {
+      static GossipStats stats;
+      return stats;
+    }
+  }  // namespace
+
   std::shared_ptr<Gossip> create(std::shared_ptr<basic::Scheduler> scheduler,
                                  std::shared_ptr<Host> host, Config config) {
     return std::make_shared<GossipCore>(std::move(config), std::move(scheduler),
@@ -156,6 +182,7 @@ namespace libp2p::protocol::gossip {
 
     [[maybe_unused]] bool inserted = msg_cache_.insert(msg, msg_id);
     assert(inserted);
+    stats().published.inc();
 
     remote_subscriptions_->onNewMessage(boost::none, msg, msg_id);
 
@@ -187,7 +214,7 @@ namespace libp2p::protocol::gossip {
 
     if (remote_subscriptions_->hasTopic(topic)
         && !msg_cache_.contains(msg_id)) {
-      log_.debug("requesting msg id {}", common::hex_lower(msg_id));
+      SUBLOG_DEBUG(log_, "requesting msg id {}", common::hex_lower(msg_id));
 
       from->message_builder->addIWant(msg_id);
       connectivity_->peerIsWritable(from, false);
@@ -196,8 +223,8 @@ namespace libp2p::protocol::gossip {
 
   void GossipCore::onIWant(const PeerContextPtr &from,
                            const MessageId &msg_id) {
-    log_.debug("peer {} wants message {}", from->str,
-               common::hex_lower(msg_id));
+    SUBLOG_DEBUG(log_, "peer {} wants message {}", from->str,
+                 common::hex_lower(msg_id));
 
     auto msg_found = msg_cache_.getMessage(msg_id);
     if (msg_found) {
@@ -237,11 +264,14 @@ namespace libp2p::protocol::gossip {
     }
 
     MessageId msg_id = create_message_id_(msg->from, msg->seq_no, msg->data);
-    log_.debug("message arrived, msg id={}", common::hex_lower(msg_id));
+    SUBLOG_DEBUG(log_, "message arrived, msg id={}", common::hex_lower(msg_id));
+    stats().received.inc();
+    stats().received_bytes.inc(msg->data.size());
 
     if (msg_cache_.contains(msg_id)) {
       // already there, ignore
       log_.debug("ignoring message, already in cache");
+      stats().duplicates.inc();
       return;
     }
 
@@ -261,6 +291,7 @@ namespace libp2p::protocol::gossip {
 
     if (!valid) {
       log_.debug("message validation failed");
+      stats().invalid.inc();
       return;
     }
 
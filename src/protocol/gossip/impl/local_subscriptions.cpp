@@ -5,6 +5,7 @@
 
 #include "local_subscriptions.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 namespace libp2p::protocol::gossip {
@@ -32,8 +33,11 @@ namespace libp2p::protocol::gossip {
       TopicSet topics, Gossip::SubscriptionCallback callback) {
     Subscription ret = Super::subscribe(std::move(callback));
 
+    // tickets grow, so vectors stay sorted
     for (const auto &t : topics) {
-      if (++topics_[t] == 1) {
+      auto &tickets = topics_[t];
+      tickets.push_back(lastTicket());
+      if (tickets.size() == 1) {
         change_fn_(true, t);
       }
     }
@@ -42,16 +46,36 @@ namespace libp2p::protocol::gossip {
     return ret;
   }
 
-  const std::map<TopicId, size_t> &LocalSubscriptions::subscribedTo() {
+  const LocalSubscriptions::TopicIndex &LocalSubscriptions::subscribedTo() {
     return topics_;
   }
 
   void LocalSubscriptions::forwardMessage(const TopicMessage::Ptr &msg) {
     assert(msg);
-    if (intersect(msg->topic_ids, topics_)) {
+
+    // callbacks may (un)subscribe or forward messages, so the tickets are
+    // copied, and the buffer is taken for the time of dispatch
+    std::vector<uint64_t> tickets = std::move(dispatch_buffer_);
+    tickets.clear();
+    for (const auto &topic : msg->topic_ids) {
+      auto it = topics_.find(topic);
+      if (it != topics_.end()) {
+        tickets.insert(tickets.end(), it->second.begin(), it->second.end());
+      }
+    }
+
+    if (!tickets.empty()) {
+      if (msg->topic_ids.size() > 1) {
+        // subscribed to several topics of the message, deliver once
+        std::sort(tickets.begin(), tickets.end());
+        tickets.erase(std::unique(tickets.begin(), tickets.end()),
+                      tickets.end());
+      }
       Gossip::Message tmp_msg{msg->from, msg->topic_ids, msg->data};
-      publish(tmp_msg);
+      publishTo(tickets, tmp_msg);
     }
+
+    dispatch_buffer_ = std::move(tickets);
   }
 
   void LocalSubscriptions::forwardEndOfSubscription() {
@@ -76,16 +100,21 @@ namespace libp2p::protocol::gossip {
 
     auto it = filters_.find(ticket);
     if (it != filters_.end()) {
-      TopicSet &s = it->second;
-      for (auto topics_it = topics_.begin(); topics_it != topics_.end();) {
-        if (s.count(topics_it->first) != 0) {
-          if (--topics_it->second == 0) {
-            change_fn_(false, topics_it->first);
-            topics_it = topics_.erase(topics_it);
-            continue;
-          }
+      for (const auto &topic : it->second) {
+        auto topics_it = topics_.find(topic);
+        if (topics_it == topics_.end()) {
+          continue;
+        }
+        auto &tickets = topics_it->second;
+        auto ticket_it =
+            std::lower_bound(tickets.begin(), tickets.end(), ticket);
+        if (ticket_it != tickets.end() && *ticket_it == ticket) {
+          tickets.erase(ticket_it);
+        }
+        if (tickets.empty()) {
+          change_fn_(false, topic);
+          topics_.erase(topics_it);
         }
-        ++topics_it;
       }
       filters_.erase(it);
     }
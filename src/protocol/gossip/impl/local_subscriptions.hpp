@@ -7,6 +7,8 @@
 #define LIBP2P_PROTOCOL_GOSSIP_LOCAL_SUBSCRIPTIONS_HPP
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include <libp2p/protocol/common/subscriptions.hpp>
 
@@ -28,10 +30,13 @@ namespace libp2p::protocol::gossip {
     Subscription subscribe(TopicSet topics,
                            Gossip::SubscriptionCallback callback);
 
-    /// Returns all topics (and counters) this host is subscribed to
-    const std::map<TopicId, size_t> &subscribedTo();
+    /// Topic -> tickets of local subscriptions to it, sorted
+    using TopicIndex = std::unordered_map<TopicId, std::vector<uint64_t>>;
 
-    /// Forwards data to subscriptions
+    /// Returns all topics (and subscribers) this host is subscribed to
+    const TopicIndex &subscribedTo();
+
+    /// Forwards data to subscriptions interested in its topics
     void forwardMessage(const TopicMessage::Ptr &msg);
 
     /// Forwards EOS to all subscribers
@@ -48,11 +53,15 @@ namespace libp2p::protocol::gossip {
     /// some topic
     OnSubscriptionSetChange change_fn_;
 
-    /// Keeps track of topics this host is subscribed to
-    std::map<TopicId, size_t> topics_;
+    /// Keeps track of topics this host is subscribed to, used to dispatch
+    /// messages only to subscriptions interested in them
+    TopicIndex topics_;
 
-    /// Used by filter()
+    /// Used by filter() and unsubscribe()
     std::map<uint64_t, TopicSet> filters_;
+
+    /// Tickets to dispatch the current message to, reused between messages
+    std::vector<uint64_t> dispatch_buffer_;
   };
 
 }  // namespace libp2p::protocol::gossip
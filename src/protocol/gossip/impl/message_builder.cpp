@@ -80,13 +80,10 @@ namespace libp2p::protocol::gossip {
 
     size_t msg_sz = pb_msg_->ByteSizeLong();
 
-    auto varint_len = multi::UVarint{msg_sz};
-    auto varint_vec = varint_len.toVector();
-    size_t prefix_sz = varint_vec.size();
+    size_t prefix_sz = multi::UVarint::encodedSize(msg_sz);
 
-    auto buffer = std::make_shared<ByteArray>();
-    buffer->resize(prefix_sz + msg_sz);
-    memcpy(buffer->data(), varint_vec.data(), prefix_sz);
+    auto buffer = std::make_shared<ByteArray>(prefix_sz + msg_sz);
+    multi::UVarint::encode(msg_sz, *buffer);
 
     bool success =
         // NOLINTNEXTLINE
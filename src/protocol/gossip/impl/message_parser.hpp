@@ -17,7 +17,8 @@ namespace libp2p::protocol::gossip {
 
   class MessageReceiver;
 
-  /// Protobuf message parser.
+  /// Protobuf message parser. One per stream: the parsed message is cleared
+  /// and refilled, so its strings and repeated fields are reused
   class MessageParser {
    public:
     MessageParser();
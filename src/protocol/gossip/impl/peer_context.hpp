@@ -29,6 +29,9 @@ namespace libp2p::protocol::gossip {
     /// Set of topics this peer is subscribed to
     std::set<TopicId> subscribed_to;
 
+    /// Number of topics where this peer is a mesh member
+    unsigned mesh_topics = 0;
+
     /// Streams connected to peer
     std::shared_ptr<Stream> outbound_stream;
     std::vector<std::shared_ptr<Stream>> inbound_streams;
@@ -54,7 +57,7 @@ namespace libp2p::protocol::gossip {
         libp2p::protocol::gossip::PeerContext);
   };
 
-  /// Operators needed to place PeerContextPtr into PeerSet but use
+  /// Operators needed to place PeerContextPtr into ordered containers but use
   /// const peer::PeerId& as a key
   bool operator<(const PeerContextPtr &ctx, const peer::PeerId &peer);
   bool operator<(const peer::PeerId &peer, const PeerContextPtr &ctx);
@@ -6,47 +6,74 @@
 #include "peer_set.hpp"
 
 #include <algorithm>
-#include <random>
 #include <chrono>
-
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/algorithm/for_each.hpp>
+#include <random>
 
 namespace libp2p::protocol::gossip {
 
+  namespace {
+
+    // Up to this number of samples they are picked without copying the set
+    constexpr size_t kSmallSample = 32;
+
+    std::mt19937 &randomGenerator() {
+      thread_local std::mt19937 gen(
+          std::chrono::system_clock::now().time_since_epoch().count());
+      return gen;
+    }
+
+    // Returns random number in [0, bound]
+    size_t randomIndex(size_t bound) {
+      return std::uniform_int_distribution<size_t>(0, bound)(
+          randomGenerator());
+    }
+
+  }  // namespace
+
   boost::optional<PeerContextPtr> PeerSet::find(
       const peer::PeerId &id) const {
-    auto it = peers_.find(id);
-    if (it == peers_.end()) {
+    auto it = index_.find(id);
+    if (it == index_.end()) {
       return boost::none;
     }
-    return *it;
+    return peers_[it->second];
   }
 
   bool PeerSet::contains(const peer::PeerId &id) const {
-    return peers_.count(id) != 0;
+    return index_.count(id) != 0;
   }
 
   bool PeerSet::insert(PeerContextPtr ctx) {
-    if (!ctx || peers_.find(ctx) != peers_.end()) {
+    if (!ctx) {
+      return false;
+    }
+    if (!index_.emplace(ctx->peer_id, peers_.size()).second) {
       return false;
     }
-    peers_.emplace(std::move(ctx));
+    peers_.push_back(std::move(ctx));
     return true;
   }
 
   boost::optional<PeerContextPtr> PeerSet::erase(const peer::PeerId &id) {
-    auto it = peers_.find(id);
-    if (it == peers_.end()) {
+    auto it = index_.find(id);
+    if (it == index_.end()) {
       return boost::none;
     }
-    boost::optional<PeerContextPtr> ret(*it);
-    peers_.erase(it);
+    auto pos = it->second;
+    index_.erase(it);
+
+    boost::optional<PeerContextPtr> ret(std::move(peers_[pos]));
+    if (pos + 1 != peers_.size()) {
+      peers_[pos] = std::move(peers_.back());
+      index_[peers_[pos]->peer_id] = pos;
+    }
+    peers_.pop_back();
     return ret;
   }
 
   void PeerSet::clear() {
     peers_.clear();
+    index_.clear();
   }
 
   bool PeerSet::empty() const {
@@ -59,33 +86,67 @@ namespace libp2p::protocol::gossip {
 
   std::vector<PeerContextPtr> PeerSet::selectRandomPeers(size_t n) const {
     std::vector<PeerContextPtr> ret;
-    if (n > 0 && !empty()) {
-      ret.reserve(n > size() ? size() : n);
-      std::mt19937 gen;
-      gen.seed(std::chrono::system_clock::now().time_since_epoch().count());
-      std::sample(peers_.begin(), peers_.end(), std::back_inserter(ret), n,
-                  gen);
+    auto sz = size();
+    if (n == 0 || sz == 0) {
+      return ret;
+    }
+    if (n >= sz) {
+      ret = peers_;
+      return ret;
+    }
+
+    if (n <= kSmallSample) {
+      // Floyd's sampling: n distinct indices, each subset equally likely
+      ret.reserve(n);
+      for (size_t j = sz - n; j < sz; ++j) {
+        const auto &candidate = peers_[randomIndex(j)];
+        if (std::find(ret.begin(), ret.end(), candidate) == ret.end()) {
+          ret.push_back(candidate);
+        } else {
+          ret.push_back(peers_[j]);
+        }
+      }
+      return ret;
     }
+
+    // partial Fisher-Yates shuffle of a copy
+    ret = peers_;
+    for (size_t i = 0; i < n; ++i) {
+      std::swap(ret[i], ret[i + randomIndex(sz - 1 - i)]);
+    }
+    ret.resize(n);
     return ret;
   }
 
   void PeerSet::selectAll(const SelectCallback &callback) const {
-    boost::for_each(peers_, callback);
+    for (const auto &ctx : peers_) {
+      callback(ctx);
+    }
   }
 
   void PeerSet::selectIf(const SelectCallback &callback,
                          const FilterCallback &filter) const {
-    boost::for_each(peers_ | boost::adaptors::filtered(filter), callback);
+    for (const auto &ctx : peers_) {
+      if (filter(ctx)) {
+        callback(ctx);
+      }
+    }
   }
 
   void PeerSet::eraseIf(const FilterCallback &filter) {
-    for (auto it = peers_.begin(); it != peers_.end();) {
-      if (filter(*it)) {
-        it = peers_.erase(it);
-      } else {
-        ++it;
+    size_t kept = 0;
+    for (size_t i = 0; i < peers_.size(); ++i) {
+      if (filter(peers_[i])) {
+        index_.erase(peers_[i]->peer_id);
+        continue;
+      }
+      if (kept != i) {
+        peers_[kept] = std::move(peers_[i]);
+        index_[peers_[kept]->peer_id] = kept;
       }
+      ++kept;
     }
+    peers_.resize(kept);
   }
 
 }  // namespace libp2p::protocol::gossip
@@ -7,13 +7,16 @@
 #define LIBP2P_PROTOCOL_GOSSIP_PEER_SET_HPP
 
 #include <functional>
-#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "peer_context.hpp"
 
 namespace libp2p::protocol::gossip {
 
-  /// Peer set for pub-sub protocols
+  /// Peer set for pub-sub protocols. Peers are stored densely, in no
+  /// particular order, and must not be inserted or erased from inside
+  /// select callbacks
   class PeerSet {
    public:
     /// Finds peer context by id
@@ -37,7 +40,7 @@ namespace libp2p::protocol::gossip {
     /// Returns # of peers in list
     size_t size() const;
 
-    /// Selects up to n random peers
+    /// Selects up to n random peers, in O(n) for small n
     std::vector<PeerContextPtr> selectRandomPeers(size_t n) const;
 
     /// Callback for peer selection
@@ -57,7 +60,11 @@ namespace libp2p::protocol::gossip {
     void eraseIf(const FilterCallback &filter);
 
    private:
-    std::set<PeerContextPtr, std::less<>> peers_;
+    /// Peers, erasure moves the last one into the hole
+    std::vector<PeerContextPtr> peers_;
+
+    /// Peer id -> index in peers_
+    std::unordered_map<peer::PeerId, size_t> index_;
   };
 
 }  // namespace libp2p::protocol::gossip
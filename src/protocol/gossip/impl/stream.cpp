@@ -7,9 +7,6 @@
 
 #include <cassert>
 
-#include <libp2p/basic/varint_reader.hpp>
-
-#include "message_parser.hpp"
 #include "peer_context.hpp"
 
 #define TRACE_ENABLED 0
@@ -30,7 +27,8 @@ namespace libp2p::protocol::gossip {
         msg_receiver_(msg_receiver),
         stream_(std::move(stream)),
         peer_(std::move(peer)),
-        read_buffer_(std::make_shared<std::vector<uint8_t>>()) {
+        reader_(std::make_shared<basic::FramedReader>(stream_,
+                                                      max_message_size_)) {
     assert(feedback_);
     assert(stream_);
   }
@@ -41,55 +39,24 @@ namespace libp2p::protocol::gossip {
       return;
     }
 
-    TRACE("reading length from {}:{}", peer_->str, stream_id_);
+    TRACE("reading message from {}:{}", peer_->str, stream_id_);
+
+    reading_ = true;
 
     // clang-format off
-    libp2p::basic::VarintReader::readVarint(
-        stream_,
+    reader_->read(
         [self_wptr = weak_from_this(), this]
-            (outcome::result<multi::UVarint> varint) {
+            (outcome::result<basic::FramedReader::Frame> res) {
           if (self_wptr.expired()) {
             return;
           }
-          onLengthRead(std::move(varint));
+          onMessageRead(res);
         }
     );
     // clang-format on
-
-    reading_ = true;
-  }
-
-  void Stream::onLengthRead(outcome::result<multi::UVarint> varint) {
-    if (!reading_) {
-      return;
-    }
-    if (varint.has_error()) {
-      reading_ = false;
-      feedback_(peer_, varint.error());
-      return;
-    }
-    auto msg_len = varint.value().toUInt64();
-
-    TRACE("reading {} bytes from {}:{}", msg_len, peer_->str, stream_id_);
-
-    if (msg_len > max_message_size_) {
-      feedback_(peer_, Error::MESSAGE_SIZE_ERROR);
-      return;
-    }
-
-    read_buffer_->resize(msg_len);
-
-    stream_->read(gsl::span(read_buffer_->data(), ssize_t(msg_len)), msg_len,
-                  [self_wptr = weak_from_this(), this,
-                   buffer = read_buffer_](auto &&res) {
-                    if (self_wptr.expired()) {
-                      return;
-                    }
-                    onMessageRead(std::forward<decltype(res)>(res));
-                  });
   }
 
-  void Stream::onMessageRead(outcome::result<size_t> res) {
+  void Stream::onMessageRead(outcome::result<basic::FramedReader::Frame> res) {
     if (!reading_) {
       return;
     }
@@ -97,24 +64,23 @@ namespace libp2p::protocol::gossip {
     reading_ = false;
 
     if (!res) {
-      feedback_(peer_, res.error());
+      if (res.error() == basic::FramedReader::Error::FRAME_TOO_LONG) {
+        feedback_(peer_, Error::MESSAGE_SIZE_ERROR);
+      } else {
+        feedback_(peer_, res.error());
+      }
       return;
     }
 
-    TRACE("read {} bytes from {}:{}", res.value(), peer_->str, stream_id_);
-
-    if (read_buffer_->size() != res.value()) {
-      feedback_(peer_, Error::MESSAGE_PARSE_ERROR);
-      return;
-    }
+    TRACE("read {} bytes from {}:{}", res.value().size(), peer_->str,
+          stream_id_);
 
-    MessageParser parser;
-    if (!parser.parse(*read_buffer_)) {
+    if (!parser_.parse(res.value())) {
       feedback_(peer_, Error::MESSAGE_PARSE_ERROR);
       return;
     }
 
-    parser.dispatch(peer_, msg_receiver_);
+    parser_.dispatch(peer_, msg_receiver_);
 
     // reads again
     read();
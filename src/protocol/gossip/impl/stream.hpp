@@ -8,12 +8,13 @@
 
 #include <deque>
 
+#include <libp2p/basic/framed_reader.hpp>
 #include <libp2p/basic/scheduler.hpp>
 #include <libp2p/common/metrics/instance_count.hpp>
 #include <libp2p/connection/stream.hpp>
-#include <libp2p/multi/uvarint.hpp>
 
 #include "common.hpp"
+#include "message_parser.hpp"
 
 namespace libp2p::protocol::gossip {
 
@@ -45,8 +46,7 @@ namespace libp2p::protocol::gossip {
     void close();
 
    private:
-    void onLengthRead(outcome::result<multi::UVarint> varint);
-    void onMessageRead(outcome::result<size_t> res);
+    void onMessageRead(outcome::result<basic::FramedReader::Frame> res);
     void beginWrite(SharedBuffer buffer);
     void onMessageWritten(outcome::result<size_t> res);
     void endWrite();
@@ -69,7 +69,10 @@ namespace libp2p::protocol::gossip {
     // TODO(artem): limit pending bytes and close slow streams that way
     size_t pending_bytes_ = 0;
 
-    std::shared_ptr<ByteArray> read_buffer_;
+    std::shared_ptr<basic::FramedReader> reader_;
+
+    /// Parses incoming messages, reused for the stream lifetime
+    MessageParser parser_;
     /// Dont send feedback or schedule writes anymore
     bool closed_ = false;
 
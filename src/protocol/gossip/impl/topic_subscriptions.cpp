@@ -175,6 +175,9 @@ namespace libp2p::protocol::gossip {
     auto res = subscribed_peers_.erase(p->peer_id);
     if (!res) {
       res = mesh_peers_.erase(p->peer_id);
+      if (res) {
+        connectivity_.peerInMesh(p, false);
+      }
     }
     dont_bother_until_.erase(p);
   }
@@ -196,6 +199,7 @@ namespace libp2p::protocol::gossip {
 
     if (self_subscribed_ && !mesh_is_full) {
       mesh_peers_.insert(p);
+      connectivity_.peerInMesh(p, true);
       subscribed_peers_.erase(p->peer_id);
     } else {
       // we don't have mesh for the topic
@@ -206,7 +210,9 @@ namespace libp2p::protocol::gossip {
 
   void TopicSubscriptions::onPrune(const PeerContextPtr &p,
                                    Time dont_bother_until) {
-    mesh_peers_.erase(p->peer_id);
+    if (mesh_peers_.erase(p->peer_id)) {
+      connectivity_.peerInMesh(p, false);
+    }
     if (p->subscribed_to.count(topic_) != 0) {
       subscribed_peers_.insert(p);
       dont_bother_until_.insert({p, dont_bother_until});
@@ -218,7 +224,9 @@ namespace libp2p::protocol::gossip {
 
     p->message_builder->addGraft(topic_);
     connectivity_.peerIsWritable(p, false);
-    mesh_peers_.insert(p);
+    if (mesh_peers_.insert(p)) {
+      connectivity_.peerInMesh(p, true);
+    }
     log_.debug("peer {} added to mesh (size={}) for topic {}", p->str,
                mesh_peers_.size(), topic_);
   }
@@ -228,6 +236,7 @@ namespace libp2p::protocol::gossip {
 
     p->message_builder->addPrune(topic_);
     connectivity_.peerIsWritable(p, false);
+    connectivity_.peerInMesh(p, false);
     subscribed_peers_.insert(p);
     log_.debug("peer {} removed from mesh (size={}) for topic {}", p->str,
                mesh_peers_.size(), topic_);
@@ -80,9 +80,8 @@ namespace libp2p::protocol {
 
     log_->info("received an IdentifyDelta message from peer {}, {}",
                peer_id_str, peer_addr_str);
-    stream->close([self{shared_from_this()}, s = stream,
-                   p = std::move(peer_id_str),
-                   a = std::move(peer_addr_str)](auto &&res) {
+    stream->close([self{shared_from_this()}, s = stream, p = peer_id_str,
+                   a = peer_addr_str](auto &&res) {
       if (!res) {
         self->log_->error("cannot close stream to peer {}, {}: {}", p, a,
                           res.error().message());
@@ -15,12 +15,6 @@
 #include <libp2p/protocol/identify/utils.hpp>
 
 namespace {
-  inline std::string fromMultiaddrToString(
-      const libp2p::multi::Multiaddress &ma) {
-    auto const &addr = ma.getBytesAddress();
-    return std::string(addr.begin(), addr.end());
-  }
-
   inline libp2p::outcome::result<libp2p::multi::Multiaddress>
   fromStringToMultiaddr(const std::string &addr) {
     return libp2p::multi::Multiaddress::create(gsl::span<const uint8_t>(
@@ -57,12 +51,16 @@ namespace libp2p::protocol {
     // set an address of the other side, so that it knows, which address we used
     // to connect to it
     if (auto remote_addr = stream->remoteMultiaddr()) {
-      msg.set_observedaddr(fromMultiaddrToString(remote_addr.value()));
+      const auto &bytes = remote_addr.value().getBytesAddress();
+      msg.set_observedaddr(bytes.data(), bytes.size());
     }
 
     // set addresses we are available on
-    for (const auto &addr : host_.getPeerInfo().addresses) {
-      msg.add_listenaddrs(fromMultiaddrToString(addr));
+    auto addresses = host_.getPeerInfo().addresses;
+    msg.mutable_listenaddrs()->Reserve(addresses.size());
+    for (const auto &addr : addresses) {
+      const auto &bytes = addr.getBytesAddress();
+      msg.add_listenaddrs(bytes.data(), bytes.size());
     }
 
     // set our public key
@@ -80,8 +78,10 @@ namespace libp2p::protocol {
     }
 
     // set versions of Libp2p and our implementation
-    msg.set_protocolversion(std::string{host_.getLibp2pVersion()});
-    msg.set_agentversion(std::string{host_.getLibp2pClientVersion()});
+    auto version = host_.getLibp2pVersion();
+    msg.set_protocolversion(version.data(), version.size());
+    auto client_version = host_.getLibp2pClientVersion();
+    msg.set_agentversion(client_version.data(), client_version.size());
 
     // write the resulting Protobuf message
     auto rw = std::make_shared<basic::ProtobufMessageReadWriter>(stream);
@@ -105,8 +105,8 @@ namespace libp2p::protocol {
     log_->info("successfully written an identify message to peer {}, {}",
                peer_id, peer_addr);
 
-    stream->close([self{shared_from_this()}, p = std::move(peer_id),
-                   a = std::move(peer_addr)](auto &&res) {
+    stream->close([self{shared_from_this()}, p = peer_id,
+                   a = peer_addr](auto &&res) {
       if (!res) {
         self->log_->error("cannot close the stream to peer {}, {}: {}", p, a,
                           res.error().message());
@@ -148,8 +148,8 @@ namespace libp2p::protocol {
 
     log_->info("received an identify message from peer {}, {}", peer_id_str,
                peer_addr_str);
-    stream->close([self{shared_from_this()}, p = std::move(peer_id_str),
-                   a = std::move(peer_addr_str)](auto &&res) {
+    stream->close([self{shared_from_this()}, p = peer_id_str,
+                   a = peer_addr_str](auto &&res) {
       if (!res) {
         self->log_->error("cannot close the stream to peer {}, {}: {}", p, a,
                           res.error().message());
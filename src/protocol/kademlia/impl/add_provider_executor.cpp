@@ -5,13 +5,22 @@
 
 #include <libp2p/protocol/kademlia/impl/add_provider_executor.hpp>
 
+#include <libp2p/log/lazy.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
+#include <libp2p/protocol/kademlia/impl/executor_metrics.hpp>
 #include <libp2p/protocol/kademlia/impl/session.hpp>
 #include <libp2p/protocol/kademlia/message.hpp>
 
 namespace libp2p::protocol::kademlia {
 
+  namespace {
+    ExecutorMetrics &stats() {
+      static ExecutorMetrics stats("add_provider");
+      return stats;
+    }
+  }  // namespace
+
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
   std::atomic_size_t AddProviderExecutor::instance_number = 0;
 
@@ -64,6 +73,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("started");
+    stats().started.inc();
 
     scheduler_
         ->schedule(scheduler::toTicks(config_.randomWalk.timeout),
@@ -85,6 +95,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("done: broabcast to {} peers", requests_succeed_);
+    (requests_succeed_ > 0 ? stats().succeeded : stats().failed).inc();
   }
 
   void AddProviderExecutor::spawn() {
@@ -119,9 +130,9 @@ namespace libp2p::protocol::kademlia {
 
       ++requests_in_progress_;
 
-      log_.debug("connecting to {}; done {}, active {}, in queue {}",
-                 peer_info.id.toBase58(), requests_succeed_,
-                 requests_in_progress_, queue_.size());
+      SUBLOG_DEBUG(log_, "connecting to {}; done {}, active {}, in queue {}",
+                   peer_info.id.toBase58(), requests_succeed_,
+                   requests_in_progress_, queue_.size());
 
       auto holder = std::make_shared<
           std::pair<std::shared_ptr<AddProviderExecutor>, scheduler::Handle>>();
@@ -155,7 +166,9 @@ namespace libp2p::protocol::kademlia {
 
   void AddProviderExecutor::onConnected(
       outcome::result<std::shared_ptr<connection::Stream>> stream_res) {
+    stats().requests.inc();
     if (not stream_res) {
+      stats().request_failures.inc();
       --requests_in_progress_;
 
       log_.debug("cannot connect to peer: {}; done {}, active {}, in queue {}",
@@ -169,12 +182,14 @@ namespace libp2p::protocol::kademlia {
     auto &stream = stream_res.value();
     assert(stream->remoteMultiaddr().has_value());
 
-    std::string addr(stream->remoteMultiaddr().value().getStringAddress());
+    // rendered only if debug log is written
+    const auto remote_addr = stream->remoteMultiaddr().value();
+    auto addr = log::address(remote_addr);
     log_.debug("connected to {}; done {}, active {}, in queue {}", addr,
                requests_succeed_, requests_in_progress_, queue_.size());
 
-    log_.debug("outgoing stream with {}",
-               stream->remotePeerId().value().toBase58());
+    SUBLOG_DEBUG(log_, "outgoing stream with {}",
+                 stream->remotePeerId().value().toBase58());
 
     auto session = session_host_->openSession(stream);
 
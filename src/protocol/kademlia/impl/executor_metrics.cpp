@@ -0,0 +1,31 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/protocol/kademlia/impl/executor_metrics.hpp>
+
+namespace libp2p::protocol::kademlia {
+
+  ExecutorMetrics::ExecutorMetrics(const std::string &executor)
+      : started{metrics::Registry::global().counter(
+          "libp2p_kademlia_executors_started_total",
+          "Kademlia executors started", {{"executor", executor}})},
+        succeeded{metrics::Registry::global().counter(
+            "libp2p_kademlia_executors_finished_total",
+            "Kademlia executors finished",
+            {{"executor", executor}, {"result", "success"}})},
+        failed{metrics::Registry::global().counter(
+            "libp2p_kademlia_executors_finished_total",
+            "Kademlia executors finished",
+            {{"executor", executor}, {"result", "failure"}})},
+        requests{metrics::Registry::global().counter(
+            "libp2p_kademlia_requests_total",
+            "Streams to remote peers requested by kademlia executors",
+            {{"executor", executor}})},
+        request_failures{metrics::Registry::global().counter(
+            "libp2p_kademlia_request_failures_total",
+            "Streams to remote peers which kademlia executors failed to open",
+            {{"executor", executor}})} {}
+
+}  // namespace libp2p::protocol::kademlia
@@ -5,13 +5,22 @@
 
 #include <libp2p/protocol/kademlia/impl/find_peer_executor.hpp>
 
+#include <libp2p/log/lazy.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
+#include <libp2p/protocol/kademlia/impl/executor_metrics.hpp>
 #include <libp2p/protocol/kademlia/impl/session.hpp>
 #include <libp2p/protocol/kademlia/message.hpp>
 
 namespace libp2p::protocol::kademlia {
 
+  namespace {
+    ExecutorMetrics &stats() {
+      static ExecutorMetrics stats("find_peer");
+      return stats;
+    }
+  }  // namespace
+
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
   std::atomic_size_t FindPeerExecutor::instance_number = 0;
 
@@ -71,6 +80,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("started");
+    stats().started.inc();
 
     scheduler_
         ->schedule(scheduler::toTicks(config_.randomWalk.timeout),
@@ -93,8 +103,10 @@ namespace libp2p::protocol::kademlia {
     }
     if (result.has_value()) {
       log_.debug("done: peer is found");
+      stats().succeeded.inc();
     } else {
       log_.debug("done: {}", result.error().message());
+      stats().failed.inc();
     }
     handler_(result);
   }
@@ -130,8 +142,8 @@ namespace libp2p::protocol::kademlia {
 
       ++requests_in_progress_;
 
-      log_.debug("connecting to {}; active {}, in queue {}", peer_id.toBase58(),
-                 requests_in_progress_, queue_.size());
+      SUBLOG_DEBUG(log_, "connecting to {}; active {}, in queue {}",
+                   peer_id.toBase58(), requests_in_progress_, queue_.size());
 
       auto holder = std::make_shared<
           std::pair<std::shared_ptr<FindPeerExecutor>, scheduler::Handle>>();
@@ -165,7 +177,9 @@ namespace libp2p::protocol::kademlia {
 
   void FindPeerExecutor::onConnected(
       outcome::result<std::shared_ptr<connection::Stream>> stream_res) {
+    stats().requests.inc();
     if (not stream_res) {
+      stats().request_failures.inc();
       --requests_in_progress_;
 
       log_.debug("cannot connect to peer: {}; active {}, in queue {}",
@@ -179,13 +193,15 @@ namespace libp2p::protocol::kademlia {
     auto &stream = stream_res.value();
     assert(stream->remoteMultiaddr().has_value());
 
-    std::string addr(stream->remoteMultiaddr().value().getStringAddress());
+    // rendered only if debug log is written
+    const auto remote_addr = stream->remoteMultiaddr().value();
+    auto addr = log::address(remote_addr);
 
     log_.debug("connected to {}; active {}, in queue {}", addr,
                requests_in_progress_, queue_.size());
 
-    log_.debug("outgoing stream with {}",
-               stream->remotePeerId().value().toBase58());
+    SUBLOG_DEBUG(log_, "outgoing stream with {}",
+                 stream->remotePeerId().value().toBase58());
 
     auto session = session_host_->openSession(stream);
     if (!session->write(serialized_request_, shared_from_this())) {
@@ -239,8 +255,9 @@ namespace libp2p::protocol::kademlia {
 
     auto self_peer_id = host_->getId();
 
-    log_.debug("Result from {} is gotten; active {}, in queue {}",
-               remote_peer_id.toBase58(), requests_in_progress_, queue_.size());
+    SUBLOG_DEBUG(log_, "Result from {} is gotten; active {}, in queue {}",
+                 remote_peer_id.toBase58(), requests_in_progress_,
+                 queue_.size());
 
     // Append gotten peer to queue
     if (msg.closer_peers) {
@@ -5,13 +5,22 @@
 
 #include <libp2p/protocol/kademlia/impl/find_providers_executor.hpp>
 
+#include <libp2p/log/lazy.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
+#include <libp2p/protocol/kademlia/impl/executor_metrics.hpp>
 #include <libp2p/protocol/kademlia/impl/session.hpp>
 #include <libp2p/protocol/kademlia/message.hpp>
 
 namespace libp2p::protocol::kademlia {
 
+  namespace {
+    ExecutorMetrics &stats() {
+      static ExecutorMetrics stats("find_providers");
+      return stats;
+    }
+  }  // namespace
+
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
   std::atomic_size_t FindProvidersExecutor::instance_number = 0;
 
@@ -43,6 +52,8 @@ namespace libp2p::protocol::kademlia {
     std::for_each(nearest_peer_ids_.begin(), nearest_peer_ids_.end(),
                   [this](auto &peer_id) { queue_.emplace(peer_id, target_); });
 
+    providers_.reserve(config_.maxProvidersPerKey);
+
     log_.debug("created");
   }
 
@@ -74,6 +85,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("started");
+    stats().started.inc();
 
     scheduler_
         ->schedule(scheduler::toTicks(config_.randomWalk.timeout),
@@ -105,6 +117,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("done: {} providers is found", result.size());
+    (result.empty() ? stats().failed : stats().succeeded).inc();
     handler_(std::move(result));
   }
 
@@ -139,8 +152,8 @@ namespace libp2p::protocol::kademlia {
 
       ++requests_in_progress_;
 
-      log_.debug("connecting to {}; active {}, in queue {}", peer_id.toBase58(),
-                 requests_in_progress_, queue_.size());
+      SUBLOG_DEBUG(log_, "connecting to {}; active {}, in queue {}",
+                   peer_id.toBase58(), requests_in_progress_, queue_.size());
 
       auto holder =
           std::make_shared<std::pair<std::shared_ptr<FindProvidersExecutor>,
@@ -175,7 +188,9 @@ namespace libp2p::protocol::kademlia {
 
   void FindProvidersExecutor::onConnected(
       outcome::result<std::shared_ptr<connection::Stream>> stream_res) {
+    stats().requests.inc();
     if (not stream_res) {
+      stats().request_failures.inc();
       --requests_in_progress_;
 
       log_.debug("cannot connect to peer: {}; active {}, in queue {}",
@@ -189,13 +204,15 @@ namespace libp2p::protocol::kademlia {
     auto &stream = stream_res.value();
     assert(stream->remoteMultiaddr().has_value());
 
-    std::string addr(stream->remoteMultiaddr().value().getStringAddress());
+    // rendered only if debug log is written
+    const auto remote_addr = stream->remoteMultiaddr().value();
+    auto addr = log::address(remote_addr);
 
     log_.debug("connected to {}; active {}, in queue {}", addr,
                requests_in_progress_, queue_.size());
 
-    log_.debug("outgoing stream with {}",
-               stream->remotePeerId().value().toBase58());
+    SUBLOG_DEBUG(log_, "outgoing stream with {}",
+                 stream->remotePeerId().value().toBase58());
 
     auto session = session_host_->openSession(stream);
 
@@ -250,8 +267,9 @@ namespace libp2p::protocol::kademlia {
 
     auto self_peer_id = host_->getId();
 
-    log_.debug("Result from {} is gotten; active {}, in queue {}",
-               remote_peer_id.toBase58(), requests_in_progress_, queue_.size());
+    SUBLOG_DEBUG(log_, "Result from {} is gotten; active {}, in queue {}",
+                 remote_peer_id.toBase58(), requests_in_progress_,
+                 queue_.size());
 
     // Providers found
     if (msg.provider_peers) {
@@ -272,8 +290,12 @@ namespace libp2p::protocol::kademlia {
           continue;
         }
 
-        // Save provider
-        providers_.emplace(peer.info.id);
+        // Save provider, the list is short, so that lookup is linear
+        if (providers_.size() < config_.maxProvidersPerKey
+            and std::find(providers_.begin(), providers_.end(), peer.info.id)
+                == providers_.end()) {
+          providers_.emplace_back(peer.info.id);
+        }
       }
 
       // If we have enough providers, that's all
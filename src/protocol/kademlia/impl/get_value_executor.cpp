@@ -9,14 +9,23 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <libp2p/log/lazy.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
+#include <libp2p/protocol/kademlia/impl/executor_metrics.hpp>
 #include <libp2p/protocol/kademlia/impl/put_value_executor.hpp>
 #include <libp2p/protocol/kademlia/impl/session.hpp>
 #include <libp2p/protocol/kademlia/message.hpp>
 
 namespace libp2p::protocol::kademlia {
 
+  namespace {
+    ExecutorMetrics &stats() {
+      static ExecutorMetrics stats("get_value");
+      return stats;
+    }
+  }  // namespace
+
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
   std::atomic_size_t GetValueExecutor::instance_number = 0;
 
@@ -90,6 +99,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("started");
+    stats().started.inc();
 
     spawn();
     return outcome::success();
@@ -126,8 +136,9 @@ namespace libp2p::protocol::kademlia {
 
       ++requests_in_progress_;
 
-      log_.debug("connecting to {}; active {}, in queue {}",
-                 peer_info.id.toBase58(), requests_in_progress_, queue_.size());
+      SUBLOG_DEBUG(log_, "connecting to {}; active {}, in queue {}",
+                   peer_info.id.toBase58(), requests_in_progress_,
+                   queue_.size());
 
       auto holder = std::make_shared<
           std::pair<std::shared_ptr<GetValueExecutor>, scheduler::Handle>>();
@@ -157,13 +168,16 @@ namespace libp2p::protocol::kademlia {
     if (requests_in_progress_ == 0) {
       done_ = true;
       log_.debug("done");
+      stats().failed.inc();
       handler_(Error::VALUE_NOT_FOUND);
     }
   }
 
   void GetValueExecutor::onConnected(
       outcome::result<std::shared_ptr<connection::Stream>> stream_res) {
+    stats().requests.inc();
     if (not stream_res) {
+      stats().request_failures.inc();
       --requests_in_progress_;
 
       log_.debug("cannot connect to peer: {}; active {}, in queue {}",
@@ -177,12 +191,14 @@ namespace libp2p::protocol::kademlia {
     auto &stream = stream_res.value();
     assert(stream->remoteMultiaddr().has_value());
 
-    std::string addr(stream->remoteMultiaddr().value().getStringAddress());
+    // rendered only if debug log is written
+    const auto remote_addr = stream->remoteMultiaddr().value();
+    auto addr = log::address(remote_addr);
     log_.debug("connected to {}; active {}, in queue {}", addr,
                requests_in_progress_, queue_.size());
 
-    log_.debug("outgoing stream with {}",
-               stream->remotePeerId().value().toBase58());
+    SUBLOG_DEBUG(log_, "outgoing stream with {}",
+                 stream->remotePeerId().value().toBase58());
 
     auto session = session_host_->openSession(stream);
 
@@ -237,8 +253,9 @@ namespace libp2p::protocol::kademlia {
 
     auto self_peer_id = host_->getId();
 
-    log_.debug("Result from {} is gotten; active {}, in queue {}",
-               remote_peer_id.toBase58(), requests_in_progress_, queue_.size());
+    SUBLOG_DEBUG(log_, "Result from {} is gotten; active {}, in queue {}",
+                 remote_peer_id.toBase58(), requests_in_progress_,
+                 queue_.size());
 
     // Append gotten peer to queue
     if (msg.closer_peers) {
@@ -281,7 +298,8 @@ namespace libp2p::protocol::kademlia {
 
       auto validation_res = validator_->validate(key_, value);
       if (not validation_res.has_value()) {
-        log_.debug("Result from {} is invalid", remote_peer_id.toBase58());
+        SUBLOG_DEBUG(log_, "Result from {} is invalid",
+                     remote_peer_id.toBase58());
         return;
       }
 
@@ -303,6 +321,7 @@ namespace libp2p::protocol::kademlia {
         // Return result to upstear
         done_ = true;
         log_.debug("done");
+        stats().succeeded.inc();
         handler_(best);
 
         // Inform peer of new value
@@ -62,6 +62,25 @@ namespace libp2p::protocol::kademlia {
     }
     started_ = true;
 
+    // protect connections to routing table members from trimming
+    static const std::string kProtectionTag = "kademlia";
+    peer_added_subscription_ =
+        bus_->getChannel<events::PeerAddedChannel>().subscribe(
+            [this](const peer::PeerId &peer) {
+              host_->getNetwork().getConnectionManager().protectPeer(
+                  peer, kProtectionTag);
+            });
+    peer_removed_subscription_ =
+        bus_->getChannel<events::PeerRemovedChannel>().subscribe(
+            [this](const peer::PeerId &peer) {
+              host_->getNetwork().getConnectionManager().unprotectPeer(
+                  peer, kProtectionTag);
+            });
+    for (const auto &peer : peer_routing_table_->getAllPeers()) {
+      host_->getNetwork().getConnectionManager().protectPeer(peer,
+                                                             kProtectionTag);
+    }
+
     // save himself into peer repo
     addPeer(host_->getPeerInfo(), true);
 
@@ -205,14 +224,14 @@ namespace libp2p::protocol::kademlia {
 
   void KademliaImpl::addPeer(const PeerInfo &peer_info, bool permanent,
                              bool is_connected) {
-    log_.debug("CALL: AddPeer ({})", peer_info.id.toBase58());
+    SUBLOG_DEBUG(log_, "CALL: AddPeer ({})", peer_info.id.toBase58());
     for (auto &addr : peer_info.addresses) {
-      log_.debug("         addr: {}", addr.getStringAddress());
+      SUBLOG_DEBUG(log_, "         addr: {}", addr.getStringAddress());
     }
 
     if (peer_info.addresses.empty()) {
-      log_.debug("{} was skipped because has not adresses",
-                 peer_info.id.toBase58());
+      SUBLOG_DEBUG(log_, "{} was skipped because has not adresses",
+                   peer_info.id.toBase58());
       return;
     }
 
@@ -222,31 +241,31 @@ namespace libp2p::protocol::kademlia {
             gsl::span(peer_info.addresses.data(), peer_info.addresses.size()),
             permanent ? peer::ttl::kPermanent : peer::ttl::kDay);
     if (not upsert_res) {
-      log_.debug("{} was skipped at addind to peer routing table: {}",
-                 peer_info.id.toBase58(), upsert_res.error().message());
+      SUBLOG_DEBUG(log_, "{} was skipped at addind to peer routing table: {}",
+                   peer_info.id.toBase58(), upsert_res.error().message());
       return;
     }
 
     auto update_res =
         peer_routing_table_->update(peer_info.id, permanent, is_connected);
     if (not update_res) {
-      log_.debug("{} was not added to peer routing table: {}",
-                 peer_info.id.toBase58(), update_res.error().message());
+      SUBLOG_DEBUG(log_, "{} was not added to peer routing table: {}",
+                   peer_info.id.toBase58(), update_res.error().message());
       return;
     }
     if (update_res.value()) {
-      log_.debug("{} was added to peer routing table; total {} peers",
-                 peer_info.id.toBase58(), peer_routing_table_->size());
+      SUBLOG_DEBUG(log_, "{} was added to peer routing table; total {} peers",
+                   peer_info.id.toBase58(), peer_routing_table_->size());
     } else {
-      log_.trace("{} was updated to peer routing table",
-                 peer_info.id.toBase58());
+      SUBLOG_TRACE(log_, "{} was updated to peer routing table",
+                   peer_info.id.toBase58());
     }
   }
 
   outcome::result<void> KademliaImpl::findPeer(const peer::PeerId &peer_id,
                                                FoundPeerInfoHandler handler) {
     BOOST_ASSERT(handler);
-    log_.debug("CALL: FindPeer ({})", peer_id.toBase58());
+    SUBLOG_DEBUG(log_, "CALL: FindPeer ({})", peer_id.toBase58());
 
     // Try to find locally
     auto peer_info = host_->getPeerRepository().getPeerInfo(peer_id);
@@ -256,7 +275,7 @@ namespace libp2p::protocol::kademlia {
                       peer_info = std::move(peer_info)] { handler(peer_info); })
           .detach();
 
-      log_.debug("{} found locally", peer_id.toBase58());
+      SUBLOG_DEBUG(log_, "{} found locally", peer_id.toBase58());
       return outcome::success();
     }
 
@@ -588,7 +607,8 @@ namespace libp2p::protocol::kademlia {
       std::shared_ptr<connection::Stream> stream) {
     auto [it, is_new_session] = sessions_.emplace(
         stream,
-        std::make_shared<Session>(weak_from_this(), scheduler_, stream));
+        std::make_shared<Session>(weak_from_this(), scheduler_, stream,
+                                  config_.maxMessageSize));
     assert(is_new_session);
 
     log_.debug("session opened, total sessions: {}", sessions_.size());
@@ -626,8 +646,8 @@ namespace libp2p::protocol::kademlia {
       return;
     }
 
-    log_.debug("incoming stream with {}",
-               stream->remotePeerId().value().toBase58());
+    SUBLOG_DEBUG(log_, "incoming stream with {}",
+                 stream->remotePeerId().value().toBase58());
 
     auto session = openSession(stream);
 
@@ -0,0 +1,314 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/protocol/kademlia/impl/provider_store.hpp>
+
+#include <algorithm>
+#include <string_view>
+
+#include <libp2p/multi/uvarint.hpp>
+
+namespace libp2p::protocol::kademlia {
+
+  namespace {
+    constexpr size_t kMinIndexSize = 16;
+
+    /// CIDv0 is sha256 multihash: hash code, digest size and digest
+    constexpr uint8_t kSha256 = 0x12;
+    constexpr uint8_t kSha256Size = 32;
+
+    constexpr uint8_t kCidV1 = 1;
+
+    /// Takes a free entry or appends a new one
+    template <typename T, typename Index>
+    Index allocate(std::vector<T> &entries, std::vector<Index> &free) {
+      if (!free.empty()) {
+        auto index = free.back();
+        free.pop_back();
+        return index;
+      }
+      entries.emplace_back();
+      return static_cast<Index>(entries.size() - 1);
+    }
+  }  // namespace
+
+  void ProviderStore::FlatIndex::insert(size_t hash, Index index) {
+    // load factor is kept not greater than 1/2
+    if ((size_ + 1) * 2 > slots_.size()) {
+      grow();
+    }
+    place(static_cast<uint32_t>(hash), index);
+    ++size_;
+  }
+
+  void ProviderStore::FlatIndex::erase(size_t hash, Index index) {
+    auto mask = slots_.size() - 1;
+    auto i = static_cast<uint32_t>(hash) & mask;
+    while (slots_[i].index != index) {
+      i = (i + 1) & mask;
+    }
+
+    // backward shift deletion, entries of the probe sequence are moved to
+    // the hole unless it precedes their home slot
+    for (auto j = (i + 1) & mask; slots_[j].index != kNone;
+         j = (j + 1) & mask) {
+      auto home = slots_[j].hash & mask;
+      if (((j - home) & mask) >= ((j - i) & mask)) {
+        slots_[i] = slots_[j];
+        i = j;
+      }
+    }
+    slots_[i] = Slot{};
+    --size_;
+  }
+
+  void ProviderStore::FlatIndex::place(uint32_t hash, Index index) {
+    auto mask = slots_.size() - 1;
+    auto i = hash & mask;
+    while (slots_[i].index != kNone) {
+      i = (i + 1) & mask;
+    }
+    slots_[i] = {hash, index};
+  }
+
+  void ProviderStore::FlatIndex::grow() {
+    std::vector<Slot> slots(std::max(kMinIndexSize, slots_.size() * 2));
+    slots.swap(slots_);
+    for (const auto &slot : slots) {
+      if (slot.index != kNone) {
+        place(slot.hash, slot.index);
+      }
+    }
+  }
+
+  ProviderStore::ProviderStore(const Config &config) : config_(config) {}
+
+  bool ProviderStore::addProvider(const ContentId &key, const PeerId &peer,
+                                  Time expires) {
+    auto multihash = multihashOf(key);
+    auto hash = hashOf(multihash);
+    auto peer_index = findPeer(peer);
+
+    if (auto k = findKey(multihash, hash); k != kNone && peer_index != kNone) {
+      for (auto r = keys_[k].head; r != kNone; r = records_[r].next) {
+        if (records_[r].peer == peer_index) {
+          // provider refreshed itself
+          records_[r].expires = expires;
+          unlink(r);
+          linkNewest(r);
+          return false;
+        }
+      }
+    }
+
+    // evictions may release the key and the peer, so they are looked up
+    // again after. Eviction of provider of the key comes first, the slot it
+    // frees counts towards the global limit too
+    auto max_per_key = std::max<size_t>(config_.maxProvidersPerKey, 1);
+    for (auto k = findKey(multihash, hash);
+         k != kNone && keys_[k].count >= max_per_key;) {
+      auto oldest = keys_[k].head;
+      for (auto r = records_[oldest].next; r != kNone; r = records_[r].next) {
+        if (records_[r].expires < records_[oldest].expires) {
+          oldest = r;
+        }
+      }
+      // key is released with its last record
+      auto last = keys_[k].count == 1;
+      removeRecord(oldest);
+      if (last) {
+        break;
+      }
+    }
+    auto max_records = std::max<size_t>(config_.maxProviderRecords, 1);
+    while (size_ >= max_records) {
+      removeRecord(oldest_);
+    }
+
+    auto k = internKey(multihash, hash);
+    auto r = allocate(records_, free_records_);
+    auto &record = records_[r];
+    record.expires = expires;
+    record.key = k;
+    record.peer = internPeer(peer);
+    record.next = keys_[k].head;
+    keys_[k].head = r;
+    ++keys_[k].count;
+    linkNewest(r);
+    ++size_;
+    return true;
+  }
+
+  std::vector<PeerId> ProviderStore::getProviders(const ContentId &key,
+                                                  Time now,
+                                                  size_t limit) const {
+    std::vector<PeerId> result;
+    auto multihash = multihashOf(key);
+    auto k = findKey(multihash, hashOf(multihash));
+    if (k == kNone) {
+      return result;
+    }
+    result.reserve(limit > 0 ? std::min<size_t>(limit, keys_[k].count)
+                             : keys_[k].count);
+    for (auto r = keys_[k].head; r != kNone; r = records_[r].next) {
+      if (records_[r].expires <= now) {
+        continue;
+      }
+      result.push_back(*peers_[records_[r].peer].id);
+      if (limit > 0 and result.size() >= limit) {
+        break;
+      }
+    }
+    return result;
+  }
+
+  bool ProviderStore::removeExpired(Time now, size_t budget) {
+    for (; budget > 0; --budget) {
+      if (oldest_ == kNone || records_[oldest_].expires > now) {
+        return true;
+      }
+      removeRecord(oldest_);
+    }
+    return oldest_ == kNone || records_[oldest_].expires > now;
+  }
+
+  size_t ProviderStore::memoryUsage() const {
+    return keys_.capacity() * sizeof(Key)
+        + free_keys_.capacity() * sizeof(Index) + key_index_.memoryUsage()
+        + key_bytes_
+        + peers_.capacity() * sizeof(Peer)
+        + free_peers_.capacity() * sizeof(Index) + peer_index_.memoryUsage()
+        + peer_bytes_ + records_.capacity() * sizeof(Record)
+        + free_records_.capacity() * sizeof(Index);
+  }
+
+  ProviderStore::Multihash ProviderStore::multihashOf(const ContentId &key) {
+    Multihash cid = key.data;
+    if (cid.size() == 2 + kSha256Size && cid[0] == kSha256
+        && cid[1] == kSha256Size) {
+      // CIDv0 is multihash
+      return cid;
+    }
+    if (!cid.empty() && cid[0] == kCidV1) {
+      // CIDv1 is version, codec and multihash
+      auto codec_size = multi::UVarint::calculateSize(cid.subspan(1));
+      if (codec_size > 0 && 1 + codec_size < static_cast<size_t>(cid.size())) {
+        return cid.subspan(1 + codec_size);
+      }
+    }
+    return cid;
+  }
+
+  size_t ProviderStore::hashOf(Multihash multihash) {
+    return std::hash<std::string_view>{}(std::string_view(
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const char *>(multihash.data()), multihash.size()));
+  }
+
+  ProviderStore::Index ProviderStore::findKey(Multihash multihash,
+                                              size_t hash) const {
+    return key_index_.find(hash, [&](Index k) {
+      return std::equal(keys_[k].multihash.begin(), keys_[k].multihash.end(),
+                        multihash.begin(), multihash.end());
+    });
+  }
+
+  ProviderStore::Index ProviderStore::findPeer(const PeerId &peer) const {
+    return peer_index_.find(std::hash<PeerId>{}(peer), [&](Index p) {
+      return *peers_[p].id == peer;
+    });
+  }
+
+  ProviderStore::Index ProviderStore::internKey(Multihash multihash,
+                                                size_t hash) {
+    if (auto k = findKey(multihash, hash); k != kNone) {
+      return k;
+    }
+    auto k = allocate(keys_, free_keys_);
+    keys_[k].multihash.assign(multihash.begin(), multihash.end());
+    key_index_.insert(hash, k);
+    key_bytes_ += keys_[k].multihash.size();
+    return k;
+  }
+
+  ProviderStore::Index ProviderStore::internPeer(const PeerId &peer) {
+    auto p = findPeer(peer);
+    if (p == kNone) {
+      p = allocate(peers_, free_peers_);
+      peers_[p].id = peer;
+      peer_index_.insert(std::hash<PeerId>{}(peer), p);
+      peer_bytes_ += peer.toVector().size();
+    }
+    ++peers_[p].refs;
+    return p;
+  }
+
+  void ProviderStore::releasePeer(Index p) {
+    auto &entry = peers_[p];
+    if (--entry.refs > 0) {
+      return;
+    }
+    peer_index_.erase(std::hash<PeerId>{}(*entry.id), p);
+    peer_bytes_ -= entry.id->toVector().size();
+    entry.id.reset();
+    free_peers_.push_back(p);
+  }
+
+  void ProviderStore::removeRecord(Index r) {
+    auto &record = records_[r];
+    auto &key = keys_[record.key];
+
+    if (key.head == r) {
+      key.head = record.next;
+    } else {
+      auto prev = key.head;
+      while (records_[prev].next != r) {
+        prev = records_[prev].next;
+      }
+      records_[prev].next = record.next;
+    }
+    if (--key.count == 0) {
+      key_index_.erase(hashOf(key.multihash), record.key);
+      key_bytes_ -= key.multihash.size();
+      key = Key{};
+      free_keys_.push_back(record.key);
+    }
+
+    releasePeer(record.peer);
+    unlink(r);
+    record = Record{};
+    free_records_.push_back(r);
+    --size_;
+  }
+
+  void ProviderStore::linkNewest(Index r) {
+    auto &record = records_[r];
+    record.older = newest_;
+    record.newer = kNone;
+    if (newest_ != kNone) {
+      records_[newest_].newer = r;
+    } else {
+      oldest_ = r;
+    }
+    newest_ = r;
+  }
+
+  void ProviderStore::unlink(Index r) {
+    auto &record = records_[r];
+    if (record.newer != kNone) {
+      records_[record.newer].older = record.older;
+    } else {
+      newest_ = record.older;
+    }
+    if (record.older != kNone) {
+      records_[record.older].newer = record.newer;
+    } else {
+      oldest_ = record.newer;
+    }
+    record.newer = kNone;
+    record.older = kNone;
+  }
+
+}  // namespace libp2p::protocol::kademlia
@@ -5,13 +5,22 @@
 
 #include <libp2p/protocol/kademlia/impl/put_value_executor.hpp>
 
+#include <libp2p/log/lazy.hpp>
 #include <libp2p/protocol/kademlia/config.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
+#include <libp2p/protocol/kademlia/impl/executor_metrics.hpp>
 #include <libp2p/protocol/kademlia/impl/session.hpp>
 #include <libp2p/protocol/kademlia/message.hpp>
 
 namespace libp2p::protocol::kademlia {
 
+  namespace {
+    ExecutorMetrics &stats() {
+      static ExecutorMetrics stats("put_value");
+      return stats;
+    }
+  }  // namespace
+
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
   std::atomic_size_t PutValueExecutor::instance_number = 0;
 
@@ -54,6 +63,7 @@ namespace libp2p::protocol::kademlia {
     }
 
     log_.debug("started");
+    stats().started.inc();
 
     spawn();
     return outcome::success();
@@ -71,9 +81,9 @@ namespace libp2p::protocol::kademlia {
 
       ++requests_in_progress_;
 
-      log_.debug("connecting to {}; active {}, in queue {}",
-                 peer_info.id.toBase58(), requests_in_progress_,
-                 addressees_.size() - addressees_idx_);
+      SUBLOG_DEBUG(log_, "connecting to {}; active {}, in queue {}",
+                   peer_info.id.toBase58(), requests_in_progress_,
+                   addressees_.size() - addressees_idx_);
 
       auto holder = std::make_shared<
           std::pair<std::shared_ptr<PutValueExecutor>, scheduler::Handle>>();
@@ -103,12 +113,15 @@ namespace libp2p::protocol::kademlia {
     if (requests_in_progress_ == 0) {
       done_ = true;
       log_.debug("done");
+      (requests_succeed_ > 0 ? stats().succeeded : stats().failed).inc();
     }
   }
 
   void PutValueExecutor::onConnected(
       outcome::result<std::shared_ptr<connection::Stream>> stream_res) {
+    stats().requests.inc();
     if (not stream_res) {
+      stats().request_failures.inc();
       --requests_in_progress_;
 
       log_.debug("cannot connect to peer: {}; active {}, in queue {}",
@@ -122,13 +135,15 @@ namespace libp2p::protocol::kademlia {
     auto &stream = stream_res.value();
     assert(stream->remoteMultiaddr().has_value());
 
-    std::string addr(stream->remoteMultiaddr().value().getStringAddress());
+    // rendered only if debug log is written
+    const auto remote_addr = stream->remoteMultiaddr().value();
+    auto addr = log::address(remote_addr);
     log_.debug("connected to {}; done{}, active {}, in queue {}", addr,
                requests_succeed_, requests_in_progress_,
                addressees_.size() - addressees_idx_);
 
-    log_.debug("outgoing stream with {}",
-               stream->remotePeerId().value().toBase58());
+    SUBLOG_DEBUG(log_, "outgoing stream with {}",
+                 stream->remotePeerId().value().toBase58());
 
     auto session = session_host_->openSession(stream);
 
@@ -5,7 +5,6 @@
 
 #include <libp2p/protocol/kademlia/impl/session.hpp>
 
-#include <libp2p/basic/varint_reader.hpp>
 #include <libp2p/protocol/kademlia/error.hpp>
 #include <libp2p/protocol/kademlia/impl/find_peer_executor.hpp>
 #include <libp2p/protocol/kademlia/message.hpp>
@@ -18,10 +17,13 @@ namespace libp2p::protocol::kademlia {
   Session::Session(std::weak_ptr<SessionHost> session_host,
                    std::weak_ptr<Scheduler> scheduler,
                    std::shared_ptr<connection::Stream> stream,
+                   size_t max_message_size,
                    scheduler::Ticks operations_timeout)
       : session_host_(std::move(session_host)),
         scheduler_(std::move(scheduler)),
         stream_(std::move(stream)),
+        reader_(std::make_shared<basic::FramedReader>(stream_,
+                                                      max_message_size)),
         operations_timeout_(operations_timeout),
         log_("KademliaSession", "kademlia", "Session", ++instance_number) {
     log_.debug("created");
@@ -39,12 +41,12 @@ namespace libp2p::protocol::kademlia {
 
     ++reading_;
 
-    libp2p::basic::VarintReader::readVarint(
-        stream_,
-        [wp = weak_from_this()](outcome::result<multi::UVarint> varint) {
-          if (auto self = wp.lock())
-            self->onLengthRead(std::move(varint));
-        });
+    reader_->read([wp = weak_from_this()](
+                      outcome::result<basic::FramedReader::Frame> res) {
+      if (auto self = wp.lock()) {
+        self->onMessageRead(res);
+      }
+    });
     setReadingTimeout();
     return true;
   }
@@ -98,34 +100,8 @@ namespace libp2p::protocol::kademlia {
     }
   }
 
-  void Session::onLengthRead(outcome::result<multi::UVarint> varint) {
-    if (stream_->isClosedForRead()) {
-      close(Error::STREAM_RESET);
-      return;
-    }
-
-    if (closed_) {
-      return;
-    }
-
-    if (varint.has_error()) {
-      close(varint.error());
-      return;
-    }
-
-    auto msg_len = varint.value().toUInt64();
-    inner_buffer_.resize(msg_len);
-
-    // NOLINTNEXTLINE(cppcoreguidelines-narrowing-conversions)
-    stream_->read(gsl::span(inner_buffer_.data(), inner_buffer_.size()),
-                  msg_len, [wp = weak_from_this()](auto &&res) {
-                    if (auto self = wp.lock()) {
-                      self->onMessageRead(std::forward<decltype(res)>(res));
-                    }
-                  });
-  }
-
-  void Session::onMessageRead(outcome::result<size_t> res) {
+  void Session::onMessageRead(
+      outcome::result<basic::FramedReader::Frame> res) {
     cancelReadingTimeout();
 
     if (closed_) {
@@ -137,13 +113,8 @@ namespace libp2p::protocol::kademlia {
       return;
     }
 
-    if (inner_buffer_.size() != res.value()) {
-      close(Error::MESSAGE_PARSE_ERROR);
-      return;
-    }
-
     Message msg;
-    if (!msg.deserialize(inner_buffer_.data(), inner_buffer_.size())) {
+    if (!msg.deserialize(res.value().data(), res.value().size())) {
       close(Error::MESSAGE_DESERIALIZE_ERROR);
       return;
     }
@@ -5,9 +5,11 @@
 
 #include <libp2p/protocol/kademlia/message.hpp>
 
+#include <array>
 #include <functional>
 
 #include <generated/protocol/kademlia/protobuf/kademlia.pb.h>
+#include <google/protobuf/arena.h>
 #include <libp2p/multi/uvarint.hpp>
 
 OUTCOME_CPP_DEFINE_CATEGORY(libp2p::protocol::kademlia, Message::Error, e) {
@@ -30,6 +32,33 @@ namespace libp2p::protocol::kademlia {
 
   namespace {
 
+    /// Size of stack block for protobuf arena, enough for typical messages
+    /// (e.g. FIND_NODE response with 20 peers), larger ones take heap blocks
+    constexpr size_t kArenaBlockSize = 4096;
+
+    /// Arena, which allocates from the stack block first
+    class ScopedArena {
+     public:
+      ScopedArena() : arena_(options(block_)) {}
+
+      template <typename T>
+      T *create() {
+        return google::protobuf::Arena::CreateMessage<T>(&arena_);
+      }
+
+     private:
+      static google::protobuf::ArenaOptions options(
+          std::array<char, kArenaBlockSize> &block) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block.data();
+        options.initial_block_size = block.size();
+        return options;
+      }
+
+      alignas(8) std::array<char, kArenaBlockSize> block_;
+      google::protobuf::Arena arena_;
+    };
+
     inline void assign_blob(std::vector<uint8_t> &dst, const std::string &src) {
       auto sz = src.size();
       if (sz == 0) {
@@ -99,6 +128,21 @@ namespace libp2p::protocol::kademlia {
       return outcome::success();
     }
 
+    template <class PbContainer>
+    void assign_pb_peers(PbContainer &dst, const Message::Peers &src) {
+      dst.Reserve(src.size());
+      for (const auto &p : src) {
+        auto *pb_peer = dst.Add();
+        const auto &pid_v = p.info.id.toVector();
+        pb_peer->set_id(pid_v.data(), pid_v.size());
+        for (const auto &addr : p.info.addresses) {
+          const auto &bytes = addr.getBytesAddress();
+          pb_peer->add_addrs(bytes.data(), bytes.size());
+        }
+        pb_peer->set_connection(pb::Message_ConnectionType(p.conn_status));
+      }
+    }
+
   }  // namespace
 
   void Message::clear() {
@@ -112,7 +156,8 @@ namespace libp2p::protocol::kademlia {
 
   bool Message::deserialize(const void *data, size_t sz) {
     clear();
-    pb::Message pb_msg;
+    ScopedArena arena;
+    auto &pb_msg = *arena.create<pb::Message>();
     if (!pb_msg.ParseFromArray(data, sz)) {
       error_message_ = "Invalid protobuf data";
       return false;
@@ -145,47 +190,28 @@ namespace libp2p::protocol::kademlia {
   }
 
   bool Message::serialize(std::vector<uint8_t> &buffer) const {
-    pb::Message pb_msg;
+    ScopedArena arena;
+    auto &pb_msg = *arena.create<pb::Message>();
     pb_msg.set_type(pb::Message_MessageType(type));
     pb_msg.set_key(key.data(), key.size());
     if (record) {
       const Record &rec_src = record.value();
-      pb::Record rec;
-      rec.set_key(rec_src.key.data.data(), rec_src.key.data.size());
-      rec.set_value(rec_src.value.data(), rec_src.value.size());
-      rec.set_timereceived(rec_src.time_received);
-      *pb_msg.mutable_record() = std::move(rec);
+      auto *rec = pb_msg.mutable_record();
+      rec->set_key(rec_src.key.data.data(), rec_src.key.data.size());
+      rec->set_value(rec_src.value.data(), rec_src.value.size());
+      rec->set_timereceived(rec_src.time_received);
     }
     if (closer_peers) {
-      for (const auto &p : closer_peers.value()) {
-        pb::Message_Peer *pb_peer = pb_msg.add_closerpeers();
-        auto &pid_v = p.info.id.toVector();
-        pb_peer->set_id(std::string(pid_v.begin(), pid_v.end()));
-        for (const auto &addr : p.info.addresses) {
-          auto &bytes = addr.getBytesAddress();
-          pb_peer->add_addrs(std::string(bytes.begin(), bytes.end()));
-        }
-        pb_peer->set_connection(pb::Message_ConnectionType(p.conn_status));
-      }
+      assign_pb_peers(*pb_msg.mutable_closerpeers(), closer_peers.value());
     }
     if (provider_peers) {
-      for (const auto &p : provider_peers.value()) {
-        pb::Message_Peer *pb_peer = pb_msg.add_providerpeers();
-        auto &pid_v = p.info.id.toVector();
-        pb_peer->set_id(std::string(pid_v.begin(), pid_v.end()));
-        for (const auto &addr : p.info.addresses) {
-          auto &bytes = addr.getBytesAddress();
-          pb_peer->add_addrs(std::string(bytes.begin(), bytes.end()));
-        }
-        pb_peer->set_connection(pb::Message_ConnectionType(p.conn_status));
-      }
+      assign_pb_peers(*pb_msg.mutable_providerpeers(),
+                      provider_peers.value());
     }
     size_t msg_sz = pb_msg.ByteSizeLong();
-    auto varint_len = multi::UVarint{msg_sz};
-    auto varint_vec = varint_len.toVector();
-    size_t prefix_sz = varint_vec.size();
+    size_t prefix_sz = multi::UVarint::encodedSize(msg_sz);
     buffer.resize(prefix_sz + msg_sz);
-    memcpy(buffer.data(), varint_vec.data(), prefix_sz);
+    multi::UVarint::encode(msg_sz, buffer);
     return pb_msg.SerializeToArray(buffer.data() + prefix_sz,  // NOLINT
                                    msg_sz);
   }
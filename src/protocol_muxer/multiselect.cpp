@@ -20,10 +20,31 @@ namespace libp2p::protocol_muxer::multiselect {
     constexpr size_t kMaxCacheSize = 8;
   }  // namespace
 
+  Multiselect::Multiselect(MultiselectConfig config) : config_(config) {}
+
   void Multiselect::selectOneOf(gsl::span<const peer::Protocol> protocols,
                                 std::shared_ptr<basic::ReadWriter> connection,
                                 bool is_initiator, bool negotiate_multiselect,
                                 ProtocolHandlerFunc cb) {
+    boost::container::small_vector<peer::ProtocolId, 4> ids;
+    ids.reserve(protocols.size());
+    for (const auto &protocol : protocols) {
+      ids.push_back(peer::internProtocol(protocol));
+    }
+    getInstance()->selectOneOf(
+        ids, std::move(connection), is_initiator, negotiate_multiselect,
+        [cb = std::move(cb)](outcome::result<peer::ProtocolId> res) {
+          if (!res) {
+            return cb(res.error());
+          }
+          cb(res.value()->name());
+        });
+  }
+
+  void Multiselect::selectOneOf(gsl::span<const peer::ProtocolId> protocols,
+                                std::shared_ptr<basic::ReadWriter> connection,
+                                bool is_initiator, bool negotiate_multiselect,
+                                ProtocolIdHandlerFunc cb) {
     getInstance()->selectOneOf(protocols, std::move(connection), is_initiator,
                                negotiate_multiselect, std::move(cb));
   }
@@ -41,12 +62,15 @@ namespace libp2p::protocol_muxer::multiselect {
     SL_TRACE(log(), "negotiating outbound stream for protocol {}", protocol_id);
 
     // This goes without using instances
+    if (config_.lazy_negotiation) {
+      return lazyStreamNegotiateImpl(stream, protocol_id, std::move(cb));
+    }
     simpleStreamNegotiateImpl(stream, protocol_id, std::move(cb));
   }
 
   void Multiselect::instanceClosed(Instance instance,
-                                   const ProtocolHandlerFunc &cb,
-                                   outcome::result<peer::Protocol> result) {
+                                   const ProtocolIdHandlerFunc &cb,
+                                   outcome::result<peer::ProtocolId> result) {
     active_instances_.erase(instance);
     if (cache_.size() < kMaxCacheSize) {
       cache_.emplace_back(std::move(instance));
@@ -0,0 +1,242 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/protocol_muxer/multiselect/lazy_stream.hpp>
+
+#include <algorithm>
+
+#include <libp2p/common/hexutil.hpp>
+#include <libp2p/log/logger.hpp>
+#include <libp2p/protocol_muxer/protocol_muxer.hpp>
+
+namespace libp2p::protocol_muxer::multiselect {
+
+  namespace {
+    const log::Logger &log() {
+      static log::Logger logger = log::createLogger("multiselect-lazy");
+      return logger;
+    }
+
+    static_assert(kProtocolId.size() + 1 < 0x80);
+
+    /// Size of multistream header message: 1 byte varint + id + newline
+    constexpr size_t kHeaderSize = kProtocolId.size() + 2;
+
+    /// Reply is read up to this size first, so that "na" can be recognized
+    /// without waiting for bytes which will never come
+    constexpr size_t kFirstReadSize = kHeaderSize + kMaxVarintSize;
+  }  // namespace
+
+  LazyStream::LazyStream(std::shared_ptr<connection::Stream> stream,
+                         peer::ProtocolId protocol)
+      : stream_(std::move(stream)),
+        protocol_(std::move(protocol)),
+        proposal_(protocol_->multistreamProposal()) {
+    assert(stream_);
+    assert(proposal_.size() >= kFirstReadSize);
+  }
+
+  void LazyStream::read(gsl::span<uint8_t> out, size_t bytes,
+                        ReadCallbackFunc cb) {
+    if (negotiated_) {
+      return stream_->read(out, bytes, std::move(cb));
+    }
+    readWithReply(out, bytes, std::move(cb), false);
+  }
+
+  void LazyStream::readSome(gsl::span<uint8_t> out, size_t bytes,
+                            ReadCallbackFunc cb) {
+    if (negotiated_) {
+      return stream_->readSome(out, bytes, std::move(cb));
+    }
+    readWithReply(out, bytes, std::move(cb), true);
+  }
+
+  void LazyStream::deferReadCallback(outcome::result<size_t> res,
+                                     ReadCallbackFunc cb) {
+    stream_->deferReadCallback(res, std::move(cb));
+  }
+
+  void LazyStream::write(gsl::span<const uint8_t> in, size_t bytes,
+                         WriteCallbackFunc cb) {
+    if (proposal_sent_) {
+      return stream_->write(in, bytes, std::move(cb));
+    }
+    writeWithProposal(in, bytes, std::move(cb));
+  }
+
+  void LazyStream::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                             WriteCallbackFunc cb) {
+    if (proposal_sent_) {
+      return stream_->writeSome(in, bytes, std::move(cb));
+    }
+    writeWithProposal(in, bytes, std::move(cb));
+  }
+
+  void LazyStream::deferWriteCallback(std::error_code ec,
+                                      WriteCallbackFunc cb) {
+    stream_->deferWriteCallback(ec, std::move(cb));
+  }
+
+  bool LazyStream::isClosedForRead() const {
+    return stream_->isClosedForRead();
+  }
+
+  bool LazyStream::isClosedForWrite() const {
+    return stream_->isClosedForWrite();
+  }
+
+  bool LazyStream::isClosed() const {
+    return stream_->isClosed();
+  }
+
+  void LazyStream::close(VoidResultHandlerFunc cb) {
+    stream_->close(std::move(cb));
+  }
+
+  void LazyStream::reset() {
+    stream_->reset();
+  }
+
+  void LazyStream::adjustWindowSize(uint32_t new_size,
+                                    VoidResultHandlerFunc cb) {
+    stream_->adjustWindowSize(new_size, std::move(cb));
+  }
+
+  void LazyStream::setPriority(Priority priority) {
+    stream_->setPriority(priority);
+  }
+
+  outcome::result<bool> LazyStream::isInitiator() const {
+    return stream_->isInitiator();
+  }
+
+  outcome::result<peer::PeerId> LazyStream::remotePeerId() const {
+    return stream_->remotePeerId();
+  }
+
+  outcome::result<multi::Multiaddress> LazyStream::localMultiaddr() const {
+    return stream_->localMultiaddr();
+  }
+
+  outcome::result<multi::Multiaddress> LazyStream::remoteMultiaddr() const {
+    return stream_->remoteMultiaddr();
+  }
+
+  void LazyStream::writeWithProposal(gsl::span<const uint8_t> in,
+                                     size_t bytes, WriteCallbackFunc cb) {
+    if (bytes > static_cast<size_t>(in.size())) {
+      return stream_->deferWriteCallback(
+          connection::Stream::Error::STREAM_INVALID_ARGUMENT, std::move(cb));
+    }
+
+    proposal_sent_ = true;
+
+    auto packet = std::make_shared<std::vector<uint8_t>>();
+    packet->reserve(proposal_.size() + bytes);
+    packet->insert(packet->end(), proposal_.begin(), proposal_.end());
+    packet->insert(packet->end(), in.begin(), in.begin() + bytes);
+
+    SL_TRACE(log(), "sending {} with {} bytes of data",
+             common::dumpBin(proposal_), bytes);
+
+    gsl::span<const uint8_t> span(*packet);
+    stream_->write(span, span.size(),
+                   [packet, bytes, cb = std::move(cb)](
+                       outcome::result<size_t> res) {
+                     if (!res) {
+                       return cb(res.error());
+                     }
+                     cb(bytes);
+                   });
+  }
+
+  void LazyStream::readWithReply(gsl::span<uint8_t> out, size_t bytes,
+                                 ReadCallbackFunc cb, bool some) {
+    if (!proposal_sent_) {
+      // the user reads first, so the proposal goes without data
+      proposal_sent_ = true;
+
+      SL_TRACE(log(), "sending {}", common::dumpBin(proposal_));
+
+      // write errors surface on the read
+      stream_->write(proposal_, proposal_.size(),
+                     [self = shared_from_this()](outcome::result<size_t>) {});
+    }
+
+    reply_.resize(proposal_.size());
+    gsl::span<uint8_t> span(reply_);
+    span = span.first(kFirstReadSize);
+
+    stream_->read(span, span.size(),
+                  [self = shared_from_this(), out, bytes, cb = std::move(cb),
+                   some](outcome::result<size_t> res) mutable {
+                    self->onReplyHeaderRead(out, bytes, std::move(cb), some,
+                                            res);
+                  });
+  }
+
+  void LazyStream::onReplyHeaderRead(gsl::span<uint8_t> out, size_t bytes,
+                                     ReadCallbackFunc cb, bool some,
+                                     outcome::result<size_t> res) {
+    if (!res) {
+      return failed(cb, res.error());
+    }
+
+    if (res.value() != kFirstReadSize) {
+      return failed(cb, ProtocolMuxer::Error::INTERNAL_ERROR);
+    }
+
+    if (!std::equal(reply_.begin(), reply_.begin() + kFirstReadSize,
+                    proposal_.begin())) {
+      SL_DEBUG(log(), "protocol was not accepted, received {}",
+               common::dumpBin(gsl::span<const uint8_t>(reply_).first(
+                   kFirstReadSize)));
+      return failed(cb, ProtocolMuxer::Error::NEGOTIATION_FAILED);
+    }
+
+    if (reply_.size() == kFirstReadSize) {
+      return onReplyRead(out, bytes, std::move(cb), some, 0);
+    }
+
+    gsl::span<uint8_t> span(reply_);
+    span = span.subspan(kFirstReadSize);
+
+    stream_->read(span, span.size(),
+                  [self = shared_from_this(), out, bytes, cb = std::move(cb),
+                   some](outcome::result<size_t> res) mutable {
+                    self->onReplyRead(out, bytes, std::move(cb), some, res);
+                  });
+  }
+
+  void LazyStream::onReplyRead(gsl::span<uint8_t> out, size_t bytes,
+                               ReadCallbackFunc cb, bool some,
+                               outcome::result<size_t> res) {
+    if (!res) {
+      return failed(cb, res.error());
+    }
+
+    if (!std::equal(reply_.begin(), reply_.end(), proposal_.begin(),
+                    proposal_.end())) {
+      SL_DEBUG(log(), "unexpected reply {}",
+               common::dumpBin(gsl::span<const uint8_t>(reply_)));
+      return failed(cb, ProtocolMuxer::Error::NEGOTIATION_FAILED);
+    }
+
+    negotiated_ = true;
+    reply_ = {};
+
+    if (some) {
+      return stream_->readSome(out, bytes, std::move(cb));
+    }
+    stream_->read(out, bytes, std::move(cb));
+  }
+
+  void LazyStream::failed(const ReadCallbackFunc &cb, std::error_code ec) {
+    stream_->reset();
+    cb(ec);
+  }
+
+}  // namespace libp2p::protocol_muxer::multiselect
@@ -19,15 +19,38 @@ namespace libp2p::protocol_muxer::multiselect {
       static log::Logger logger = log::createLogger("multiselect");
       return logger;
     }
+
+    /// Encoded messages, which don't depend on protocols
+    const MsgBuf &openingMessage() {
+      static const MsgBuf msg = detail::createMessage(kProtocolId).value();
+      return msg;
+    }
+
+    const MsgBuf &naMessage() {
+      static const MsgBuf msg = detail::createMessage(kNA).value();
+      return msg;
+    }
+
+    template <typename Protocols>
+    std::string joinNames(const Protocols &protocols) {
+      std::string names;
+      for (const auto &p : protocols) {
+        if (!names.empty()) {
+          names += ", ";
+        }
+        names += p->name();
+      }
+      return names;
+    }
   }  // namespace
 
   MultiselectInstance::MultiselectInstance(Multiselect &owner)
       : owner_(owner) {}
 
   void MultiselectInstance::selectOneOf(
-      gsl::span<const peer::Protocol> protocols,
+      gsl::span<const peer::ProtocolId> protocols,
       std::shared_ptr<basic::ReadWriter> connection, bool is_initiator,
-      bool negotiate_multiselect, Multiselect::ProtocolHandlerFunc cb) {
+      bool negotiate_multiselect, Multiselect::ProtocolIdHandlerFunc cb) {
     assert(!protocols.empty());
     assert(connection);
     assert(cb);
@@ -73,7 +96,7 @@ namespace libp2p::protocol_muxer::multiselect {
     if (is_initiator_) {
       sendProposal();
     } else {
-      send(detail::createMessage(kProtocolId));
+      send(Packet{openingMessage(), nullptr});
     }
   }
 
@@ -84,13 +107,7 @@ namespace libp2p::protocol_muxer::multiselect {
       return false;
     }
 
-    if (!multistream_negotiated_) {
-      std::array<std::string_view, 2> a(
-          {kProtocolId, protocols_[current_protocol_]});
-      send(detail::createMessage(a, false));
-    } else {
-      send(detail::createMessage(protocols_[current_protocol_]));
-    }
+    send(protocols_[current_protocol_], !multistream_negotiated_);
 
     wait_for_protocol_reply_ = true;
     return true;
@@ -98,37 +115,43 @@ namespace libp2p::protocol_muxer::multiselect {
 
   void MultiselectInstance::sendLS() {
     if (!ls_response_) {
-      auto msg_res = detail::createMessage(protocols_, true);
+      boost::container::small_vector<std::string_view, 4> names;
+      for (const auto &p : protocols_) {
+        names.push_back(p->name());
+      }
+      auto msg_res = detail::createMessage(names, true);
       if (!msg_res) {
-        // will defer error
-        return send(msg_res);
+        return sendError(msg_res.error());
       }
       ls_response_ = std::make_shared<MsgBuf>(std::move(msg_res.value()));
     }
-    send(ls_response_.value());
+    send(Packet{*ls_response_, ls_response_});
   }
 
   void MultiselectInstance::sendNA() {
-    if (!na_response_) {
-      na_response_ =
-          std::make_shared<MsgBuf>(detail::createMessage(kNA).value());
-    }
-    send(na_response_.value());
+    send(Packet{naMessage(), nullptr});
   }
 
-  void MultiselectInstance::send(outcome::result<MsgBuf> msg) {
-    if (!msg) {
-      return connection_->deferWriteCallback(
-          msg.error(),
-          [wptr = weak_from_this(),
-           round = current_round_](outcome::result<size_t> res) {
-            auto self = wptr.lock();
-            if (self && self->current_round_ == round) {
-              self->onDataWritten(res);
-            }
-          });
+  void MultiselectInstance::send(const peer::ProtocolId &protocol,
+                                 bool with_header) {
+    auto bytes = with_header ? protocol->multistreamProposal()
+                             : protocol->multistreamLine();
+    if (bytes.empty()) {
+      return sendError(ProtocolMuxer::Error::INTERNAL_ERROR);
     }
-    send(std::make_shared<MsgBuf>(std::move(msg.value())));
+    send(Packet{bytes, protocol});
+  }
+
+  void MultiselectInstance::sendError(std::error_code ec) {
+    connection_->deferWriteCallback(
+        ec,
+        [wptr = weak_from_this(),
+         round = current_round_](outcome::result<size_t> res) {
+          auto self = wptr.lock();
+          if (self && self->current_round_ == round) {
+            self->onDataWritten(res);
+          }
+        });
   }
 
   void MultiselectInstance::send(Packet packet) {
@@ -137,14 +160,14 @@ namespace libp2p::protocol_muxer::multiselect {
       return;
     }
 
-    auto span = gsl::span<const uint8_t>(*packet);
+    auto span = packet.bytes;
 
     SL_TRACE(log(), "sending {}", common::dumpBin(span));
 
     connection_->write(
         span, span.size(),
         [wptr = weak_from_this(), round = current_round_,
-         packet = std::move(packet)](outcome::result<size_t> res) {
+         holder = std::move(packet.holder)](outcome::result<size_t> res) {
           auto self = wptr.lock();
           if (self && self->current_round_ == round) {
             self->onDataWritten(res);
@@ -174,11 +197,11 @@ namespace libp2p::protocol_muxer::multiselect {
     }
   }
 
-  void MultiselectInstance::close(outcome::result<std::string> result) {
+  void MultiselectInstance::close(outcome::result<peer::ProtocolId> result) {
     closed_ = true;
     ++current_round_;
     write_queue_.clear();
-    Multiselect::ProtocolHandlerFunc callback;
+    Multiselect::ProtocolIdHandlerFunc callback;
     callback.swap(callback_);
 
     owner_.instanceClosed(shared_from_this(), callback, std::move(result));
@@ -229,7 +252,7 @@ namespace libp2p::protocol_muxer::multiselect {
 
     SL_TRACE(log(), "received {}", common::dumpBin(span));
 
-    boost::optional<outcome::result<std::string>> got_result;
+    MaybeResult got_result;
 
     auto state = parser_.consume(span);
     switch (state) {
@@ -297,9 +320,9 @@ namespace libp2p::protocol_muxer::multiselect {
       if (wait_for_protocol_reply_) {
         assert(current_protocol_ < protocols_.size());
 
-        if (protocols_[current_protocol_] == protocol) {
+        if (protocols_[current_protocol_]->name() == protocol) {
           // successful client side negotiation
-          return MaybeResult(std::string(protocol));
+          return MaybeResult(protocols_[current_protocol_]);
         }
       }
 
@@ -312,11 +335,11 @@ namespace libp2p::protocol_muxer::multiselect {
 
     size_t idx = 0;
     for (const auto &p : protocols_) {
-      if (p == protocol) {
+      if (p->name() == protocol) {
         // successful server side negotiation
         wait_for_reply_sent_ = idx;
         write_queue_.clear();
-        send(detail::createMessage(protocol));
+        send(p, false);
         break;
       }
       ++idx;
@@ -334,7 +357,7 @@ namespace libp2p::protocol_muxer::multiselect {
     if (is_initiator_) {
       if (current_protocol_ < protocols_.size()) {
         SL_DEBUG(log(), "protocol {} was not accepted by peer",
-                 protocols_[current_protocol_]);
+                 protocols_[current_protocol_]->name());
       }
 
       ++current_protocol_;
@@ -345,7 +368,7 @@ namespace libp2p::protocol_muxer::multiselect {
       }
 
       SL_DEBUG(log(), "Failed to negotiate protocols: {}",
-               fmt::join(protocols_.begin(), protocols_.end(), ", "));
+               joinNames(protocols_));
       return MaybeResult(ProtocolMuxer::Error::NEGOTIATION_FAILED);
     }
 
@@ -5,9 +5,11 @@
 
 #include <libp2p/protocol_muxer/multiselect/simple_stream_negotiate.hpp>
 
+#include <algorithm>
+
 #include <libp2p/common/hexutil.hpp>
 #include <libp2p/log/logger.hpp>
-#include <libp2p/protocol_muxer/multiselect/serializing.hpp>
+#include <libp2p/protocol_muxer/multiselect/lazy_stream.hpp>
 #include <libp2p/protocol_muxer/protocol_muxer.hpp>
 
 namespace libp2p::protocol_muxer::multiselect {
@@ -22,7 +24,8 @@ namespace libp2p::protocol_muxer::multiselect {
     using Callback = std::function<void(outcome::result<StreamPtr>)>;
 
     struct Buffers {
-      MsgBuf written;
+      peer::ProtocolId protocol;
+      gsl::span<const uint8_t> written;
       MsgBuf read;
     };
 
@@ -35,7 +38,8 @@ namespace libp2p::protocol_muxer::multiselect {
     void completed(StreamPtr stream, const Callback &cb,
                    const Buffers &buffers) {
       // In this case we expect the exact echo in reply
-      if (buffers.read == buffers.written) {
+      if (std::equal(buffers.read.begin(), buffers.read.end(),
+                     buffers.written.begin(), buffers.written.end())) {
         return cb(std::move(stream));
       }
       failed(stream, cb, ProtocolMuxer::Error::NEGOTIATION_FAILED);
@@ -114,20 +118,21 @@ namespace libp2p::protocol_muxer::multiselect {
   void simpleStreamNegotiateImpl(const StreamPtr &stream,
                                  const peer::Protocol &protocol_id,
                                  Callback cb) {
-    std::array<std::string_view, 2> a({kProtocolId, protocol_id});
-    auto res = detail::createMessage(a, false);
-    if (!res) {
+    auto protocol = peer::internProtocol(protocol_id);
+    if (protocol->multistreamProposal().empty()) {
       return stream->deferWriteCallback(
-          res.error(), [cb = std::move(cb)](auto res) { cb(res.error()); });
+          ProtocolMuxer::Error::INTERNAL_ERROR,
+          [cb = std::move(cb)](auto res) { cb(res.error()); });
     }
 
     auto buffers = std::make_shared<Buffers>();
-    buffers->written = std::move(res.value());
+    buffers->written = protocol->multistreamProposal();
+    buffers->protocol = std::move(protocol);
     buffers->read.resize(buffers->written.size());
 
     assert(buffers->written.size() >= kMaxVarintSize);
 
-    gsl::span<const uint8_t> span(buffers->written);
+    auto span = buffers->written;
 
     SL_TRACE(log(), "sending {}", common::dumpBin(span));
 
@@ -140,4 +145,23 @@ namespace libp2p::protocol_muxer::multiselect {
         });
   }
 
+  void lazyStreamNegotiateImpl(const StreamPtr &stream,
+                               const peer::Protocol &protocol_id,
+                               Callback cb) {
+    auto protocol = peer::internProtocol(protocol_id);
+    if (protocol->multistreamProposal().empty()) {
+      return stream->deferWriteCallback(
+          ProtocolMuxer::Error::INTERNAL_ERROR,
+          [cb = std::move(cb)](auto res) { cb(res.error()); });
+    }
+
+    auto lazy_stream = std::make_shared<LazyStream>(stream, std::move(protocol));
+
+    // keep the callback asynchronous as in simple negotiation
+    stream->deferReadCallback(
+        0,
+        [cb = std::move(cb), lazy_stream = std::move(lazy_stream)](
+            outcome::result<size_t>) mutable { cb(std::move(lazy_stream)); });
+  }
+
 }  // namespace libp2p::protocol_muxer::multiselect
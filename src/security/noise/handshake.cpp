@@ -8,6 +8,7 @@
 #include <libp2p/security/noise/handshake.hpp>
 
 #include <libp2p/common/byteutil.hpp>
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/peer/peer_id.hpp>
 #include <libp2p/security/noise/crypto/cipher_suite.hpp>
 #include <libp2p/security/noise/crypto/noise_ccp1305.hpp>
@@ -37,6 +38,21 @@ namespace libp2p::security::noise {
   namespace {
     template <typename T>
     void unused(T &&) {}
+
+    struct HandshakeStats {
+      metrics::Histogram &duration = metrics::Registry::global().histogram(
+          "libp2p_noise_handshake_duration_seconds",
+          "Duration of successful noise handshakes",
+          metrics::Histogram::durationBuckets());
+      metrics::Counter &failures = metrics::Registry::global().counter(
+          "libp2p_noise_handshake_failures_total",
+          "Number of failed noise handshakes");
+    };
+
+    HandshakeStats &stats() {
+      static HandshakeStats stats;
+      return stats;
+    }
   }  // namespace
 
   std::shared_ptr<CipherSuite> defaultCipherSuite() {
@@ -71,8 +87,10 @@ namespace libp2p::security::noise {
   }
 
   void Handshake::connect() {
+    started_ = std::chrono::steady_clock::now();
     auto result = runHandshake();
     if (result.has_error()) {
+      stats().failures.inc();
       connection_cb_(result.error());
     }
   }
@@ -257,6 +275,12 @@ namespace libp2p::security::noise {
   }
 
   void Handshake::hscb(outcome::result<bool> secured) {
+    if (secured.has_error() || not secured.value()
+        || not remote_peer_pubkey_) {
+      stats().failures.inc();
+    } else {
+      stats().duration.observe(std::chrono::steady_clock::now() - started_);
+    }
     if (secured.has_error()) {
       log_->error("handshake failed, {}", secured.error().message());
       return connection_cb_(secured.error());
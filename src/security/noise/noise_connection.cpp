@@ -5,6 +5,7 @@
 
 #include <libp2p/security/noise/noise_connection.hpp>
 
+#include <libp2p/common/metrics/registry.hpp>
 #include <libp2p/crypto/x25519_provider/x25519_provider_impl.hpp>
 #include <libp2p/security/noise/crypto/interfaces.hpp>
 
@@ -25,6 +26,22 @@
 #define OUTCOME_CB(name, res) OUTCOME_CB_NAME_I(UNIQUE_NAME(name), name, res)
 
 namespace libp2p::connection {
+  namespace {
+    struct NoiseStats {
+      metrics::Counter &bytes_decrypted = metrics::Registry::global().counter(
+          "libp2p_noise_bytes_received_total",
+          "Plaintext bytes decrypted by noise connections");
+      metrics::Counter &bytes_encrypted = metrics::Registry::global().counter(
+          "libp2p_noise_bytes_sent_total",
+          "Plaintext bytes encrypted by noise connections");
+    };
+
+    NoiseStats &stats() {
+      static NoiseStats stats;
+      return stats;
+    }
+  }  // namespace
+
   NoiseConnection::NoiseConnection(
       std::shared_ptr<RawConnection> raw_connection,
       crypto::PublicKey localPubkey, crypto::PublicKey remotePubkey,
@@ -93,6 +110,7 @@ namespace libp2p::connection {
                    cb{std::move(cb)}](auto _data) mutable {
       OUTCOME_CB(data, _data);
       OUTCOME_CB(decrypted, self->decoder_cs_->decrypt({}, *data, {}));
+      stats().bytes_decrypted.inc(decrypted.size());
       self->frame_buffer_->assign(decrypted.begin(), decrypted.end());
       self->readSome(out, bytes, std::move(cb));
     });
@@ -112,6 +130,7 @@ namespace libp2p::connection {
     }
     auto n{std::min(bytes, security::noise::kMaxPlainText)};
     OUTCOME_CB(encrypted, encoder_cs_->encrypt({}, in.subspan(0, n), {}));
+    stats().bytes_encrypted.inc(n);
     writing_ = std::move(encrypted);
     framer_->write(writing_,
                    [self{shared_from_this()}, in{in.subspan(n)},
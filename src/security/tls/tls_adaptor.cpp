@@ -5,12 +5,15 @@
 
 #include <libp2p/security/tls/tls_adaptor.hpp>
 
+#include <string_view>
+
 #include <libp2p/peer/peer_id.hpp>
 #include <libp2p/security/tls/tls_errors.hpp>
 #include <libp2p/transport/tcp/tcp_connection.hpp>
 
 #include "tls_connection.hpp"
 #include "tls_details.hpp"
+#include "tls_session_cache.hpp"
 
 namespace libp2p::security {
 
@@ -20,10 +23,12 @@ namespace libp2p::security {
   TlsAdaptor::TlsAdaptor(
       std::shared_ptr<peer::IdentityManager> idmgr,
       std::shared_ptr<boost::asio::io_context> io_context,
-      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller)
+      std::shared_ptr<crypto::marshaller::KeyMarshaller> key_marshaller,
+      TlsConfig config)
       : idmgr_(std::move(idmgr)),
         io_context_(std::move(io_context)),
-        key_marshaller_(std::move(key_marshaller)) {
+        key_marshaller_(std::move(key_marshaller)),
+        config_(config) {
     assert(idmgr_);
     assert(io_context_);
     assert(key_marshaller_);
@@ -72,6 +77,8 @@ namespace libp2p::security {
           boost::asio::const_buffer(ck.private_key.data(),
                                     ck.private_key.size()),
           boost::asio::ssl::context_base::asn1);
+
+      setupSessionResumption();
     } catch (const std::exception &e) {
       ssl_context_.reset();
       log()->error("context init failed: {}", e.what());
@@ -81,6 +88,32 @@ namespace libp2p::security {
     return outcome::success();
   }
 
+  void TlsAdaptor::setupSessionResumption() {
+    auto *ctx = ssl_context_->native_handle();
+
+    if (!config_.session_resumption) {
+      // don't spend time on tickets nobody uses
+      SSL_CTX_set_num_tickets(ctx, 0);
+      return;
+    }
+
+    // Server side tickets are stateless (encrypted with the context's key),
+    // client side sessions are kept per peer by the cache
+    SSL_CTX_set_session_cache_mode(
+        ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &TlsConnection::onNewSession);
+    SSL_CTX_set_num_tickets(ctx, 1);
+
+    // required to resume sessions with client certificates
+    static constexpr std::string_view kSessionIdContext = "libp2p-tls";
+    SSL_CTX_set_session_id_context(
+        ctx, reinterpret_cast<const uint8_t *>(kSessionIdContext.data()),
+        kSessionIdContext.size());
+
+    session_cache_ =
+        std::make_shared<tls_details::SessionCache>(config_.session_cache_size);
+  }
+
   void TlsAdaptor::asyncHandshake(
       std::shared_ptr<connection::RawConnection> conn,
       boost::optional<peer::PeerId> remote_peer, SecConnCallbackFunc cb) {
@@ -110,7 +143,7 @@ namespace libp2p::security {
       } else {
         auto tls_conn = std::make_shared<TlsConnection>(
             std::move(conn), ssl_context_, *idmgr_, tcp_conn->socket_,
-            std::move(remote_peer));
+            std::move(remote_peer), session_cache_);
         tls_conn->asyncHandshake(std::move(cb), key_marshaller_);
       }
     }
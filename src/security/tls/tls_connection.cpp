@@ -21,18 +21,52 @@ namespace libp2p::connection {
     inline auto makeBuffer(Span s) {
       return boost::asio::buffer(s.data(), s.size());
     }
+
+    /// Index of SSL ex data which points to the TlsConnection.
+    /// App data cannot be used, asio keeps verify callback there
+    int connectionIndex() {
+      static const int index =
+          SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+      return index;
+    }
   }  // namespace
 
   TlsConnection::TlsConnection(
       std::shared_ptr<RawConnection> raw_connection,
       std::shared_ptr<boost::asio::ssl::context> ssl_context,
       const peer::IdentityManager &idmgr, tcp_socket_t &tcp_socket,
-      boost::optional<peer::PeerId> remote_peer)
+      boost::optional<peer::PeerId> remote_peer,
+      std::shared_ptr<security::tls_details::SessionCache> session_cache)
       : local_peer_(idmgr.getId()),
         raw_connection_(std::move(raw_connection)),
         ssl_context_(std::move(ssl_context)),
         socket_(std::ref(tcp_socket), *ssl_context_),
-        remote_peer_(std::move(remote_peer)) {}
+        remote_peer_(std::move(remote_peer)) {
+    if (!session_cache || !raw_connection_->isInitiator()) {
+      return;
+    }
+    assert(remote_peer_);
+    session_cache_ = std::move(session_cache);
+
+    auto *ssl = socket_.native_handle();
+    SSL_set_ex_data(ssl, connectionIndex(), this);
+
+    if (auto session = session_cache_->take(remote_peer_.value())) {
+      // peer identity is still verified, the certificate is in the session
+      SSL_set_session(ssl, session.get());
+    }
+  }
+
+  int TlsConnection::onNewSession(SSL *ssl, SSL_SESSION *session) {
+    auto *conn =
+        static_cast<TlsConnection *>(SSL_get_ex_data(ssl, connectionIndex()));
+    // tickets come after the handshake, but only verified peers are cached
+    if (conn != nullptr && conn->session_cache_ && conn->remote_pubkey_) {
+      conn->session_cache_->put(conn->remote_peer_.value(), session);
+    }
+    // the session is not kept by the callback
+    return 0;
+  }
 
   void TlsConnection::asyncHandshake(
       HandshakeCallback cb,
@@ -78,9 +112,12 @@ namespace libp2p::connection {
       }
       remote_pubkey_ = std::move(id.public_key);
 
-      SL_DEBUG(log(), "handshake success for {}bound connection to {}",
+      SL_DEBUG(log(), "handshake success for {}bound connection to {}{}",
                   (raw_connection_->isInitiator() ? "out" : "in"),
-                  remote_peer_->toBase58());
+                  remote_peer_->toBase58(),
+                  (SSL_session_reused(socket_.native_handle()) != 0
+                       ? ", session resumed"
+                       : ""));
       return cb(shared_from_this());
     }
 
@@ -18,6 +18,8 @@
 #include <libp2p/peer/identity_manager.hpp>
 #include <libp2p/security/tls/tls_errors.hpp>
 
+#include "tls_session_cache.hpp"
+
 namespace libp2p::connection {
 
   /// Secure connection of TLS 1.3 protocol
@@ -43,10 +45,15 @@ namespace libp2p::connection {
     /// \param tcp_socket Raw socket extracted from raw connection
     /// \param remote_peer Expected peer id of remote peer, has value for
     /// outbound connections
-    TlsConnection(std::shared_ptr<RawConnection> raw_connection,
-                  std::shared_ptr<boost::asio::ssl::context> ssl_context,
-                  const peer::IdentityManager &idmgr, tcp_socket_t &tcp_socket,
-                  boost::optional<peer::PeerId> remote_peer);
+    /// \param session_cache Sessions to resume outbound connections, may be
+    /// nullptr if resumption is disabled
+    TlsConnection(
+        std::shared_ptr<RawConnection> raw_connection,
+        std::shared_ptr<boost::asio::ssl::context> ssl_context,
+        const peer::IdentityManager &idmgr, tcp_socket_t &tcp_socket,
+        boost::optional<peer::PeerId> remote_peer,
+        std::shared_ptr<security::tls_details::SessionCache> session_cache =
+            nullptr);
 
     /// Performs async handshake and passes its result into callback. This fn is
     /// distinct from the ctor because it uses shared_from_this()
@@ -108,6 +115,10 @@ namespace libp2p::connection {
     /// Closes the socket
     outcome::result<void> close() override;
 
+    /// New session callback for SSL_CTX_sess_set_new_cb(), stores sessions
+    /// of verified outbound connections into their session cache
+    static int onNewSession(SSL *ssl, SSL_SESSION *session);
+
    private:
     /// Async handshake callback. Performs libp2p-specific verification and
     /// extraction of remote peer's identity fields
@@ -133,6 +144,9 @@ namespace libp2p::connection {
     /// Remote public key, extracted from peer certificate during handshake
     boost::optional<crypto::PublicKey> remote_pubkey_;
 
+    /// Sessions for resumption, nullptr for inbound connections
+    std::shared_ptr<security::tls_details::SessionCache> session_cache_;
+
    public:
     LIBP2P_METRICS_INSTANCE_COUNT_IF_ENABLED(libp2p::connection::TlsConnection);
   };
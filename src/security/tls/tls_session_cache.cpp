@@ -0,0 +1,50 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tls_session_cache.hpp"
+
+namespace libp2p::security::tls_details {
+
+  SessionCache::SessionCache(size_t capacity) : capacity_(capacity) {}
+
+  void SessionCache::put(const peer::PeerId &peer,
+                         const SSL_SESSION *session) {
+    if (capacity_ == 0 || SSL_SESSION_is_resumable(session) == 0) {
+      return;
+    }
+
+    Session copy(SSL_SESSION_dup(session), &SSL_SESSION_free);
+    if (!copy) {
+      return;
+    }
+
+    if (auto it = index_.find(peer); it != index_.end()) {
+      lru_.erase(it->second);
+      index_.erase(it);
+    } else if (lru_.size() >= capacity_) {
+      index_.erase(lru_.back().first);
+      lru_.pop_back();
+    }
+
+    lru_.emplace_front(peer, std::move(copy));
+    index_.emplace(peer, lru_.begin());
+  }
+
+  SessionCache::Session SessionCache::take(const peer::PeerId &peer) {
+    auto it = index_.find(peer);
+    if (it == index_.end()) {
+      return {nullptr, &SSL_SESSION_free};
+    }
+    auto session = std::move(it->second->second);
+    lru_.erase(it->second);
+    index_.erase(it);
+    return session;
+  }
+
+  size_t SessionCache::size() const {
+    return lru_.size();
+  }
+
+}  // namespace libp2p::security::tls_details
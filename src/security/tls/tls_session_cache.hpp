@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_SECURITY_TLS_SESSION_CACHE_HPP
+#define LIBP2P_SECURITY_TLS_SESSION_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include <openssl/ssl.h>
+#include <boost/noncopyable.hpp>
+
+#include <libp2p/peer/peer_id.hpp>
+
+namespace libp2p::security::tls_details {
+
+  /// Client side TLS 1.3 sessions of recently connected peers, which allow
+  /// to resume the session instead of full handshake on reconnect
+  class SessionCache : private boost::noncopyable {
+   public:
+    using Session = std::unique_ptr<SSL_SESSION, decltype(&SSL_SESSION_free)>;
+
+    /// Ctor.
+    /// \param capacity max number of peers, least recently stored sessions
+    /// are evicted
+    explicit SessionCache(size_t capacity);
+
+    /// Stores a copy of the session, replaces the previous one of the peer.
+    /// A copy is needed because OpenSSL marks the original session
+    /// non-resumable when its connection is closed without TLS shutdown
+    void put(const peer::PeerId &peer, const SSL_SESSION *session);
+
+    /// Takes the peer's session out of the cache, as session tickets are
+    /// single-use. Returns nullptr if there is no session
+    Session take(const peer::PeerId &peer);
+
+    size_t size() const;
+
+   private:
+    using Entry = std::pair<peer::PeerId, Session>;
+
+    const size_t capacity_;
+
+    /// Most recently stored sessions in front
+    std::list<Entry> lru_;
+    std::unordered_map<peer::PeerId, std::list<Entry>::iterator> index_;
+  };
+
+}  // namespace libp2p::security::tls_details
+
+#endif  // LIBP2P_SECURITY_TLS_SESSION_CACHE_HPP
@@ -0,0 +1,203 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_connection.hpp>
+
+#include <boost/asio/post.hpp>
+
+namespace libp2p::transport {
+
+  MemoryConnection::MemoryConnection(boost::asio::io_context &context,
+                                     multi::Multiaddress local,
+                                     multi::Multiaddress remote,
+                                     bool initiator)
+      : context_(context),
+        local_(std::move(local)),
+        remote_(std::move(remote)),
+        initiator_(initiator),
+        inbound_(kInitialBufferSize) {}
+
+  MemoryConnection::~MemoryConnection() {
+    if (!closed_by_host_) {
+      if (auto peer = peer_.lock(); peer) {
+        peer->onPeerClosed();
+      }
+    }
+  }
+
+  MemoryConnection::ConnectionPair MemoryConnection::makePair(
+      boost::asio::io_context &context,
+      const multi::Multiaddress &initiator_address,
+      const multi::Multiaddress &acceptor_address) {
+    auto initiator = std::make_shared<MemoryConnection>(
+        context, initiator_address, acceptor_address, true);
+    auto acceptor = std::make_shared<MemoryConnection>(
+        context, acceptor_address, initiator_address, false);
+    initiator->peer_ = acceptor;
+    acceptor->peer_ = initiator;
+    return {std::move(initiator), std::move(acceptor)};
+  }
+
+  template <typename Callback, typename Arg>
+  void MemoryConnection::post(Callback cb, Arg arg) {
+    boost::asio::post(context_, [self{shared_from_this()}, cb{std::move(cb)},
+                                 arg{std::move(arg)}]() { cb(arg); });
+  }
+
+  void MemoryConnection::read(gsl::span<uint8_t> out, size_t bytes,
+                              ReadCallbackFunc cb) {
+    doRead(out, bytes, false, std::move(cb));
+  }
+
+  void MemoryConnection::readSome(gsl::span<uint8_t> out, size_t bytes,
+                                  ReadCallbackFunc cb) {
+    doRead(out, bytes, true, std::move(cb));
+  }
+
+  void MemoryConnection::doRead(gsl::span<uint8_t> out, size_t bytes,
+                                bool some, ReadCallbackFunc cb) {
+    if (closed_by_host_) {
+      return post(std::move(cb), outcome::result<size_t>(
+                                     Error::CONNECTION_CLOSED_BY_HOST));
+    }
+    if (bytes > static_cast<size_t>(out.size())) {
+      return post(std::move(cb), outcome::result<size_t>(
+                                     Error::CONNECTION_INVALID_ARGUMENT));
+    }
+    if (pending_read_) {
+      // like a socket, does not allow concurrent reads
+      return post(std::move(cb), outcome::result<size_t>(
+                                     Error::CONNECTION_INTERNAL_ERROR));
+    }
+    pending_read_ = PendingRead{out, bytes, 0, some, std::move(cb)};
+    processPendingRead();
+  }
+
+  void MemoryConnection::processPendingRead() {
+    if (!pending_read_) {
+      return;
+    }
+    auto &op = pending_read_.value();
+
+    auto n = std::min(inbound_.size(), op.bytes - op.done);
+    std::copy_n(inbound_.begin(), n, op.out.begin() + op.done);
+    inbound_.erase_begin(n);
+    op.done += n;
+
+    if (op.done == op.bytes || (op.some && op.done > 0)) {
+      return completePendingRead(op.done);
+    }
+    if (closed_by_peer_) {
+      completePendingRead(Error::CONNECTION_CLOSED_BY_PEER);
+    }
+  }
+
+  void MemoryConnection::completePendingRead(outcome::result<size_t> res) {
+    if (!pending_read_) {
+      return;
+    }
+    auto cb = std::move(pending_read_->cb);
+    pending_read_.reset();
+    post(std::move(cb), res);
+  }
+
+  void MemoryConnection::deferReadCallback(outcome::result<size_t> res,
+                                           ReadCallbackFunc cb) {
+    boost::asio::post(context_, [wptr{weak_from_this()}, cb{std::move(cb)},
+                                 res]() {
+      auto self = wptr.lock();
+      if (self && !self->closed_by_host_) {
+        cb(res);
+      }
+    });
+  }
+
+  void MemoryConnection::write(gsl::span<const uint8_t> in, size_t bytes,
+                               WriteCallbackFunc cb) {
+    // inbound buffers are unbounded, so write never blocks and
+    // writeSome always writes everything
+    writeSome(in, bytes, std::move(cb));
+  }
+
+  void MemoryConnection::writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                                   WriteCallbackFunc cb) {
+    if (closed_by_host_) {
+      return post(std::move(cb), outcome::result<size_t>(
+                                     Error::CONNECTION_CLOSED_BY_HOST));
+    }
+    if (bytes > static_cast<size_t>(in.size())) {
+      return post(std::move(cb), outcome::result<size_t>(
+                                     Error::CONNECTION_INVALID_ARGUMENT));
+    }
+    auto peer = peer_.lock();
+    if (!peer || closed_by_peer_) {
+      return post(std::move(cb), outcome::result<size_t>(
+                                     Error::CONNECTION_CLOSED_BY_PEER));
+    }
+    peer->onPeerData(in.first(bytes));
+    post(std::move(cb), outcome::result<size_t>(bytes));
+  }
+
+  void MemoryConnection::deferWriteCallback(std::error_code ec,
+                                            WriteCallbackFunc cb) {
+    boost::asio::post(context_, [wptr{weak_from_this()}, cb{std::move(cb)},
+                                 ec]() {
+      auto self = wptr.lock();
+      if (self && !self->closed_by_host_) {
+        cb(ec);
+      }
+    });
+  }
+
+  void MemoryConnection::onPeerData(gsl::span<const uint8_t> data) {
+    if (closed_by_host_) {
+      return;
+    }
+    auto required = inbound_.size() + static_cast<size_t>(data.size());
+    if (required > inbound_.capacity()) {
+      inbound_.set_capacity(std::max(required, inbound_.capacity() * 2));
+    }
+    inbound_.insert(inbound_.end(), data.begin(), data.end());
+    processPendingRead();
+  }
+
+  void MemoryConnection::onPeerClosed() {
+    closed_by_peer_ = true;
+    peer_.reset();
+    processPendingRead();
+  }
+
+  outcome::result<multi::Multiaddress> MemoryConnection::remoteMultiaddr() {
+    return remote_;
+  }
+
+  outcome::result<multi::Multiaddress> MemoryConnection::localMultiaddr() {
+    return local_;
+  }
+
+  bool MemoryConnection::isInitiator() const noexcept {
+    return initiator_;
+  }
+
+  outcome::result<void> MemoryConnection::close() {
+    if (closed_by_host_) {
+      return outcome::success();
+    }
+    closed_by_host_ = true;
+    inbound_.clear();
+    completePendingRead(Error::CONNECTION_CLOSED_BY_HOST);
+    if (auto peer = peer_.lock(); peer) {
+      peer->onPeerClosed();
+    }
+    peer_.reset();
+    return outcome::success();
+  }
+
+  bool MemoryConnection::isClosed() const {
+    // data sent by the peer before closing is still readable
+    return closed_by_host_ || (closed_by_peer_ && inbound_.empty());
+  }
+
+}  // namespace libp2p::transport
@@ -0,0 +1,129 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_listener.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/asio/post.hpp>
+#include <libp2p/transport/impl/upgrader_session.hpp>
+
+namespace libp2p::transport {
+
+  namespace {
+    /// Process-wide table of active memory listeners
+    struct Registry {
+      /// Ids which are given to dialers' sides of connections and to
+      /// listeners bound to /memory/0
+      static constexpr uint64_t kFirstEphemeralId = 1ull << 48;
+
+      std::mutex mutex;
+      std::unordered_map<uint64_t, std::weak_ptr<MemoryListener>> listeners;
+      uint64_t next_ephemeral_id = kFirstEphemeralId;
+
+      uint64_t nextEphemeralId() {
+        std::lock_guard lock(mutex);
+        return next_ephemeral_id++;
+      }
+    };
+
+    Registry &registry() {
+      static Registry instance;
+      return instance;
+    }
+  }  // namespace
+
+  MemoryListener::MemoryListener(boost::asio::io_context &context,
+                                 std::shared_ptr<Upgrader> upgrader,
+                                 TransportListener::HandlerFunc handler)
+      : context_(context),
+        upgrader_(std::move(upgrader)),
+        handle_(std::move(handler)) {}
+
+  MemoryListener::~MemoryListener() {
+    std::ignore = close();
+  }
+
+  outcome::result<void> MemoryListener::listen(
+      const multi::Multiaddress &address) {
+    if (!canListen(address)) {
+      return std::errc::address_family_not_supported;
+    }
+    if (id_) {
+      return std::errc::already_connected;
+    }
+    OUTCOME_TRY(id, detail::getMemoryId(address));
+
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+    if (id == 0) {
+      id = reg.next_ephemeral_id++;
+    }
+    auto &entry = reg.listeners[id];
+    if (!entry.expired()) {
+      return std::errc::address_in_use;
+    }
+    entry = weak_from_this();
+    id_ = id;
+    return outcome::success();
+  }
+
+  bool MemoryListener::canListen(const multi::Multiaddress &ma) const {
+    return detail::supportsMemory(ma);
+  }
+
+  outcome::result<multi::Multiaddress> MemoryListener::getListenMultiaddr()
+      const {
+    if (!id_) {
+      return std::errc::not_connected;
+    }
+    return detail::makeMemoryAddress(*id_);
+  }
+
+  bool MemoryListener::isClosed() const {
+    return !id_;
+  }
+
+  outcome::result<void> MemoryListener::close() {
+    if (!id_) {
+      return outcome::success();
+    }
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+    reg.listeners.erase(*id_);
+    id_.reset();
+    return outcome::success();
+  }
+
+  std::shared_ptr<MemoryListener> MemoryListener::find(uint64_t id) {
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+    auto it = reg.listeners.find(id);
+    if (it == reg.listeners.end()) {
+      return nullptr;
+    }
+    return it->second.lock();
+  }
+
+  std::shared_ptr<MemoryConnection> MemoryListener::accept() {
+    if (!id_) {
+      return nullptr;
+    }
+    auto [initiator, acceptor] = MemoryConnection::makePair(
+        context_, detail::makeMemoryAddress(registry().nextEphemeralId()),
+        detail::makeMemoryAddress(*id_));
+
+    boost::asio::post(context_, [self{shared_from_this()},
+                                 conn{std::move(acceptor)}]() mutable {
+      auto session = std::make_shared<UpgraderSession>(
+          self->upgrader_, std::move(conn), self->handle_);
+      session->secureInbound();
+    });
+
+    return initiator;
+  }
+
+}  // namespace libp2p::transport
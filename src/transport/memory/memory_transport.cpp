@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/transport/memory/memory_transport.hpp>
+
+#include <boost/asio/post.hpp>
+#include <libp2p/transport/impl/upgrader_session.hpp>
+
+namespace libp2p::transport {
+
+  MemoryTransport::MemoryTransport(
+      std::shared_ptr<boost::asio::io_context> context,
+      std::shared_ptr<Upgrader> upgrader)
+      : context_(std::move(context)), upgrader_(std::move(upgrader)) {}
+
+  void MemoryTransport::dial(const peer::PeerId &remoteId,
+                             multi::Multiaddress address,
+                             TransportAdaptor::HandlerFunc handler) {
+    dial(remoteId, std::move(address), std::move(handler),
+         std::chrono::milliseconds::zero());
+  }
+
+  void MemoryTransport::dial(const peer::PeerId &remoteId,
+                             multi::Multiaddress address,
+                             TransportAdaptor::HandlerFunc handler,
+                             std::chrono::milliseconds /*timeout*/) {
+    // in-process connection is established immediately, so timeout is
+    // not applicable here
+    boost::asio::post(*context_, [self{shared_from_this()}, remoteId,
+                                  address{std::move(address)},
+                                  handler{std::move(handler)}]() mutable {
+      auto id = detail::getMemoryId(address);
+      if (!id) {
+        return handler(id.error());
+      }
+      auto listener = MemoryListener::find(id.value());
+      auto conn = listener ? listener->accept() : nullptr;
+      if (!conn) {
+        return handler(std::errc::connection_refused);
+      }
+      auto session = std::make_shared<UpgraderSession>(
+          self->upgrader_, std::move(conn), std::move(handler));
+      session->secureOutbound(remoteId);
+    });
+  }
+
+  std::shared_ptr<TransportListener> MemoryTransport::createListener(
+      TransportListener::HandlerFunc handler) {
+    return std::make_shared<MemoryListener>(*context_, upgrader_,
+                                            std::move(handler));
+  }
+
+  bool MemoryTransport::canDial(const multi::Multiaddress &ma) const {
+    return detail::supportsMemory(ma);
+  }
+
+  peer::Protocol MemoryTransport::getProtocolId() const {
+    return "/memory/1.0.0";
+  }
+
+}  // namespace libp2p::transport
@@ -0,0 +1,192 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <deque>
+#include <string>
+
+#include <libp2p/basic/coroutine.hpp>
+#include <libp2p/basic/readwriter.hpp>
+
+using libp2p::outcome::result;
+
+namespace {
+
+  /// Stream which reads given bytes in chunks and collects written bytes.
+  /// Callbacks are either called synchronously or posted and called by poll(),
+  /// after reset() they are dropped, as Yamux streams do
+  class FakeStream : public libp2p::basic::ReadWriter {
+   public:
+    FakeStream(std::string data, size_t max_chunk, bool sync)
+        : data_(std::move(data)), max_chunk_(max_chunk), sync_(sync) {}
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      FAIL() << "read() is not expected";
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      auto n = std::min({bytes, max_chunk_, data_.size() - offset_});
+      std::copy_n(data_.begin() + offset_, n, out.begin());
+      offset_ += n;
+      complete(n, std::move(cb));
+    }
+
+    void deferReadCallback(result<size_t> res, ReadCallbackFunc cb) override {
+      posted_.emplace_back([res, cb = std::move(cb)] { cb(res); });
+    }
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override {
+      written.append(in.begin(), in.begin() + bytes);
+      complete(bytes, std::move(cb));
+    }
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override {
+      write(in, bytes, std::move(cb));
+    }
+
+    void deferWriteCallback(std::error_code ec,
+                            WriteCallbackFunc cb) override {
+      deferReadCallback(ec, std::move(cb));
+    }
+
+    void poll() {
+      while (!posted_.empty()) {
+        auto f = std::move(posted_.front());
+        posted_.pop_front();
+        f();
+      }
+    }
+
+    void reset() {
+      reset_ = true;
+      posted_.clear();
+    }
+
+    std::string written;
+
+   private:
+    void complete(size_t n, std::function<void(result<size_t>)> cb) {
+      if (reset_) {
+        return;
+      }
+      if (sync_) {
+        return cb(n);
+      }
+      deferReadCallback(n, std::move(cb));
+    }
+
+    std::string data_;
+    size_t max_chunk_;
+    bool sync_;
+    size_t offset_ = 0;
+    bool reset_ = false;
+    std::deque<std::function<void()>> posted_;
+  };
+
+  /// Echoes the stream until it is exhausted
+  class Echo : public libp2p::basic::Coroutine<Echo> {
+   public:
+    Echo(std::shared_ptr<FakeStream> stream, bool &destroyed)
+        : stream_(std::move(stream)), destroyed_(destroyed) {}
+
+    ~Echo() {
+      destroyed_ = true;
+    }
+
+    static void start(std::shared_ptr<Echo> self) {
+      self->spawn(self);
+    }
+
+    void resume(result<size_t> res) {
+      BOOST_ASIO_CORO_REENTER(this) {
+        for (;;) {
+          BOOST_ASIO_CORO_YIELD awaitReadSome(*stream_, buf_, buf_.size());
+          if (!res || res.value() == 0) {
+            break;
+          }
+          ++reads;
+          BOOST_ASIO_CORO_YIELD awaitWrite(*stream_, buf_, res.value());
+          if (!res) {
+            break;
+          }
+        }
+      }
+    }
+
+    size_t reads = 0;
+
+   private:
+    std::shared_ptr<FakeStream> stream_;
+    bool &destroyed_;
+    std::array<uint8_t, 4> buf_{};
+  };
+
+}  // namespace
+
+/**
+ * @given stream which completes operations asynchronously
+ * @when echo coroutine is spawned and the only reference is dropped
+ * @then coroutine is alive until the stream is exhausted, all the data is
+ * echoed, then the coroutine is destroyed
+ */
+TEST(Coroutine, AsyncCompletion) {
+  const std::string data = "hello, coroutine";
+  auto stream = std::make_shared<FakeStream>(data, 3, false);
+
+  bool destroyed = false;
+  auto echo = std::make_shared<Echo>(stream, destroyed);
+  std::weak_ptr<Echo> weak = echo;
+  Echo::start(std::move(echo));
+
+  EXPECT_FALSE(destroyed);
+  ASSERT_FALSE(weak.expired());
+  EXPECT_EQ(weak.lock()->reads, 0);
+
+  stream->poll();
+
+  EXPECT_TRUE(destroyed);
+  EXPECT_EQ(stream->written, data);
+}
+
+/**
+ * @given stream which calls back synchronously
+ * @when echo coroutine is spawned
+ * @then the body does not recurse, all the data is echoed and the coroutine
+ * is destroyed before spawn returns
+ */
+TEST(Coroutine, SyncCompletion) {
+  const std::string data(10000, 'x');
+  auto stream = std::make_shared<FakeStream>(data, 1, true);
+
+  bool destroyed = false;
+  auto echo = std::make_shared<Echo>(stream, destroyed);
+  Echo::start(std::move(echo));
+
+  EXPECT_TRUE(destroyed);
+  EXPECT_EQ(stream->written, data);
+}
+
+/**
+ * @given echo coroutine suspended on stream operation
+ * @when the stream is reset and drops the pending callback
+ * @then the coroutine is destroyed
+ */
+TEST(Coroutine, DroppedCallback) {
+  auto stream = std::make_shared<FakeStream>("hello", 3, false);
+
+  bool destroyed = false;
+  Echo::start(std::make_shared<Echo>(stream, destroyed));
+  EXPECT_FALSE(destroyed);
+
+  stream->reset();
+  EXPECT_TRUE(destroyed);
+  EXPECT_TRUE(stream->written.empty());
+}
@@ -0,0 +1,212 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+#include <libp2p/basic/framed_reader.hpp>
+
+using libp2p::outcome::result;
+using libp2p::basic::FramedReader;
+
+namespace {
+
+  /// Reader which serves given bytes in chunks of limited size,
+  /// all the callbacks are posted and called by poll()
+  class ChunkedReader : public libp2p::basic::Reader {
+   public:
+    ChunkedReader(std::vector<uint8_t> data, size_t max_chunk)
+        : data_(std::move(data)), max_chunk_(max_chunk) {}
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      FAIL() << "read() is not expected";
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      ++read_calls;
+      auto n = std::min({bytes, max_chunk_, data_.size() - offset_});
+      std::copy_n(data_.begin() + offset_, n, out.begin());
+      offset_ += n;
+      deferReadCallback(n, std::move(cb));
+    }
+
+    void deferReadCallback(result<size_t> res, ReadCallbackFunc cb) override {
+      posted_.emplace_back([res, cb = std::move(cb)] { cb(res); });
+    }
+
+    void poll() {
+      while (!posted_.empty()) {
+        auto f = std::move(posted_.front());
+        posted_.pop_front();
+        f();
+      }
+    }
+
+    size_t read_calls = 0;
+
+   private:
+    std::vector<uint8_t> data_;
+    size_t max_chunk_;
+    size_t offset_ = 0;
+    std::deque<std::function<void()>> posted_;
+  };
+
+  void appendFrame(std::vector<uint8_t> &out, const std::string &frame) {
+    auto size = frame.size();
+    do {
+      uint8_t byte = size & 0x7f;
+      size >>= 7;
+      out.push_back(size != 0 ? (byte | 0x80) : byte);
+    } while (size != 0);
+    out.insert(out.end(), frame.begin(), frame.end());
+  }
+
+  /// Reads frames until error, collects them
+  void readAll(std::shared_ptr<FramedReader> reader,
+               std::vector<std::string> &frames, std::error_code &error) {
+    reader->read([reader, &frames, &error](result<FramedReader::Frame> res) {
+      if (!res) {
+        error = res.error();
+        return;
+      }
+      frames.emplace_back(res.value().begin(), res.value().end());
+      readAll(reader, frames, error);
+    });
+  }
+
+}  // namespace
+
+class FramedReaderTest : public testing::TestWithParam<size_t> {};
+
+/**
+ * @given frames of different sizes incl. empty and larger than read-ahead
+ * buffer, stream returns them in chunks of various sizes
+ * @when frames are read one by one until stream ends
+ * @then all the frames are delivered intact, then STREAM_CLOSED is reported
+ */
+TEST_P(FramedReaderTest, ReadsAllFrames) {
+  std::vector<std::string> expected{"a", "", std::string(300, 'b'), "cde",
+                                    std::string(5000, 'f'), "g"};
+  std::vector<uint8_t> data;
+  for (const auto &f : expected) {
+    appendFrame(data, f);
+  }
+
+  auto stream = std::make_shared<ChunkedReader>(data, GetParam());
+  auto reader = std::make_shared<FramedReader>(stream, 10000, 64);
+
+  std::vector<std::string> frames;
+  std::error_code error;
+  readAll(reader, frames, error);
+  stream->poll();
+
+  EXPECT_EQ(frames, expected);
+  EXPECT_EQ(error, FramedReader::Error::STREAM_CLOSED);
+}
+
+INSTANTIATE_TEST_CASE_P(ChunkSizes, FramedReaderTest,
+                        testing::Values(1, 2, 7, 64, 1000, 100000));
+
+/**
+ * @given many small frames received in one chunk
+ * @when they are read
+ * @then stream is read once per buffer, not per frame or byte
+ */
+TEST(FramedReader, SeveralFramesPerRead) {
+  std::vector<uint8_t> data;
+  for (int i = 0; i < 100; ++i) {
+    appendFrame(data, "frame");
+  }
+
+  auto stream = std::make_shared<ChunkedReader>(data, data.size());
+  auto reader = std::make_shared<FramedReader>(stream, 100, data.size());
+
+  std::vector<std::string> frames;
+  std::error_code error;
+  readAll(reader, frames, error);
+  stream->poll();
+
+  EXPECT_EQ(frames.size(), 100);
+  EXPECT_EQ(stream->read_calls, 2);
+}
+
+/**
+ * @given frame which length exceeds the limit
+ * @when it is read
+ * @then FRAME_TOO_LONG is reported without reading the frame body
+ */
+TEST(FramedReader, FrameTooLong) {
+  std::vector<uint8_t> data;
+  appendFrame(data, std::string(1000, 'x'));
+
+  auto stream = std::make_shared<ChunkedReader>(data, 2);
+  auto reader = std::make_shared<FramedReader>(stream, 999);
+
+  std::vector<std::string> frames;
+  std::error_code error;
+  readAll(reader, frames, error);
+  stream->poll();
+
+  EXPECT_TRUE(frames.empty());
+  EXPECT_EQ(error, FramedReader::Error::FRAME_TOO_LONG);
+  EXPECT_EQ(stream->read_calls, 1);
+}
+
+/**
+ * @given length prefix which overflows uint64
+ * @when it is read
+ * @then BAD_LENGTH_PREFIX is reported
+ */
+TEST(FramedReader, BadLengthPrefix) {
+  std::vector<uint8_t> data(11, 0xff);
+
+  auto stream = std::make_shared<ChunkedReader>(data, data.size());
+  auto reader = std::make_shared<FramedReader>(stream, 100);
+
+  std::vector<std::string> frames;
+  std::error_code error;
+  readAll(reader, frames, error);
+  stream->poll();
+
+  EXPECT_EQ(error, FramedReader::Error::BAD_LENGTH_PREFIX);
+}
+
+/**
+ * @given read operation in progress
+ * @when another read is called
+ * @then the second one fails with READ_IN_PROGRESS, the first one completes
+ */
+TEST(FramedReader, ReadInProgress) {
+  std::vector<uint8_t> data;
+  appendFrame(data, "frame");
+
+  auto stream = std::make_shared<ChunkedReader>(data, data.size());
+  auto reader = std::make_shared<FramedReader>(stream, 100);
+
+  boost::optional<result<std::string>> first;
+  boost::optional<result<std::string>> second;
+  auto to_string = [](result<FramedReader::Frame> res) -> result<std::string> {
+    if (!res) {
+      return res.error();
+    }
+    return std::string(res.value().begin(), res.value().end());
+  };
+  reader->read([&](auto res) { first = to_string(res); });
+  reader->read([&](auto res) { second = to_string(res); });
+  EXPECT_FALSE(first);
+  EXPECT_FALSE(second);
+
+  stream->poll();
+
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->value(), "frame");
+  ASSERT_TRUE(second);
+  EXPECT_EQ(second->error(), FramedReader::Error::READ_IN_PROGRESS);
+}
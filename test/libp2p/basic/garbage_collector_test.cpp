@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/basic/garbage_collector.hpp>
+
+#include <gtest/gtest.h>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+
+#include "testutil/async/manual_scheduler_backend.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace libp2p::basic;
+
+namespace {
+  /// Collects given number of garbage entries incrementally
+  struct GarbageStub : public GarbageCollectable {
+    void collectGarbage() override {
+      garbage = 0;
+    }
+
+    bool collectSomeGarbage(size_t budget) override {
+      ++steps;
+      garbage -= std::min(budget, garbage);
+      return garbage == 0;
+    }
+
+    size_t garbage = 0;
+    size_t steps = 0;
+  };
+}  // namespace
+
+class GarbageCollectorTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  std::shared_ptr<ManualSchedulerBackend> backend =
+      std::make_shared<ManualSchedulerBackend>();
+  std::shared_ptr<Scheduler> scheduler =
+      std::make_shared<SchedulerImpl>(backend, Scheduler::Config{});
+  GarbageCollector::Config config{std::chrono::milliseconds(100), 10};
+};
+
+/**
+ * @given garbage collector with 2 collectables
+ * @when interval passes
+ * @then garbage is collected in steps of limited budget, each collectable
+ * is called until it has no more garbage
+ */
+TEST_F(GarbageCollectorTest, CollectsInSteps) {
+  auto a = std::make_shared<GarbageStub>();
+  auto b = std::make_shared<GarbageStub>();
+  a->garbage = 25;
+  b->garbage = 5;
+
+  GarbageCollector gc(scheduler, config);
+  gc.add(a);
+  gc.add(b);
+  gc.start();
+
+  backend->shift(std::chrono::milliseconds(50));
+  ASSERT_EQ(a->steps, 0);
+
+  backend->shift(std::chrono::milliseconds(50));
+  ASSERT_EQ(a->garbage, 0);
+  ASSERT_EQ(a->steps, 3);
+  ASSERT_EQ(b->steps, 1);
+
+  // the next pass
+  a->garbage = 5;
+  backend->shift(std::chrono::milliseconds(100));
+  ASSERT_EQ(a->steps, 4);
+  ASSERT_EQ(b->steps, 2);
+}
+
+/**
+ * @given garbage collector with collectable destroyed
+ * @when interval passes
+ * @then other collectables are collected
+ */
+TEST_F(GarbageCollectorTest, ExpiredCollectable) {
+  auto a = std::make_shared<GarbageStub>();
+  auto b = std::make_shared<GarbageStub>();
+
+  GarbageCollector gc(scheduler, config);
+  gc.add(a);
+  gc.add(b);
+  gc.start();
+
+  a.reset();
+  backend->shift(std::chrono::milliseconds(100));
+  ASSERT_EQ(b->steps, 1);
+}
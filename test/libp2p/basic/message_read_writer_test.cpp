@@ -84,3 +84,22 @@ TEST_F(MessageReadWriterTest, Write) {
 
   ASSERT_TRUE(operation_completed_);
 }
+
+TEST_F(MessageReadWriterTest, WriteSerialized) {
+  EXPECT_CALL(*conn_mock_, write(_, kMsgLength + 1, _))
+      .WillOnce(CheckWrite(msg_with_varint_bytes_, len_varint_));
+
+  msg_rw_->writeSerialized(
+      kMsgLength,
+      [this](gsl::span<uint8_t> out) {
+        ASSERT_EQ(out.size(), kMsgLength);
+        std::copy(msg_bytes_.begin(), msg_bytes_.end(), out.begin());
+      },
+      [this](auto &&res) {
+        ASSERT_TRUE(res);
+        ASSERT_EQ(res.value(), msg_bytes_.size());
+        operation_completed_ = true;
+      });
+
+  ASSERT_TRUE(operation_completed_);
+}
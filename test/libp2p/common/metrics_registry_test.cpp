@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/common/metrics/prometheus.hpp>
+#include <libp2p/common/metrics/registry.hpp>
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using libp2p::metrics::Registry;
+using libp2p::metrics::toPrometheusText;
+
+/**
+ * @given counter updated from several threads
+ * @when its value is read
+ * @then it is the sum of all the increments
+ */
+TEST(MetricsRegistry, CounterIsShardedPerThread) {
+  Registry registry;
+  auto &counter = registry.counter("requests_total", "Requests");
+  constexpr size_t kThreads = 4;
+  constexpr size_t kIncrements = 10000;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (size_t i = 0; i < kIncrements; ++i) {
+        counter.inc();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(counter.value(), kThreads * kIncrements);
+}
+
+/**
+ * @given registry
+ * @when the same metric is requested twice
+ * @then the same instance is returned, different labels give different
+ * instances
+ */
+TEST(MetricsRegistry, SameNameAndLabelsGiveSameMetric) {
+  Registry registry;
+  auto &a = registry.counter("x_total", "X", {{"k", "a"}});
+  auto &a2 = registry.counter("x_total", "X", {{"k", "a"}});
+  auto &b = registry.counter("x_total", "X", {{"k", "b"}});
+  EXPECT_EQ(&a, &a2);
+  EXPECT_NE(&a, &b);
+}
+
+/**
+ * @given registry with counter, gauge and histogram
+ * @when exported to prometheus text format
+ * @then output contains help, type and all the series in order
+ */
+TEST(MetricsRegistry, PrometheusText) {
+  Registry registry;
+  registry.counter("bytes_total", "Bytes \\ sent", {{"proto", "/a\"b"}})
+      .inc(42);
+  auto &gauge = registry.gauge("queue_depth", "Queue depth");
+  gauge.inc(5);
+  gauge.dec(2);
+  auto &histogram =
+      registry.histogram("latency_seconds", "Latency", {0.3, 1});
+  histogram.observe(0.25);
+  histogram.observe(0.5);
+  histogram.observe(2.0);
+
+  EXPECT_EQ(histogram.count(), 3);
+
+  EXPECT_EQ(toPrometheusText(registry),
+            "# HELP bytes_total Bytes \\\\ sent\n"
+            "# TYPE bytes_total counter\n"
+            "bytes_total{proto=\"/a\\\"b\"} 42\n"
+            "# HELP latency_seconds Latency\n"
+            "# TYPE latency_seconds histogram\n"
+            "latency_seconds_bucket{le=\"0.3\"} 1\n"
+            "latency_seconds_bucket{le=\"1\"} 2\n"
+            "latency_seconds_bucket{le=\"+Inf\"} 3\n"
+            "latency_seconds_sum 2.75\n"
+            "latency_seconds_count 3\n"
+            "# HELP queue_depth Queue depth\n"
+            "# TYPE queue_depth gauge\n"
+            "queue_depth 3\n");
+}
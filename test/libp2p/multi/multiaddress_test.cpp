@@ -5,6 +5,8 @@
 
 #include <libp2p/multi/multiaddress.hpp>
 
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -259,3 +261,108 @@ TEST_F(MultiaddressTest, DnsAndIpfs) {
   ASSERT_EQ(peer_id_opt.value(),
             "12D3KooWDgtynm4S9M3m6ZZhXYu2RrWKdvkCSScc25xKDVSg1Sjd");
 }
+
+/**
+ * @given bytes with truncated value or varint
+ * @when creating a multiaddress from them
+ * @then creation fails
+ */
+TEST_F(MultiaddressTest, CreateFromTruncatedBytes) {
+  // ip4 with 3 bytes of address
+  ASSERT_FALSE(Multiaddress::create("04C0A800"_unhex));
+  // unterminated protocol code varint
+  ASSERT_FALSE(Multiaddress::create("A5"_unhex));
+  // dns4 with length 10 and only 2 bytes of name
+  ASSERT_FALSE(Multiaddress::create("360A6162"_unhex));
+  // dns4 with invalid character in name
+  ASSERT_FALSE(Multiaddress::create("3603612F62"_unhex));
+}
+
+/**
+ * @given addresses, which are equal in binary form, but written differently
+ * @when comparing and hashing them
+ * @then they are equal and have the same string form
+ */
+TEST_F(MultiaddressTest, CompareAndHashBytes) {
+  auto p2p =
+      "/p2p/12D3KooWDgtynm4S9M3m6ZZhXYu2RrWKdvkCSScc25xKDVSg1Sjd"_multiaddr;
+  auto ipfs =
+      "/ipfs/12D3KooWDgtynm4S9M3m6ZZhXYu2RrWKdvkCSScc25xKDVSg1Sjd/"_multiaddr;
+  ASSERT_EQ(p2p, ipfs);
+  ASSERT_FALSE(p2p < ipfs);
+  ASSERT_FALSE(ipfs < p2p);
+  ASSERT_EQ(std::hash<Multiaddress>()(p2p), std::hash<Multiaddress>()(ipfs));
+  ASSERT_EQ(ipfs.getStringAddress(), p2p.getStringAddress());
+
+  auto tcp = "/ip4/192.168.0.1/tcp/228"_multiaddr;
+  auto udp = "/ip4/192.168.0.1/udp/228"_multiaddr;
+  ASSERT_NE(tcp, udp);
+  ASSERT_NE(tcp < udp, udp < tcp);
+}
+
+/**
+ * @given address with rendered string
+ * @when it is encapsulated and decapsulated
+ * @then the string follows the bytes
+ */
+TEST_F(MultiaddressTest, StringFollowsBytes) {
+  auto address = "/ip4/192.168.0.1"_multiaddr;
+  ASSERT_EQ(address.getStringAddress(), "/ip4/192.168.0.1");
+  auto copy = address;
+
+  address.encapsulate("/tcp/228/ws"_multiaddr);
+  ASSERT_EQ(address.getStringAddress(), "/ip4/192.168.0.1/tcp/228/ws");
+  ASSERT_EQ(copy.getStringAddress(), "/ip4/192.168.0.1");
+
+  ASSERT_TRUE(address.decapsulate(Protocol::Code::TCP));
+  ASSERT_EQ(address.getStringAddress(), "/ip4/192.168.0.1");
+  ASSERT_EQ(address, copy);
+}
+
+/**
+ * @given address created from bytes, without rendered string
+ * @when it is rendered and copied from several threads at once
+ * @then all the threads get the same string
+ */
+TEST_F(MultiaddressTest, StringRenderedConcurrently) {
+  EXPECT_OUTCOME_TRUE(address, Multiaddress::create(valid_ip_udp_bytes));
+
+  std::vector<std::thread> threads;
+  std::vector<std::string> results(4);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i] {
+      auto copy = address;
+      results[i] =
+          i % 2 == 0 ? address.getStringAddress() : copy.getStringAddress();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &result : results) {
+    ASSERT_EQ(result, valid_ip_udp);
+  }
+
+  auto moved = std::move(address);
+  ASSERT_EQ(moved.getStringAddress(), valid_ip_udp);
+}
+
+/**
+ * @given address, which has a value equal to a protocol name
+ * @when getting its protocols
+ * @then only protocols are returned
+ */
+TEST_F(MultiaddressTest, ValueLooksLikeProtocol) {
+  auto address = "/dns4/tcp/tcp/1"_multiaddr;
+  ASSERT_THAT(address.getProtocolsWithValues(),
+              ::testing::ElementsAre(
+                  std::make_pair(*ProtocolList::get("dns4"), "tcp"),
+                  std::make_pair(*ProtocolList::get("tcp"), "1")));
+  ASSERT_EQ(address.getProtocols().size(), 2);
+  ASSERT_EQ(address.getValuesForProtocol(Protocol::Code::TCP),
+            std::vector<std::string>{"1"});
+  auto [first, rest] = address.splitFirst();
+  ASSERT_EQ(first.getStringAddress(), "/dns4/tcp");
+  ASSERT_TRUE(rest);
+  ASSERT_EQ(rest->getStringAddress(), "/tcp/1");
+}
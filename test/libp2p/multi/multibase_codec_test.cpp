@@ -5,6 +5,8 @@
 
 #include <libp2p/multi/multibase_codec/multibase_codec_impl.hpp>
 
+#include <libp2p/multi/multibase_codec/codecs/base58.hpp>
+
 #include <gtest/gtest.h>
 #include <libp2p/common/literals.hpp>
 #include <libp2p/common/types.hpp>
@@ -388,6 +390,18 @@ TEST_F(Base58Encoding, SkipsWhitespacesFailure) {
   ASSERT_FALSE(error.has_value());
 }
 
+/**
+ * @given base58-encoded string view, which is a part of a longer string
+ * @when decoding it
+ * @then only the characters of the view are decoded
+ */
+TEST_F(Base58Encoding, DecodesOnlyView) {
+  constexpr std::string_view str{"2gNotBase58"};
+  auto decoded = detail::decodeBase58(str.substr(0, 2));
+  ASSERT_TRUE(decoded);
+  ASSERT_EQ(decoded.value(), "61"_unhex);
+}
+
 class Base64Encoding : public MultibaseCodecTest {
  public:
   MultibaseCodec::Encoding encoding = MultibaseCodec::Encoding::BASE64;
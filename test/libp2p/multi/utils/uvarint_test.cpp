@@ -101,3 +101,26 @@ TEST(UVaring, DecodeOverflowFailure) {
   auto var = UVarint::create(overflow_encoded_data);
   ASSERT_FALSE(var);
 }
+
+/**
+ * @given Integers which need from 1 to 10 bytes to be encoded
+ * @when Encoding them into preallocated buffer
+ * @then Size and bytes are the same as of UVarint instance
+ */
+TEST(UVarint, EncodeIntoBuffer) {
+  std::vector<uint64_t> values{0, 1, 127, 128, 300, 16383, 16384};
+  for (uint64_t x = 1; x < std::numeric_limits<uint64_t>::max() / 128;) {
+    x *= 128;
+    values.push_back(x - 1);
+    values.push_back(x);
+  }
+  values.push_back(std::numeric_limits<uint64_t>::max());
+
+  for (auto value : values) {
+    UVarint var{value};
+    std::vector<uint8_t> buffer(UVarint::encodedSize(value));
+    ASSERT_EQ(buffer.size(), var.size());
+    ASSERT_EQ(UVarint::encode(value, buffer), var.size());
+    ASSERT_EQ(buffer, var.toVector());
+  }
+}
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/muxer/mplex/mplex_reading_state.hpp"
+
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+
+using namespace libp2p::connection;
+using namespace libp2p::common;
+
+using Flag = MplexFrame::Flag;
+
+class MplexFrameTest : public ::testing::Test {
+ public:
+  ~MplexFrameTest() override = default;
+
+  /// Frames as they are received: header and all data fragments joined
+  struct Received {
+    Flag flag;
+    MplexStream::StreamNumber stream_number;
+    MplexFrame::Length length;
+    ByteArray data;
+  };
+
+  std::vector<Received> received;
+  bool error = false;
+
+  /// Accepts data of message frames only, as the connection does
+  MplexReadingState reading_state{
+      [this](libp2p::outcome::result<MplexFrame> header) {
+        if (!header) {
+          error = true;
+          return false;
+        }
+        auto &h = header.value();
+        received.push_back({h.flag, h.stream_number, h.length, {}});
+        if (h.flag != Flag::MESSAGE_INITIATOR
+            && h.flag != Flag::MESSAGE_RECEIVER) {
+          reading_state.discardData();
+        }
+        return true;
+      },
+      [this](gsl::span<const uint8_t> segment) {
+        auto &data = received.back().data;
+        data.insert(data.end(), segment.begin(), segment.end());
+      }};
+
+  /// Frames of a typical stream lifetime
+  ByteArray makeFrames() {
+    ByteArray bytes;
+    appendFrame(bytes, Flag::NEW_STREAM, 1, "6E616D65"_unhex);
+    appendFrame(bytes, Flag::MESSAGE_INITIATOR, 1, "1234456789AB"_unhex);
+    appendFrame(bytes, Flag::MESSAGE_RECEIVER, 300, ByteArray(200, 0x42));
+    appendFrame(bytes, Flag::CLOSE_INITIATOR, 1);
+    return bytes;
+  }
+
+  void checkReceived() {
+    ASSERT_FALSE(error);
+    ASSERT_EQ(received.size(), 4);
+    EXPECT_EQ(received[0].flag, Flag::NEW_STREAM);
+    EXPECT_EQ(received[0].length, 4);
+    EXPECT_TRUE(received[0].data.empty());
+    EXPECT_EQ(received[1].flag, Flag::MESSAGE_INITIATOR);
+    EXPECT_EQ(received[1].stream_number, 1);
+    EXPECT_EQ(received[1].data, "1234456789AB"_unhex);
+    EXPECT_EQ(received[2].flag, Flag::MESSAGE_RECEIVER);
+    EXPECT_EQ(received[2].stream_number, 300);
+    EXPECT_EQ(received[2].length, 200);
+    EXPECT_EQ(received[2].data, ByteArray(200, 0x42));
+    EXPECT_EQ(received[3].flag, Flag::CLOSE_INITIATOR);
+    EXPECT_EQ(received[3].length, 0);
+  }
+};
+
+/**
+ * @given message frame
+ * @when it is serialized
+ * @then the header is stream number and flag varint, then length varint
+ */
+TEST_F(MplexFrameTest, AppendFrame) {
+  ByteArray bytes{0xFF};
+  appendFrame(bytes, Flag::MESSAGE_RECEIVER, 300, "1234"_unhex);
+  EXPECT_EQ(bytes, "FFE112021234"_unhex);
+  EXPECT_EQ(createFrameBytes(Flag::MESSAGE_RECEIVER, 300, "1234"_unhex),
+            "E112021234"_unhex);
+}
+
+/**
+ * @given frames received in one piece
+ * @when they are segmented
+ * @then headers and data of messages are passed, other data is discarded
+ */
+TEST_F(MplexFrameTest, ReadAtOnce) {
+  reading_state.onDataReceived(makeFrames());
+  checkReceived();
+}
+
+/**
+ * @given frames received byte by byte
+ * @when they are segmented
+ * @then the result is the same as if they were received at once
+ */
+TEST_F(MplexFrameTest, ReadByteByByte) {
+  auto bytes = makeFrames();
+  for (auto &byte : bytes) {
+    reading_state.onDataReceived(gsl::span<const uint8_t>(&byte, 1));
+  }
+  checkReceived();
+}
+
+/**
+ * @given frame with unknown flag, or with too long varint
+ * @when they are segmented
+ * @then error is passed to header callback
+ */
+TEST_F(MplexFrameTest, ProtocolError) {
+  reading_state.onDataReceived("0700"_unhex);
+  EXPECT_TRUE(error);
+
+  error = false;
+  reading_state.reset();
+  reading_state.onDataReceived("02FFFFFFFFFFFFFFFFFFFF01"_unhex);
+  EXPECT_TRUE(error);
+}
@@ -0,0 +1,234 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/muxer/yamux/yamux_stream.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/optional.hpp>
+#include "libp2p/muxer/yamux/yamux_frame.hpp"
+#include "mock/libp2p/connection/secure_connection_mock.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace libp2p;              // NOLINT
+using namespace libp2p::connection;  // NOLINT
+using std::chrono_literals::operator""ms;
+
+namespace {
+  constexpr size_t kInitial = YamuxFrame::kInitialWindowSize;
+  constexpr size_t kMaxWindow = 16 * kInitial;
+  constexpr size_t kFrame = YamuxFrame::kMaxDataFrameSize;
+
+  /// Records data frames, window updates and reservations, time and RTT are
+  /// set by test
+  class FeedbackStub : public YamuxStreamFeedback {
+   public:
+    void writeStreamData(uint32_t,
+                         gsl::span<const uint8_t> data,
+                         bool some) override {
+      writes.emplace_back(data.size(), some);
+    }
+
+    void ackReceivedBytes(uint32_t, uint32_t bytes) override {
+      acks.push_back(bytes);
+    }
+
+    void deferCall(std::function<void()>) override {}
+
+    void resetStream(uint32_t) override {}
+
+    void streamClosed(uint32_t) override {}
+
+    outcome::result<void> reserveMemory(size_t) override {
+      return outcome::success();
+    }
+
+    void releaseMemory(size_t) override {}
+
+    outcome::result<void> reserveWindow(size_t bytes) override {
+      if (window_reserved + bytes > window_budget) {
+        return std::make_error_code(std::errc::not_enough_memory);
+      }
+      window_reserved += bytes;
+      return outcome::success();
+    }
+
+    void releaseWindow(size_t bytes) override {
+      window_reserved -= bytes;
+    }
+
+    std::chrono::milliseconds now() const override {
+      return time;
+    }
+
+    std::chrono::milliseconds rtt() const override {
+      return round_trip;
+    }
+
+    void setStreamPriority(uint32_t, Stream::Priority) override {}
+
+    std::vector<std::pair<size_t, bool>> writes;
+    std::vector<uint32_t> acks;
+    size_t window_reserved = 0;
+    size_t window_budget = kMaxWindow;
+    std::chrono::milliseconds time{1000};
+    std::chrono::milliseconds round_trip{50};
+  };
+}  // namespace
+
+class YamuxWindowTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    stream = std::make_shared<YamuxStream>(
+        std::make_shared<SecureConnectionMock>(), feedback, 1, kMaxWindow,
+        kMaxWindow);
+  }
+
+  /// Peer sends bytes, the client reads them at once
+  void receiveAndConsume(size_t bytes) {
+    std::vector<uint8_t> data(bytes, 0x42);  // NOLINT
+    ASSERT_EQ(stream->onDataReceived(data), YamuxStream::kKeepStream);
+    stream->readSome(data, data.size(), [](outcome::result<size_t>) {});
+  }
+
+  FeedbackStub feedback;
+  std::shared_ptr<YamuxStream> stream;
+};
+
+/**
+ * @given stream with RTT measured
+ * @when half of the receive window is consumed within a round trip
+ * @then the window is doubled and the growth is sent with window update
+ */
+TEST_F(YamuxWindowTest, GrowsOnFastConsumption) {
+  receiveAndConsume(kInitial / 2);
+  ASSERT_EQ(feedback.acks, std::vector<uint32_t>({kInitial / 2 + kInitial}));
+  ASSERT_EQ(feedback.window_reserved, kInitial);
+}
+
+/**
+ * @given stream with RTT not measured yet
+ * @when half of the receive window is consumed
+ * @then consumed bytes are returned to peer, the window doesn't grow
+ */
+TEST_F(YamuxWindowTest, NoGrowthWithoutRtt) {
+  feedback.round_trip = {};
+  receiveAndConsume(kInitial / 2);
+  ASSERT_EQ(feedback.acks, std::vector<uint32_t>({kInitial / 2}));
+  ASSERT_EQ(feedback.window_reserved, 0);
+}
+
+/**
+ * @given stream with RTT measured
+ * @when half of the receive window is consumed slower than in 2 round trips
+ * @then the window doesn't grow
+ */
+TEST_F(YamuxWindowTest, NoGrowthOnSlowConsumption) {
+  feedback.time += 1000ms;
+  receiveAndConsume(kInitial / 2);
+  ASSERT_EQ(feedback.acks, std::vector<uint32_t>({kInitial / 2}));
+}
+
+/**
+ * @given connection window budget exhausted
+ * @when half of the receive window is consumed fast
+ * @then the window doesn't grow
+ */
+TEST_F(YamuxWindowTest, NoGrowthOverBudget) {
+  feedback.window_budget = 0;
+  receiveAndConsume(kInitial / 2);
+  ASSERT_EQ(feedback.acks, std::vector<uint32_t>({kInitial / 2}));
+  ASSERT_EQ(feedback.window_reserved, 0);
+}
+
+/**
+ * @given stream with grown receive window
+ * @when the stream consumes data after idle interval
+ * @then the window shrinks back to initial size by bytes consumed, which are
+ * not returned to peer, and its growth is released
+ */
+TEST_F(YamuxWindowTest, ShrinksWhenIdle) {
+  receiveAndConsume(kInitial / 2);
+  ASSERT_EQ(feedback.window_reserved, kInitial);
+
+  feedback.time += YamuxStream::kWindowIdleInterval;
+  receiveAndConsume(kInitial);
+  ASSERT_EQ(feedback.acks.size(), 1);
+  ASSERT_EQ(feedback.window_reserved, 0);
+
+  // grows again from initial size
+  receiveAndConsume(kInitial / 2);
+  ASSERT_EQ(feedback.acks.size(), 2);
+  ASSERT_EQ(feedback.acks.back(), kInitial / 2 + kInitial);
+}
+
+/**
+ * @given stream with grown receive window and consumed bytes not yet returned
+ * to peer
+ * @when connection checks the stream after idle interval
+ * @then the window shrinks by those bytes without waiting for the next
+ * consumption, and its growth is released
+ */
+TEST_F(YamuxWindowTest, ShrinksIdleOnCheck) {
+  receiveAndConsume(kInitial / 2);
+  receiveAndConsume(kInitial / 4);
+  ASSERT_EQ(feedback.acks.size(), 1);
+  ASSERT_EQ(feedback.window_reserved, kInitial);
+
+  stream->shrinkIdleWindow(feedback.time);
+  ASSERT_EQ(feedback.window_reserved, kInitial);
+
+  feedback.time += YamuxStream::kWindowIdleInterval;
+  stream->shrinkIdleWindow(feedback.time);
+  ASSERT_EQ(feedback.acks.size(), 1);
+  ASSERT_EQ(feedback.window_reserved, kInitial - kInitial / 4);
+}
+
+/**
+ * @given stream with send window larger than a frame
+ * @when more than a frame is written by writeSome()
+ * @then one frame is written, and its acknowledgement completes the write
+ */
+TEST_F(YamuxWindowTest, WriteSomeLimitedToFrame) {
+  std::vector<uint8_t> data(kFrame + kFrame / 2, 0x42);  // NOLINT
+  boost::optional<size_t> written;
+  stream->writeSome(data, data.size(), [&](outcome::result<size_t> res) {
+    ASSERT_TRUE(res);
+    written = res.value();
+  });
+  ASSERT_EQ(feedback.writes,
+            (std::vector<std::pair<size_t, bool>>{{kFrame, true}}));
+
+  stream->onDataWritten(kFrame);
+  ASSERT_EQ(written, kFrame);
+  ASSERT_FALSE(stream->isClosed());
+}
+
+/**
+ * @given stream with send window larger than a frame
+ * @when more than a frame is written by write()
+ * @then data is written in frames, the write completes when all of them are
+ * acknowledged
+ */
+TEST_F(YamuxWindowTest, WriteSplitIntoFrames) {
+  std::vector<uint8_t> data(kFrame + kFrame / 2, 0x42);  // NOLINT
+  boost::optional<size_t> written;
+  stream->write(data, data.size(), [&](outcome::result<size_t> res) {
+    ASSERT_TRUE(res);
+    written = res.value();
+  });
+  ASSERT_EQ(feedback.writes,
+            (std::vector<std::pair<size_t, bool>>{{kFrame, false},
+                                                  {kFrame / 2, false}}));
+
+  stream->onDataWritten(kFrame);
+  ASSERT_FALSE(written);
+  stream->onDataWritten(kFrame / 2);
+  ASSERT_EQ(written, data.size());
+  ASSERT_FALSE(stream->isClosed());
+}
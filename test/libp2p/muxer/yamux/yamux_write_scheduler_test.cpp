@@ -0,0 +1,106 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "libp2p/muxer/yamux/yamux_write_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libp2p::connection;
+
+namespace {
+  constexpr size_t kFrameSize =
+      YamuxWriteScheduler::kQuantum * Stream::kDefaultPriority;
+
+  /// Frame of stream, stream id is kept in item to check the order
+  YamuxWriteScheduler::Item frame(YamuxWriteScheduler::StreamId stream_id,
+                                  size_t size = kFrameSize) {
+    return {YamuxWriteScheduler::Buffer(size), stream_id, false};
+  }
+
+  /// Pops everything, returns stream ids of frames in order of writing
+  std::vector<YamuxWriteScheduler::StreamId> popAll(YamuxWriteScheduler &q) {
+    std::vector<YamuxWriteScheduler::StreamId> order;
+    while (!q.empty()) {
+      order.push_back(q.pop().stream_id);
+    }
+    return order;
+  }
+}  // namespace
+
+/**
+ * @given streams' frames enqueued before control frame
+ * @when frames are dequeued
+ * @then control frame is the first
+ */
+TEST(YamuxWriteSchedulerTest, ControlFramesFirst) {
+  YamuxWriteScheduler q;
+  q.pushStreamFrame(1, frame(1));
+  q.pushStreamFrame(3, frame(3));
+  q.pushControl(frame(0, 12));
+  ASSERT_EQ(q.size(), 3);
+  ASSERT_EQ(popAll(q), std::vector<uint32_t>({0, 1, 3}));
+}
+
+/**
+ * @given bulk stream with many frames and stream with one frame enqueued later
+ * @when frames are dequeued
+ * @then the second stream's frame is written after one frame of bulk stream
+ */
+TEST(YamuxWriteSchedulerTest, RoundRobin) {
+  YamuxWriteScheduler q;
+  for (int i = 0; i < 4; ++i) {
+    q.pushStreamFrame(1, frame(1));
+  }
+  q.pushStreamFrame(3, frame(3));
+  ASSERT_EQ(popAll(q), std::vector<uint32_t>({1, 3, 1, 1, 1}));
+}
+
+/**
+ * @given small frames within a quantum
+ * @when frames are dequeued
+ * @then a stream writes frames up to its quantum in one turn
+ */
+TEST(YamuxWriteSchedulerTest, DeficitAccumulates) {
+  YamuxWriteScheduler q;
+  q.pushStreamFrame(1, frame(1, kFrameSize / 2));
+  q.pushStreamFrame(1, frame(1, kFrameSize / 2));
+  q.pushStreamFrame(1, frame(1, kFrameSize / 2));
+  q.pushStreamFrame(3, frame(3, kFrameSize / 2));
+  ASSERT_EQ(popAll(q), std::vector<uint32_t>({1, 1, 3, 1}));
+}
+
+/**
+ * @given stream with doubled priority
+ * @when frames are dequeued
+ * @then it writes twice as many frames per round as a stream with default
+ * priority
+ */
+TEST(YamuxWriteSchedulerTest, Priorities) {
+  YamuxWriteScheduler q;
+  q.setPriority(1, Stream::kDefaultPriority * 2);
+  for (int i = 0; i < 4; ++i) {
+    q.pushStreamFrame(1, frame(1));
+  }
+  for (int i = 0; i < 2; ++i) {
+    q.pushStreamFrame(3, frame(3));
+  }
+  ASSERT_EQ(popAll(q), std::vector<uint32_t>({1, 1, 3, 1, 1, 3}));
+}
+
+/**
+ * @given data frame header glued to its payload
+ * @when control frame is enqueued after the header was dequeued
+ * @then the payload is written before the control frame
+ */
+TEST(YamuxWriteSchedulerTest, GluedFrames) {
+  YamuxWriteScheduler q;
+  q.pushStreamFrame(1, frame(0, YamuxFrame::kHeaderLength), true);
+  q.pushStreamFrame(1, frame(1));
+  ASSERT_EQ(q.pop().stream_id, 0);
+  q.pushControl(frame(0, 12));
+  ASSERT_EQ(q.pop().stream_id, 1);
+  ASSERT_EQ(q.pop().stream_id, 0);
+  ASSERT_TRUE(q.empty());
+}
@@ -3,8 +3,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
 #include <libp2p/common/literals.hpp>
 #include "libp2p/network/connection_manager.hpp"
 #include "libp2p/network/impl/connection_manager_impl.hpp"
@@ -12,6 +14,7 @@
 #include "libp2p/peer/peer_id.hpp"
 #include "mock/libp2p/connection/capable_connection_mock.hpp"
 #include "mock/libp2p/transport/transport_mock.hpp"
+#include "testutil/async/manual_scheduler_backend.hpp"
 #include "testutil/libp2p/peer.hpp"
 #include "testutil/prepare_loggers.hpp"
 
@@ -21,6 +24,8 @@ using namespace transport;
 using namespace connection;
 using namespace peer;
 using namespace common;
+using basic::ManualSchedulerBackend;
+using basic::SchedulerImpl;
 
 using testing::_;
 using testing::NiceMock;
@@ -47,7 +52,7 @@ struct ConnectionManagerTest : public ::testing::Test {
   std::shared_ptr<libp2p::event::Bus> bus;
   std::shared_ptr<TransportMock> t;
 
-  std::shared_ptr<ConnectionManager> cmgr;
+  std::shared_ptr<ConnectionManagerImpl> cmgr;
 
   peer::PeerId p1 = testutil::randomPeerId();
   peer::PeerId p2 = testutil::randomPeerId();
@@ -56,6 +61,19 @@ struct ConnectionManagerTest : public ::testing::Test {
   std::shared_ptr<CapableConnectionMock> conn11;
   std::shared_ptr<CapableConnectionMock> conn12;
   std::shared_ptr<CapableConnectionMock> conn2;
+
+  /// Recreates manager with trimming config and the same connections
+  void enableTrimming(ConnectionManagerConfig config,
+                      std::shared_ptr<basic::Scheduler> scheduler = nullptr) {
+    cmgr = std::make_shared<ConnectionManagerImpl>(bus, scheduler, config);
+    cmgr->addConnectionToPeer(p1, conn11);
+    cmgr->addConnectionToPeer(p1, conn12);
+    cmgr->addConnectionToPeer(p2, conn2);
+
+    for (auto &conn : {conn11, conn12, conn2}) {
+      EXPECT_CALL(*conn, isClosed()).WillRepeatedly(Return(false));
+    }
+  }
 };
 
 /**
@@ -137,6 +155,140 @@ TEST_F(ConnectionManagerTest, GarbageCollection) {
   ASSERT_EQ(cmgr->getConnectionsToPeer(p3).size(), 0);
 }
 
+/**
+ * @given peer with 2 connections
+ * @when get best connection with default and custom score
+ * @then the oldest connection is the best by default, the one with the
+ * highest score is the best with custom score
+ */
+TEST_F(ConnectionManagerTest, BestConnByScore) {
+  EXPECT_CALL(*conn11, isClosed()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*conn12, isClosed()).WillRepeatedly(Return(false));
+  EXPECT_EQ(cmgr->getBestConnectionForPeer(p1), conn11);
+
+  cmgr->setConnectionScore([this](const ConnectionInfo &info) {
+    return info.connection == conn12 ? 1 : 0;
+  });
+  EXPECT_EQ(cmgr->getBestConnectionForPeer(p1), conn12);
+}
+
+/**
+ * @given 3 peers. p1 has 2 conns, p2 has 1, p3 has 0
+ * @when connections are reported closed
+ * @then they are removed at once, best connection is updated, peer without
+ * connections is reported disconnected
+ */
+TEST_F(ConnectionManagerTest, ClosedConnectionsRemoved) {
+  std::vector<PeerId> disconnected;
+  auto &channel = bus->getChannel<network::event::OnPeerDisconnectedChannel>();
+  auto handle = channel.subscribe(
+      [&](const PeerId &p) { disconnected.push_back(p); });
+
+  EXPECT_CALL(*conn12, isClosed()).WillRepeatedly(Return(false));
+  cmgr->onConnectionClosed(p1, conn11);
+  EXPECT_EQ(cmgr->getConnectionsToPeer(p1).size(), 1);
+  EXPECT_EQ(cmgr->getBestConnectionForPeer(p1), conn12);
+  EXPECT_TRUE(disconnected.empty());
+
+  cmgr->onConnectionClosed(p2, conn2);
+  EXPECT_EQ(cmgr->getBestConnectionForPeer(p2), nullptr);
+  EXPECT_EQ(disconnected, std::vector<PeerId>{p2});
+
+  EXPECT_EQ(cmgr->getConnections().size(), 1);
+}
+
+/**
+ * @given 3 peers. p1 has 2 conns, p2 has 1, p3 has 0
+ * @when visiting connections and peers
+ * @then all connections and connected peers are visited once
+ */
+TEST_F(ConnectionManagerTest, ForEach) {
+  std::vector<ConnectionManager::ConnectionSPtr> conns;
+  cmgr->forEachConnection(
+      [&](const ConnectionManager::ConnectionSPtr &c) { conns.push_back(c); });
+  EXPECT_THAT(conns, testing::UnorderedElementsAre(conn11, conn12, conn2));
+
+  std::vector<PeerId> peers;
+  cmgr->forEachConnectedPeer([&](const PeerId &p) { peers.push_back(p); });
+  EXPECT_THAT(peers, testing::UnorderedElementsAre(p1, p2));
+}
+
+/**
+ * @given 3 connections above the high watermark of 2
+ * @when connections are trimmed down to the low watermark of 1
+ * @then redundant connection to p1 is closed first, then the youngest one
+ */
+TEST_F(ConnectionManagerTest, TrimConnections) {
+  enableTrimming({2, 1, std::chrono::milliseconds::zero()});
+
+  EXPECT_CALL(*conn12, close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conn2, close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conn11, close()).Times(0);
+  EXPECT_EQ(cmgr->trimConnections(), 2);
+}
+
+/**
+ * @given 3 connections above the high watermark, p2 is protected
+ * @when connections are trimmed
+ * @then connections to p2 are not closed, until the protection is removed
+ */
+TEST_F(ConnectionManagerTest, TrimSkipsProtectedPeers) {
+  enableTrimming({2, 1, std::chrono::milliseconds::zero()});
+  cmgr->protectPeer(p2, "a");
+  cmgr->protectPeer(p2, "b");
+  cmgr->unprotectPeer(p2, "a");
+  EXPECT_TRUE(cmgr->isProtected(p2));
+
+  EXPECT_CALL(*conn11, close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conn12, close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conn2, close()).Times(0);
+  EXPECT_EQ(cmgr->trimConnections(), 2);
+
+  cmgr->unprotectPeer(p2, "b");
+  EXPECT_FALSE(cmgr->isProtected(p2));
+}
+
+/**
+ * @given 3 connections above the high watermark
+ * @when connections are trimmed during grace period
+ * @then nothing is closed
+ */
+TEST_F(ConnectionManagerTest, TrimSkipsNewConnections) {
+  enableTrimming({2, 1, std::chrono::hours(1)});
+
+  for (auto &conn : {conn11, conn12, conn2}) {
+    EXPECT_CALL(*conn, close()).Times(0);
+  }
+  EXPECT_EQ(cmgr->trimConnections(), 0);
+}
+
+/**
+ * @given manager driven by scheduler with the high watermark of 3
+ * @when the 4th connection is added
+ * @then trimming is deferred to the scheduler, not done in place, then
+ * redundant and the youngest connections are closed
+ */
+TEST_F(ConnectionManagerTest, TrimScheduledAboveHighWatermark) {
+  auto backend = std::make_shared<ManualSchedulerBackend>();
+  auto scheduler =
+      std::make_shared<SchedulerImpl>(backend, basic::Scheduler::Config{});
+  enableTrimming({3, 2, std::chrono::milliseconds::zero()}, scheduler);
+
+  auto conn3 = std::make_shared<CapableConnectionMock>();
+  EXPECT_CALL(*conn3, isClosed()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*conn12, close()).Times(0);
+  EXPECT_CALL(*conn3, close()).Times(0);
+  cmgr->addConnectionToPeer(p3, conn3);
+  testing::Mock::VerifyAndClearExpectations(conn12.get());
+  testing::Mock::VerifyAndClearExpectations(conn3.get());
+
+  EXPECT_CALL(*conn12, isClosed()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*conn3, isClosed()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*conn12, close()).WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*conn3, close()).WillOnce(Return(outcome::success()));
+  backend->shift(std::chrono::milliseconds(1));
+}
+
 int main(int argc, char *argv[]) {
   if (std::getenv("TRACE_DEBUG") != nullptr) {
     testutil::prepareLoggers(soralog::Level::TRACE);
@@ -0,0 +1,176 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <boost/di/extension/scopes/shared.hpp>
+#include <boost/optional.hpp>
+
+#include <libp2p/injector/host_injector.hpp>
+#include <libp2p/network/impl/resource_manager_impl.hpp>
+
+#include "testutil/prepare_loggers.hpp"
+
+using namespace libp2p;  // NOLINT
+
+namespace {
+  using StreamSPtr = std::shared_ptr<connection::Stream>;
+
+  const peer::Protocol kProtocol = "/resource/test/1.0.0";
+
+  /// Server with the given resource manager and client, connected over TCP
+  /// loopback via Yamux
+  class Hosts {
+   public:
+    explicit Hosts(std::shared_ptr<network::ResourceManager> rm)
+        : io_(std::make_shared<boost::asio::io_context>()),
+          server_(makeHost(
+              boost::di::bind<network::ResourceManager>.to(
+                  std::move(rm))[boost::di::override])),
+          client_(makeHost()) {}
+
+    ~Hosts() {
+      client_->stop();
+      server_->stop();
+      io_->restart();
+      io_->poll();
+    }
+
+    bool start(const multi::Multiaddress &address) {
+      server_->setProtocolHandler(kProtocol, [this](StreamSPtr stream) {
+        accepted_.push_back(std::move(stream));
+      });
+      if (!server_->listen(address)) {
+        return false;
+      }
+      server_->start();
+      client_->start();
+      return true;
+    }
+
+    /// Opens client stream to server, nullptr on failure
+    StreamSPtr openStream() {
+      auto result = std::make_shared<boost::optional<StreamSPtr>>();
+      client_->newStream(server_->getPeerInfo(), kProtocol,
+                         [result](Host::StreamResult r) {
+                           *result = r ? r.value() : nullptr;
+                         });
+      if (!runUntil([&] { return result->has_value(); })) {
+        return nullptr;
+      }
+      auto stream = result->value();
+      if (!stream) {
+        return nullptr;
+      }
+
+      // the server may reset the stream after the client side negotiated it,
+      // so its acceptance is awaited too
+      auto accepted = accepted_.size();
+      runUntil(
+          [&] { return accepted_.size() > accepted || stream->isClosed(); });
+      return stream->isClosed() ? nullptr : stream;
+    }
+
+    void disconnect() {
+      client_->disconnect(server_->getId());
+      runUntil([&] {
+        return server_->getNetwork()
+            .getConnectionManager()
+            .getConnectionsToPeer(client_->getId())
+            .empty();
+      });
+    }
+
+    peer::PeerId clientId() const {
+      return client_->getId();
+    }
+
+   private:
+    template <typename... InjectorArgs>
+    std::shared_ptr<Host> makeHost(InjectorArgs &&...args) {
+      auto injector =
+          injector::makeHostInjector<boost::di::extension::shared_config>(
+              boost::di::bind<boost::asio::io_context>.to(
+                  io_)[boost::di::override],
+              boost::di::bind<muxer::MuxerAdaptor *[]>()  // NOLINT
+                  .template to<muxer::Yamux>()[boost::di::override],
+              std::forward<InjectorArgs>(args)...);
+      return injector.template create<std::shared_ptr<Host>>();
+    }
+
+    template <typename Predicate>
+    bool runUntil(Predicate &&done) {
+      constexpr auto kTimeout = std::chrono::seconds(10);
+      auto deadline = std::chrono::steady_clock::now() + kTimeout;
+      io_->restart();
+      while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          return false;
+        }
+        io_->run_one_for(kTimeout);
+      }
+      return true;
+    }
+
+    std::shared_ptr<boost::asio::io_context> io_;
+    std::shared_ptr<Host> server_;
+    std::shared_ptr<Host> client_;
+    std::vector<StreamSPtr> accepted_;
+  };
+}  // namespace
+
+class ResourceManagerIntegrationTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+};
+
+/**
+ * @given server, which allows 2 muxed streams per peer
+ * @when client opens 3 streams over yamux
+ * @then the third stream is reset by server, the streams reserved are
+ * released when the connection is closed
+ */
+TEST_F(ResourceManagerIntegrationTest, YamuxStreamsPerPeer) {
+  network::ResourceManagerConfig config;
+  config.peer.streams = 2;
+  auto rm = std::make_shared<network::ResourceManagerImpl>(config);
+
+  Hosts hosts(rm);
+  ASSERT_TRUE(hosts.start(
+      multi::Multiaddress::create("/ip4/127.0.0.1/tcp/40020").value()));
+
+  auto s1 = hosts.openStream();
+  auto s2 = hosts.openStream();
+  ASSERT_TRUE(s1);
+  ASSERT_TRUE(s2);
+  EXPECT_EQ(rm->peerUsage(hosts.clientId()).streams, 2);
+
+  EXPECT_FALSE(hosts.openStream());
+  EXPECT_EQ(rm->peerUsage(hosts.clientId()).streams, 2);
+
+  hosts.disconnect();
+  EXPECT_EQ(rm->systemUsage().streams, 0);
+  EXPECT_EQ(rm->systemUsage().memory, 0);
+}
+
+/**
+ * @given server, which allows 1 inbound stream of the protocol
+ * @when client opens 2 streams of the protocol
+ * @then the second stream is reset by server after negotiation
+ */
+TEST_F(ResourceManagerIntegrationTest, ProtocolStreams) {
+  network::ResourceManagerConfig config;
+  config.protocol_streams_overrides[kProtocol] = 1;
+  auto rm = std::make_shared<network::ResourceManagerImpl>(config);
+
+  Hosts hosts(rm);
+  ASSERT_TRUE(hosts.start(
+      multi::Multiaddress::create("/ip4/127.0.0.1/tcp/40021").value()));
+
+  auto s1 = hosts.openStream();
+  ASSERT_TRUE(s1);
+  EXPECT_FALSE(hosts.openStream());
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "libp2p/network/impl/resource_manager_impl.hpp"
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/connection/stream_mock.hpp"
+#include "testutil/libp2p/peer.hpp"
+
+using namespace libp2p;
+using namespace network;
+using namespace connection;
+
+using testing::NiceMock;
+using testing::Return;
+
+struct ResourceManagerTest : public ::testing::Test {
+  void SetUp() override {
+    config.system = {3, 3, 300};
+    config.peer = {2, 2, 200};
+    config.protocol_streams = 2;
+    config.protocol_streams_overrides["/limited"] = 1;
+    rm = std::make_shared<ResourceManagerImpl>(config);
+  }
+
+  static std::shared_ptr<NiceMock<CapableConnectionMock>> openConnection() {
+    auto conn = std::make_shared<NiceMock<CapableConnectionMock>>();
+    ON_CALL(*conn, isClosed()).WillByDefault(Return(false));
+    return conn;
+  }
+
+  static std::shared_ptr<NiceMock<StreamMock>> openStream() {
+    auto stream = std::make_shared<NiceMock<StreamMock>>();
+    ON_CALL(*stream, isClosed()).WillByDefault(Return(false));
+    return stream;
+  }
+
+  ResourceManagerConfig config;
+  std::shared_ptr<ResourceManager> rm;
+
+  peer::PeerId p1 = testutil::randomPeerId();
+  peer::PeerId p2 = testutil::randomPeerId();
+};
+
+/**
+ * @given peer limit of 2 connections, system limit of 3
+ * @when connections are added for 2 peers
+ * @then third connection of a peer is rejected by peer limit, fourth
+ * connection in the system is rejected by system limit
+ */
+TEST_F(ResourceManagerTest, ConnectionLimits) {
+  auto c1 = openConnection();
+  auto c2 = openConnection();
+  auto c3 = openConnection();
+  auto c4 = openConnection();
+  ASSERT_TRUE(rm->addConnection(p1, c1));
+  ASSERT_TRUE(rm->addConnection(p1, c2));
+  ASSERT_EQ(rm->addConnection(p1, c3).error(),
+            ResourceManager::Error::PEER_LIMIT_EXCEEDED);
+  ASSERT_TRUE(rm->addConnection(p2, c3));
+  ASSERT_EQ(rm->addConnection(p2, c4).error(),
+            ResourceManager::Error::SYSTEM_LIMIT_EXCEEDED);
+  ASSERT_EQ(rm->systemUsage().connections, 3);
+  ASSERT_EQ(rm->peerUsage(p1).connections, 2);
+}
+
+/**
+ * @given peer and system connection limits reached
+ * @when one connection is closed and another is destroyed
+ * @then their slots are released without explicit calls
+ */
+TEST_F(ResourceManagerTest, ClosedConnectionsReleased) {
+  auto c1 = openConnection();
+  auto c2 = openConnection();
+  auto c3 = openConnection();
+  ASSERT_TRUE(rm->addConnection(p1, c1));
+  ASSERT_TRUE(rm->addConnection(p1, c2));
+  ASSERT_TRUE(rm->addConnection(p2, c3));
+
+  auto c4 = openConnection();
+  EXPECT_CALL(*c1, isClosed()).WillRepeatedly(Return(true));
+  ASSERT_TRUE(rm->addConnection(p1, c4));
+
+  auto c5 = openConnection();
+  c3.reset();
+  ASSERT_TRUE(rm->addConnection(p2, c5));
+  ASSERT_EQ(rm->systemUsage().connections, 3);
+}
+
+/**
+ * @given peer limit of 2 streams, system limit of 3
+ * @when streams are reserved and released
+ * @then reservations over the limits fail until some streams are released
+ */
+TEST_F(ResourceManagerTest, StreamLimits) {
+  ASSERT_TRUE(rm->reserveStream(p1));
+  ASSERT_TRUE(rm->reserveStream(p1));
+  ASSERT_EQ(rm->reserveStream(p1).error(),
+            ResourceManager::Error::PEER_LIMIT_EXCEEDED);
+  ASSERT_TRUE(rm->reserveStream(p2));
+  ASSERT_EQ(rm->reserveStream(p2).error(),
+            ResourceManager::Error::SYSTEM_LIMIT_EXCEEDED);
+
+  rm->releaseStream(p1);
+  ASSERT_TRUE(rm->reserveStream(p2));
+  ASSERT_EQ(rm->peerUsage(p1).streams, 1);
+  ASSERT_EQ(rm->peerUsage(p2).streams, 2);
+
+  rm->releaseStream(p1);
+  rm->releaseStream(p2);
+  rm->releaseStream(p2);
+  ASSERT_EQ(rm->systemUsage().streams, 0);
+}
+
+/**
+ * @given peer memory limit of 200 bytes, system limit of 300
+ * @when memory is reserved and released
+ * @then reservations over the limits fail, released bytes can be reused
+ */
+TEST_F(ResourceManagerTest, MemoryLimits) {
+  ASSERT_TRUE(rm->reserveMemory(p1, 150));
+  ASSERT_EQ(rm->reserveMemory(p1, 51).error(),
+            ResourceManager::Error::PEER_LIMIT_EXCEEDED);
+  ASSERT_TRUE(rm->reserveMemory(p1, 50));
+  ASSERT_EQ(rm->reserveMemory(p2, 101).error(),
+            ResourceManager::Error::SYSTEM_LIMIT_EXCEEDED);
+  ASSERT_TRUE(rm->reserveMemory(p2, 100));
+
+  rm->releaseMemory(p1, 200);
+  ASSERT_EQ(rm->peerUsage(p1).memory, 0);
+  ASSERT_TRUE(rm->reserveMemory(p2, 100));
+  ASSERT_EQ(rm->systemUsage().memory, 200);
+}
+
+/**
+ * @given default protocol limit of 2 streams, and 1 for "/limited"
+ * @when inbound streams are added
+ * @then streams over protocol limit are rejected until some are closed
+ */
+TEST_F(ResourceManagerTest, ProtocolLimits) {
+  auto s1 = openStream();
+  auto s2 = openStream();
+  auto s3 = openStream();
+  auto s4 = openStream();
+  ASSERT_TRUE(rm->addProtocolStream("/limited", s1));
+  ASSERT_EQ(rm->addProtocolStream("/limited", s2).error(),
+            ResourceManager::Error::PROTOCOL_LIMIT_EXCEEDED);
+
+  ASSERT_TRUE(rm->addProtocolStream("/other", s2));
+  ASSERT_TRUE(rm->addProtocolStream("/other", s3));
+  ASSERT_EQ(rm->addProtocolStream("/other", s4).error(),
+            ResourceManager::Error::PROTOCOL_LIMIT_EXCEEDED);
+
+  EXPECT_CALL(*s1, isClosed()).WillRepeatedly(Return(true));
+  ASSERT_TRUE(rm->addProtocolStream("/limited", s4));
+}
@@ -196,3 +196,45 @@ TEST_F(InmemAddressRepository_Test, GetPeers) {
   auto s = db->getPeers();
   EXPECT_EQ(s.size(), 2);
 }
+
+/**
+ * @given 3 expired addresses
+ * @when garbage is collected with budget of 2 entries
+ * @then 2 addresses are evicted, the rest of garbage is collected by the next
+ * call
+ */
+TEST_F(InmemAddressRepository_Test, IncrementalGarbageCollection) {
+  EXPECT_OUTCOME_TRUE_1(
+      db->addAddresses(p1, std::vector<Multiaddress>{ma1, ma2}, 10ms));
+  EXPECT_OUTCOME_TRUE_1(
+      db->addAddresses(p2, std::vector<Multiaddress>{ma3}, 10ms));
+  EXPECT_OUTCOME_TRUE_1(
+      db->addAddresses(p2, std::vector<Multiaddress>{ma4}, 1000ms));
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_FALSE(db->collectSomeGarbage(2));
+
+  size_t left = 0;
+  db->forEachPeer([&](const PeerId &p) {
+    left += db->getAddresses(p).value().size();
+  });
+  EXPECT_EQ(left, 2);
+
+  EXPECT_TRUE(db->collectSomeGarbage(2));
+  EXPECT_FALSE(db->hasPeer(p1));
+  EXPECT_OUTCOME_TRUE_2(v, db->getAddresses(p2));
+  EXPECT_EQ(v, std::vector<Multiaddress>{ma4});
+}
+
+/**
+ * @given permanent address
+ * @when garbage is collected
+ * @then the address is not evicted
+ */
+TEST_F(InmemAddressRepository_Test, PermanentAddress) {
+  EXPECT_OUTCOME_TRUE_1(db->addAddresses(
+      p1, std::vector<Multiaddress>{ma1}, ttl::kPermanent));
+  collectGarbage();
+  EXPECT_OUTCOME_TRUE_2(v, db->getAddresses(p1));
+  EXPECT_EQ(v.size(), 1);
+}
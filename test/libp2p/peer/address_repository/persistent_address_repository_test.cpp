@@ -0,0 +1,188 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/address_repository/persistent_address_repository.hpp>
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/peer/address_repository/inmem_address_repository.hpp>
+#include "mock/libp2p/network/dnsaddr_resolver_mock.hpp"
+#include "testutil/async/manual_scheduler_backend.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace libp2p;              // NOLINT
+using namespace libp2p::peer;        // NOLINT
+using namespace libp2p::common;      // NOLINT
+using multi::Multiaddress;
+using std::literals::chrono_literals::operator""ms;
+
+class PersistentAddressRepositoryTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    testutil::prepareLoggers();
+  }
+
+  void SetUp() override {
+    removeDbFiles();
+    restart();
+  }
+
+  void TearDown() override {
+    repo.reset();
+    peerstore.reset();
+    removeDbFiles();
+  }
+
+  /// Drops repository, what was not written yet is flushed, and opens it
+  /// again over the same db file
+  void restart(bool preload = true) {
+    repo.reset();
+    peerstore.reset();
+    PeerstoreDb::Config config;
+    config.preload = preload;
+    config.clock = [this] { return kStartTime + backend->now().count(); };
+    peerstore = std::make_shared<PeerstoreDb>(
+        std::make_shared<storage::SQLite>(kDbFile), scheduler, config);
+    repo = std::make_shared<PersistentAddressRepository>(
+        std::make_shared<InmemAddressRepository>(
+            std::make_shared<network::DnsaddrResolverMock>()),
+        peerstore);
+  }
+
+  /// Number of addresses in db
+  int stored() {
+    int count = 0;
+    peerstore->db() << "SELECT count(*) FROM addresses;" >> count;
+    return count;
+  }
+
+  void removeDbFiles() {
+    for (const auto *suffix : {"", "-wal", "-shm"}) {
+      boost::filesystem::remove(kDbFile + suffix);
+    }
+  }
+
+  const std::string kDbFile = "peerstore_test.sqlite";
+
+  /// Wall clock of peerstore follows the scheduler time
+  static constexpr PeerstoreDb::Timestamp kStartTime = 1'000'000;
+
+  std::shared_ptr<basic::ManualSchedulerBackend> backend =
+      std::make_shared<basic::ManualSchedulerBackend>();
+  std::shared_ptr<basic::Scheduler> scheduler =
+      std::make_shared<basic::SchedulerImpl>(backend,
+                                             basic::Scheduler::Config{});
+  std::shared_ptr<PeerstoreDb> peerstore;
+  std::shared_ptr<PersistentAddressRepository> repo;
+
+  const PeerId p1 = PeerId::fromHash("12051203020304"_multihash).value();
+  const PeerId p2 = PeerId::fromHash("12051203FFFFFF"_multihash).value();
+
+  const Multiaddress ma1 = "/ip4/127.0.0.1/tcp/8080"_multiaddr;
+  const Multiaddress ma2 = "/ip4/127.0.0.1/tcp/8081"_multiaddr;
+};
+
+/**
+ * @given repository with addresses of peers
+ * @when it is restarted
+ * @then the addresses are preloaded
+ */
+TEST_F(PersistentAddressRepositoryTest, SurvivesRestart) {
+  EXPECT_OUTCOME_TRUE_1(
+      repo->addAddresses(p1, std::vector{ma1}, ttl::kAddress));
+  EXPECT_OUTCOME_TRUE_1(
+      repo->upsertAddresses(p1, std::vector{ma2}, ttl::kPermanent));
+  EXPECT_OUTCOME_TRUE_1(repo->addAddresses(p2, std::vector{ma1}, ttl::kDay));
+
+  restart();
+
+  EXPECT_TRUE(repo->hasPeer(p1));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p1, p2}));
+  EXPECT_OUTCOME_TRUE(addresses, repo->getAddresses(p1));
+  EXPECT_EQ(std::set<Multiaddress>(addresses.begin(), addresses.end()),
+            std::set<Multiaddress>({ma1, ma2}));
+}
+
+/**
+ * @given repository with addresses of peers
+ * @when it is restarted without preloading
+ * @then peers are known without loading, their addresses are loaded on
+ * access, which doesn't announce them as added
+ */
+TEST_F(PersistentAddressRepositoryTest, SurvivesRestartLazy) {
+  EXPECT_OUTCOME_TRUE_1(
+      repo->addAddresses(p1, std::vector{ma1}, ttl::kAddress));
+  EXPECT_OUTCOME_TRUE_1(
+      repo->upsertAddresses(p1, std::vector{ma2}, ttl::kPermanent));
+  EXPECT_OUTCOME_TRUE_1(repo->addAddresses(p2, std::vector{ma1}, ttl::kDay));
+
+  restart(false);
+  size_t added = 0;
+  auto connection = repo->onAddressAdded(
+      [&](const PeerId &, const Multiaddress &) { ++added; });
+
+  EXPECT_TRUE(repo->hasPeer(p1));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p1, p2}));
+
+  EXPECT_OUTCOME_TRUE(addresses, repo->getAddresses(p1));
+  EXPECT_EQ(std::set<Multiaddress>(addresses.begin(), addresses.end()),
+            std::set<Multiaddress>({ma1, ma2}));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p1, p2}));
+  EXPECT_EQ(added, 0);
+}
+
+/**
+ * @given repository
+ * @when addresses are added
+ * @then they are written to db after flush interval in one batch
+ */
+TEST_F(PersistentAddressRepositoryTest, WriteBehind) {
+  EXPECT_OUTCOME_TRUE_1(
+      repo->addAddresses(p1, std::vector{ma1, ma2}, ttl::kAddress));
+  EXPECT_EQ(peerstore->pending(), 2);
+  EXPECT_EQ(stored(), 0);
+
+  backend->shift(PeerstoreDb::Config{}.flush_interval);
+  EXPECT_EQ(peerstore->pending(), 0);
+  EXPECT_EQ(stored(), 2);
+}
+
+/**
+ * @given repository with addresses, one of which expires soon
+ * @when it is restarted after expiration
+ * @then expired address is not loaded, and is removed from db by garbage
+ * collection
+ */
+TEST_F(PersistentAddressRepositoryTest, ExpiredAddress) {
+  EXPECT_OUTCOME_TRUE_1(repo->addAddresses(p1, std::vector{ma1}, 10ms));
+  EXPECT_OUTCOME_TRUE_1(repo->addAddresses(p2, std::vector{ma2}, ttl::kDay));
+  backend->shift(20ms);
+
+  restart();
+  EXPECT_FALSE(repo->hasPeer(p1));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p2}));
+  EXPECT_EQ(stored(), 2);
+
+  repo->collectGarbage();
+  EXPECT_EQ(stored(), 1);
+}
+
+/**
+ * @given repository with addresses of peer
+ * @when the peer is cleared and repository is restarted
+ * @then the peer has no addresses
+ */
+TEST_F(PersistentAddressRepositoryTest, Clear) {
+  EXPECT_OUTCOME_TRUE_1(
+      repo->addAddresses(p1, std::vector{ma1, ma2}, ttl::kAddress));
+  repo->clear(p1);
+
+  restart();
+  EXPECT_FALSE(repo->hasPeer(p1));
+  EXPECT_OUTCOME_FALSE_1(repo->getAddresses(p1));
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/interned_protocol.hpp>
+
+#include <gtest/gtest.h>
+
+using libp2p::peer::internProtocol;
+
+namespace {
+  std::string toString(gsl::span<const uint8_t> bytes) {
+    return std::string(bytes.begin(), bytes.end());
+  }
+}  // namespace
+
+/**
+ * @given protocol name
+ * @when it is interned
+ * @then name, multistream line and proposal are encoded
+ */
+TEST(InternedProtocol, Encoding) {
+  auto p = internProtocol("/ipfs/id/1.0.0");
+  EXPECT_EQ(p->name(), "/ipfs/id/1.0.0");
+  EXPECT_EQ(toString(p->multistreamLine()), "\x0f/ipfs/id/1.0.0\n");
+  EXPECT_EQ(toString(p->multistreamProposal()),
+            "\x13/multistream/1.0.0\n\x0f/ipfs/id/1.0.0\n");
+}
+
+/**
+ * @given protocol name
+ * @when it is interned several times
+ * @then the same id is returned while it is referenced
+ */
+TEST(InternedProtocol, SameId) {
+  std::string name = "/test/same/1.0.0";
+  auto p1 = internProtocol(name);
+  auto p2 = internProtocol(std::string_view(name));
+  EXPECT_EQ(p1, p2);
+  EXPECT_NE(p1, internProtocol("/test/other/1.0.0"));
+
+  std::weak_ptr<const libp2p::peer::InternedProtocol> weak = p1;
+  p1.reset();
+  p2.reset();
+  EXPECT_TRUE(weak.expired());
+
+  auto p3 = internProtocol(name);
+  EXPECT_EQ(p3->name(), name);
+}
+
+/**
+ * @given name which exceeds multistream message size limit
+ * @when it is interned
+ * @then it has no multistream encoding
+ */
+TEST(InternedProtocol, TooLong) {
+  auto p = internProtocol(std::string(70000, 'x'));
+  EXPECT_EQ(p->name().size(), 70000);
+  EXPECT_TRUE(p->multistreamLine().empty());
+  EXPECT_TRUE(p->multistreamProposal().empty());
+}
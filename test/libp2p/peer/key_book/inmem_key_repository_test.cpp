@@ -53,6 +53,8 @@ TEST_F(InmemKeyRepositoryTest, PubkeyStore) {
   db_->clear(p1_);
 
   EXPECT_EQ(v->size(), 0);
+  EXPECT_FALSE(db_->hasPeer(p1_));
+  EXPECT_TRUE(db_->hasPeer(p2_));
 }
 
 TEST_F(InmemKeyRepositoryTest, KeyPairStore) {
@@ -0,0 +1,139 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/peer/key_repository/persistent_key_repository.hpp>
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <libp2p/basic/scheduler/scheduler_impl.hpp>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/peer/key_repository/inmem_key_repository.hpp>
+#include "testutil/async/manual_scheduler_backend.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace libp2p;          // NOLINT
+using namespace libp2p::peer;    // NOLINT
+using namespace libp2p::common;  // NOLINT
+using crypto::Key;
+using crypto::PublicKey;
+
+class PersistentKeyRepositoryTest : public ::testing::TestWithParam<bool> {
+ public:
+  void SetUp() override {
+    removeDbFiles();
+    restart();
+  }
+
+  void TearDown() override {
+    repo.reset();
+    peerstore.reset();
+    removeDbFiles();
+  }
+
+  /// Drops repository, what was not written yet is flushed, and opens it
+  /// again over the same db file, preloading it if test parameter is set
+  void restart() {
+    repo.reset();
+    peerstore.reset();
+    PeerstoreDb::Config config;
+    config.preload = GetParam();
+    peerstore = std::make_shared<PeerstoreDb>(
+        std::make_shared<storage::SQLite>(kDbFile), scheduler, config);
+    repo = std::make_shared<PersistentKeyRepository>(
+        std::make_shared<InmemKeyRepository>(), peerstore);
+  }
+
+  /// Stores address of peer, as address repository would
+  void addAddress(const PeerId &p) {
+    peerstore->db() << "INSERT INTO addresses VALUES (?, ?, ?);"
+                    << p.toVector() << std::vector<uint8_t>{1}
+                    << PeerstoreDb::kNever;
+  }
+
+  /// Number of keys in db
+  int stored() {
+    int count = 0;
+    peerstore->db() << "SELECT count(*) FROM public_keys;" >> count;
+    return count;
+  }
+
+  void removeDbFiles() {
+    for (const auto *suffix : {"", "-wal", "-shm"}) {
+      boost::filesystem::remove(kDbFile + suffix);
+    }
+  }
+
+  const std::string kDbFile = "peerstore_keys_test.sqlite";
+
+  std::shared_ptr<basic::ManualSchedulerBackend> backend =
+      std::make_shared<basic::ManualSchedulerBackend>();
+  std::shared_ptr<basic::Scheduler> scheduler =
+      std::make_shared<basic::SchedulerImpl>(backend,
+                                             basic::Scheduler::Config{});
+  std::shared_ptr<PeerstoreDb> peerstore;
+  std::shared_ptr<PersistentKeyRepository> repo;
+
+  const PeerId p1 = PeerId::fromHash("12051203020304"_multihash).value();
+  const PeerId p2 = PeerId::fromHash("12051203FFFFFF"_multihash).value();
+
+  const PublicKey k1{{Key::Type::Ed25519, std::vector<uint8_t>(32, 1)}};
+  const PublicKey k2{{Key::Type::Secp256k1, std::vector<uint8_t>(33, 2)}};
+};
+
+/**
+ * @given repository with keys of peers
+ * @when it is restarted
+ * @then the keys are read from db
+ */
+TEST_P(PersistentKeyRepositoryTest, SurvivesRestart) {
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p1, k1));
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p1, k2));
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p2, k1));
+
+  restart();
+
+  EXPECT_TRUE(repo->hasPeer(p1));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p1, p2}));
+  EXPECT_OUTCOME_TRUE(keys, repo->getPublicKeys(p1));
+  EXPECT_EQ(*keys, std::unordered_set<PublicKey>({k1, k2}));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p1, p2}));
+}
+
+/**
+ * @given repository with keys of peer
+ * @when the peer is cleared and repository is restarted
+ * @then the peer has no keys
+ */
+TEST_P(PersistentKeyRepositoryTest, Clear) {
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p1, k1));
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p2, k2));
+  repo->clear(p1);
+
+  restart();
+  EXPECT_FALSE(repo->hasPeer(p1));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p2}));
+  EXPECT_EQ(stored(), 1);
+}
+
+/**
+ * @given keys of peer with addresses and of peer without them
+ * @when garbage is collected
+ * @then keys of the peer without addresses are removed from db and cache
+ */
+TEST_P(PersistentKeyRepositoryTest, CollectsOrphans) {
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p1, k1));
+  EXPECT_OUTCOME_TRUE_1(repo->addPublicKey(p2, k2));
+  addAddress(p1);
+
+  repo->collectGarbage();
+  EXPECT_EQ(stored(), 1);
+  EXPECT_TRUE(repo->hasPeer(p1));
+  EXPECT_FALSE(repo->hasPeer(p2));
+  EXPECT_EQ(repo->getPeers(), std::unordered_set<PeerId>({p1}));
+}
+
+INSTANTIATE_TEST_CASE_P(Preload,
+                        PersistentKeyRepositoryTest,
+                        ::testing::Bool());
@@ -5,6 +5,8 @@
 
 #include "libp2p/peer/peer_id.hpp"
 
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <libp2p/crypto/key_marshaller/key_marshaller_impl.hpp>
 #include <libp2p/crypto/sha/sha256.hpp>
@@ -56,6 +58,51 @@ TEST_F(PeerIdTest, FromBase58Success) {
   EXPECT_EQ(peer_id.toMultihash(), hash);
 }
 
+/**
+ * @given base58-encoded sha256 multihash surrounded by whitespaces
+ * @when creating a PeerId from it @and getting its base58 form several times
+ * @then the form is canonical for PeerId, its copies and moved instances
+ */
+TEST_F(PeerIdTest, ToBase58Cached) {
+  EXPECT_OUTCOME_TRUE(hash, Multihash::create(libp2p::multi::sha256, kBuffer));
+  auto hash_b58 = encodeBase58(hash.toBuffer());
+
+  EXPECT_OUTCOME_TRUE(peer_id, PeerId::fromBase58(" " + hash_b58 + "\n"))
+  EXPECT_EQ(peer_id.toBase58(), hash_b58);
+  EXPECT_EQ(peer_id.toBase58(), hash_b58);
+
+  auto copy = peer_id;
+  EXPECT_EQ(copy.toBase58(), hash_b58);
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved.toBase58(), hash_b58);
+}
+
+/**
+ * @given PeerId without cached base58 form
+ * @when it is encoded and copied from several threads at once
+ * @then all the threads get the same form
+ */
+TEST_F(PeerIdTest, ToBase58Concurrent) {
+  EXPECT_OUTCOME_TRUE(hash, Multihash::create(libp2p::multi::sha256, kBuffer));
+  EXPECT_OUTCOME_TRUE(peer_id, PeerId::fromHash(hash))
+  auto hash_b58 = encodeBase58(hash.toBuffer());
+
+  std::vector<std::thread> threads;
+  std::vector<std::string> results(4);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i] {
+      auto copy = peer_id;
+      results[i] = i % 2 == 0 ? peer_id.toBase58() : copy.toBase58();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &result : results) {
+    EXPECT_EQ(result, hash_b58);
+  }
+}
+
 /**
  * @given some random string
  * @when creating a PeerId from it
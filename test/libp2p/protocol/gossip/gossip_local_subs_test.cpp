@@ -148,3 +148,61 @@ TEST(Gossip, MultipleSubscriptons) {
     s->checkExpected();
   }
 }
+
+/**
+ * @given LocalSubscriptions router with overlapping subscriptions
+ * @when Publishing messages, while some subscriptions are canceled and
+ * created inside callbacks, and unsubscribing then
+ * @then Messages reach only subscriptions to their topics, once, and host
+ * subscription set changes are reported once per topic
+ */
+TEST(Gossip, SubscriptionIndex) {
+  std::vector<std::string> changes;
+  auto subs = createSubscriptions([&](bool subscribe, const g::TopicId &t) {
+    changes.push_back((subscribe ? "+" : "-") + t);
+  });
+
+  SubscrCtx a;
+  SubscrCtx b;
+  a.subscribe(*subs, {"1", "2", "3"});
+  b.subscribe(*subs, {"3", "4"});
+  EXPECT_EQ(changes, (std::vector<std::string>{"+1", "+2", "+3", "+4"}));
+
+  // canceled inside callback of the same message: not delivered to 'd'
+  SubscrCtx d;
+  std::vector<libp2p::protocol::Subscription> late;
+  size_t c_received = 0;
+  auto c = subs->subscribe({"3"}, [&](g::Gossip::SubscriptionData data) {
+    ASSERT_TRUE(data.has_value());
+    ++c_received;
+    d.unsubscribe();
+    late.push_back(subs->subscribe({"3"}, [](g::Gossip::SubscriptionData) {
+      FAIL() << "subscribed inside callback of the same message";
+    }));
+  });
+  d.subscribe(*subs, {"3"});
+
+  uint64_t seq = 0;
+  subs->forwardMessage(createTestMessage({"1", "2", "3"}, seq++));
+  subs->forwardMessage(createTestMessage({"4"}, seq++));
+  subs->forwardMessage(createTestMessage({"5"}, seq++));
+
+  a.expected_count = 1;
+  b.expected_count = 2;
+  d.expected_count = 0;
+  a.checkExpected();
+  b.checkExpected();
+  d.checkExpected();
+  EXPECT_EQ(c_received, 1);
+
+  changes.clear();
+  late.clear();
+  c.cancel();
+  a.unsubscribe();
+  EXPECT_EQ(changes, (std::vector<std::string>{"-1", "-2"}));
+  EXPECT_EQ(subs->subscribedTo().size(), 2);
+
+  b.unsubscribe();
+  EXPECT_EQ(changes, (std::vector<std::string>{"-1", "-2", "-3", "-4"}));
+  EXPECT_TRUE(subs->subscribedTo().empty());
+}
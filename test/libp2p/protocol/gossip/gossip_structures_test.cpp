@@ -150,6 +150,65 @@ TEST(Gossip, PeerSet) {
   ASSERT_EQ(known_peers.size(), NP - NP / (deleted_topic_no + 1));
 }
 
+/**
+ * @given PeerSet of NP peers
+ * @when Erasing peers one by one and sampling random peers in between
+ * @then The set finds exactly the remaining peers, samples are distinct
+ * members of the set, and every peer appears in samples
+ */
+TEST(Gossip, PeerSetEraseAndSample) {
+  const size_t NP = 100;
+  std::vector<g::PeerContextPtr> all_peers;
+  g::PeerSet peers;
+  for (size_t i = 0; i < NP; ++i) {
+    all_peers.push_back(
+        std::make_shared<g::PeerContext>(testutil::randomPeerId()));
+    ASSERT_TRUE(peers.insert(all_peers.back()));
+  }
+  ASSERT_FALSE(peers.insert(all_peers.front()));
+
+  auto checkSample = [&](size_t n) {
+    auto vec = peers.selectRandomPeers(n);
+    ASSERT_EQ(vec.size(), std::min(n, peers.size()));
+    std::set<g::PeerContextPtr> distinct(vec.begin(), vec.end());
+    ASSERT_EQ(distinct.size(), vec.size());
+    for (const auto &p : vec) {
+      ASSERT_TRUE(peers.contains(p->peer_id));
+    }
+  };
+
+  // both small and large samples cover the whole set
+  for (size_t n : {3, 60}) {
+    std::set<g::PeerContextPtr> seen;
+    for (size_t i = 0; i < 1000 && seen.size() < NP; ++i) {
+      auto vec = peers.selectRandomPeers(n);
+      seen.insert(vec.begin(), vec.end());
+    }
+    ASSERT_EQ(seen.size(), NP);
+  }
+
+  // erase from the middle, the front and the back in turn
+  for (size_t i = 0; i < NP; ++i) {
+    size_t pos = (i % 3 == 0) ? all_peers.size() / 2
+                              : (i % 3 == 1 ? 0 : all_peers.size() - 1);
+    auto erased = peers.erase(all_peers[pos]->peer_id);
+    ASSERT_TRUE(erased);
+    ASSERT_EQ(erased.value(), all_peers[pos]);
+    ASSERT_FALSE(peers.erase(all_peers[pos]->peer_id));
+    all_peers.erase(all_peers.begin() + pos);
+
+    ASSERT_EQ(peers.size(), all_peers.size());
+    for (const auto &p : all_peers) {
+      auto found = peers.find(p->peer_id);
+      ASSERT_TRUE(found);
+      ASSERT_EQ(found.value(), p);
+    }
+    checkSample(5);
+    checkSample(40);
+  }
+  ASSERT_TRUE(peers.empty());
+}
+
 /**
  * @given Empty MessageCache
  * @when We insert messages into it on different timestamp
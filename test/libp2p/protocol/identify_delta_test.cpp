@@ -88,8 +88,6 @@ class IdentifyDeltaTest : public testing::Test {
   ConnectionManagerMock conn_manager_;
   PeerRepositoryMock peer_repo_;
   ProtocolRepositoryMock proto_repo_;
-  std::shared_ptr<CapableConnectionMock> conn_ =
-      std::make_shared<CapableConnectionMock>();
   std::shared_ptr<StreamMock> stream_ = std::make_shared<StreamMock>();
 
   const std::string kIdentifyDeltaProtocol = "/p2p/id/delta/1.0.0";
@@ -111,9 +109,8 @@ ACTION_P(InvokeLambda, s) {
  */
 TEST_F(IdentifyDeltaTest, Send) {
   // getActivePeers
-  EXPECT_CALL(conn_manager_, getConnections())
-      .WillOnce(Return(std::vector<std::shared_ptr<CapableConnection>>{conn_}));
-  EXPECT_CALL(*conn_, remotePeer()).WillOnce(Return(kRemotePeerId));
+  EXPECT_CALL(conn_manager_, forEachConnectedPeer(_))
+      .WillOnce([this](const auto &visitor) { visitor(kRemotePeerId); });
   EXPECT_CALL(host_, getPeerRepository()).WillOnce(ReturnRef(peer_repo_));
   EXPECT_CALL(peer_repo_, getPeerInfo(kRemotePeerId))
       .WillOnce(Return(kPeerInfo));
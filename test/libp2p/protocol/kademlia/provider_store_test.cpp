@@ -0,0 +1,223 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <libp2p/protocol/kademlia/impl/provider_store.hpp>
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "testutil/libp2p/peer.hpp"
+
+using libp2p::peer::PeerId;
+using libp2p::protocol::kademlia::Config;
+using libp2p::protocol::kademlia::ContentId;
+using libp2p::protocol::kademlia::ProviderStore;
+
+struct ProviderStoreTest : public ::testing::Test {
+  Config config_;
+  ProviderStore store_{config_};
+
+  ContentId cid_{"content"};
+  ContentId other_cid_{"other content"};
+  PeerId peer_ = testutil::randomPeerId();
+  PeerId other_peer_ = testutil::randomPeerId();
+};
+
+/**
+ * @given provider of content
+ * @when it provides the content again
+ * @then the record is refreshed and not duplicated
+ */
+TEST_F(ProviderStoreTest, Refresh) {
+  EXPECT_TRUE(store_.addProvider(cid_, peer_, 10));
+  EXPECT_FALSE(store_.addProvider(cid_, peer_, 20));
+
+  EXPECT_EQ(store_.size(), 1);
+  EXPECT_EQ(store_.getProviders(cid_, 15), std::vector{peer_});
+  EXPECT_TRUE(store_.getProviders(other_cid_, 15).empty());
+}
+
+/**
+ * @given provider of two contents
+ * @then its peer id is stored once
+ */
+TEST_F(ProviderStoreTest, PeerInterned) {
+  store_.addProvider(cid_, peer_, 10);
+  store_.addProvider(other_cid_, peer_, 10);
+  store_.addProvider(other_cid_, other_peer_, 10);
+
+  EXPECT_EQ(store_.size(), 3);
+  EXPECT_EQ(store_.keys(), 2);
+  EXPECT_EQ(store_.peers(), 2);
+}
+
+/**
+ * @given content with maxProvidersPerKey providers
+ * @when one more provider is added
+ * @then the provider, which expires first, is evicted
+ */
+TEST_F(ProviderStoreTest, ProvidersPerKeyLimit) {
+  config_.maxProvidersPerKey = 2;
+  store_.addProvider(cid_, peer_, 10);
+  store_.addProvider(cid_, other_peer_, 20);
+  auto third = testutil::randomPeerId();
+  store_.addProvider(cid_, third, 30);
+
+  auto providers = store_.getProviders(cid_, 0);
+  EXPECT_EQ(providers.size(), 2);
+  EXPECT_EQ(std::count(providers.begin(), providers.end(), peer_), 0);
+  EXPECT_EQ(store_.peers(), 2);
+  EXPECT_EQ(store_.getProviders(cid_, 0, 1).size(), 1);
+}
+
+/**
+ * @given store with maxProviderRecords records
+ * @when a record is added
+ * @then the least recently refreshed record is evicted
+ */
+TEST_F(ProviderStoreTest, GlobalLimit) {
+  config_.maxProviderRecords = 2;
+  store_.addProvider(cid_, peer_, 10);
+  store_.addProvider(other_cid_, peer_, 20);
+  store_.addProvider(cid_, peer_, 30);
+
+  ContentId third_cid{"third content"};
+  store_.addProvider(third_cid, other_peer_, 40);
+
+  EXPECT_EQ(store_.size(), 2);
+  EXPECT_EQ(store_.getProviders(cid_, 0), std::vector{peer_});
+  EXPECT_TRUE(store_.getProviders(other_cid_, 0).empty());
+  EXPECT_EQ(store_.getProviders(third_cid, 0), std::vector{other_peer_});
+}
+
+/**
+ * @given store with maxProviderRecords records, maxProvidersPerKey of which
+ * are of the same content
+ * @when a provider of the content is added
+ * @then only the provider of the content, which expires first, is evicted
+ */
+TEST_F(ProviderStoreTest, BothLimits) {
+  config_.maxProviderRecords = 3;
+  config_.maxProvidersPerKey = 2;
+  store_.addProvider(other_cid_, other_peer_, 10);
+  store_.addProvider(cid_, peer_, 20);
+  auto second = testutil::randomPeerId();
+  store_.addProvider(cid_, second, 30);
+
+  auto third = testutil::randomPeerId();
+  store_.addProvider(cid_, third, 40);
+
+  EXPECT_EQ(store_.size(), 3);
+  EXPECT_EQ(store_.getProviders(other_cid_, 0), std::vector{other_peer_});
+  auto providers = store_.getProviders(cid_, 0);
+  EXPECT_EQ(providers.size(), 2);
+  EXPECT_EQ(std::count(providers.begin(), providers.end(), second), 1);
+  EXPECT_EQ(std::count(providers.begin(), providers.end(), third), 1);
+}
+
+/**
+ * @given CIDs with identity multihashes, which differ only in the first byte
+ * of their 40 bytes long digests
+ * @when providers of both are added
+ * @then each CID has its own providers
+ */
+TEST_F(ProviderStoreTest, SameSuffix) {
+  // CIDv1, raw codec, identity multihash of 40 bytes
+  std::vector<uint8_t> bytes{0x01, 0x55, 0x00, 40};
+  bytes.resize(bytes.size() + 40, 0x42);
+  ContentId cid1;
+  cid1.data = bytes;
+  ContentId cid2;
+  cid2.data = bytes;
+  cid2.data[4] = 0x43;
+
+  store_.addProvider(cid1, peer_, 10);
+  store_.addProvider(cid2, other_peer_, 10);
+
+  EXPECT_EQ(store_.keys(), 2);
+  EXPECT_EQ(store_.getProviders(cid1, 0), std::vector{peer_});
+  EXPECT_EQ(store_.getProviders(cid2, 0), std::vector{other_peer_});
+}
+
+/**
+ * @given CIDv0 and CIDv1s with different codecs of the same sha256 multihash
+ * @when providers of them are added
+ * @then they share records, as the same content
+ */
+TEST_F(ProviderStoreTest, SameMultihash) {
+  // cid_ is CIDv1 of raw codec, ending with multihash
+  ContentId cid_v0;
+  cid_v0.data.assign(cid_.data.end() - 34, cid_.data.end());
+  ContentId cid_dag_pb;
+  cid_dag_pb.data = {0x01, 0x70};
+  cid_dag_pb.data.insert(cid_dag_pb.data.end(), cid_v0.data.begin(),
+                         cid_v0.data.end());
+
+  store_.addProvider(cid_, peer_, 10);
+  EXPECT_FALSE(store_.addProvider(cid_v0, peer_, 20));
+  store_.addProvider(cid_dag_pb, other_peer_, 20);
+
+  EXPECT_EQ(store_.keys(), 1);
+  EXPECT_EQ(store_.getProviders(cid_, 0).size(), 2);
+}
+
+/**
+ * @given expired records
+ * @then they are not returned and are removed in batches of given size
+ */
+TEST_F(ProviderStoreTest, RemoveExpired) {
+  std::vector<PeerId> peers;
+  for (auto i = 1; i <= 5; ++i) {
+    peers.push_back(testutil::randomPeerId());
+    store_.addProvider(cid_, peers.back(), i * 10);
+  }
+
+  EXPECT_EQ(store_.getProviders(cid_, 30).size(), 2);
+
+  EXPECT_FALSE(store_.removeExpired(30, 2));
+  EXPECT_EQ(store_.size(), 3);
+  EXPECT_TRUE(store_.removeExpired(30, 2));
+  EXPECT_EQ(store_.size(), 2);
+  EXPECT_EQ(store_.peers(), 2);
+
+  EXPECT_TRUE(store_.removeExpired(100, 10));
+  EXPECT_EQ(store_.size(), 0);
+  EXPECT_EQ(store_.keys(), 0);
+  EXPECT_EQ(store_.peers(), 0);
+
+  // released entries are reused
+  store_.addProvider(cid_, peer_, 110);
+  EXPECT_EQ(store_.getProviders(cid_, 100), std::vector{peer_});
+}
+
+/**
+ * @given many contents and providers
+ * @when the half of records expire
+ * @then the rest are found
+ */
+TEST_F(ProviderStoreTest, Many) {
+  constexpr size_t kContents = 1000;
+  std::vector<PeerId> peers;
+  for (auto i = 0; i < 10; ++i) {
+    peers.push_back(testutil::randomPeerId());
+  }
+  for (size_t i = 0; i < kContents; ++i) {
+    store_.addProvider(ContentId{std::to_string(i)}, peers[i % peers.size()],
+                       i);
+  }
+  EXPECT_EQ(store_.size(), kContents);
+
+  EXPECT_TRUE(store_.removeExpired(kContents / 2 - 1, kContents));
+  EXPECT_EQ(store_.size(), kContents / 2);
+  for (size_t i = 0; i < kContents; ++i) {
+    auto providers = store_.getProviders(ContentId{std::to_string(i)}, 0);
+    if (i < kContents / 2) {
+      EXPECT_TRUE(providers.empty());
+    } else {
+      EXPECT_EQ(providers, std::vector{peers[i % peers.size()]});
+    }
+  }
+}
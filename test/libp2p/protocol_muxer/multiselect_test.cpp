@@ -9,7 +9,16 @@
 
 #include <gtest/gtest.h>
 
+#include "testutil/libp2p/stream_pair.hpp"
 #include "testutil/prepare_loggers.hpp"
+
+using libp2p::connection::Stream;
+using libp2p::outcome::result;
+using libp2p::protocol_muxer::ProtocolMuxer;
+using libp2p::protocol_muxer::multiselect::Multiselect;
+using libp2p::protocol_muxer::multiselect::MultiselectConfig;
+using libp2p::testutil::PipeStream;
+
 /**
  * @given static vector
  * @when resizing it over static capacity
@@ -97,3 +106,119 @@ TEST(Multiselect, SingleValidMessagesPartialRead) {
   test(1, 2);
   test(2, 1);
 }
+
+namespace {
+  const libp2p::peer::Protocol kPingProtocol = "/ping/1.0.0";
+
+  /// Accepts the protocol on server side, then reads 4 bytes and replies
+  /// with 4 bytes
+  void serveOnePing(Multiselect &muxer, std::shared_ptr<PipeStream> stream,
+                    std::string &received) {
+    std::vector<libp2p::peer::Protocol> protocols{kPingProtocol};
+    muxer.selectOneOf(
+        protocols, stream, false, true,
+        [stream, &received](result<libp2p::peer::Protocol> res) {
+          if (!res) {
+            return;
+          }
+          auto buf = std::make_shared<std::array<uint8_t, 4>>();
+          stream->read(*buf, buf->size(),
+                       [stream, buf, &received](result<size_t> res) {
+                         ASSERT_TRUE(res);
+                         received.assign(buf->begin(), buf->end());
+                         std::string_view pong("pong");
+                         stream->write(
+                             gsl::span<const uint8_t>(
+                                 reinterpret_cast<const uint8_t *>(
+                                     pong.data()),
+                                 pong.size()),
+                             pong.size(), [](result<size_t>) {});
+                       });
+        });
+  }
+
+  /// Writes "ping" to negotiated stream and reads reply
+  void sendPing(std::shared_ptr<Stream> stream, std::string &reply,
+                std::error_code &error) {
+    std::string_view ping("ping");
+    stream->write(
+        gsl::span<const uint8_t>(
+            reinterpret_cast<const uint8_t *>(ping.data()), ping.size()),
+        ping.size(), [](result<size_t>) {});
+    auto buf = std::make_shared<std::array<uint8_t, 4>>();
+    stream->read(*buf, buf->size(),
+                 [stream, buf, &reply, &error](result<size_t> res) {
+                   if (!res) {
+                     error = res.error();
+                     return;
+                   }
+                   reply.assign(buf->begin(), buf->end());
+                 });
+  }
+
+  struct PingResult {
+    std::string received;
+    std::string reply;
+    std::error_code error;
+    size_t client_writes = 0;
+  };
+
+  PingResult ping(bool lazy, const libp2p::peer::Protocol &protocol) {
+    boost::asio::io_context io;
+    auto [client, server] = PipeStream::makePair(io);
+    Multiselect client_muxer(MultiselectConfig{lazy});
+    Multiselect server_muxer;
+
+    PingResult ping_result;
+    serveOnePing(server_muxer, server, ping_result.received);
+    client_muxer.simpleStreamNegotiate(
+        client, protocol, [&ping_result](result<std::shared_ptr<Stream>> res) {
+          if (!res) {
+            ping_result.error = res.error();
+            return;
+          }
+          sendPing(res.value(), ping_result.reply, ping_result.error);
+        });
+    io.run();
+    ping_result.client_writes = client->writes;
+    return ping_result;
+  }
+}  // namespace
+
+/**
+ * @given client and server multiselect
+ * @when client negotiates outbound stream in default mode
+ * @then proposal and data are sent in separate writes, data is exchanged
+ */
+TEST(Multiselect, SimpleNegotiation) {
+  auto res = ping(false, kPingProtocol);
+  EXPECT_FALSE(res.error);
+  EXPECT_EQ(res.received, "ping");
+  EXPECT_EQ(res.reply, "pong");
+  EXPECT_EQ(res.client_writes, 2);
+}
+
+/**
+ * @given client multiselect in lazy mode and server multiselect
+ * @when client negotiates outbound stream and writes data
+ * @then proposal and data are sent in one write, data is exchanged
+ */
+TEST(Multiselect, LazyNegotiation) {
+  auto res = ping(true, kPingProtocol);
+  EXPECT_FALSE(res.error);
+  EXPECT_EQ(res.received, "ping");
+  EXPECT_EQ(res.reply, "pong");
+  EXPECT_EQ(res.client_writes, 1);
+}
+
+/**
+ * @given client multiselect in lazy mode and server multiselect
+ * @when client proposes protocol unknown to server
+ * @then stream is returned, but the first read fails with NEGOTIATION_FAILED
+ */
+TEST(Multiselect, LazyNegotiationRejected) {
+  auto res = ping(true, "/unknown/1.0.0");
+  EXPECT_EQ(res.error, ProtocolMuxer::Error::NEGOTIATION_FAILED);
+  EXPECT_TRUE(res.received.empty());
+  EXPECT_TRUE(res.reply.empty());
+}
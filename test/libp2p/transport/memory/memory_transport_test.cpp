@@ -0,0 +1,218 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <chrono>
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <libp2p/common/literals.hpp>
+#include <libp2p/transport/memory.hpp>
+#include "mock/libp2p/connection/capable_connection_mock.hpp"
+#include "mock/libp2p/transport/upgrader_mock.hpp"
+#include "testutil/gmock_actions.hpp"
+#include "testutil/libp2p/peer.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace libp2p::transport;
+using namespace libp2p::multi;
+using namespace libp2p::common;
+using namespace libp2p::connection;
+using std::chrono_literals::operator""ms;
+using libp2p::common::ByteArray;
+
+using ::testing::_;
+using ::testing::NiceMock;
+
+namespace {
+  auto makeUpgrader() {
+    auto upgrader = std::make_shared<NiceMock<UpgraderMock>>();
+    ON_CALL(*upgrader, upgradeToSecureOutbound(_, _, _))
+        .WillByDefault(UpgradeToSecureOutbound([](auto &&raw) {
+          std::shared_ptr<SecureConnection> sec =
+              std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+          return sec;
+        }));
+    ON_CALL(*upgrader, upgradeToSecureInbound(_, _))
+        .WillByDefault(UpgradeToSecureInbound([](auto &&raw) {
+          std::shared_ptr<SecureConnection> sec =
+              std::make_shared<CapableConnBasedOnRawConnMock>(raw);
+          return sec;
+        }));
+    ON_CALL(*upgrader, upgradeToMuxed(_, _))
+        .WillByDefault(UpgradeToMuxed([](auto &&sec) {
+          std::shared_ptr<CapableConnection> cap =
+              std::make_shared<CapableConnBasedOnRawConnMock>(sec);
+          return cap;
+        }));
+
+    return upgrader;
+  }
+
+  class MemoryTransportTest : public ::testing::Test {
+   public:
+    std::shared_ptr<boost::asio::io_context> context =
+        std::make_shared<boost::asio::io_context>();
+    std::shared_ptr<MemoryTransport> transport =
+        std::make_shared<MemoryTransport>(context, makeUpgrader());
+  };
+}  // namespace
+
+/**
+ * @given memory transport
+ * @when checking dialable addresses
+ * @then only /memory/<id> addresses are accepted
+ */
+TEST_F(MemoryTransportTest, CanDial) {
+  EXPECT_TRUE(transport->canDial("/memory/1"_multiaddr));
+  EXPECT_FALSE(transport->canDial("/ip4/127.0.0.1/tcp/40003"_multiaddr));
+}
+
+/**
+ * @given two listeners
+ * @when bound on the same memory address
+ * @then the second one gets address_in_use, the address is released on close
+ */
+TEST_F(MemoryTransportTest, TwoListenersCantBindOnSameId) {
+  auto ma = "/memory/40003"_multiaddr;
+  auto listener1 = transport->createListener([](auto &&) {});
+  auto listener2 = transport->createListener([](auto &&) {});
+
+  EXPECT_OUTCOME_TRUE_1(listener1->listen(ma))
+  auto r = listener2->listen(ma);
+  ASSERT_FALSE(r);
+  ASSERT_EQ(r.error().value(), (int)std::errc::address_in_use);
+
+  EXPECT_OUTCOME_TRUE_1(listener1->close())
+  EXPECT_TRUE(listener1->isClosed());
+  EXPECT_OUTCOME_TRUE_1(listener2->listen(ma))
+}
+
+/**
+ * @given listener bound to /memory/0
+ * @when its listen address is requested
+ * @then some nonzero id is allocated
+ */
+TEST_F(MemoryTransportTest, EphemeralId) {
+  auto listener = transport->createListener([](auto &&) {});
+  EXPECT_OUTCOME_TRUE_1(listener->listen("/memory/0"_multiaddr))
+  EXPECT_OUTCOME_TRUE(ma, listener->getListenMultiaddr())
+  EXPECT_NE(ma, "/memory/0"_multiaddr);
+  EXPECT_TRUE(transport->canDial(ma));
+}
+
+/**
+ * @given memory transport
+ * @when dial to an id nobody listens on
+ * @then get connection_refused error
+ */
+TEST_F(MemoryTransportTest, DialToNoServer) {
+  bool called = false;
+  transport->dial(testutil::randomPeerId(), "/memory/40003"_multiaddr,
+                  [&](auto &&rc) {
+                    called = true;
+                    ASSERT_FALSE(rc);
+                    ASSERT_EQ(rc.error().value(),
+                              (int)std::errc::connection_refused);
+                  });
+  context->run_for(50ms);
+  ASSERT_TRUE(called);
+}
+
+/**
+ * @given echo server listening on memory address
+ * @when client dials it and sends a message
+ * @then client receives the same message back
+ */
+TEST_F(MemoryTransportTest, Echo) {
+  constexpr size_t kSize = 100000;
+  auto ma = "/memory/40003"_multiaddr;
+  size_t answered = 0;
+
+  auto listener = transport->createListener([&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn)
+    EXPECT_FALSE(conn->isInitiator());
+    EXPECT_OUTCOME_TRUE(local, conn->localMultiaddr())
+    EXPECT_EQ(local, ma);
+
+    auto buf = std::make_shared<ByteArray>(kSize, 0);
+    conn->read(*buf, kSize, [&, conn, buf](auto &&res) {
+      ASSERT_TRUE(res) << res.error().message();
+      conn->write(*buf, kSize, [&, conn, buf](auto &&res) {
+        ASSERT_TRUE(res) << res.error().message();
+        ++answered;
+      });
+    });
+  });
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma))
+
+  bool received = false;
+  transport->dial(testutil::randomPeerId(), ma, [&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn)
+    EXPECT_TRUE(conn->isInitiator());
+    EXPECT_OUTCOME_TRUE(remote, conn->remoteMultiaddr())
+    EXPECT_EQ(remote, ma);
+
+    auto buf = std::make_shared<ByteArray>(kSize, 0);
+    auto readback = std::make_shared<ByteArray>(kSize, 0);
+    std::generate(buf->begin(), buf->end(), []() {
+      return rand();  // NOLINT
+    });
+    conn->write(*buf, kSize, [&, conn, buf, readback](auto &&res) {
+      ASSERT_TRUE(res) << res.error().message();
+      conn->read(*readback, kSize, [&, conn, buf, readback](auto &&res) {
+        ASSERT_TRUE(res) << res.error().message();
+        ASSERT_EQ(*buf, *readback);
+        received = true;
+      });
+    });
+  });
+
+  context->run_for(100ms);
+  ASSERT_EQ(answered, 1);
+  ASSERT_TRUE(received);
+}
+
+/**
+ * @given server with one active client
+ * @when client closes connection
+ * @then pending read on server side fails with CONNECTION_CLOSED_BY_PEER
+ */
+TEST_F(MemoryTransportTest, ClientClosesConnection) {
+  auto ma = "/memory/40003"_multiaddr;
+  bool read_failed = false;
+
+  auto listener = transport->createListener([&](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn)
+    auto buf = std::make_shared<ByteArray>(100, 0);
+    conn->readSome(*buf, buf->size(), [&, conn, buf](auto &&res) {
+      ASSERT_FALSE(res);
+      ASSERT_EQ(res.error(), RawConnection::Error::CONNECTION_CLOSED_BY_PEER);
+      read_failed = true;
+    });
+  });
+  EXPECT_OUTCOME_TRUE_1(listener->listen(ma))
+
+  transport->dial(testutil::randomPeerId(), ma, [](auto &&rconn) {
+    EXPECT_OUTCOME_TRUE(conn, rconn)
+    EXPECT_OUTCOME_TRUE_1(conn->close())
+    EXPECT_TRUE(conn->isClosed());
+  });
+
+  context->run_for(50ms);
+  ASSERT_TRUE(read_failed);
+}
+
+int main(int argc, char *argv[]) {
+  if (std::getenv("TRACE_DEBUG") != nullptr) {
+    testutil::prepareLoggers(soralog::Level::TRACE);
+  } else {
+    testutil::prepareLoggers(soralog::Level::ERROR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
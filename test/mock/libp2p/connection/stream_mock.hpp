@@ -49,6 +49,8 @@ namespace libp2p::connection {
 
     MOCK_METHOD2(adjustWindowSize, void(uint32_t, VoidResultHandlerFunc));
 
+    MOCK_METHOD1(setPriority, void(Priority));
+
     MOCK_CONST_METHOD0(isInitiator, outcome::result<bool>());
 
     MOCK_CONST_METHOD0(remotePeerId, outcome::result<peer::PeerId>());
@@ -17,6 +17,9 @@ namespace libp2p::network {
     ~ConnectionManagerMock() override = default;
 
     MOCK_CONST_METHOD0(getConnections, std::vector<ConnectionSPtr>());
+    MOCK_CONST_METHOD1(forEachConnection,
+                       void(const ConnectionVisitor &visitor));
+    MOCK_CONST_METHOD1(forEachConnectedPeer, void(const PeerVisitor &visitor));
     MOCK_CONST_METHOD1(getConnectionsToPeer,
                        std::vector<ConnectionSPtr>(const peer::PeerId &p));
     MOCK_CONST_METHOD1(getBestConnectionForPeer,
@@ -27,6 +30,12 @@ namespace libp2p::network {
 
     MOCK_METHOD1(closeConnectionsToPeer, void(const peer::PeerId &p));
 
+    MOCK_METHOD2(protectPeer,
+                 void(const peer::PeerId &p, const std::string &tag));
+    MOCK_METHOD2(unprotectPeer,
+                 void(const peer::PeerId &p, const std::string &tag));
+    MOCK_CONST_METHOD1(isProtected, bool(const peer::PeerId &p));
+
     MOCK_METHOD0(collectGarbage, void());
 
     MOCK_METHOD2(onConnectionClosed, void(
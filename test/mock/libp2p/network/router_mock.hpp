@@ -23,6 +23,10 @@ namespace libp2p::network {
 
     MOCK_CONST_METHOD0(getSupportedProtocols, std::vector<peer::Protocol>());
 
+    MOCK_CONST_METHOD0(
+        getSupportedProtocolIds,
+        std::shared_ptr<const std::vector<peer::ProtocolId>>());
+
     MOCK_METHOD1(removeProtocolHandlers, void(const peer::Protocol &));
 
     MOCK_METHOD0(removeAll, void());
@@ -41,6 +41,11 @@ namespace libp2p::peer {
 
     MOCK_CONST_METHOD0(getPeers, std::unordered_set<PeerId>());
 
+    MOCK_CONST_METHOD1(forEachPeer,
+                       void(const std::function<PeerVisitor> &));
+
+    MOCK_CONST_METHOD1(hasPeer, bool(const PeerId &));
+
     // garbage collectable
     MOCK_METHOD0(collectGarbage, void());
   };
@@ -27,6 +27,11 @@ namespace libp2p::peer {
     MOCK_METHOD1(addKeyPair, outcome::result<void>(const KeyPair &));
 
     MOCK_CONST_METHOD0(getPeers, std::unordered_set<PeerId>());
+
+    MOCK_CONST_METHOD1(forEachPeer,
+                       void(const std::function<PeerVisitor> &));
+
+    MOCK_CONST_METHOD1(hasPeer, bool(const PeerId &));
   };
 }  // namespace libp2p::peer
 
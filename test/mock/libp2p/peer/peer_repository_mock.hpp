@@ -22,6 +22,9 @@ namespace libp2p::peer {
 
     MOCK_CONST_METHOD0(getPeers, std::unordered_set<PeerId>());
 
+    MOCK_CONST_METHOD1(forEachPeer,
+                       void(const std::function<PeerVisitor> &));
+
     MOCK_CONST_METHOD1(getPeerInfo, PeerInfo(const PeerId &));
   };
 }  // namespace libp2p::peer
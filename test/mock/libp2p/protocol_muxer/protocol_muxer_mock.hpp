@@ -20,6 +20,12 @@ namespace libp2p::protocol_muxer {
                       bool is_initiator, bool negotiate_multiselect,
                       ProtocolHandlerFunc cb));
 
+    MOCK_METHOD5(selectOneOf,
+                 void(gsl::span<const peer::ProtocolId> protocols,
+                      std::shared_ptr<basic::ReadWriter> connection,
+                      bool is_initiator, bool negotiate_multiselect,
+                      ProtocolIdHandlerFunc cb));
+
     MOCK_METHOD3(
         simpleStreamNegotiate,
         void(const std::shared_ptr<connection::Stream> &,
@@ -0,0 +1,200 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LIBP2P_TESTUTIL_STREAM_PAIR_HPP
+#define LIBP2P_TESTUTIL_STREAM_PAIR_HPP
+
+#include <chrono>
+#include <deque>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <libp2p/connection/stream.hpp>
+#include <libp2p/peer/peer_id.hpp>
+
+namespace libp2p::testutil {
+
+  /**
+   * In-memory stream, connected to the other end of the pair. Written data
+   * is delivered to the other end after the given delay, all callbacks are
+   * called from io_context
+   */
+  class PipeStream : public connection::Stream,
+                     public std::enable_shared_from_this<PipeStream> {
+   public:
+    using Delay = std::chrono::microseconds;
+
+    /// Creates connected streams, the first one is the initiator
+    static std::pair<std::shared_ptr<PipeStream>, std::shared_ptr<PipeStream>>
+    makePair(boost::asio::io_context &io, Delay delay = Delay::zero()) {
+      auto a = std::make_shared<PipeStream>(io, delay, true);
+      auto b = std::make_shared<PipeStream>(io, delay, false);
+      a->other_ = b;
+      b->other_ = a;
+      return {a, b};
+    }
+
+    PipeStream(boost::asio::io_context &io, Delay delay, bool initiator)
+        : io_(io), delay_(delay), initiator_(initiator) {}
+
+    void read(gsl::span<uint8_t> out, size_t bytes,
+              ReadCallbackFunc cb) override {
+      startRead(out, bytes, std::move(cb), false);
+    }
+
+    void readSome(gsl::span<uint8_t> out, size_t bytes,
+                  ReadCallbackFunc cb) override {
+      startRead(out, bytes, std::move(cb), true);
+    }
+
+    void deferReadCallback(outcome::result<size_t> res,
+                           ReadCallbackFunc cb) override {
+      boost::asio::post(io_, [res, cb = std::move(cb)] { cb(res); });
+    }
+
+    void write(gsl::span<const uint8_t> in, size_t bytes,
+               WriteCallbackFunc cb) override {
+      if (reset_ || closed_for_write_) {
+        return deferWriteCallback(Error::STREAM_NOT_WRITABLE, std::move(cb));
+      }
+      ++writes;
+      std::vector<uint8_t> data(in.begin(), in.begin() + bytes);
+      if (delay_ == Delay::zero()) {
+        boost::asio::post(io_, [other = other_, data = std::move(data)] {
+          if (auto s = other.lock()) {
+            s->onData(data);
+          }
+        });
+      } else {
+        auto timer = std::make_shared<boost::asio::steady_timer>(io_, delay_);
+        timer->async_wait(
+            [timer, other = other_, data = std::move(data)](auto &&) {
+              if (auto s = other.lock()) {
+                s->onData(data);
+              }
+            });
+      }
+      deferReadCallback(bytes, std::move(cb));
+    }
+
+    void writeSome(gsl::span<const uint8_t> in, size_t bytes,
+                   WriteCallbackFunc cb) override {
+      write(in, bytes, std::move(cb));
+    }
+
+    void deferWriteCallback(std::error_code ec,
+                            WriteCallbackFunc cb) override {
+      deferReadCallback(ec, std::move(cb));
+    }
+
+    bool isClosedForRead() const override {
+      return reset_;
+    }
+
+    bool isClosedForWrite() const override {
+      return reset_ || closed_for_write_;
+    }
+
+    bool isClosed() const override {
+      return isClosedForRead() && isClosedForWrite();
+    }
+
+    void close(VoidResultHandlerFunc cb) override {
+      closed_for_write_ = true;
+      boost::asio::post(io_, [cb = std::move(cb)] { cb(outcome::success()); });
+    }
+
+    void reset() override {
+      if (reset_) {
+        return;
+      }
+      reset_ = true;
+      failRead(Error::STREAM_RESET_BY_HOST);
+      boost::asio::post(io_, [other = other_] {
+        if (auto s = other.lock()) {
+          s->reset_ = true;
+          s->failRead(Error::STREAM_RESET_BY_PEER);
+        }
+      });
+    }
+
+    void adjustWindowSize(uint32_t, VoidResultHandlerFunc cb) override {
+      boost::asio::post(io_, [cb = std::move(cb)] { cb(outcome::success()); });
+    }
+
+    outcome::result<bool> isInitiator() const override {
+      return initiator_;
+    }
+
+    outcome::result<peer::PeerId> remotePeerId() const override {
+      return Error::STREAM_INTERNAL_ERROR;
+    }
+
+    outcome::result<multi::Multiaddress> localMultiaddr() const override {
+      return Error::STREAM_INTERNAL_ERROR;
+    }
+
+    outcome::result<multi::Multiaddress> remoteMultiaddr() const override {
+      return Error::STREAM_INTERNAL_ERROR;
+    }
+
+    /// Count of write operations, i.e. packets sent to the other end
+    size_t writes = 0;
+
+   private:
+    void startRead(gsl::span<uint8_t> out, size_t bytes, ReadCallbackFunc cb,
+                   bool some) {
+      if (reset_) {
+        return deferReadCallback(Error::STREAM_NOT_READABLE, std::move(cb));
+      }
+      out_ = out.first(bytes);
+      read_cb_ = std::move(cb);
+      some_ = some;
+      tryRead();
+    }
+
+    void onData(const std::vector<uint8_t> &data) {
+      if (reset_) {
+        return;
+      }
+      buffer_.insert(buffer_.end(), data.begin(), data.end());
+      tryRead();
+    }
+
+    void tryRead() {
+      if (!read_cb_ || buffer_.empty()) {
+        return;
+      }
+      if (!some_ && buffer_.size() < static_cast<size_t>(out_.size())) {
+        return;
+      }
+      auto n = std::min(buffer_.size(), static_cast<size_t>(out_.size()));
+      std::copy_n(buffer_.begin(), n, out_.begin());
+      buffer_.erase(buffer_.begin(), buffer_.begin() + n);
+      deferReadCallback(n, std::exchange(read_cb_, {}));
+    }
+
+    void failRead(std::error_code ec) {
+      if (read_cb_) {
+        deferReadCallback(ec, std::exchange(read_cb_, {}));
+      }
+    }
+
+    boost::asio::io_context &io_;
+    Delay delay_;
+    bool initiator_;
+    std::weak_ptr<PipeStream> other_;
+    std::deque<uint8_t> buffer_;
+    gsl::span<uint8_t> out_;
+    ReadCallbackFunc read_cb_;
+    bool some_ = false;
+    bool closed_for_write_ = false;
+    bool reset_ = false;
+  };
+
+}  // namespace libp2p::testutil
+
+#endif  // LIBP2P_TESTUTIL_STREAM_PAIR_HPP